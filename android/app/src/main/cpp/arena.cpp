@@ -0,0 +1,191 @@
+#include "arena.h"
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+struct NekkoArenaBlock {
+    NekkoArenaBlock* next;
+    size_t size;    // usable bytes after the header
+};
+
+// Lives in the arena it belongs to.
+struct NekkoArenaAdopted {
+    NekkoArenaAdopted* next;
+    void* ptr;
+};
+
+namespace {
+    constexpr size_t kAlign = alignof(max_align_t);
+    constexpr size_t kMinBlock = 256;
+    constexpr size_t kMaxBlock = 1 << 20;
+
+    void free_adopted(NekkoArena* arena) {
+        for (NekkoArenaAdopted* a = arena->adopted; a; a = a->next) free(a->ptr);
+        arena->adopted = nullptr;
+    }
+
+    constexpr size_t align_up(size_t n, size_t a) { return (n + a - 1) & ~(a - 1); }
+
+    constexpr size_t kBlockHeader = align_up(sizeof(NekkoArenaBlock), kAlign);
+    constexpr size_t kArenaHeader = align_up(sizeof(NekkoArena), kAlign);
+
+    char* block_data(NekkoArenaBlock* block) { return (char*)block + kBlockHeader; }
+
+    // Slow path: the head block is exhausted. Requests larger than half a
+    // block get a block of their own, linked behind the head so the bump
+    // space left in the head is not wasted.
+    void* arena_grow(NekkoArena* arena, size_t size) {
+        if (size > arena->nextBlockSize / 2) {
+            NekkoArenaBlock* big = (NekkoArenaBlock*)malloc(kBlockHeader + size);
+            if (!big) return nullptr;
+            big->size = size;
+            big->next = arena->head->next;
+            arena->head->next = big;
+            return block_data(big);
+        }
+
+        size_t blockSize = arena->nextBlockSize;
+        NekkoArenaBlock* block = (NekkoArenaBlock*)malloc(kBlockHeader + blockSize);
+        if (!block) return nullptr;
+        block->size = blockSize;
+        block->next = arena->head;
+        arena->head = block;
+        arena->cur = block_data(block) + size;
+        arena->end = block_data(block) + blockSize;
+        if (arena->nextBlockSize < kMaxBlock) arena->nextBlockSize *= 2;
+        return block_data(block);
+    }
+
+    inline void* arena_bump(NekkoArena* arena, size_t size, size_t align) {
+        uintptr_t p = ((uintptr_t)arena->cur + (align - 1)) & ~(uintptr_t)(align - 1);
+        if (p + size <= (uintptr_t)arena->end) {
+            arena->cur = (char*)(p + size);
+            return (void*)p;
+        }
+        // Fresh blocks start kAlign-aligned, so `align` needs no extra room.
+        return arena_grow(arena, align_up(size, align));
+    }
+}
+
+NekkoArena* nekko_arena_create(size_t sizeHint) {
+    size_t first = align_up(sizeHint < kMinBlock ? kMinBlock : sizeHint, kAlign);
+    // The arena header lives in its own first block: one malloc per arena.
+    NekkoArenaBlock* block = (NekkoArenaBlock*)malloc(kBlockHeader + kArenaHeader + first);
+    if (!block) return nullptr;
+    block->next = nullptr;
+    block->size = kArenaHeader + first;
+
+    NekkoArena* arena = (NekkoArena*)block_data(block);
+    arena->head = block;
+    arena->cur = block_data(block) + kArenaHeader;
+    arena->end = arena->cur + first;
+    arena->nextBlockSize = first < kMaxBlock ? first : kMaxBlock;
+    arena->adopted = nullptr;
+    return arena;
+}
+
+void nekko_arena_release(NekkoArena* arena) {
+    if (!arena) return;
+    free_adopted(arena);
+    // The arena itself sits in the oldest block, so free it last.
+    NekkoArenaBlock* block = arena->head;
+    while (block) {
+        NekkoArenaBlock* next = block->next;
+        free(block);
+        block = next;
+    }
+}
+
+NekkoArena* nekko_arena_recycle(NekkoArena* arena) {
+    if (!arena) return nullptr;
+    free_adopted(arena);
+    NekkoArenaBlock* block = arena->head;
+    if (!block->next) {
+        arena->cur = block_data(block) + kArenaHeader;
+        return arena;
+    }
+    size_t total = 0;
+    for (; block; block = block->next) total += block->size;
+    nekko_arena_release(arena);
+    return nekko_arena_create(total);
+}
+
+void* nekko_arena_alloc(NekkoArena* arena, size_t size) {
+    return arena_bump(arena, size, kAlign);
+}
+
+void* nekko_arena_alloc_aligned(NekkoArena* arena, size_t size, size_t align) {
+    return arena_bump(arena, size, align);
+}
+
+void* nekko_arena_calloc(NekkoArena* arena, size_t count, size_t size) {
+    if (count == 0 || size == 0) return nullptr;
+    if (count > SIZE_MAX / size) return nullptr;
+    void* p = arena_bump(arena, count * size, kAlign);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
+
+bool nekko_arena_adopt(NekkoArena* arena, void* ptr) {
+    if (!ptr) return true;
+    NekkoArenaAdopted* a = (NekkoArenaAdopted*)nekko_arena_alloc(arena, sizeof(NekkoArenaAdopted));
+    if (!a) {
+        free(ptr);
+        return false;
+    }
+    a->ptr = ptr;
+    a->next = arena->adopted;
+    arena->adopted = a;
+    return true;
+}
+
+void nekko_arena_merge(NekkoArena* into, NekkoArena* from) {
+    if (!from) return;
+    // Adopted nodes live in `from`'s blocks, which are about to be `into`'s.
+    if (from->adopted) {
+        NekkoArenaAdopted* last = from->adopted;
+        while (last->next) last = last->next;
+        last->next = into->adopted;
+        into->adopted = from->adopted;
+    }
+    // Behind the head, like a big block, so `into` keeps bumping where it
+    // was. `from` itself sits in its oldest block and goes with it.
+    NekkoArenaBlock* first = from->head;
+    NekkoArenaBlock* last = first;
+    while (last->next) last = last->next;
+    last->next = into->head->next;
+    into->head->next = first;
+}
+
+char* nekko_arena_strndup(NekkoArena* arena, const char* s, size_t len) {
+    if (!s) return nullptr;
+    char* out = (char*)arena_bump(arena, len + 1, 1);
+    if (!out) return nullptr;
+    memcpy(out, s, len);
+    out[len] = '\0';
+    return out;
+}
+
+char* nekko_arena_strdup(NekkoArena* arena, const char* s) {
+    if (!s) return nullptr;
+    return nekko_arena_strndup(arena, s, strlen(s));
+}
+
+char* nekko_arena_printf(NekkoArena* arena, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(nullptr, 0, format, args);
+    va_end(args);
+    if (len < 0) return nullptr;
+
+    char* buf = (char*)arena_bump(arena, (size_t)len + 1, 1);
+    if (!buf) return nullptr;
+
+    va_start(args, format);
+    vsnprintf(buf, (size_t)len + 1, format, args);
+    va_end(args);
+    return buf;
+}
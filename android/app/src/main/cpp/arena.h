@@ -0,0 +1,55 @@
+// Bump allocator backing every parse result.
+// A result and everything it points to (arrays, strings, error message) is
+// carved out of one NekkoArena, so freeing the result is one
+// nekko_arena_release() instead of a free() per field.
+#ifndef NEKKO_ARENA_H
+#define NEKKO_ARENA_H
+
+#include <stddef.h>
+
+struct NekkoArenaBlock;
+struct NekkoArenaAdopted;
+
+struct NekkoArena {
+    struct NekkoArenaBlock* head;   // newest block first
+    char* cur;                      // bump pointer inside head
+    char* end;
+    size_t nextBlockSize;
+    struct NekkoArenaAdopted* adopted;  // malloc'd buffers freed with the arena
+};
+
+// `sizeHint` is the expected total allocation; the first block is sized from
+// it so typical results never grow. Returns nullptr on OOM.
+NekkoArena* nekko_arena_create(size_t sizeHint);
+void nekko_arena_release(NekkoArena* arena);
+
+// Discards every allocation so the arena can be reused. If the last use
+// outgrew the first block, the arena is rebuilt as one block big enough for
+// all of it, so the returned pointer may differ from `arena`.
+NekkoArena* nekko_arena_recycle(NekkoArena* arena);
+
+// Aligned for any struct in native-lib.h.
+void* nekko_arena_alloc(NekkoArena* arena, size_t size);
+void* nekko_arena_calloc(NekkoArena* arena, size_t count, size_t size);
+// `align` (a power of two, at most 16) instead, for small records that would
+// waste most of a 16-byte slot.
+void* nekko_arena_alloc_aligned(NekkoArena* arena, size_t size, size_t align);
+
+// Hands a malloc'd buffer to the arena: it is freed on release or recycle,
+// so a result can point into a buffer it did not copy. On OOM `ptr` is freed
+// at once and false is returned.
+bool nekko_arena_adopt(NekkoArena* arena, void* ptr);
+
+// Moves every allocation of `from` into `into`, which then frees them, and
+// ends `from` (do not release it). Nothing is copied or allocated, so
+// pointers into `from` stay valid: a parse can fill one arena per thread and
+// hand them all to the result's.
+void nekko_arena_merge(NekkoArena* into, NekkoArena* from);
+
+// String helpers. All return nullptr for a nullptr source.
+char* nekko_arena_strdup(NekkoArena* arena, const char* s);
+char* nekko_arena_strndup(NekkoArena* arena, const char* s, size_t len);
+char* nekko_arena_printf(NekkoArena* arena, const char* format, ...)
+        __attribute__((format(printf, 2, 3)));
+
+#endif // NEKKO_ARENA_H
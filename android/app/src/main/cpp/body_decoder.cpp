@@ -0,0 +1,231 @@
+#include "body_decoder.h"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <strings.h>
+
+#include <zlib.h>
+#if NEKKO_HAVE_BROTLI
+#include <brotli/decode.h>
+#endif
+
+#include "yyjson.h"
+
+namespace {
+    // First guess at the decoded size when the body does not say. API JSON
+    // compresses 8-12x, so this usually needs no regrowth.
+    constexpr size_t kRatioGuess = 8;
+    constexpr size_t kMinOutput = 4096;
+
+    // The decoded body, grown geometrically, always with room for the
+    // padding after `cap`.
+    class Output {
+    public:
+        ~Output() { free(data_); }
+
+        bool reserve(size_t cap, const char** error) {
+            if (data_ && cap <= cap_) return true;
+            if (cap > kMaxDecodedBody) {
+                *error = "Decoded body too large";
+                return false;
+            }
+            char* grown = (char*)realloc(data_, cap + YYJSON_PADDING_SIZE);
+            if (!grown) {
+                *error = "Out of memory";
+                return false;
+            }
+            data_ = grown;
+            cap_ = cap;
+            return true;
+        }
+
+        // Room for at least one more byte.
+        bool grow(const char** error) {
+            if (len_ < cap_) return true;
+            size_t cap = cap_ < kMinOutput ? kMinOutput : cap_ * 2;
+            if (cap > kMaxDecodedBody && cap_ < kMaxDecodedBody) cap = kMaxDecodedBody;
+            return reserve(cap, error);
+        }
+
+        uint8_t* tail() { return (uint8_t*)data_ + len_; }
+        size_t room() const { return cap_ - len_; }
+        void wrote(size_t n) { len_ += n; }
+
+        char* release(size_t* len) {
+            memset(data_ + len_, 0, YYJSON_PADDING_SIZE);
+            *len = len_;
+            char* data = data_;
+            data_ = nullptr;
+            return data;
+        }
+
+    private:
+        char* data_ = nullptr;
+        size_t len_ = 0, cap_ = 0;
+    };
+
+    // gzip ends with the decoded size mod 2^32; exact for any body we would
+    // accept, and only a hint if the body is several members or lies.
+    size_t first_guess(const uint8_t* body, size_t len, BodyEncoding encoding) {
+        if (encoding == BodyEncoding::Gzip && len >= 18) {
+            const uint8_t* t = body + len - 4;
+            size_t isize = (size_t)t[0] | (size_t)t[1] << 8 | (size_t)t[2] << 16 | (size_t)t[3] << 24;
+            if (isize) return isize < kMaxDecodedBody ? isize : kMaxDecodedBody;
+        }
+        size_t guess = len < kMaxDecodedBody / kRatioGuess ? len * kRatioGuess : kMaxDecodedBody;
+        return guess < kMinOutput ? kMinOutput : guess;
+    }
+
+    // "deflate" is meant to be zlib-wrapped, but servers also send the bare
+    // stream; the two header bytes tell them apart the way browsers do.
+    bool has_zlib_header(const uint8_t* body, size_t len) {
+        return len >= 2 && (body[0] & 0x0f) == Z_DEFLATED && (body[0] >> 4) + 8 <= MAX_WBITS &&
+               ((body[0] << 8) | body[1]) % 31 == 0;
+    }
+
+    bool inflate_body(const uint8_t* body, size_t len, BodyEncoding encoding, Output& out, const char** error) {
+        // gzip bodies are also accepted with a zlib header (32: detect).
+        int windowBits = encoding == BodyEncoding::Gzip ? 32 + MAX_WBITS
+                         : has_zlib_header(body, len) ? MAX_WBITS : -MAX_WBITS;
+        z_stream zs = {};
+        if (inflateInit2(&zs, windowBits) != Z_OK) {
+            *error = "Out of memory";
+            return false;
+        }
+        const uint8_t* in = body;
+        size_t inLeft = len;
+        bool ok = false;
+        for (;;) {
+            if (zs.avail_in == 0 && inLeft) {
+                zs.next_in = (Bytef*)in;
+                zs.avail_in = (uInt)(inLeft < UINT_MAX ? inLeft : UINT_MAX);
+                in += zs.avail_in;
+                inLeft -= zs.avail_in;
+            }
+            if (!out.grow(error)) break;
+            zs.next_out = out.tail();
+            zs.avail_out = (uInt)(out.room() < UINT_MAX ? out.room() : UINT_MAX);
+            uInt room = zs.avail_out;
+            int rc = inflate(&zs, Z_NO_FLUSH);
+            out.wrote(room - zs.avail_out);
+
+            if (rc == Z_STREAM_END) {
+                if (zs.avail_in == 0 && inLeft == 0) {
+                    ok = true;
+                    break;
+                }
+                // Concatenated gzip members decode as one body.
+                if (encoding == BodyEncoding::Gzip && inflateReset(&zs) == Z_OK) continue;
+                *error = "Corrupt compressed body";
+                break;
+            }
+            if (rc == Z_OK) continue;
+            if (rc == Z_BUF_ERROR && zs.avail_out == 0) continue;
+            if (rc == Z_MEM_ERROR) *error = "Out of memory";
+            else if (rc == Z_BUF_ERROR) *error = "Truncated compressed body";
+            else *error = "Corrupt compressed body";
+            break;
+        }
+        inflateEnd(&zs);
+        return ok;
+    }
+
+#if NEKKO_HAVE_BROTLI
+    bool brotli_body(const uint8_t* body, size_t len, Output& out, const char** error) {
+        BrotliDecoderState* state = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+        if (!state) {
+            *error = "Out of memory";
+            return false;
+        }
+        const uint8_t* in = body;
+        size_t inLeft = len;
+        bool ok = false;
+        for (;;) {
+            if (!out.grow(error)) break;
+            uint8_t* next = out.tail();
+            size_t room = out.room();
+            BrotliDecoderResult rc = BrotliDecoderDecompressStream(state, &inLeft, &in, &room, &next, nullptr);
+            out.wrote((size_t)(next - out.tail()));
+            if (rc == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT) continue;
+            if (rc == BROTLI_DECODER_RESULT_SUCCESS) {
+                ok = inLeft == 0;
+                if (!ok) *error = "Corrupt compressed body";
+            } else if (rc == BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT) {
+                *error = "Truncated compressed body";
+            } else {
+                *error = "Corrupt compressed body";
+            }
+            break;
+        }
+        BrotliDecoderDestroyInstance(state);
+        return ok;
+    }
+#endif
+
+    bool name_is(const char* name, size_t len, const char* want) {
+        return strlen(want) == len && strncasecmp(name, want, len) == 0;
+    }
+}
+
+BodyEncoding body_encoding_from_name(const char* name) {
+    if (!name) return BodyEncoding::Identity;
+    while (*name == ' ' || *name == '\t') name++;
+    size_t len = strlen(name);
+    while (len && (name[len - 1] == ' ' || name[len - 1] == '\t')) len--;
+    if (len == 0 || name_is(name, len, "identity")) return BodyEncoding::Identity;
+    if (name_is(name, len, "gzip") || name_is(name, len, "x-gzip")) return BodyEncoding::Gzip;
+    if (name_is(name, len, "deflate")) return BodyEncoding::Deflate;
+    if (name_is(name, len, "br")) return BodyEncoding::Brotli;
+    return BodyEncoding::Unknown;
+}
+
+bool body_encoding_supported(BodyEncoding encoding) {
+    switch (encoding) {
+        case BodyEncoding::Identity:
+        case BodyEncoding::Gzip:
+        case BodyEncoding::Deflate:
+            return true;
+        case BodyEncoding::Brotli:
+#if NEKKO_HAVE_BROTLI
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+char* decode_body(const uint8_t* body, size_t len, BodyEncoding encoding,
+                  size_t* decodedLen, const char** error) {
+    *decodedLen = 0;
+    if (!body && len) {
+        *error = "Null body";
+        return nullptr;
+    }
+    if (!body_encoding_supported(encoding)) {
+        *error = "Unsupported content encoding";
+        return nullptr;
+    }
+
+    Output out;
+    bool ok;
+    if (encoding == BodyEncoding::Identity) {
+        ok = out.reserve(len, error);
+        if (ok && len) {
+            memcpy(out.tail(), body, len);
+            out.wrote(len);
+        }
+    } else if (encoding == BodyEncoding::Brotli) {
+#if NEKKO_HAVE_BROTLI
+        ok = out.reserve(first_guess(body, len, encoding), error) && brotli_body(body, len, out, error);
+#else
+        ok = false;
+#endif
+    } else {
+        ok = out.reserve(first_guess(body, len, encoding), error) &&
+             inflate_body(body, len, encoding, out, error);
+    }
+    return ok ? out.release(decodedLen) : nullptr;
+}
@@ -0,0 +1,35 @@
+// Content-Encoding decoding for response bodies handed over as received.
+// The decoded body goes straight into a parser buffer (the
+// nekko_alloc_buffer layout: malloc'd, YYJSON_PADDING_SIZE zero bytes after
+// the payload), so it can be parsed insitu without another copy.
+//
+// gzip and deflate use zlib, which every build links. br needs libbrotlidec
+// at build time (NEKKO_HAVE_BROTLI); without it body_encoding_supported()
+// says so and the caller decodes it some other way.
+#ifndef NEKKO_BODY_DECODER_H
+#define NEKKO_BODY_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class BodyEncoding { Identity, Gzip, Deflate, Brotli, Unknown };
+
+// A Content-Encoding header value. nullptr, "" and "identity" are Identity;
+// case and surrounding spaces are ignored. Stacked codings ("gzip, br") are
+// Unknown.
+BodyEncoding body_encoding_from_name(const char* name);
+
+bool body_encoding_supported(BodyEncoding encoding);
+
+// Decodes `body` into a new padded buffer, released with free(). Returns
+// nullptr on failure with `*error` set to a static message: unsupported
+// encoding, corrupt or truncated data, out of memory, or a body that would
+// decode past kMaxDecodedBody.
+char* decode_body(const uint8_t* body, size_t len, BodyEncoding encoding,
+                  size_t* decodedLen, const char** error);
+
+// Upper bound on a decoded body, so a small hostile payload cannot expand
+// into all of memory.
+constexpr size_t kMaxDecodedBody = 256u << 20;
+
+#endif // NEKKO_BODY_DECODER_H
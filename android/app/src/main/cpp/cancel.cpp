@@ -0,0 +1,35 @@
+#include "cancel.h"
+
+#include <climits>
+#include <new>
+
+// --- Cancellation API ---
+
+extern "C" {
+
+__attribute__((visibility("default"))) __attribute__((used))
+NekkoCancel* nekko_cancel_create(int64_t timeout_ms) {
+    NekkoCancel* cancel = new (std::nothrow) NekkoCancel();
+    // Anything past what the clock can count is no deadline at all.
+    if (cancel && timeout_ms > 0 && timeout_ms < INT64_MAX / 2000000) {
+        cancel->deadline = nekko_cancel_now() + timeout_ms * 1000000;
+    }
+    return cancel;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_cancel(NekkoCancel* cancel) {
+    if (cancel) cancel->fired.store(true, std::memory_order_relaxed);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+bool nekko_cancelled(NekkoCancel* cancel) {
+    return cancel_requested(cancel);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_cancel_destroy(NekkoCancel* cancel) {
+    delete cancel;
+}
+
+}
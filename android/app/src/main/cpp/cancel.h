@@ -0,0 +1,34 @@
+// Internal side of NekkoCancel (declared opaque in native-lib.h).
+#ifndef NEKKO_CANCEL_H
+#define NEKKO_CANCEL_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+
+#include "native-lib.h"
+
+// Set from any thread by nekko_cancel; read by the parse it was given to
+// once per array element, so a loop notices within one element.
+struct NekkoCancel {
+    std::atomic<bool> fired{false};
+    int64_t deadline = 0;   // steady clock, ns; 0 for none
+};
+
+inline int64_t nekko_cancel_now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Whether work under `cancel` should stop: cancelled, or past its deadline
+// (after which it stays cancelled). False for a null token.
+inline bool cancel_requested(NekkoCancel* cancel) {
+    if (!cancel) return false;
+    if (cancel->fired.load(std::memory_order_relaxed)) return true;
+    if (cancel->deadline == 0 || nekko_cancel_now() < cancel->deadline) return false;
+    cancel->fired.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+#endif // NEKKO_CANCEL_H
@@ -0,0 +1,269 @@
+// Single-pass field extraction for yyjson objects.
+//
+// yyjson_obj_get is a linear scan over an object's members, so a parser that
+// reads k fields, each with a casing fallback, scans the object up to 2k
+// times. A KeyTable maps every accepted spelling of every field to a slot
+// through a perfect hash found at compile time; ObjFields walks the object
+// once and drops each member into its slot. An object then costs one pass
+// over its members however many fields and aliases the parser knows.
+#ifndef NEKKO_FIELD_TABLE_H
+#define NEKKO_FIELD_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <array>
+
+#include "yyjson.h"
+
+// --- Helper for Robust Int parsing ---
+inline int64_t get_json_int64(yyjson_val* val) {
+    if (!val) return 0;
+    if (yyjson_is_int(val)) return yyjson_get_sint(val);
+    if (yyjson_is_uint(val)) return (int64_t)yyjson_get_uint(val);
+    if (yyjson_is_real(val)) return (int64_t)yyjson_get_real(val);
+    if (yyjson_is_str(val)) {
+        return atoll(yyjson_get_str(val));
+    }
+    return 0;
+}
+
+inline int get_json_int(yyjson_val* val) {
+    if (!val) return 0;
+    if (yyjson_is_int(val)) return yyjson_get_int(val);
+    if (yyjson_is_uint(val)) return (int)yyjson_get_uint(val);
+    if (yyjson_is_real(val)) return (int)yyjson_get_real(val);
+    if (yyjson_is_str(val)) {
+        return atoi(yyjson_get_str(val));
+    }
+    return 0;
+}
+
+// What counts as "set" when an object carries more than one spelling of a
+// field: the first alias in table order with a set value wins, as with the
+// `x = get(A); if (!x) x = get(B);` chains this replaces.
+enum class FieldKind : uint8_t {
+    Int,    // non-zero after get_json_int
+    Int64,  // non-zero after get_json_int64
+    Str,    // a string
+    Bool,   // true
+    Any,    // present (objects, arrays)
+};
+
+struct KeyAlias {
+    const char* key;
+    uint8_t slot;
+    FieldKind kind;
+};
+
+namespace field_table_detail {
+    constexpr size_t const_strlen(const char* s) {
+        size_t n = 0;
+        while (s[n]) n++;
+        return n;
+    }
+
+    // FNV-1a over the whole key, seeded so make_key_table can search for a
+    // seed under which the table's keys land in distinct buckets.
+    constexpr uint32_t key_hash(uint32_t seed, const char* k, size_t len) {
+        uint32_t h = 2166136261u ^ seed;
+        for (size_t i = 0; i < len; i++) {
+            h ^= (uint8_t)k[i];
+            h *= 16777619u;
+        }
+        return h ^ (h >> 15);
+    }
+
+    constexpr size_t bucket_count(size_t keys) {
+        size_t n = 8;
+        while (n < keys * 4) n *= 2;
+        return n;
+    }
+
+    // Not constexpr: reaching it while building a table is a compile error.
+    void no_perfect_hash_for_key_set();
+}
+
+template <size_t NSlots, size_t NKeys>
+struct KeyTable {
+    static constexpr size_t kBuckets = field_table_detail::bucket_count(NKeys);
+    static_assert(NKeys < 255 && NSlots < 256, "one byte per alias and slot index");
+
+    uint32_t seed = 0;
+    uint8_t buckets[kBuckets] = {};     // alias index + 1, 0 when empty
+    const char* keys[NKeys] = {};
+    uint8_t lens[NKeys] = {};
+    uint8_t slots[NKeys] = {};
+    uint8_t ranks[NKeys] = {};          // position among its slot's aliases
+    FieldKind kinds[NSlots] = {};
+
+    // Alias index of `key`, or -1 for a key the table does not know.
+    int find(const char* key, size_t len) const {
+        if (len == 0 || len > 255) return -1;
+        uint32_t h = field_table_detail::key_hash(seed, key, len);
+        uint8_t b = buckets[h & (kBuckets - 1)];
+        if (!b) return -1;
+        size_t a = b - 1;
+        if (lens[a] != len || memcmp(keys[a], key, len) != 0) return -1;
+        return (int)a;
+    }
+};
+
+namespace field_table_detail {
+    template <size_t NSlots, size_t NKeys>
+    constexpr KeyTable<NSlots, NKeys> build_key_table(const KeyAlias* aliases) {
+        KeyTable<NSlots, NKeys> t;
+        for (size_t i = 0; i < NKeys; i++) {
+            t.keys[i] = aliases[i].key;
+            t.lens[i] = (uint8_t)const_strlen(aliases[i].key);
+            t.slots[i] = aliases[i].slot;
+            t.kinds[aliases[i].slot] = aliases[i].kind;
+            for (size_t j = 0; j < i; j++) {
+                if (aliases[j].slot == aliases[i].slot) t.ranks[i]++;
+            }
+        }
+        for (uint32_t seed = 0; seed < 4096; seed++) {
+            bool perfect = true;
+            for (size_t b = 0; b < t.kBuckets; b++) t.buckets[b] = 0;
+            for (size_t i = 0; i < NKeys && perfect; i++) {
+                size_t b = key_hash(seed, t.keys[i], t.lens[i]) & (t.kBuckets - 1);
+                if (t.buckets[b]) perfect = false;
+                else t.buckets[b] = (uint8_t)(i + 1);
+            }
+            if (perfect) {
+                t.seed = seed;
+                return t;
+            }
+        }
+        no_perfect_hash_for_key_set();
+        return t;
+    }
+}
+
+// Builds the table for `aliases`, listed in priority order per slot. A key
+// listed twice, or a set the hash cannot separate, fails to compile.
+template <size_t NSlots, size_t NKeys>
+constexpr KeyTable<NSlots, NKeys> make_key_table(const KeyAlias (&aliases)[NKeys]) {
+    return field_table_detail::build_key_table<NSlots, NKeys>(aliases);
+}
+
+// Same, for alias lists computed at compile time (see schema.h).
+template <size_t NSlots, size_t NKeys>
+constexpr KeyTable<NSlots, NKeys> make_key_table(const std::array<KeyAlias, NKeys>& aliases) {
+    return field_table_detail::build_key_table<NSlots, NKeys>(aliases.data());
+}
+
+// Key order of the objects in one array. TLU repeats the same member order
+// for every element, so after the first element each member is recognised by
+// comparing it with the key seen at the same position last time, without
+// hashing. A position that differs is looked up in the KeyTable and its hint
+// replaced, so a change of order costs one hash per moved member.
+// Hints point at keys inside the document and must not outlive it.
+struct ShapeHint {
+    static constexpr size_t kMaxMembers = 32;
+
+    const char* keys[kMaxMembers];
+    uint32_t lens[kMaxMembers];
+    int16_t aliases[kMaxMembers];   // -1: a key the table does not know
+    size_t count = 0;
+
+    // Alias index of the `idx`th member of an object, or -1.
+    template <size_t NSlots, size_t NKeys>
+    int find(const KeyTable<NSlots, NKeys>& table, size_t idx, const char* k, size_t len) {
+        if (idx < count && lens[idx] == len && memcmp(keys[idx], k, len) == 0) {
+            return aliases[idx];
+        }
+        int a = table.find(k, len);
+        if (idx < kMaxMembers) {
+            keys[idx] = k;
+            lens[idx] = (uint32_t)len;
+            aliases[idx] = (int16_t)a;
+        }
+        return a;
+    }
+
+    // Records how many members the object just read had.
+    void finish(size_t members) { count = members < kMaxMembers ? members : kMaxMembers; }
+};
+
+// The chosen value of each slot of one object, fed a member at a time.
+template <size_t NSlots, size_t NKeys>
+class FieldSlots {
+public:
+    explicit FieldSlots(const KeyTable<NSlots, NKeys>& table) : table_(table) {}
+
+    // False when the object already had this exact key: a repeated key keeps
+    // its first value, like yyjson_obj_get, so the new one can be skipped.
+    bool wants(int a) const {
+        uint8_t slot = table_.slots[a];
+        return !vals_[slot] || ranks_[slot] != table_.ranks[a];
+    }
+
+    // `val` must stay valid for as long as the slots are read.
+    void take(int a, yyjson_val* val) {
+        if (a < 0) return;
+        uint8_t slot = table_.slots[a];
+        if (prefer(table_.kinds[slot], slot, table_.ranks[a], val)) {
+            vals_[slot] = val;
+            ranks_[slot] = table_.ranks[a];
+        }
+    }
+
+    yyjson_val* operator[](size_t slot) const { return vals_[slot]; }
+
+private:
+    static bool is_set(FieldKind kind, yyjson_val* v) {
+        switch (kind) {
+            case FieldKind::Int: return get_json_int(v) != 0;
+            case FieldKind::Int64: return get_json_int64(v) != 0;
+            case FieldKind::Str: return yyjson_is_str(v);
+            case FieldKind::Bool: return yyjson_get_bool(v);
+            case FieldKind::Any: return true;
+        }
+        return true;
+    }
+
+    // Only reached when an object spells a field more than one way.
+    bool prefer(FieldKind kind, uint8_t slot, uint8_t rank, yyjson_val* val) const {
+        yyjson_val* held = vals_[slot];
+        if (!held) return true;
+        if (rank == ranks_[slot]) return false;
+        bool heldSet = is_set(kind, held);
+        bool valSet = is_set(kind, val);
+        if (rank < ranks_[slot]) return valSet || !heldSet;
+        return valSet && !heldSet;
+    }
+
+    const KeyTable<NSlots, NKeys>& table_;
+    yyjson_val* vals_[NSlots] = {};
+    uint8_t ranks_[NSlots] = {};
+};
+
+// The members of one object, sorted into slots in a single pass.
+template <size_t NSlots, size_t NKeys>
+class ObjFields : public FieldSlots<NSlots, NKeys> {
+public:
+    ObjFields(const KeyTable<NSlots, NKeys>& table, yyjson_val* obj) : FieldSlots<NSlots, NKeys>(table) {
+        if (!yyjson_is_obj(obj)) return;
+        size_t idx, max;
+        yyjson_val *key, *val;
+        yyjson_obj_foreach(obj, idx, max, key, val) {
+            this->take(table.find(unsafe_yyjson_get_str(key), unsafe_yyjson_get_len(key)), val);
+        }
+    }
+
+    // Same result, using and updating the key order of the previous element.
+    ObjFields(const KeyTable<NSlots, NKeys>& table, yyjson_val* obj, ShapeHint& hint) : FieldSlots<NSlots, NKeys>(table) {
+        if (!yyjson_is_obj(obj)) return;
+        size_t idx, max;
+        yyjson_val *key, *val;
+        yyjson_obj_foreach(obj, idx, max, key, val) {
+            this->take(hint.find(table, idx, unsafe_yyjson_get_str(key), unsafe_yyjson_get_len(key)), val);
+        }
+        hint.finish(max);
+    }
+};
+
+#endif // NEKKO_FIELD_TABLE_H
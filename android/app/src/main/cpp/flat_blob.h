@@ -0,0 +1,234 @@
+// Flat results: a parse result copied into one contiguous allocation
+// (NekkoBlob, native-lib.h) instead of a tree of arena arrays, so it can be
+// freed with one call, copied byte for byte between isolates or to disk,
+// and walked front to back.
+//
+// The structs inside are the usual *Native layouts, pointers included, so
+// Dart reads a blob's root exactly like a parse result. Pointers are valid
+// at the address recorded in the header; after a copy, nekko_blob_relocate
+// moves them to the new one.
+//
+// What is a pointer comes from the entity descriptors (native-schema.h):
+// BlobWalk visits every string, array and ref they list, in their order,
+// which is also the order the blob is laid out in. Every pointer member of
+// a flattened struct must therefore appear in its descriptor.
+#ifndef NEKKO_FLAT_BLOB_H
+#define NEKKO_FLAT_BLOB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <tuple>
+#include <type_traits>
+
+#include "native-lib.h"
+#include "schema.h"
+
+// A pointer to a single struct (RegistrationResult::data), walked with
+// `Desc`. Only flattening reads these; decoders never see them.
+template <auto Member, typename Desc>
+struct RefField {};
+
+template <auto Member, typename Desc>
+constexpr auto ref() {
+    return RefField<Member, Desc>{};
+}
+
+namespace blob_detail {
+    constexpr size_t align_up(size_t n, size_t a) { return (n + a - 1) & ~(a - 1); }
+
+    template <typename R>
+    constexpr size_t root_offset() {
+        return align_up(sizeof(NekkoBlob), alignof(R));
+    }
+}
+
+// Calls v.string(char*&) for each string and v.array(Item*&, int&) for each
+// array (a ref is an array of one), then walks the items the array now
+// points to. A visitor may move the pointer; returning false stops the walk.
+template <typename T, typename S = Schema<T>>
+struct BlobWalk {
+    template <typename V>
+    static bool walk(T& obj, V& v) {
+        return std::apply([&](const auto&... f) { return (visit(f, obj, v) && ...); }, S::fields);
+    }
+
+private:
+    template <auto Member, size_t N, typename V>
+    static bool visit(const ScalarField<Member, N>&, T& obj, V& v) {
+        if constexpr (std::is_same_v<schema_detail::member_t<Member>, char*>) return v.string(obj.*Member);
+        else return true;
+    }
+
+    template <auto Member, size_t N, typename V>
+    static bool visit(const ObjectField<Member, N>&, T& obj, V& v) {
+        return BlobWalk<schema_detail::member_t<Member>>::walk(obj.*Member, v);
+    }
+
+    template <typename Sub, size_t N, typename V>
+    static bool visit(const EmbedField<Sub, N>&, T& obj, V& v) {
+        return BlobWalk<T, Sub>::walk(obj, v);
+    }
+
+    template <auto Items, auto Count, size_t N, typename V>
+    static bool visit(const ArrayField<Items, Count, N>&, T& obj, V& v) {
+        using Item = std::remove_pointer_t<schema_detail::member_t<Items>>;
+        return items<Item, Schema<Item>>(obj.*Items, obj.*Count, v);
+    }
+
+    template <auto Member, typename Desc, typename V>
+    static bool visit(const RefField<Member, Desc>&, T& obj, V& v) {
+        using Item = std::remove_pointer_t<schema_detail::member_t<Member>>;
+        int count = obj.*Member ? 1 : 0;
+        return items<Item, Desc>(obj.*Member, count, v);
+    }
+
+    template <typename Item, typename Desc, typename V>
+    static bool items(Item*& items, int& count, V& v) {
+        if (!v.array(items, count)) return false;
+        for (int i = 0; items && i < count; i++) {
+            if (!BlobWalk<Item, Desc>::walk(items[i], v)) return false;
+        }
+        return true;
+    }
+};
+
+// Bytes a blob for the tree will take, laid out as BlobCopy lays it out.
+struct BlobMeasure {
+    size_t size;
+
+    bool string(char*& s) {
+        if (s) size += strlen(s) + 1;
+        return true;
+    }
+
+    template <typename Item>
+    bool array(Item*& items, int& count) {
+        if (items && count > 0) size = blob_detail::align_up(size, alignof(Item)) + (size_t)count * sizeof(Item);
+        return true;
+    }
+};
+
+// Copies what each pointer points to into the blob, in walk order, and
+// points it at the copy. Runs over the root's copy, so the walk descends
+// into copies too.
+struct BlobCopy {
+    char* base;
+    size_t used;
+
+    char* bump(size_t size, size_t align) {
+        used = blob_detail::align_up(used, align);
+        char* p = base + used;
+        used += size;
+        return p;
+    }
+
+    bool string(char*& s) {
+        if (!s) return true;
+        size_t n = strlen(s) + 1;
+        char* copy = bump(n, 1);
+        memcpy(copy, s, n);
+        s = copy;
+        return true;
+    }
+
+    template <typename Item>
+    bool array(Item*& items, int& count) {
+        if (!items || count <= 0) {
+            items = nullptr;
+            count = 0;
+            return true;
+        }
+        Item* copy = (Item*)bump((size_t)count * sizeof(Item), alignof(Item));
+        memcpy(copy, items, (size_t)count * sizeof(Item));
+        items = copy;
+        return true;
+    }
+};
+
+// Moves every pointer from `from` to `base`. Each target must lie inside
+// the blob, past everything before it in walk order (as BlobCopy placed
+// it), so a damaged blob cannot send a reader outside it or get a slot
+// relocated twice.
+struct BlobRelocate {
+    char* base;
+    size_t size;
+    uintptr_t from;
+    size_t cursor;
+
+    bool target(const void* p, size_t* offset) {
+        uintptr_t v = (uintptr_t)p;
+        if (v < from || v - from < cursor || v - from >= size) return false;
+        *offset = (size_t)(v - from);
+        return true;
+    }
+
+    bool string(char*& s) {
+        if (!s) return true;
+        size_t off;
+        if (!target(s, &off)) return false;
+        const char* nul = (const char*)memchr(base + off, 0, size - off);
+        if (!nul) return false;
+        s = base + off;
+        cursor = (size_t)(nul - base) + 1;
+        return true;
+    }
+
+    template <typename Item>
+    bool array(Item*& items, int& count) {
+        if (!items) return count == 0;
+        size_t off;
+        if (count <= 0 || !target(items, &off) || off % alignof(Item)) return false;
+        if ((size_t)count > (size - off) / sizeof(Item)) return false;
+        items = (Item*)(base + off);
+        cursor = off + (size_t)count * sizeof(Item);
+        return true;
+    }
+};
+
+// One malloc'd blob holding `result` and everything it points to, with
+// the arena left out; nullptr when out of memory. `S` describes R.
+template <typename R, typename S>
+NekkoBlob* blob_flatten(R* result, uint8_t kind) {
+    constexpr size_t rootOff = blob_detail::root_offset<R>();
+    BlobMeasure measure{rootOff + sizeof(R)};
+    BlobWalk<R, S>::walk(*result, measure);
+
+    // Zeroed, so padding and gaps are the same on every run.
+    char* base = (char*)calloc(1, measure.size);
+    if (!base) return nullptr;
+    R* root = (R*)(base + rootOff);
+    memcpy(root, result, sizeof(R));
+    root->arena = nullptr;
+    root->stringsBorrowed = false;
+    BlobCopy copy{base, rootOff + sizeof(R)};
+    BlobWalk<R, S>::walk(*root, copy);
+
+    NekkoBlob* blob = (NekkoBlob*)base;
+    blob->magic = NEKKO_BLOB_MAGIC;
+    blob->version = NEKKO_BLOB_VERSION;
+    blob->kind = kind;
+    blob->pointerSize = sizeof(void*);
+    blob->size = measure.size;
+    blob->base = (uint64_t)(uintptr_t)base;
+    blob->root = rootOff;
+    return blob;
+}
+
+// The pointer half of nekko_blob_relocate, once the header checks out.
+template <typename R, typename S>
+bool blob_relocate(NekkoBlob* blob) {
+    constexpr size_t rootOff = blob_detail::root_offset<R>();
+    if (blob->root != rootOff || blob->size < rootOff + sizeof(R)) return false;
+    char* base = (char*)blob;
+    R* root = (R*)(base + rootOff);
+    root->arena = nullptr;
+    BlobRelocate relocate{base, (size_t)blob->size, (uintptr_t)blob->base, rootOff + sizeof(R)};
+    if (!BlobWalk<R, S>::walk(*root, relocate)) return false;
+    blob->base = (uint64_t)(uintptr_t)base;
+    return true;
+}
+
+#endif // NEKKO_FLAT_BLOB_H
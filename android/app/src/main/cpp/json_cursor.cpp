@@ -0,0 +1,382 @@
+#include "json_cursor.h"
+
+#include <cstdlib>
+
+namespace {
+    using json_cursor_detail::skip_plain;
+
+    // Length of the well-formed UTF-8 sequence at `s`, 0 if there is none:
+    // no overlong forms, no surrogates, nothing past U+10FFFF.
+    size_t utf8_seq_len(const uint8_t* s) {
+        uint8_t c = s[0];
+        if (c >= 0xC2 && c <= 0xDF) {
+            return (s[1] & 0xC0) == 0x80 ? 2 : 0;
+        }
+        if (c >= 0xE0 && c <= 0xEF) {
+            uint8_t lo = c == 0xE0 ? 0xA0 : 0x80;
+            uint8_t hi = c == 0xED ? 0x9F : 0xBF;
+            return s[1] >= lo && s[1] <= hi && (s[2] & 0xC0) == 0x80 ? 3 : 0;
+        }
+        if (c >= 0xF0 && c <= 0xF4) {
+            uint8_t lo = c == 0xF0 ? 0x90 : 0x80;
+            uint8_t hi = c == 0xF4 ? 0x8F : 0xBF;
+            return s[1] >= lo && s[1] <= hi && (s[2] & 0xC0) == 0x80 && (s[3] & 0xC0) == 0x80 ? 4 : 0;
+        }
+        return 0;
+    }
+
+    bool hex4(const char* s, uint32_t* out) {
+        uint32_t v = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = s[i];
+            uint32_t d;
+            if (c >= '0' && c <= '9') d = (uint32_t)(c - '0');
+            else if (c >= 'a' && c <= 'f') d = (uint32_t)(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') d = (uint32_t)(c - 'A' + 10);
+            else return false;
+            v = (v << 4) | d;
+        }
+        *out = v;
+        return true;
+    }
+
+    char* put_utf8(char* dst, uint32_t cp) {
+        if (cp < 0x80) {
+            *dst++ = (char)cp;
+        } else if (cp < 0x800) {
+            *dst++ = (char)(0xC0 | (cp >> 6));
+            *dst++ = (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            *dst++ = (char)(0xE0 | (cp >> 12));
+            *dst++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = (char)(0x80 | (cp & 0x3F));
+        } else {
+            *dst++ = (char)(0xF0 | (cp >> 18));
+            *dst++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+            *dst++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+            *dst++ = (char)(0x80 | (cp & 0x3F));
+        }
+        return dst;
+    }
+
+    // Where a failed cursor points: a zero byte, which no token starts with.
+    char kStop[YYJSON_PADDING_SIZE] = {};
+
+    // --- Skipping ---
+    // skip_value() checks what it passes over exactly as the readers would,
+    // but on a local pointer and without writing anything back.
+
+    inline char* skip_ws(char* p) {
+        while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++;
+        return p;
+    }
+
+    // Past the escape at `p` (the backslash), or nullptr.
+    char* skip_escape(char* p) {
+        switch (p[1]) {
+            case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+                return p + 2;
+            case 'u': {
+                uint32_t hi, lo;
+                if (!hex4(p + 2, &hi)) return nullptr;
+                p += 6;
+                if ((hi & 0xF800) != 0xD800) return p;
+                if ((hi & 0xFC00) != 0xD800) return nullptr;
+                if (p[0] != '\\' || p[1] != 'u' || !hex4(p + 2, &lo)) return nullptr;
+                return (lo & 0xFC00) == 0xDC00 ? p + 6 : nullptr;
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    // Past the string whose opening quote is at `p`, or nullptr.
+    char* skip_string(char* p) {
+        p++;
+        for (;;) {
+            p = skip_plain(p);
+            uint8_t c = (uint8_t)*p;
+            if (c == '"') return p + 1;
+            if (c >= 0x80) {
+                size_t n = utf8_seq_len((const uint8_t*)p);
+                if (!n) return nullptr;
+                p += n;
+            } else if (c == '\\') {
+                if (!(p = skip_escape(p))) return nullptr;
+            } else {
+                return nullptr;
+            }
+        }
+    }
+
+    // Past `"key":` at `p` and the whitespace after it, or nullptr.
+    char* skip_key(char* p) {
+        if (*p != '"' || !(p = skip_string(p))) return nullptr;
+        p = skip_ws(p);
+        return *p == ':' ? skip_ws(p + 1) : nullptr;
+    }
+
+    char* skip_literal(char* p) {
+        if (memcmp(p, "true", 4) == 0 || memcmp(p, "null", 4) == 0) return p + 4;
+        if (memcmp(p, "false", 5) == 0) return p + 5;
+        return nullptr;
+    }
+
+    // Plain integers short enough to be exact are checked here; everything
+    // else goes through yyjson_read_number so its rules decide.
+    char* skip_number(char* p) {
+        char* digits = p + (*p == '-');
+        char* end = digits;
+        while ((uint8_t)(*end - '0') <= 9) end++;
+        size_t n = (size_t)(end - digits);
+        if (n && n <= 18 && (*digits != '0' || n == 1) && *end != '.' && *end != 'e' && *end != 'E') {
+            return end;
+        }
+        yyjson_val num;
+        return (char*)yyjson_read_number(p, &num, 0, nullptr, nullptr);
+    }
+}
+
+bool JsonCursor::fail() {
+    failed_ = true;
+    first_ = false;
+    cur_ = kStop;
+    return false;
+}
+
+// Strings with no escapes (nearly all of them) are only scanned: the
+// closing quote becomes the terminator. After the first escape the rest is
+// moved down over the consumed escape bytes.
+bool JsonCursor::read_string_slow(const char** str, size_t* len) {
+    char* hdr = ++cur_;
+    char* src = hdr;
+    for (;;) {
+        src = skip_plain(src);
+        uint8_t c = (uint8_t)*src;
+        if (c == '"') {
+            *src = '\0';
+            *str = hdr;
+            *len = (size_t)(src - hdr);
+            cur_ = src + 1;
+            return true;
+        }
+        if (c == '\\') break;
+        if (c < 0x20) return fail();
+        if (c >= 0x80) {
+            size_t n = utf8_seq_len((const uint8_t*)src);
+            if (!n) return fail();
+            src += n;
+        } else {
+            src++;
+        }
+    }
+
+    char* dst = src;
+    for (;;) {
+        uint8_t c = (uint8_t)*src;
+        if (c == '"') {
+            *dst = '\0';
+            *str = hdr;
+            *len = (size_t)(dst - hdr);
+            cur_ = src + 1;
+            return true;
+        }
+        if (c == '\\') {
+            switch (src[1]) {
+                case '"': *dst++ = '"'; break;
+                case '\\': *dst++ = '\\'; break;
+                case '/': *dst++ = '/'; break;
+                case 'b': *dst++ = '\b'; break;
+                case 'f': *dst++ = '\f'; break;
+                case 'n': *dst++ = '\n'; break;
+                case 'r': *dst++ = '\r'; break;
+                case 't': *dst++ = '\t'; break;
+                case 'u': {
+                    uint32_t hi, lo;
+                    if (!hex4(src + 2, &hi)) return fail();
+                    src += 6;
+                    if ((hi & 0xF800) != 0xD800) {
+                        dst = put_utf8(dst, hi);
+                        continue;
+                    }
+                    // A surrogate must be a high one followed by an escaped low one.
+                    if ((hi & 0xFC00) != 0xD800) return fail();
+                    if (src[0] != '\\' || src[1] != 'u' || !hex4(src + 2, &lo)) return fail();
+                    if ((lo & 0xFC00) != 0xDC00) return fail();
+                    dst = put_utf8(dst, (((hi - 0xD800) << 10) | (lo - 0xDC00)) + 0x10000);
+                    src += 6;
+                    continue;
+                }
+                default: return fail();
+            }
+            src += 2;
+        } else if (c < 0x20) {
+            return fail();
+        } else if (c >= 0x80) {
+            size_t n = utf8_seq_len((const uint8_t*)src);
+            if (!n) return fail();
+            memmove(dst, src, n);
+            dst += n;
+            src += n;
+        } else {
+            *dst++ = *src++;
+        }
+    }
+}
+
+bool JsonCursor::read_literal(yyjson_val* out) {
+    out->uni.u64 = 0;
+    if (memcmp(cur_, "true", 4) == 0) {
+        out->tag = YYJSON_TYPE_BOOL | YYJSON_SUBTYPE_TRUE;
+        cur_ += 4;
+    } else if (memcmp(cur_, "false", 5) == 0) {
+        out->tag = YYJSON_TYPE_BOOL | YYJSON_SUBTYPE_FALSE;
+        cur_ += 5;
+    } else if (memcmp(cur_, "null", 4) == 0) {
+        out->tag = YYJSON_TYPE_NULL;
+        cur_ += 4;
+    } else {
+        return fail();
+    }
+    return true;
+}
+
+// Integers of up to 18 digits, which is nearly every number the API sends,
+// read inline; anything else (fractions, exponents, leading zeros, larger
+// magnitudes) goes to yyjson_read_number.
+bool JsonCursor::read_small_int(yyjson_val* out) {
+    const char* p = cur_;
+    bool neg = *p == '-';
+    p += neg;
+    const char* digits = p;
+    uint64_t v = 0;
+    while ((uint8_t)(*p - '0') <= 9 && p - digits < 18) v = v * 10 + (uint64_t)(*p++ - '0');
+    size_t n = (size_t)(p - digits);
+    if (n == 0 || (*digits == '0' && n > 1)) return false;
+    if ((uint8_t)(*p - '0') <= 9 || *p == '.' || *p == 'e' || *p == 'E') return false;
+    if (neg) {
+        out->tag = YYJSON_TYPE_NUM | YYJSON_SUBTYPE_SINT;
+        out->uni.i64 = -(int64_t)v;
+    } else {
+        out->tag = YYJSON_TYPE_NUM | YYJSON_SUBTYPE_UINT;
+        out->uni.u64 = v;
+    }
+    cur_ = (char*)p;
+    return true;
+}
+
+void JsonCursor::read_value(yyjson_val* out) {
+    skip_space();
+    switch (*cur_) {
+        case '"': {
+            const char* str;
+            size_t len;
+            if (read_string(&str, &len)) {
+                out->tag = ((uint64_t)len << YYJSON_TAG_BIT) | YYJSON_TYPE_STR;
+                out->uni.str = str;
+                return;
+            }
+            break;
+        }
+        case '[':
+        case '{':
+            out->tag = *cur_ == '[' ? YYJSON_TYPE_ARR : YYJSON_TYPE_OBJ;
+            out->uni.ptr = nullptr;
+            skip_value();
+            return;
+        case 't': case 'f': case 'n':
+            if (read_literal(out)) return;
+            break;
+        default: {
+            if (read_small_int(out)) return;
+            const char* end = yyjson_read_number(cur_, out, 0, nullptr, nullptr);
+            if (end) {
+                cur_ = (char*)end;
+                return;
+            }
+            fail();
+            break;
+        }
+    }
+    out->tag = YYJSON_TYPE_NULL;
+}
+
+// Iterative, so nesting depth is bounded by memory rather than the stack,
+// as it is for yyjson.
+void JsonCursor::skip_value_slow() {
+    if (failed_) return;
+    char local[64];
+    char* closers = local;
+    size_t cap = sizeof(local), depth = 0;
+    char* p = cur_;
+    for (;;) {
+        // A value starts at `p`.
+        p = skip_ws(p);
+        switch (*p) {
+            case '"':
+                p = skip_string(p);
+                break;
+            case '[':
+            case '{': {
+                if (depth == cap) {
+                    char* grown = (char*)malloc(cap * 2);
+                    if (!grown) {
+                        p = nullptr;
+                        break;
+                    }
+                    memcpy(grown, closers, depth);
+                    if (closers != local) free(closers);
+                    closers = grown;
+                    cap *= 2;
+                }
+                char close = *p == '[' ? ']' : '}';
+                closers[depth++] = close;
+                p = skip_ws(p + 1);
+                if (*p == close) {
+                    p++;
+                    depth--;
+                    break;
+                }
+                if (close == '}') p = skip_key(p);
+                if (p) continue;
+                break;
+            }
+            case 't': case 'f': case 'n':
+                p = skip_literal(p);
+                break;
+            default:
+                p = skip_number(p);
+                break;
+        }
+        // Close every container that ends after this value.
+        while (p && depth) {
+            p = skip_ws(p);
+            if (*p == ',') {
+                p = skip_ws(p + 1);
+                if (closers[depth - 1] == '}') p = skip_key(p);
+                break;
+            }
+            p = *p == closers[depth - 1] ? p + 1 : nullptr;
+            depth--;
+        }
+        if (!p || !depth) break;
+    }
+    if (closers != local) free(closers);
+    if (p) cur_ = p;
+    else fail();
+}
+
+void JsonCursor::read_members(const char* const* keys, yyjson_val* out, size_t n) {
+    if (!enter_object()) {
+        skip_value();
+        return;
+    }
+    const char* key;
+    size_t len;
+    while (next_key(&key, &len)) {
+        size_t i = 0;
+        while (i < n && !(out[i].tag == YYJSON_TYPE_NONE && strlen(keys[i]) == len && memcmp(keys[i], key, len) == 0)) i++;
+        if (i < n) read_value(&out[i]);
+        else skip_value();
+    }
+}
@@ -0,0 +1,189 @@
+// Forward-only JSON reader for parsers that take a handful of fields out of
+// a large document. Where yyjson_read builds a DOM of every value and the
+// parser then walks it, a JsonCursor hands out one member at a time and
+// skips whatever the caller does not ask for, so the document is read once
+// and nothing is allocated.
+//
+// Input rules are those of yyjson_read with YYJSON_READ_INSITU and
+// YYJSON_READ_STOP_WHEN_DONE: strict RFC 8259, UTF-8 validated, numbers
+// read by yyjson itself, strings unescaped in place and NUL-terminated, and
+// anything after the root value ignored. Skipped values are validated too,
+// so a document the cursor accepts is exactly one yyjson would.
+//
+// Scalars come back as stack yyjson_val, so the get_json_int family and the
+// field tables work on them unchanged. A container read with read_value()
+// is skipped and comes back typed but empty.
+#ifndef NEKKO_JSON_CURSOR_H
+#define NEKKO_JSON_CURSOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "yyjson.h"
+
+namespace json_cursor_detail {
+    // String bytes that need a look: quote, backslash, control character or
+    // the start of a multi-byte sequence.
+    struct SpecialBytes {
+        bool is[256] = {};
+        constexpr SpecialBytes() {
+            for (int c = 0; c < 0x20; c++) is[c] = true;
+            for (int c = 0x80; c < 0x100; c++) is[c] = true;
+            is['"'] = is['\\'] = true;
+        }
+    };
+    inline constexpr SpecialBytes kSpecial;
+
+    // First special byte at or after `p`; the zero padding stops it at the
+    // latest. Unrolled so each position gets its own branch, which predicts
+    // well on short strings of recurring lengths (keys, codes).
+    inline char* skip_plain(char* p) {
+        for (;;) {
+#pragma GCC unroll 16
+            for (int i = 0; i < 16; i++) {
+                if (kSpecial.is[(uint8_t)p[i]]) return p + i;
+            }
+            p += 16;
+        }
+    }
+}
+
+class JsonCursor {
+public:
+    // `data` is writable and followed by YYJSON_PADDING_SIZE zero bytes
+    // (nekko_alloc_buffer, or an arena_padded_copy).
+    JsonCursor(char* data, size_t len) : cur_(data), end_(data + len) {}
+
+    // Set by the first syntax error. Every call after that is a no-op that
+    // reports an empty container, so loops unwind on their own.
+    bool failed() const { return failed_; }
+
+    // Type of the next value; YYJSON_TYPE_NONE where no value can start.
+    yyjson_type peek() {
+        skip_space();
+        switch (*cur_) {
+            case '{': return YYJSON_TYPE_OBJ;
+            case '[': return YYJSON_TYPE_ARR;
+            case '"': return YYJSON_TYPE_STR;
+            case 't': case 'f': return YYJSON_TYPE_BOOL;
+            case 'n': return YYJSON_TYPE_NULL;
+            case '-': case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                return YYJSON_TYPE_NUM;
+            default: return YYJSON_TYPE_NONE;
+        }
+    }
+
+    //     if (cur.enter_array()) while (cur.next_element()) { read one value }
+    // enter_array() consumes nothing unless the next value is an array.
+    bool enter_array() { return enter('['); }
+    bool next_element() { return next(']'); }
+
+    //     if (cur.enter_object()) while (cur.next_key(&k, &n)) { read one value }
+    bool enter_object() { return enter('{'); }
+    bool next_key(const char** key, size_t* len) {
+        if (!next('}')) return false;
+        skip_space();
+        if (*cur_ != '"' || !read_string(key, len)) return fail();
+        skip_space();
+        if (*cur_ != ':') return fail();
+        cur_++;
+        return true;
+    }
+
+    // The next value. Containers are skipped; `out` gets their type only.
+    void read_value(yyjson_val* out);
+
+    // Plain strings, the values skipped most, are passed over inline.
+    void skip_value() {
+        skip_space();
+        if (*cur_ == '"') {
+            char* end = json_cursor_detail::skip_plain(cur_ + 1);
+            if (*end == '"') {
+                cur_ = end + 1;
+                return;
+            }
+        }
+        skip_value_slow();
+    }
+
+    // Reads the first occurrence of each of `keys` in the object at the
+    // cursor into the matching `out` slot (left untouched when absent) and
+    // skips every other member. `out` starts zeroed (YYJSON_TYPE_NONE).
+    void read_members(const char* const* keys, yyjson_val* out, size_t n);
+
+    // For input that arrives in pieces: a position to come back to when
+    // what follows it turned out to be cut off. Rewinding clears failed().
+    // Strings read in between have been unescaped in place, so only
+    // next_element() and skip_value() may run between the two.
+    struct Mark {
+        char* cur;
+        bool first;
+    };
+    Mark mark() const { return {cur_, first_}; }
+    void rewind(const Mark& m) {
+        cur_ = m.cur;
+        first_ = m.first;
+        failed_ = false;
+    }
+
+    // Where the next token starts.
+    const char* token() {
+        skip_space();
+        return cur_;
+    }
+
+private:
+    bool enter(char open) {
+        skip_space();
+        if (*cur_ != open) return false;
+        cur_++;
+        first_ = true;
+        return true;
+    }
+
+    bool next(char close) {
+        skip_space();
+        if (first_) {
+            first_ = false;
+            if (*cur_ != close) return !failed_;
+        } else if (*cur_ == ',') {
+            cur_++;
+            return true;
+        } else if (*cur_ != close) {
+            return fail();
+        }
+        cur_++;
+        return false;
+    }
+
+    void skip_space() {
+        while (*cur_ == ' ' || *cur_ == '\n' || *cur_ == '\r' || *cur_ == '\t') cur_++;
+    }
+
+    // Plain strings (no escapes, no multi-byte characters: every key the
+    // API sends) are finished here; the rest go to read_string_slow.
+    bool read_string(const char** str, size_t* len) {
+        char* end = json_cursor_detail::skip_plain(cur_ + 1);
+        if (*end != '"') return read_string_slow(str, len);
+        *end = '\0';
+        *str = cur_ + 1;
+        *len = (size_t)(end - cur_ - 1);
+        cur_ = end + 1;
+        return true;
+    }
+
+    bool read_string_slow(const char** str, size_t* len);
+    void skip_value_slow();
+    bool read_literal(yyjson_val* out);
+    bool read_small_int(yyjson_val* out);
+    bool fail();
+
+    char* cur_;
+    char* end_;
+    bool first_ = false;    // just entered a container: no comma before the next item
+    bool failed_ = false;
+};
+
+#endif // NEKKO_JSON_CURSOR_H
@@ -0,0 +1,242 @@
+#include "json_doc.h"
+
+#include <cerrno>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "body_decoder.h"
+#include "field_table.h"
+#include "native-lib.h"
+
+namespace {
+    NekkoDoc* failed_doc(const char* error) {
+        NekkoDoc* doc = (NekkoDoc*)calloc(1, sizeof(NekkoDoc));
+        if (doc) doc->error = error;
+        return doc;
+    }
+
+    int value_type(yyjson_val* val) {
+        switch (yyjson_get_type(val)) {
+            case YYJSON_TYPE_NULL: return NEKKO_VALUE_NULL;
+            case YYJSON_TYPE_BOOL: return NEKKO_VALUE_BOOL;
+            case YYJSON_TYPE_NUM: return NEKKO_VALUE_NUMBER;
+            case YYJSON_TYPE_STR: return NEKKO_VALUE_STRING;
+            case YYJSON_TYPE_ARR: return NEKKO_VALUE_ARRAY;
+            case YYJSON_TYPE_OBJ: return NEKKO_VALUE_OBJECT;
+            default: return NEKKO_VALUE_NONE;
+        }
+    }
+
+    // Numbers (reals truncated, as get_json_int64 does), booleans as 0 and
+    // 1, and strings that hold nothing but a number, which is how the API
+    // sends some ids. Anything else does not read.
+    bool read_int64(yyjson_val* val, int64_t* out) {
+        switch (yyjson_get_type(val)) {
+            case YYJSON_TYPE_NUM:
+                *out = get_json_int64(val);
+                return true;
+            case YYJSON_TYPE_BOOL:
+                *out = yyjson_get_bool(val);
+                return true;
+            case YYJSON_TYPE_STR: {
+                const char* str = yyjson_get_str(val);
+                size_t len = yyjson_get_len(val);
+                if (len == 0) return false;
+                char* end;
+                errno = 0;
+                long long n = strtoll(str, &end, 10);
+                if (end != str + len || errno) return false;
+                *out = n;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    bool read_double(yyjson_val* val, double* out) {
+        switch (yyjson_get_type(val)) {
+            case YYJSON_TYPE_NUM:
+                *out = yyjson_get_num(val);
+                return true;
+            case YYJSON_TYPE_BOOL:
+                *out = yyjson_get_bool(val);
+                return true;
+            case YYJSON_TYPE_STR: {
+                const char* str = yyjson_get_str(val);
+                size_t len = yyjson_get_len(val);
+                if (len == 0) return false;
+                char* end;
+                double d = strtod(str, &end);
+                if (end != str + len) return false;
+                *out = d;
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+    // Calls `visit(i, value)` for each of the first `cap` elements of the
+    // array at `arrayPtr`, with `value` the one `fieldPtr` names inside the
+    // element (nullptr when it has none). Returns the array's length, 0 when
+    // `arrayPtr` does not name an array.
+    template <typename Visit>
+    size_t extract(const NekkoDoc* doc, const char* arrayPtr, const char* fieldPtr,
+                   size_t cap, Visit visit) {
+        yyjson_val* arr = nekko_doc_get(doc, arrayPtr);
+        if (!yyjson_is_arr(arr)) return 0;
+        size_t fieldLen = fieldPtr ? strlen(fieldPtr) : 0;
+        // Only a pointer can follow the element; anything else names nothing.
+        bool fieldOk = fieldLen == 0 || fieldPtr[0] == '/';
+
+        size_t idx, max;
+        yyjson_val* elem;
+        yyjson_arr_foreach(arr, idx, max, elem) {
+            if (idx >= cap) break;
+            yyjson_val* val = nullptr;
+            if (fieldLen == 0) val = elem;
+            else if (fieldOk) val = yyjson_ptr_getx(elem, fieldPtr, fieldLen, nullptr);
+            visit(idx, val);
+        }
+        return yyjson_arr_size(arr);
+    }
+}
+
+NekkoDoc* nekko_doc_adopt(char* buf, size_t len) {
+    NekkoDoc* doc = (NekkoDoc*)calloc(1, sizeof(NekkoDoc));
+    if (!doc) {
+        free(buf);
+        return nullptr;
+    }
+    doc->buf = buf;
+    doc->doc = yyjson_read_opts(buf, len, YYJSON_READ_INSITU | YYJSON_READ_STOP_WHEN_DONE, nullptr, nullptr);
+    if (!doc->doc) doc->error = "Failed to parse JSON";
+    return doc;
+}
+
+yyjson_val* nekko_doc_get(const NekkoDoc* doc, const char* ptr) {
+    if (!doc || !doc->doc || !ptr) return nullptr;
+    return yyjson_doc_ptr_getn(doc->doc, ptr, strlen(ptr));
+}
+
+// --- Document API ---
+
+extern "C" {
+
+__attribute__((visibility("default"))) __attribute__((used))
+NekkoDoc* nekko_doc_open(const uint8_t* data, size_t len) {
+    if (!data) return failed_doc("Null JSON string");
+    char* buf = (char*)malloc(len + YYJSON_PADDING_SIZE);
+    if (!buf) return failed_doc("Out of memory");
+    memcpy(buf, data, len);
+    memset(buf + len, 0, YYJSON_PADDING_SIZE);
+    return nekko_doc_adopt(buf, len);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+NekkoDoc* nekko_doc_open_buffer(uint8_t* buf, size_t len) {
+    if (!buf) return failed_doc("Null JSON string");
+    return nekko_doc_adopt((char*)buf, len);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+NekkoDoc* nekko_doc_open_encoded(const uint8_t* body, size_t len, const char* encoding) {
+    size_t decodedLen;
+    const char* error = nullptr;
+    char* decoded = decode_body(body, len, body_encoding_from_name(encoding), &decodedLen, &error);
+    if (!decoded) return failed_doc(error);
+    return nekko_doc_adopt(decoded, decodedLen);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+const char* nekko_doc_error(const NekkoDoc* doc) {
+    return doc ? doc->error : "Out of memory";
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_doc_close(NekkoDoc* doc) {
+    if (!doc) return;
+    yyjson_doc_free(doc->doc);
+    free(doc->buf);
+    free(doc);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+int nekko_doc_type(const NekkoDoc* doc, const char* ptr) {
+    return value_type(nekko_doc_get(doc, ptr));
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+size_t nekko_doc_size(const NekkoDoc* doc, const char* ptr) {
+    yyjson_val* val = nekko_doc_get(doc, ptr);
+    if (yyjson_is_arr(val)) return yyjson_arr_size(val);
+    if (yyjson_is_obj(val)) return yyjson_obj_size(val);
+    return 0;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+bool nekko_doc_int64(const NekkoDoc* doc, const char* ptr, int64_t* out) {
+    int64_t n;
+    if (!read_int64(nekko_doc_get(doc, ptr), &n)) return false;
+    if (out) *out = n;
+    return true;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+bool nekko_doc_double(const NekkoDoc* doc, const char* ptr, double* out) {
+    double d;
+    if (!read_double(nekko_doc_get(doc, ptr), &d)) return false;
+    if (out) *out = d;
+    return true;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+const char* nekko_doc_string(const NekkoDoc* doc, const char* ptr, size_t* len) {
+    yyjson_val* val = nekko_doc_get(doc, ptr);
+    if (!yyjson_is_str(val)) return nullptr;
+    if (len) *len = yyjson_get_len(val);
+    return yyjson_get_str(val);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+uint8_t* nekko_doc_write(const NekkoDoc* doc, const char* ptr, size_t* len) {
+    yyjson_val* val = nekko_doc_get(doc, ptr);
+    if (!val) return nullptr;
+    return (uint8_t*)yyjson_val_write(val, YYJSON_WRITE_NOFLAG, len);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+size_t nekko_doc_extract_int64(const NekkoDoc* doc, const char* arrayPtr, const char* fieldPtr,
+                               int64_t* out, uint8_t* present, size_t cap) {
+    return extract(doc, arrayPtr, fieldPtr, cap, [&](size_t i, yyjson_val* val) {
+        int64_t n = 0;
+        bool ok = read_int64(val, &n);
+        out[i] = ok ? n : 0;
+        if (present) present[i] = ok;
+    });
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+size_t nekko_doc_extract_double(const NekkoDoc* doc, const char* arrayPtr, const char* fieldPtr,
+                                double* out, uint8_t* present, size_t cap) {
+    return extract(doc, arrayPtr, fieldPtr, cap, [&](size_t i, yyjson_val* val) {
+        double d = 0;
+        bool ok = read_double(val, &d);
+        out[i] = ok ? d : 0;
+        if (present) present[i] = ok;
+    });
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+size_t nekko_doc_extract_string(const NekkoDoc* doc, const char* arrayPtr, const char* fieldPtr,
+                                const char** out, uint32_t* lens, size_t cap) {
+    return extract(doc, arrayPtr, fieldPtr, cap, [&](size_t i, yyjson_val* val) {
+        bool ok = yyjson_is_str(val);
+        out[i] = ok ? yyjson_get_str(val) : nullptr;
+        if (lens) lens[i] = ok ? (uint32_t)yyjson_get_len(val) : 0;
+    });
+}
+
+}
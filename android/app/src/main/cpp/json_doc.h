@@ -0,0 +1,28 @@
+// Internal side of NekkoDoc (declared opaque in native-lib.h): a parsed
+// document kept resident so one response can answer many queries.
+#ifndef NEKKO_JSON_DOC_H
+#define NEKKO_JSON_DOC_H
+
+#include <stddef.h>
+
+#include "yyjson.h"
+
+// The DOM is read in place from `buf`, so every string in it points into
+// that buffer and both go together in nekko_doc_close. Nothing in a doc
+// changes after it is opened, so any number of threads may query it at once.
+struct NekkoDoc {
+    yyjson_doc* doc;        // nullptr when the input did not parse
+    char* buf;              // padded input, malloc'd
+    const char* error;      // static message, nullptr on success
+};
+
+// Takes over `buf` (malloc'd, `len` bytes followed by YYJSON_PADDING_SIZE
+// zero bytes) and parses it in place; `buf` is released with the doc, or
+// right away if no doc can be made. nullptr only when out of memory.
+NekkoDoc* nekko_doc_adopt(char* buf, size_t len);
+
+// The value `ptr` (an RFC 6901 JSON Pointer, NUL-terminated; "" is the
+// root) names in `doc`, or nullptr.
+yyjson_val* nekko_doc_get(const NekkoDoc* doc, const char* ptr);
+
+#endif // NEKKO_JSON_DOC_H
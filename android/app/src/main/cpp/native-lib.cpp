@@ -1,65 +1,212 @@
+#ifdef __ANDROID__
 #include <jni.h>
+#endif
 #include <string>
 
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <iterator>
+#include <new>
 #include "yyjson.h"
+#include "arena.h"
+#include "body_decoder.h"
+#include "cancel.h"
+#include "field_table.h"
+#include "json_cursor.h"
+#include "native-lib.h"
+#include "native-schema.h"
+#include "parser_ctx.h"
+#include "string_pool.h"
+#include "utf16.h"
+#include "worker_pool.h"
+
+namespace {
+    // Every result owns one arena holding the result struct itself, its
+    // arrays, strings and error message (see arena.h). The first block is
+    // sized from the input: the output of these parsers is roughly half the
+    // JSON it came from, so most results fit in a single malloc.
+    // `extra` reserves room for anything else the parser knows it will put in
+    // the arena up front (e.g. a padded copy of the input).
+    template <typename T>
+    T* new_result(size_t inputLen, size_t extra = 0) {
+        NekkoArena* arena = nekko_arena_create(sizeof(T) + inputLen / 2 + extra);
+        if (!arena) return nullptr;
+        T* result = (T*)nekko_arena_calloc(arena, 1, sizeof(T));
+        result->arena = arena;
+        return result;
+    }
 
-extern "C" {
-
-    // --- Data Structures ---
-    
-    struct BookingStatusNative {
-        int id;
-        char* name;
+    // How one call parses: whether strings borrow from the input, and the
+    // context (if any) whose allocator backs the DOM.
+    struct ParseOptions {
+        bool borrow;
+        nekko_ctx* ctx;
+        NekkoCancel* cancel = nullptr;     // the ctx's, or a background job's
     };
 
-    struct ExamPeriodNative {
-        int id;
-        char* examPeriodCode;
-        char* name;
-        long long startDate;
-        long long endDate;
-        int numberOfExamDays;
-        struct BookingStatusNative bookingStatus;
-    };
+    // Interning through the context takes precedence over borrowing.
+    ParseOptions ctx_options(nekko_ctx* ctx) {
+        bool borrow = ctx && (ctx->flags & NEKKO_CTX_BORROW_STRINGS) && !(ctx->flags & NEKKO_CTX_INTERN_STRINGS);
+        return {borrow, ctx, nekko_ctx_cancel(ctx)};
+    }
 
-    struct ExamScheduleNative {
-        int id;
-        char* name;
-        int displayOrder;
-        bool voided;
-        int examPeriodsCount;
-        struct ExamPeriodNative* examPeriods; // Array
-    };
+    // Where one call's strings go. Copies are interned, so a value repeated
+    // through the payload is stored once: in the context's pool if it keeps
+    // one, else in `local`, a pool for this result alone. User, token and
+    // registration-action payloads repeat nothing (a JWT is seen once), so
+    // their parsers skip the pool and copy with a plain StringSink.
+    StringSink call_strings(NekkoArena* arena, const ParseOptions& opt, StringPool& local) {
+        if (StringPool* shared = nekko_ctx_strings(opt.ctx)) return {arena, false, shared};
+        return {arena, opt.borrow, opt.borrow ? nullptr : &local};
+    }
 
-    // Result container to easily pass array back
-    struct ExamScheduleResult {
-        int count;
-        struct ExamScheduleNative* schedules; // Array
-        char* errorMessage; // Null if success
-    };
+    // What new_result should reserve for `local` above: its slot table, when
+    // the call's strings go through it, so the table lands in the first block.
+    size_t local_pool_bytes(size_t inputLen, const ParseOptions& opt) {
+        if (opt.borrow || nekko_ctx_strings(opt.ctx)) return 0;
+        return StringPool::table_bytes(inputLen);
+    }
 
-    // --- Notification Structs ---
-    struct NotificationNative {
-        long long triggerTime;
-        char* title;
-        char* body;
-        int id; // Unique ID for notification
-    };
+    // The fields of `entity` the call's context asks for (NEKKO_FIELDS_ALL
+    // without a context), for the parsers that do not go through DecodeEnv.
+    uint64_t call_fields(const ParseOptions& opt, NekkoEntity entity) {
+        const uint64_t* fields = nekko_ctx_fields(opt.ctx);
+        return fields ? fields[entity] : NEKKO_FIELDS_ALL;
+    }
 
-    struct NotificationResult {
-        int count;
-        struct NotificationNative* notifications;
-        char* errorMessage;
+    // Brackets a parse on a context; declare it before the first read_json
+    // so every DOM is freed by the time it closes.
+    class CtxCall {
+    public:
+        explicit CtxCall(nekko_ctx* ctx) : ctx_(ctx) { if (ctx_) nekko_ctx_begin(ctx_); }
+        ~CtxCall() { if (ctx_) nekko_ctx_end(ctx_); }
+        CtxCall(const CtxCall&) = delete;
+        CtxCall& operator=(const CtxCall&) = delete;
+
+    private:
+        nekko_ctx* ctx_;
     };
 
-    // --- Helper Functions ---
-    
-    char* safe_strdup(const char* s) {
-        if (!s) return nullptr;
-        return strdup(s);
+    // Borrowing needs the strings to live in the input, so it parses in
+    // place; the buffer must then be padded (nekko_alloc_buffer).
+    yyjson_doc* read_json(const char* json, size_t len, yyjson_read_flag flags, const ParseOptions& opt) {
+        if (opt.borrow) flags |= YYJSON_READ_INSITU;
+        const yyjson_alc* alc = opt.ctx ? &opt.ctx->alc : NULL;
+        return yyjson_read_opts((char*)json, len, flags, alc, NULL);
+    }
+
+    // Plain malloc behind the yyjson_alc interface, for buffers that come
+    // from the context's region when a call has one.
+    void* malloc_alc_malloc(void*, size_t size) { return malloc(size); }
+    void* malloc_alc_realloc(void*, void* ptr, size_t, size_t size) { return realloc(ptr, size); }
+    void malloc_alc_free(void*, void* ptr) { free(ptr); }
+    const yyjson_alc kMallocAlc = {malloc_alc_malloc, malloc_alc_realloc, malloc_alc_free, nullptr};
+
+    // Writable copy of `json` with the zeroed tail YYJSON_READ_INSITU reads
+    // past the end of the input.
+    char* arena_padded_copy(NekkoArena* arena, const char* json, size_t len) {
+        char* copy = (char*)nekko_arena_alloc(arena, len + YYJSON_PADDING_SIZE);
+        if (!copy) return nullptr;
+        memcpy(copy, json, len);
+        memset(copy + len, 0, YYJSON_PADDING_SIZE);
+        return copy;
+    }
+
+    // `result` as is, or nullptr with its arena released if `opt.cancel`
+    // has fired: a cancelled parse keeps nothing.
+    template <typename T>
+    T* unless_cancelled(T* result, const ParseOptions& opt) {
+        if (!result || !cancel_requested(opt.cancel)) return result;
+        nekko_arena_release(result->arena);
+        return nullptr;
+    }
+
+    // Parses `buf`, a padded malloc buffer, in place with `parse` and hands
+    // it to the result's arena, so the strings borrow from it without the
+    // caller having to keep anything alive.
+    template <typename T>
+    T* parse_owned(char* buf, size_t len, T* (*parse)(const char*, size_t, const ParseOptions&),
+                   NekkoCancel* cancel = nullptr) {
+        T* result = parse(buf, len, ParseOptions{true, nullptr, cancel});
+        if (!result) {
+            free(buf);
+            return nullptr;
+        }
+        if (!nekko_arena_adopt(result->arena, buf)) {
+            nekko_arena_release(result->arena);
+            result = new_result<T>(0);
+            if (!result) return nullptr;
+            result->errorMessage = nekko_arena_strdup(result->arena, "Out of memory");
+            return result;
+        }
+        result->stringsBorrowed = false;
+        return result;
+    }
+
+    // Decodes `body` into a padded buffer and parses that as parse_owned.
+    template <typename T>
+    T* parse_encoded(const uint8_t* body, size_t len, const char* encoding,
+                     T* (*parse)(const char*, size_t, const ParseOptions&), NekkoCancel* cancel = nullptr) {
+        size_t decodedLen = 0;
+        const char* error = nullptr;
+        char* decoded = decode_body(body, len, body_encoding_from_name(encoding), &decodedLen, &error);
+        if (!decoded) {
+            T* result = new_result<T>(0);
+            if (!result) return nullptr;
+            result->errorMessage = nekko_arena_strdup(result->arena, error);
+            return result;
+        }
+
+        return parse_owned<T>(decoded, decodedLen, parse, cancel);
+    }
+
+    // What nekko_submit_parse runs: `buf` parsed as parse_owned, or decoded
+    // from `encoding` as parse_encoded (when there is one). nullptr, with
+    // `buf` freed, for a job cancelled before it started.
+    template <typename T>
+    void* parse_job(uint8_t* buf, size_t len, const char* encoding, NekkoCancel* cancel,
+                    T* (*parse)(const char*, size_t, const ParseOptions&)) {
+        if (cancel_requested(cancel)) {
+            free(buf);
+            return nullptr;
+        }
+        if (!encoding) return parse_owned<T>((char*)buf, len, parse, cancel);
+        T* result = parse_encoded<T>(buf, len, encoding, parse, cancel);
+        free(buf);
+        return result;
     }
 
+    // Parses `data` in place with `parse` and copies the result into one
+    // blob, described by `Desc`; the arena goes as soon as the copy is made.
+    template <typename T, typename Desc>
+    NekkoBlob* parse_flat(uint8_t* data, size_t len, NekkoBlobKind kind,
+                          T* (*parse)(const char*, size_t, const ParseOptions&)) {
+        T* result = parse((const char*)data, len, ParseOptions{true, nullptr});
+        if (!result) return nullptr;
+        NekkoBlob* blob = blob_flatten<T, Desc>(result, (uint8_t)kind);
+        nekko_arena_release(result->arena);
+        return blob;
+    }
+
+    // BlobWalk visitor putting every string of a decoded tree through
+    // `strings`, in the order a Decoder stores them.
+    struct RetakeStrings {
+        const StringSink& strings;
+
+        bool string(char*& s) {
+            s = strings.take(s);
+            return true;
+        }
+
+        template <typename Item>
+        bool array(Item*&, int&) { return true; }
+    };
+}
+
+extern "C" {
+
     // --- Exported Functions ---
 
     __attribute__((visibility("default"))) __attribute__((used))
@@ -67,156 +214,118 @@ extern "C" {
         return YYJSON_VERSION_STRING;
     }
 
+    // --- Input Buffers ---
+    // Buffers for the *_bytes entry points: `len` bytes of payload followed
+    // by YYJSON_PADDING_SIZE zero bytes, so insitu parsers can use them
+    // without a copy. Release with nekko_free_buffer once every result that
+    // borrows from the buffer has been freed.
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    uint8_t* nekko_alloc_buffer(size_t len) {
+        uint8_t* buf = (uint8_t*)malloc(len + YYJSON_PADDING_SIZE);
+        if (buf) memset(buf + len, 0, YYJSON_PADDING_SIZE);
+        return buf;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void nekko_free_buffer(uint8_t* buf) {
+        free(buf);
+    }
+
+    // --- Compressed Bodies ---
+    // A response body as received, with its Content-Encoding header, decoded
+    // natively into a padded buffer (see body_decoder.h).
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    bool nekko_body_encoding_supported(const char* encoding) {
+        return body_encoding_supported(body_encoding_from_name(encoding));
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    uint8_t* nekko_decode_body(const uint8_t* body, size_t len, const char* encoding, size_t* out_len) {
+        size_t decodedLen = 0;
+        const char* error = nullptr;
+        uint8_t* decoded = (uint8_t*)decode_body(body, len, body_encoding_from_name(encoding), &decodedLen, &error);
+        if (out_len) *out_len = decoded ? decodedLen : 0;
+        return decoded;
+    }
+
     __attribute__((visibility("default"))) __attribute__((used))
     void free_exam_schedule_result(struct ExamScheduleResult* result) {
         if (!result) return;
-        if (result->schedules) {
-            for (int i = 0; i < result->count; ++i) {
-                struct ExamScheduleNative* schedule = &result->schedules[i];
-                free(schedule->name);
-                if (schedule->examPeriods) {
-                    for (int j = 0; j < schedule->examPeriodsCount; ++j) {
-                        struct ExamPeriodNative* period = &schedule->examPeriods[j];
-                        free(period->examPeriodCode);
-                        free(period->name);
-                        free(period->bookingStatus.name);
-                    }
-                    free(schedule->examPeriods);
-                }
-            }
-            free(result->schedules);
-        }
-        free(result->errorMessage);
-        free(result);
+        nekko_arena_release(result->arena);
     }
 
     __attribute__((visibility("default"))) __attribute__((used))
     void free_notification_result(struct NotificationResult* result) {
         if (!result) return;
-        if (result->notifications) {
-            for(int i=0; i<result->count; i++) {
-                free(result->notifications[i].title);
-                free(result->notifications[i].body);
-            }
-            free(result->notifications);
-        }
-        free(result->errorMessage);
-        free(result);
+        nekko_arena_release(result->arena);
     }
 
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct ExamScheduleResult* parse_exam_schedules(const char* json_str) {
-        struct ExamScheduleResult* result = (struct ExamScheduleResult*)calloc(1, sizeof(struct ExamScheduleResult));
+    static struct ExamScheduleResult* parse_exam_schedules_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct ExamScheduleResult* result = new_result<struct ExamScheduleResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringPool pool(arena, json_len);
+        StringSink strings = call_strings(arena, opt, pool);
+        CtxCall ctxCall(opt.ctx);
         if (!json_str) {
-            result->errorMessage = strdup("Null JSON string");
+            result->errorMessage = nekko_arena_strdup(arena, "Null JSON string");
             return result;
         }
 
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
         if (!doc) {
-            result->errorMessage = strdup("Failed to parse JSON");
+            result->errorMessage = nekko_arena_strdup(arena, "Failed to parse JSON");
             return result;
         }
 
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!yyjson_is_arr(root)) {
-             result->errorMessage = strdup("Root is not an array");
+             result->errorMessage = nekko_arena_strdup(arena, "Root is not an array");
              yyjson_doc_free(doc);
              return result;
         }
 
-        result->count = (int)yyjson_arr_size(root);
-        result->schedules = (struct ExamScheduleNative*)calloc(result->count, sizeof(struct ExamScheduleNative));
-
-        size_t idx, max;
-        yyjson_val *item;
-        yyjson_arr_foreach(root, idx, max, item) {
-            struct ExamScheduleNative* schedule = &result->schedules[idx];
-            
-            schedule->id = yyjson_get_int(yyjson_obj_get(item, "id"));
-            schedule->name = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "name")));
-            schedule->displayOrder = yyjson_get_int(yyjson_obj_get(item, "displayOrder"));
-            schedule->voided = yyjson_get_bool(yyjson_obj_get(item, "voided"));
-            
-            yyjson_val *periods = yyjson_obj_get(item, "examPeriods");
-            if (yyjson_is_arr(periods)) {
-                schedule->examPeriodsCount = (int)yyjson_arr_size(periods);
-                schedule->examPeriods = (struct ExamPeriodNative*)calloc(schedule->examPeriodsCount, sizeof(struct ExamPeriodNative));
-                
-                size_t p_idx, p_max;
-                yyjson_val *p_item;
-                yyjson_arr_foreach(periods, p_idx, p_max, p_item) {
-                     struct ExamPeriodNative* period = &schedule->examPeriods[p_idx];
-                     period->id = yyjson_get_int(yyjson_obj_get(p_item, "id"));
-                     period->examPeriodCode = safe_strdup(yyjson_get_str(yyjson_obj_get(p_item, "examPeriodCode")));
-                     period->name = safe_strdup(yyjson_get_str(yyjson_obj_get(p_item, "name")));
-                     period->startDate = yyjson_get_int(yyjson_obj_get(p_item, "startDate"));
-                     period->endDate = yyjson_get_int(yyjson_obj_get(p_item, "endDate"));
-                     period->numberOfExamDays = yyjson_get_int(yyjson_obj_get(p_item, "numberOfExamDays"));
-                     
-                     yyjson_val *status = yyjson_obj_get(p_item, "bookingStatus");
-                     if (status) {
-                        period->bookingStatus.id = yyjson_get_int(yyjson_obj_get(status, "id"));
-                        period->bookingStatus.name = safe_strdup(yyjson_get_str(yyjson_obj_get(status, "name")));
-                     }
-                }
-            }
-        }
+        DecodeEnv env(arena, strings, nekko_ctx_fields(opt.ctx), opt.cancel);
+        result->schedules = Decoder<ExamScheduleNative>::decode_array(root, &result->count, env);
 
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
-    
-// --- ExamRoom Structs ---
-    struct ExamRoomNative {
-        int id;
-        char* subjectName;
-        char* examPeriodCode;
-        char* examCode;
-        char* studentCode;
-        long long examDate; // Milliseconds
-        char* examTime;
-        char* roomName;
-        char* roomBuilding;
-        char* examMethod;
-        char* notes;
-        int numberExpectedStudent;
-    };
 
-    struct ExamRoomResult {
-        int count;
-        struct ExamRoomNative* rooms;
-        char* errorMessage;
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamScheduleResult* parse_exam_schedules(const char* json_str) {
+        return parse_exam_schedules_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamScheduleResult* parse_exam_schedules_bytes(const uint8_t* data, size_t len) {
+        return parse_exam_schedules_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamScheduleResult* parse_exam_schedules_borrowed(uint8_t* data, size_t len) {
+        return parse_exam_schedules_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
 
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamScheduleResult* parse_exam_schedules_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_exam_schedules_impl((const char*)data, len, ctx_options(ctx));
+    }
+    
     // --- Exported Helper for Freeing ExamRoomResult ---
     __attribute__((visibility("default"))) __attribute__((used))
     void free_exam_room_result(struct ExamRoomResult* result) {
-         if (!result) return;
-         if (result->rooms) {
-             for (int i = 0; i < result->count; ++i) {
-                 struct ExamRoomNative* room = &result->rooms[i];
-                 free(room->subjectName);
-                 free(room->examPeriodCode);
-                 free(room->examCode);
-                 free(room->studentCode);
-                 free(room->examTime);
-                 free(room->roomName);
-                 free(room->roomBuilding);
-                 free(room->examMethod);
-                 free(room->notes);
-             }
-             free(result->rooms);
-         }
-         free(result->errorMessage);
-         free(result);
+        if (!result) return;
+        nekko_arena_release(result->arena);
     }
     
     // --- Helper for Time Parsing (Thread-Safe Replacement for strtok) ---
     // Tries to extract "HH:mm-HH:mm" or "HH-HH" from roomCode
     // Example: "CSE406_08-11-2025_10-12_325-A2" -> "10-12"
     // Example: "SomeCode_Date_07:00-09:00_Room" -> "07:00-09:00"
-    char* extract_time_from_room_code(const char* roomCode) {
+    char* extract_time_from_room_code(NekkoArena* arena, const char* roomCode) {
         if (!roomCode) return nullptr;
         
         // Manual parsing to avoid strtok (not thread-safe)
@@ -242,12 +351,7 @@ extern "C" {
                    
                    // Heuristic: 1 dash = Time (10-12), 2 dashes = Date (08-11-2025)
                    if (hasDash && firstIsDigit && dashCount == 1) {
-                        char* result = (char*)malloc(len + 1);
-                        if (result) {
-                            memcpy(result, start, len);
-                            result[len] = '\0';
-                            return result;
-                        }
+                        return nekko_arena_strndup(arena, start, len);
                    }
                 }
                 
@@ -271,417 +375,1000 @@ extern "C" {
                }
            }
            if (hasDash && firstIsDigit && dashCount == 1) {
-                char* result = (char*)malloc(len + 1);
-                if (result) {
-                    memcpy(result, start, len);
-                    result[len] = '\0';
-                    return result;
-                }
+                return nekko_arena_strndup(arena, start, len);
            }
         }
         
         return nullptr;
     }
 
-    // --- Helper for Robust Int parsing ---
-    int64_t get_json_int64(yyjson_val* val) {
-        if (!val) return 0;
-        if (yyjson_is_int(val)) return yyjson_get_sint(val);
-        if (yyjson_is_uint(val)) return (int64_t)yyjson_get_uint(val);
-        if (yyjson_is_real(val)) return (int64_t)yyjson_get_real(val);
-        if (yyjson_is_str(val)) {
-            return atoll(yyjson_get_str(val));
-        }
-        return 0;
-    }
-
-    int get_json_int(yyjson_val* val) {
-        if (!val) return 0;
-        if (yyjson_is_int(val)) return yyjson_get_int(val);
-        if (yyjson_is_uint(val)) return (int)yyjson_get_uint(val);
-        if (yyjson_is_real(val)) return (int)yyjson_get_real(val);
-        if (yyjson_is_str(val)) {
-            return atoi(yyjson_get_str(val));
-        }
-        return 0;
-    }
+    // --- Exam room field tables ---
 
-    // --- Parser for ExamRooms ---
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct ExamRoomResult* parse_exam_rooms(const char* json_str) {
-        struct ExamRoomResult* result = (struct ExamRoomResult*)calloc(1, sizeof(struct ExamRoomResult));
-        if (!json_str) {
-            result->errorMessage = strdup("Null JSON string");
-            return result;
-        }
+    enum { kErId, kErSubjectName, kErExamPeriodCode, kErExamCode, kErStudentCode, kErExamRoom, kErSlots };
+    constexpr KeyAlias kExamRoomItemAliases[] = {
+        {"id", kErId, FieldKind::Int},
+        {"subjectName", kErSubjectName, FieldKind::Str},
+        {"examPeriodCode", kErExamPeriodCode, FieldKind::Str},
+        {"examCode", kErExamCode, FieldKind::Str},
+        {"studentCode", kErStudentCode, FieldKind::Str},
+        {"examRoom", kErExamRoom, FieldKind::Any},
+    };
+    constexpr auto kExamRoomItemKeys = make_key_table<kErSlots>(kExamRoomItemAliases);
 
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
-        if (!doc) {
-            result->errorMessage = strdup("Failed to parse JSON");
-            return result;
-        }
+    enum {
+        kRmExamDate, kRmStartHour, kRmRoomCode, kRmRoom, kRmExamMethod, kRmNotes,
+        kRmNumberExpectedStudent, kRmSlots
+    };
+    constexpr KeyAlias kExamRoomAliases[] = {
+        {"examDate", kRmExamDate, FieldKind::Int64},
+        {"startHour", kRmStartHour, FieldKind::Any},
+        {"roomCode", kRmRoomCode, FieldKind::Str},
+        {"room", kRmRoom, FieldKind::Any},
+        {"examMethod", kRmExamMethod, FieldKind::Any},
+        {"notes", kRmNotes, FieldKind::Str},
+        {"numberExpectedStudent", kRmNumberExpectedStudent, FieldKind::Int},
+    };
+    constexpr auto kExamRoomKeys = make_key_table<kRmSlots>(kExamRoomAliases);
 
+    // --- Parser for ExamRooms ---
+    // Fills `result` from a parsed document; shared by the one-shot and the
+    // chunked entry points.
+    // Only the fields set in `fields` (NekkoExamRoomField bits) are filled.
+    static void build_exam_rooms(struct ExamRoomResult* result, yyjson_doc* doc, const StringSink& strings,
+                                 uint64_t fields, NekkoCancel* cancel = nullptr) {
+        NekkoArena* arena = result->arena;
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!yyjson_is_arr(root)) {
-             result->errorMessage = strdup("Root is not an array");
-             yyjson_doc_free(doc);
-             return result;
+             result->errorMessage = nekko_arena_strdup(arena, "Root is not an array");
+             return;
         }
 
         result->count = (int)yyjson_arr_size(root);
-        result->rooms = (struct ExamRoomNative*)calloc(result->count, sizeof(struct ExamRoomNative));
+        result->rooms = arena_array<struct ExamRoomNative>(arena, result->count);
 
+        auto want = [fields](int field) { return (fields >> field & 1) != 0; };
+        // Everything below examRoom
+        constexpr uint64_t kRoomFields =
+            1ull << NEKKO_EXAM_ROOM_FIELD_EXAM_DATE | 1ull << NEKKO_EXAM_ROOM_FIELD_EXAM_TIME |
+            1ull << NEKKO_EXAM_ROOM_FIELD_ROOM_NAME | 1ull << NEKKO_EXAM_ROOM_FIELD_ROOM_BUILDING |
+            1ull << NEKKO_EXAM_ROOM_FIELD_EXAM_METHOD | 1ull << NEKKO_EXAM_ROOM_FIELD_NOTES |
+            1ull << NEKKO_EXAM_ROOM_FIELD_EXPECTED_STUDENTS;
+
+        ShapeHint itemShape, roomShape;
         size_t idx, max;
         yyjson_val *item;
         yyjson_arr_foreach(root, idx, max, item) {
+            if (cancel_requested(cancel)) break;
             struct ExamRoomNative* room = &result->rooms[idx];
+            ObjFields f(kExamRoomItemKeys, item, itemShape);
             
-            room->id = get_json_int(yyjson_obj_get(item, "id"));
-            room->subjectName = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "subjectName")));
-            room->examPeriodCode = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "examPeriodCode")));
-            room->examCode = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "examCode")));
-            room->studentCode = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "studentCode")));
-
-            yyjson_val *examRoomObj = yyjson_obj_get(item, "examRoom");
-            if (examRoomObj) {
+            if (want(NEKKO_EXAM_ROOM_FIELD_ID)) room->id = get_json_int(f[kErId]);
+            if (want(NEKKO_EXAM_ROOM_FIELD_SUBJECT_NAME)) room->subjectName = strings.take(yyjson_get_str(f[kErSubjectName]));
+            if (want(NEKKO_EXAM_ROOM_FIELD_EXAM_PERIOD_CODE)) room->examPeriodCode = strings.take(yyjson_get_str(f[kErExamPeriodCode]));
+            if (want(NEKKO_EXAM_ROOM_FIELD_EXAM_CODE)) room->examCode = strings.take(yyjson_get_str(f[kErExamCode]));
+            if (want(NEKKO_EXAM_ROOM_FIELD_STUDENT_CODE)) room->studentCode = strings.take(yyjson_get_str(f[kErStudentCode]));
+
+            yyjson_val *examRoomObj = f[kErExamRoom];
+            if (examRoomObj && (fields & kRoomFields)) {
+                ObjFields rf(kExamRoomKeys, examRoomObj, roomShape);
+
                 // Exam Date - Use 64-bit int for milliseconds
-                room->examDate = get_json_int64(yyjson_obj_get(examRoomObj, "examDate"));
+                if (want(NEKKO_EXAM_ROOM_FIELD_EXAM_DATE)) room->examDate = get_json_int64(rf[kRmExamDate]);
                 
                 // Exam Time logic
-                yyjson_val *startHour = yyjson_obj_get(examRoomObj, "startHour");
-                if (startHour) {
+                yyjson_val *startHour = rf[kRmStartHour];
+                if (startHour && want(NEKKO_EXAM_ROOM_FIELD_EXAM_TIME)) {
                      const char* startString = yyjson_get_str(yyjson_obj_get(startHour, "startString"));
                      if (startString) {
-                         room->examTime = safe_strdup(startString);
+                         room->examTime = strings.take(startString);
                      }
                 }
                 
                 // Fallback time from roomCode if needed
-                if (!room->examTime) {
-                     const char* roomCode = yyjson_get_str(yyjson_obj_get(examRoomObj, "roomCode"));
+                if (!room->examTime && want(NEKKO_EXAM_ROOM_FIELD_EXAM_TIME)) {
+                     const char* roomCode = yyjson_get_str(rf[kRmRoomCode]);
                      if (roomCode) {
-                         room->examTime = extract_time_from_room_code(roomCode);
+                         room->examTime = extract_time_from_room_code(arena, roomCode);
                      }
                 }
 
                  // Room Name
-                 yyjson_val *roomObj = yyjson_obj_get(examRoomObj, "room");
+                 yyjson_val *roomObj = rf[kRmRoom];
                  if (roomObj) {
-                      room->roomName = safe_strdup(yyjson_get_str(yyjson_obj_get(roomObj, "name")));
+                      if (want(NEKKO_EXAM_ROOM_FIELD_ROOM_NAME)) {
+                          room->roomName = strings.take(yyjson_get_str(yyjson_obj_get(roomObj, "name")));
+                      }
                       
                       yyjson_val *building = yyjson_obj_get(roomObj, "building");
-                      if (building) {
-                          room->roomBuilding = safe_strdup(yyjson_get_str(yyjson_obj_get(building, "name")));
+                      if (building && want(NEKKO_EXAM_ROOM_FIELD_ROOM_BUILDING)) {
+                          room->roomBuilding = strings.take(yyjson_get_str(yyjson_obj_get(building, "name")));
                       }
                  }
 
                  // Method
-                 yyjson_val *examMethod = yyjson_obj_get(examRoomObj, "examMethod");
-                 if (examMethod) {
-                     room->examMethod = safe_strdup(yyjson_get_str(yyjson_obj_get(examMethod, "name")));
+                 yyjson_val *examMethod = rf[kRmExamMethod];
+                 if (examMethod && want(NEKKO_EXAM_ROOM_FIELD_EXAM_METHOD)) {
+                     room->examMethod = strings.take(yyjson_get_str(yyjson_obj_get(examMethod, "name")));
                  }
 
                  // Notes and Student count
-                 room->notes = safe_strdup(yyjson_get_str(yyjson_obj_get(examRoomObj, "notes")));
-                 room->numberExpectedStudent = get_json_int(yyjson_obj_get(examRoomObj, "numberExpectedStudent"));
+                 if (want(NEKKO_EXAM_ROOM_FIELD_NOTES)) room->notes = strings.take(yyjson_get_str(rf[kRmNotes]));
+                 if (want(NEKKO_EXAM_ROOM_FIELD_EXPECTED_STUDENTS)) room->numberExpectedStudent = get_json_int(rf[kRmNumberExpectedStudent]);
             }
         }
+    }
+
+    static struct ExamRoomResult* parse_exam_rooms_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct ExamRoomResult* result = new_result<struct ExamRoomResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        CtxCall ctxCall(opt.ctx);
+        if (!json_str) {
+            result->errorMessage = nekko_arena_strdup(arena, "Null JSON string");
+            return result;
+        }
+
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
+        if (!doc) {
+            result->errorMessage = nekko_arena_strdup(arena, "Failed to parse JSON");
+            return result;
+        }
 
+        StringPool pool(arena, json_len);
+        build_exam_rooms(result, doc, call_strings(arena, opt, pool), call_fields(opt, NEKKO_ENTITY_EXAM_ROOM),
+                         opt.cancel);
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
 
-    // --- Course Structs ---
-    struct CourseNative {
-        int id;
-        char* courseCode;
-        char* courseName;
-        char* classCode;
-        char* className;
-        int dayOfWeek;
-        int startCourseHour;
-        int endCourseHour;
-        char* room;
-        char* building;
-        char* campus;
-        int credits;
-        long long startDate;
-        long long endDate;
-        int fromWeek;
-        int toWeek;
-        char* lecturerName;
-        char* lecturerEmail;
-        char* status;
-        double grade; // nullable in Dart, 0 or -1 if null? Using -1.0 as sentinel or strict?
-        bool hasGrade;
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamRoomResult* parse_exam_rooms(const char* json_str) {
+        return parse_exam_rooms_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
 
-    struct CourseResult {
-        int count;
-        struct CourseNative* courses;
-        char* errorMessage;
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamRoomResult* parse_exam_rooms_bytes(const uint8_t* data, size_t len) {
+        return parse_exam_rooms_impl((const char*)data, len, ParseOptions{});
+    }
 
-    // --- Exported Helper for Freeing CourseResult ---
     __attribute__((visibility("default"))) __attribute__((used))
-    void free_course_result(struct CourseResult* result) {
-         if (!result) return;
-         if (result->courses) {
-             // Strings are borrowed from JSON buffer (Zero-Copy), so do NOT free them.
-             free(result->courses);
-         }
-         free(result->errorMessage);
-         free(result);
+    struct ExamRoomResult* parse_exam_rooms_borrowed(uint8_t* data, size_t len) {
+        return parse_exam_rooms_impl((const char*)data, len, ParseOptions{true, nullptr});
     }
 
-    // --- Parser for Courses ---
     __attribute__((visibility("default"))) __attribute__((used))
-    struct CourseResult* parse_courses(const char* json_str) {
-        struct CourseResult* result = (struct CourseResult*)calloc(1, sizeof(struct CourseResult));
-        if (!json_str) {
-            result->errorMessage = strdup("Null JSON string");
-            return result;
-        }
+    struct ExamRoomResult* parse_exam_rooms_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_exam_rooms_impl((const char*)data, len, ctx_options(ctx));
+    }
 
-        // Use INSITU flag for Zero-Copy: Modifies input string in-place.
-        // We cast away const because we know Dart allocated this buffer for us to use.
-        yyjson_doc *doc = yyjson_read_opts((char*)json_str, strlen(json_str), YYJSON_READ_INSITU | YYJSON_READ_STOP_WHEN_DONE, NULL, NULL);
-        if (!doc) {
-            result->errorMessage = strdup("Failed to parse JSON");
-            return result;
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamRoomResult* parse_exam_rooms_encoded(const uint8_t* body, size_t len, const char* encoding) {
+        return parse_encoded<struct ExamRoomResult>(body, len, encoding, parse_exam_rooms_impl);
+    }
+
+    // --- Exam room batches ---
+
+    // One input of a batch: its DOM and the rows read from it, their
+    // strings still pointing into the DOM.
+    struct ExamRoomPart {
+        yyjson_doc* doc;
+        struct ExamRoomResult* rows;
+    };
+
+    // The batch result row holding each id so far. Open addressing over an
+    // arena; id 0 marks a free slot, so callers keep rows without an id out
+    // of it.
+    struct RowIndex {
+        struct Slot {
+            int id;
+            int row;
+        };
+        Slot* slots;
+        size_t mask;
+
+        RowIndex(NekkoArena* arena, size_t count) {
+            size_t cap = 16;
+            while (cap < count * 2) cap <<= 1;
+            slots = arena_array<Slot>(arena, cap);
+            mask = cap - 1;
         }
 
-        yyjson_val *root = yyjson_doc_get_root(doc);
-        if (!yyjson_is_arr(root)) {
-             result->errorMessage = strdup("Root is not an array");
-             yyjson_doc_free(doc);
-             // Note: In Insitu mode, freeing doc does not touch the input buffer content (strings remain valid)
-             return result;
+        // The row that already has `id`, or -1 once `row` is recorded for
+        // it. Out of memory, every id is new.
+        int find_or_add(int id, int row) {
+            if (!slots) return -1;
+            for (size_t i = (uint32_t)id * 2654435761u & mask;; i = (i + 1) & mask) {
+                if (slots[i].id == id) return slots[i].row;
+                if (slots[i].id == 0) {
+                    slots[i] = {id, row};
+                    return -1;
+                }
+            }
         }
-        
-        // Pass 1: Count total items needed
-        size_t total_count = 0;
-        size_t idx, max;
-        yyjson_val *item;
-        
-        yyjson_arr_foreach(root, idx, max, item) {
-             yyjson_val *courseSubject = yyjson_obj_get(item, "courseSubject");
-             if (courseSubject) {
-                 yyjson_val *timetables = yyjson_obj_get(courseSubject, "timetables");
-                 if (yyjson_is_arr(timetables) && yyjson_arr_size(timetables) > 0) {
-                     total_count += yyjson_arr_size(timetables);
-                 } else {
-                     total_count++; // Fallback single item
-                 }
-             } else {
-                 total_count++; // Fallback single item
-             }
+    };
+
+    constexpr char* ExamRoomNative::* kExamRoomStrings[] = {
+        &ExamRoomNative::subjectName, &ExamRoomNative::examPeriodCode, &ExamRoomNative::examCode,
+        &ExamRoomNative::studentCode, &ExamRoomNative::examTime, &ExamRoomNative::roomName,
+        &ExamRoomNative::roomBuilding, &ExamRoomNative::examMethod, &ExamRoomNative::notes,
+    };
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamRoomResult* parse_exam_rooms_batch(const uint8_t** bufs, const size_t* lens, int n) {
+        size_t total = 0;
+        for (int i = 0; bufs && lens && i < n; i++) total += lens[i];
+        struct ExamRoomResult* result = new_result<struct ExamRoomResult>(total);
+        if (!result) return nullptr;
+        NekkoArena* arena = result->arena;
+        if (n < 0 || n > NEKKO_EXAM_ROOM_BATCH_MAX || (n > 0 && (!bufs || !lens))) {
+            result->errorMessage = nekko_arena_strdup(arena, "Invalid input");
+            return result;
         }
-        
-        // Allocate exact memory
-        result->count = (int)total_count;
-        if (result->count > 0) {
-            result->courses = (struct CourseNative*)calloc(result->count, sizeof(struct CourseNative));
+        if (n == 0) return result;
+
+        ScratchScope scratch;
+        ExamRoomPart* parts = arena_array<ExamRoomPart>(scratch.arena(), (size_t)n);
+        if (!parts) {
+            result->errorMessage = nekko_arena_strdup(arena, "Out of memory");
+            return result;
         }
 
-        // Pass 2: Fill data
-        size_t current_idx = 0;
-        yyjson_arr_foreach(root, idx, max, item) {
-             // Extract shared data from item
-             int id = get_json_int(yyjson_obj_get(item, "id"));
-             
-             // Prioritize subjectName, fallback to courseName
-             // ZERO-COPY: Direct pointer assignment
-             char* subjectName = (char*)yyjson_get_str(yyjson_obj_get(item, "subjectName"));
-             if (!subjectName) subjectName = (char*)yyjson_get_str(yyjson_obj_get(item, "courseName"));
-             
-             char* subjectCode = (char*)yyjson_get_str(yyjson_obj_get(item, "subjectCode"));
-             if (!subjectCode) subjectCode = (char*)yyjson_get_str(yyjson_obj_get(item, "courseCode"));
-             
-             int credits = get_json_int(yyjson_obj_get(item, "numberOfCredit"));
-             if (credits == 0) credits = get_json_int(yyjson_obj_get(item, "credits"));
-             
-             char* status = (char*)yyjson_get_str(yyjson_obj_get(item, "status"));
-             
-             double grade = 0.0;
-             bool hasGrade = false;
-             yyjson_val* gradeVal = yyjson_obj_get(item, "grade");
-             if (gradeVal && !yyjson_is_null(gradeVal)) {
-                 grade = yyjson_get_num(gradeVal);
-                 hasGrade = true;
-             }
+        // Each input on its own thread, into an arena of its own; strings
+        // are only copied below, through the result's pool.
+        WorkerPool::shared().parallel_for((size_t)n, [&](size_t i) {
+            ExamRoomPart& part = parts[i];
+            part.rows = new_result<struct ExamRoomResult>(lens[i] / 4);
+            if (!part.rows) return;
+            if (!bufs[i]) {
+                part.rows->errorMessage = nekko_arena_strdup(part.rows->arena, "Null JSON string");
+                return;
+            }
+            part.doc = yyjson_read((const char*)bufs[i], lens[i], 0);
+            if (!part.doc) {
+                part.rows->errorMessage = nekko_arena_strdup(part.rows->arena, "Failed to parse JSON");
+                return;
+            }
+            build_exam_rooms(part.rows, part.doc, StringSink{part.rows->arena, true}, NEKKO_FIELDS_ALL);
+        });
+
+        size_t rows = 0;
+        const char* error = nullptr;
+        bool parsed = false;
+        for (int i = 0; i < n; i++) {
+            const struct ExamRoomResult* r = parts[i].rows;
+            if (!r) error = error ? error : "Out of memory";
+            else if (r->errorMessage) error = error ? error : r->errorMessage;
+            else {
+                parsed = true;
+                rows += (size_t)r->count;
+            }
+        }
 
-             yyjson_val *courseSubject = yyjson_obj_get(item, "courseSubject");
-             
-             if (!courseSubject) {
-                 // Push 1 item with minimal info
-                 if (current_idx < total_count) {
-                    struct CourseNative* c = &result->courses[current_idx++];
-                    c->id = id;
-                    c->courseCode = subjectCode;
-                    c->courseName = subjectName;
-                    c->credits = credits;
-                    c->status = status;
-                    c->hasGrade = hasGrade;
-                    c->grade = grade;
-                 }
-                 continue;
-             }
-             
-             // Extract courseSubject specific data
-             char* classCode = (char*)yyjson_get_str(yyjson_obj_get(courseSubject, "classCode"));
-             char* className = (char*)yyjson_get_str(yyjson_obj_get(courseSubject, "className"));
-             
-             char* lecturerName = nullptr;
-             char* lecturerEmail = nullptr;
-             yyjson_val *lecturer = yyjson_obj_get(courseSubject, "lecturer");
-             if (lecturer && yyjson_is_obj(lecturer)) {
-                  lecturerName = (char*)yyjson_get_str(yyjson_obj_get(lecturer, "name"));
-                  lecturerEmail = (char*)yyjson_get_str(yyjson_obj_get(lecturer, "email"));
-             }
+        if (!parsed) {
+            result->errorMessage = nekko_arena_strdup(arena, error);
+        } else if (rows > 0) {
+            StringPool pool(arena);
+            StringSink strings{arena, false, &pool};
+            RowIndex index(scratch.arena(), rows);
+            result->rooms = arena_array<struct ExamRoomNative>(arena, rows);
+            for (int i = 0; result->rooms && i < n; i++) {
+                const struct ExamRoomResult* r = parts[i].rows;
+                if (!r || r->errorMessage) continue;
+                for (int k = 0; k < r->count; k++) {
+                    const struct ExamRoomNative& row = r->rooms[k];
+                    // A room listed again keeps its first row, which then
+                    // names this input too.
+                    int seen = row.id != 0 ? index.find_or_add(row.id, result->count) : -1;
+                    if (seen >= 0) {
+                        result->rooms[seen].sources |= 1ull << i;
+                        continue;
+                    }
+                    struct ExamRoomNative* out = &result->rooms[result->count++];
+                    *out = row;
+                    out->source = i;
+                    out->sources = 1ull << i;
+                    for (char* ExamRoomNative::* field : kExamRoomStrings) out->*field = strings.take(row.*field);
+                }
+            }
+        }
 
-             yyjson_val *timetables = yyjson_obj_get(courseSubject, "timetables");
-             if (yyjson_is_arr(timetables) && yyjson_arr_size(timetables) > 0) {
-                  // Iterate timetables (Expansion)
-                  size_t t_idx, t_max;
-                  yyjson_val *timetable;
-                  yyjson_arr_foreach(timetables, t_idx, t_max, timetable) {
-                       if (current_idx >= total_count) break;
-                       struct CourseNative* c = &result->courses[current_idx++];
-                       
-                       // Copy shared info
-                       c->id = id;
-                       c->courseCode = subjectCode;
-                       c->courseName = subjectName;
-                       c->credits = credits;
-                       c->status = status;
-                       c->hasGrade = hasGrade;
-                       c->grade = grade;
-                       
-                       c->classCode = classCode;
-                       c->className = className;
-                       c->lecturerName = lecturerName;
-                       c->lecturerEmail = lecturerEmail;
-                       
-                       // Timetable specific
-                       c->dayOfWeek = get_json_int(yyjson_obj_get(timetable, "weekIndex"));
-                       c->fromWeek = get_json_int(yyjson_obj_get(timetable, "fromWeek"));
-                       c->toWeek = get_json_int(yyjson_obj_get(timetable, "toWeek"));
-                       c->startDate = get_json_int64(yyjson_obj_get(timetable, "startDate"));
-                       c->endDate = get_json_int64(yyjson_obj_get(timetable, "endDate"));
-                       
-                       // Start/End Hour logic
-                       yyjson_val* startHour = yyjson_obj_get(timetable, "startHour");
-                       if (startHour && yyjson_is_obj(startHour)) c->startCourseHour = get_json_int(yyjson_obj_get(startHour, "id"));
-                       else c->startCourseHour = get_json_int(yyjson_obj_get(timetable, "startTime")); // fallback
-                       
-                       yyjson_val* endHour = yyjson_obj_get(timetable, "endHour");
-                       if (endHour && yyjson_is_obj(endHour)) c->endCourseHour = get_json_int(yyjson_obj_get(endHour, "id"));
-                       else c->endCourseHour = get_json_int(yyjson_obj_get(timetable, "endTime")); // fallback
-                       
-                       // Room logic
-                       yyjson_val* roomVal = yyjson_obj_get(timetable, "room");
-                       if (roomVal) {
-                           if (yyjson_is_obj(roomVal)) {
-                               c->room = (char*)yyjson_get_str(yyjson_obj_get(roomVal, "name"));
-                               yyjson_val* b = yyjson_obj_get(roomVal, "building");
-                               if(b && yyjson_is_obj(b)) c->building = (char*)yyjson_get_str(yyjson_obj_get(b, "name"));
-                               else if (b && yyjson_is_str(b)) c->building = (char*)yyjson_get_str(b);
-                           } else if (yyjson_is_str(roomVal)) {
-                               c->room = (char*)yyjson_get_str(roomVal);
-                           }
-                       }
-                       
-                       if (!c->building) {
-                            yyjson_val* b = yyjson_obj_get(timetable, "building");
-                             if (b && yyjson_is_str(b)) c->building = (char*)yyjson_get_str(b);
-                       }
-                       
-                       c->campus = (char*)yyjson_get_str(yyjson_obj_get(timetable, "campus"));
-                  }
-             } else {
-                if (current_idx < total_count) {
-                    struct CourseNative* c = &result->courses[current_idx++];
-                    c->id = id;
-                    c->courseCode = subjectCode;
-                    c->courseName = subjectName;
-                    c->credits = credits;
-                    c->status = status;
-                    c->hasGrade = hasGrade;
-                    c->grade = grade;
-                    c->classCode = classCode;
-                    c->className = className;
-                    c->lecturerName = lecturerName;
-                    c->lecturerEmail = lecturerEmail;
-                    
-                    // Fallback simple fields if they exist at courseSubject level
-                    c->dayOfWeek = get_json_int(yyjson_obj_get(courseSubject, "dayOfWeek"));
-                    
-                    yyjson_val* startHour = yyjson_obj_get(courseSubject, "startCourseHour");
-                    if(startHour && yyjson_is_obj(startHour)) c->startCourseHour = get_json_int(yyjson_obj_get(startHour, "id"));
-                    else if (startHour) c->startCourseHour = get_json_int(startHour);
-
-                    yyjson_val* endHour = yyjson_obj_get(courseSubject, "endCourseHour");
-                    if(endHour && yyjson_is_obj(endHour)) c->endCourseHour = get_json_int(yyjson_obj_get(endHour, "id"));
-                    else if (endHour) c->endCourseHour = get_json_int(endHour);
-                    
-                    yyjson_val* roomVal = yyjson_obj_get(courseSubject, "room");
-                    if(roomVal && yyjson_is_str(roomVal)) c->room = (char*)yyjson_get_str(roomVal);
-                 }
-             }
+        for (int i = 0; i < n; i++) {
+            yyjson_doc_free(parts[i].doc);
+            free_exam_room_result(parts[i].rows);
         }
-        
-        yyjson_doc_free(doc);
         return result;
     }
 
-    // --- Native Notification Generator ---
-    
-    // Helper to format string safely
-    char* format_string(const char* format, ...) {
-        va_list args;
-        va_start(args, format);
-        int len = vsnprintf(nullptr, 0, format, args);
-        va_end(args);
-        if (len < 0) return nullptr;
-        
-        char* buf = (char*)malloc(len + 1);
-        if (!buf) return nullptr;
-        
-        va_start(args, format);
-        vsnprintf(buf, len + 1, format, args);
-        va_end(args);
-        return buf;
+    // --- Exported Helper for Freeing CourseResult ---
+    __attribute__((visibility("default"))) __attribute__((used))
+    void free_course_result(struct CourseResult* result) {
+        if (!result) return;
+        // Strings are borrowed from the JSON buffer (Zero-Copy); only the
+        // course array lives in the arena.
+        nekko_arena_release(result->arena);
     }
 
-    struct TempHour {
-        int id;
-        int h;
-        int m;
-        char* str;
+    // --- Course field tables ---
+
+    enum { kCiId, kCiName, kCiCode, kCiCredits, kCiStatus, kCiGrade, kCiCourseSubject, kCiSlots };
+    constexpr KeyAlias kCourseItemAliases[] = {
+        {"id", kCiId, FieldKind::Int},
+        {"subjectName", kCiName, FieldKind::Str},
+        {"courseName", kCiName, FieldKind::Str},
+        {"subjectCode", kCiCode, FieldKind::Str},
+        {"courseCode", kCiCode, FieldKind::Str},
+        {"numberOfCredit", kCiCredits, FieldKind::Int},
+        {"credits", kCiCredits, FieldKind::Int},
+        {"status", kCiStatus, FieldKind::Str},
+        {"grade", kCiGrade, FieldKind::Any},
+        {"courseSubject", kCiCourseSubject, FieldKind::Any},
     };
+    constexpr auto kCourseItemKeys = make_key_table<kCiSlots>(kCourseItemAliases);
 
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct NotificationResult* generate_notifications(
-        const char* courses_json,
-        const char* hours_json,
-        long long semester_start_millis
-    ) {
-        struct NotificationResult* result = (struct NotificationResult*)calloc(1, sizeof(struct NotificationResult));
-        
-        if (!courses_json || !hours_json) {
-             result->errorMessage = strdup("Invalid input JSONs");
-             return result;
-        }
+    enum {
+        kCsiClassCode, kCsiClassName, kCsiLecturer, kCsiTimetables, kCsiDayOfWeek,
+        kCsiStartCourseHour, kCsiEndCourseHour, kCsiRoom, kCsiSlots
+    };
+    constexpr KeyAlias kCourseSubjectInfoAliases[] = {
+        {"classCode", kCsiClassCode, FieldKind::Str},
+        {"className", kCsiClassName, FieldKind::Str},
+        {"lecturer", kCsiLecturer, FieldKind::Any},
+        {"timetables", kCsiTimetables, FieldKind::Any},
+        {"dayOfWeek", kCsiDayOfWeek, FieldKind::Int},
+        {"startCourseHour", kCsiStartCourseHour, FieldKind::Any},
+        {"endCourseHour", kCsiEndCourseHour, FieldKind::Any},
+        {"room", kCsiRoom, FieldKind::Any},
+    };
+    constexpr auto kCourseSubjectInfoKeys = make_key_table<kCsiSlots>(kCourseSubjectInfoAliases);
 
-        yyjson_doc *docCourses = yyjson_read_opts((char*)courses_json, strlen(courses_json), YYJSON_READ_INSITU | YYJSON_READ_STOP_WHEN_DONE, NULL, NULL);
-        yyjson_doc *docHours = yyjson_read(hours_json, strlen(hours_json), 0);
-        
-        if (!docCourses || !docHours) {
-            result->errorMessage = strdup("Failed to parse JSONs");
-            if (docCourses) yyjson_doc_free(docCourses);
-            if (docHours) yyjson_doc_free(docHours);
-            return result;
+    enum {
+        kCtWeekIndex, kCtFromWeek, kCtToWeek, kCtStartDate, kCtEndDate, kCtStartHour, kCtStartTime,
+        kCtEndHour, kCtEndTime, kCtRoom, kCtBuilding, kCtCampus, kCtSlots
+    };
+    constexpr KeyAlias kCourseTimetableAliases[] = {
+        {"weekIndex", kCtWeekIndex, FieldKind::Int},
+        {"fromWeek", kCtFromWeek, FieldKind::Int},
+        {"toWeek", kCtToWeek, FieldKind::Int},
+        {"startDate", kCtStartDate, FieldKind::Int64},
+        {"endDate", kCtEndDate, FieldKind::Int64},
+        {"startHour", kCtStartHour, FieldKind::Any},
+        {"startTime", kCtStartTime, FieldKind::Any},
+        {"endHour", kCtEndHour, FieldKind::Any},
+        {"endTime", kCtEndTime, FieldKind::Any},
+        {"room", kCtRoom, FieldKind::Any},
+        {"building", kCtBuilding, FieldKind::Any},
+        {"campus", kCtCampus, FieldKind::Str},
+    };
+    constexpr auto kCourseTimetableKeys = make_key_table<kCtSlots>(kCourseTimetableAliases);
+
+    // --- Parser for Courses ---
+    // The largest payload, so it is read without a DOM: one JsonCursor pass
+    // that skips what no field needs and appends a CourseNative per
+    // timetable as it goes. Members can come in any order, so the fields a
+    // course item or course subject shares with its rows are filled in once
+    // the object closes. Field choice matches the table-driven readers: the
+    // first spelling with a value, the first occurrence of a repeated key.
+    //
+    // Rows collect in a buffer from `alc` (the context's region, when there
+    // is one) and are copied into the result once the count is known.
+    class CourseRows {
+    public:
+        // `expected` sizes the first block, so a typical document needs one.
+        CourseRows(const yyjson_alc* alc, size_t expected) : alc_(alc), expected_(expected ? expected : 1) {}
+        ~CourseRows() { if (rows_) alc_->free(alc_->ctx, rows_); }
+        CourseRows(const CourseRows&) = delete;
+        CourseRows& operator=(const CourseRows&) = delete;
+
+        // A zeroed row; nullptr when out of memory.
+        struct CourseNative* push() {
+            if (count_ == cap_) {
+                size_t cap = cap_ ? cap_ * 2 : expected_;
+                void* grown = rows_ ? alc_->realloc(alc_->ctx, rows_, cap_ * sizeof(CourseNative), cap * sizeof(CourseNative))
+                                    : alc_->malloc(alc_->ctx, cap * sizeof(CourseNative));
+                if (!grown) {
+                    oom_ = true;
+                    return nullptr;
+                }
+                rows_ = (struct CourseNative*)grown;
+                cap_ = cap;
+            }
+            struct CourseNative* c = &rows_[count_++];
+            memset(c, 0, sizeof(*c));
+            return c;
+        }
+
+        // Drops every row, keeping the buffer.
+        void clear() { count_ = 0; }
+
+        struct CourseNative& operator[](size_t i) { return rows_[i]; }
+        size_t size() const { return count_; }
+        bool oom() const { return oom_; }
+        const struct CourseNative* data() const { return rows_; }
+
+    private:
+        const yyjson_alc* alc_;
+        size_t expected_;
+        struct CourseNative* rows_ = nullptr;
+        size_t count_ = 0, cap_ = 0;
+        bool oom_ = false;
+    };
+
+    // JSON bytes per timetable row, for sizing the row buffer up front. API
+    // documents run about 400 (ids, dates, hours, a room); rounding down
+    // makes the estimate err high.
+    constexpr size_t kCourseRowBytes = 256;
+
+    struct CourseScan {
+        JsonCursor json;
+        CourseRows rows;
+        ShapeHint itemShape, subjectShape, timetableShape;
+        // NekkoCourseField bits to fill, and the slots of each table they
+        // are read from (project_course_scan); other members are skipped.
+        uint64_t fields = NEKKO_FIELDS_ALL;
+        uint32_t itemSlots = ~0u, subjectSlots = ~0u, timetableSlots = ~0u;
+        NekkoCancel* cancel = nullptr;      // checked before each item
+
+        bool wants(int field) const { return (fields >> field & 1) != 0; }
+    };
+
+    // Where each course field comes from. A field can come from several
+    // members (fallbacks, the level without timetables), and a member can
+    // feed several fields (a room object holds the building too).
+    enum CourseLevel : uint8_t { kLevelItem, kLevelSubject, kLevelTimetable };
+    struct CourseFieldSource {
+        uint8_t field;      // NekkoCourseField
+        CourseLevel level;
+        uint8_t slot;
+    };
+    constexpr CourseFieldSource kCourseFieldSources[] = {
+        {NEKKO_COURSE_FIELD_ID, kLevelItem, kCiId},
+        {NEKKO_COURSE_FIELD_CODE, kLevelItem, kCiCode},
+        {NEKKO_COURSE_FIELD_NAME, kLevelItem, kCiName},
+        {NEKKO_COURSE_FIELD_CREDITS, kLevelItem, kCiCredits},
+        {NEKKO_COURSE_FIELD_STATUS, kLevelItem, kCiStatus},
+        {NEKKO_COURSE_FIELD_GRADE, kLevelItem, kCiGrade},
+        {NEKKO_COURSE_FIELD_CLASS_CODE, kLevelSubject, kCsiClassCode},
+        {NEKKO_COURSE_FIELD_CLASS_NAME, kLevelSubject, kCsiClassName},
+        {NEKKO_COURSE_FIELD_LECTURER_NAME, kLevelSubject, kCsiLecturer},
+        {NEKKO_COURSE_FIELD_LECTURER_EMAIL, kLevelSubject, kCsiLecturer},
+        {NEKKO_COURSE_FIELD_DAY_OF_WEEK, kLevelSubject, kCsiDayOfWeek},
+        {NEKKO_COURSE_FIELD_START_HOUR, kLevelSubject, kCsiStartCourseHour},
+        {NEKKO_COURSE_FIELD_END_HOUR, kLevelSubject, kCsiEndCourseHour},
+        {NEKKO_COURSE_FIELD_ROOM, kLevelSubject, kCsiRoom},
+        {NEKKO_COURSE_FIELD_DAY_OF_WEEK, kLevelTimetable, kCtWeekIndex},
+        {NEKKO_COURSE_FIELD_FROM_WEEK, kLevelTimetable, kCtFromWeek},
+        {NEKKO_COURSE_FIELD_TO_WEEK, kLevelTimetable, kCtToWeek},
+        {NEKKO_COURSE_FIELD_START_DATE, kLevelTimetable, kCtStartDate},
+        {NEKKO_COURSE_FIELD_END_DATE, kLevelTimetable, kCtEndDate},
+        {NEKKO_COURSE_FIELD_START_HOUR, kLevelTimetable, kCtStartHour},
+        {NEKKO_COURSE_FIELD_START_HOUR, kLevelTimetable, kCtStartTime},
+        {NEKKO_COURSE_FIELD_END_HOUR, kLevelTimetable, kCtEndHour},
+        {NEKKO_COURSE_FIELD_END_HOUR, kLevelTimetable, kCtEndTime},
+        {NEKKO_COURSE_FIELD_ROOM, kLevelTimetable, kCtRoom},
+        {NEKKO_COURSE_FIELD_BUILDING, kLevelTimetable, kCtRoom},
+        {NEKKO_COURSE_FIELD_BUILDING, kLevelTimetable, kCtBuilding},
+        {NEKKO_COURSE_FIELD_CAMPUS, kLevelTimetable, kCtCampus},
+    };
+
+    // Limits `scan` to `fields`. The courseSubject and its timetables are
+    // always entered: they decide how many rows there are.
+    static void project_course_scan(CourseScan& scan, uint64_t fields) {
+        scan.fields = fields;
+        scan.itemSlots = 1u << kCiCourseSubject;
+        scan.subjectSlots = 1u << kCsiTimetables;
+        scan.timetableSlots = 0;
+        for (const CourseFieldSource& src : kCourseFieldSources) {
+            if (!scan.wants(src.field)) continue;
+            uint32_t bit = 1u << src.slot;
+            if (src.level == kLevelItem) scan.itemSlots |= bit;
+            else if (src.level == kLevelSubject) scan.subjectSlots |= bit;
+            else scan.timetableSlots |= bit;
+        }
+    }
+
+    static const char* const kIdKey[] = {"id"};
+    static const char* const kNameKey[] = {"name"};
+    static const char* const kLecturerKeys[] = {"name", "email"};
+
+    // Object-valued `room` of a timetable: its name, and a building given
+    // either as a string or as an object with a name.
+    static void scan_course_room(const CourseScan& scan, JsonCursor& json, struct CourseNative* c) {
+        yyjson_val name = {}, building = {}, buildingName = {};
+        json.enter_object();
+        const char* key;
+        size_t len;
+        while (json.next_key(&key, &len)) {
+            if (len == 4 && memcmp(key, "name", 4) == 0 && name.tag == YYJSON_TYPE_NONE) {
+                json.read_value(&name);
+            } else if (len == 8 && memcmp(key, "building", 8) == 0 && building.tag == YYJSON_TYPE_NONE) {
+                if (json.peek() == YYJSON_TYPE_OBJ) {
+                    json.read_members(kNameKey, &buildingName, 1);
+                    building.tag = YYJSON_TYPE_OBJ;
+                } else {
+                    json.read_value(&building);
+                }
+            } else {
+                json.skip_value();
+            }
+        }
+        if (scan.wants(NEKKO_COURSE_FIELD_ROOM)) c->room = (char*)yyjson_get_str(&name);
+        if (!scan.wants(NEKKO_COURSE_FIELD_BUILDING)) return;
+        if (yyjson_is_obj(&building)) c->building = (char*)yyjson_get_str(&buildingName);
+        else if (yyjson_is_str(&building)) c->building = (char*)yyjson_get_str(&building);
+    }
+
+    static void scan_course_timetable(CourseScan& scan, struct CourseNative* c) {
+        JsonCursor& json = scan.json;
+        if (!json.enter_object()) {
+            json.skip_value();
+            return;
+        }
+        FieldSlots f(kCourseTimetableKeys);
+        yyjson_val vals[std::size(kCourseTimetableAliases)];
+        yyjson_val startHourId = {}, endHourId = {};
+        const char* key;
+        size_t len, idx = 0;
+        while (json.next_key(&key, &len)) {
+            int a = scan.timetableShape.find(kCourseTimetableKeys, idx++, key, len);
+            if (a < 0 || !(scan.timetableSlots >> kCourseTimetableKeys.slots[a] & 1) || !f.wants(a)) {
+                json.skip_value();
+                continue;
+            }
+            uint8_t slot = kCourseTimetableKeys.slots[a];
+            bool obj = json.peek() == YYJSON_TYPE_OBJ;
+            if (obj && slot == kCtStartHour) json.read_members(kIdKey, &startHourId, 1);
+            else if (obj && slot == kCtEndHour) json.read_members(kIdKey, &endHourId, 1);
+            else if (obj && slot == kCtRoom) scan_course_room(scan, json, c);
+            else json.read_value(&vals[a]);
+            if (obj) vals[a].tag = YYJSON_TYPE_OBJ;
+            f.take(a, &vals[a]);
+        }
+        scan.timetableShape.finish(idx);
+
+        c->dayOfWeek = get_json_int(f[kCtWeekIndex]);
+        c->fromWeek = get_json_int(f[kCtFromWeek]);
+        c->toWeek = get_json_int(f[kCtToWeek]);
+        c->startDate = get_json_int64(f[kCtStartDate]);
+        c->endDate = get_json_int64(f[kCtEndDate]);
+
+        // Start/End Hour logic
+        if (yyjson_is_obj(f[kCtStartHour])) c->startCourseHour = get_json_int(&startHourId);
+        else c->startCourseHour = get_json_int(f[kCtStartTime]); // fallback
+        if (yyjson_is_obj(f[kCtEndHour])) c->endCourseHour = get_json_int(&endHourId);
+        else c->endCourseHour = get_json_int(f[kCtEndTime]); // fallback
+
+        // Room logic: an object was read by scan_course_room
+        yyjson_val* roomVal = f[kCtRoom];
+        if (yyjson_is_str(roomVal) && scan.wants(NEKKO_COURSE_FIELD_ROOM)) c->room = (char*)yyjson_get_str(roomVal);
+        if (!c->building) {
+            yyjson_val* b = f[kCtBuilding];
+            if (yyjson_is_str(b)) c->building = (char*)yyjson_get_str(b);
+        }
+        c->campus = (char*)yyjson_get_str(f[kCtCampus]);
+    }
+
+    static void scan_course_subject(CourseScan& scan) {
+        JsonCursor& json = scan.json;
+        size_t first = scan.rows.size();
+        FieldSlots f(kCourseSubjectInfoKeys);
+        yyjson_val vals[std::size(kCourseSubjectInfoAliases)];
+        yyjson_val lecturer[2] = {}, startHourId = {}, endHourId = {};
+        json.enter_object();
+        const char* key;
+        size_t len, idx = 0;
+        while (json.next_key(&key, &len)) {
+            int a = scan.subjectShape.find(kCourseSubjectInfoKeys, idx++, key, len);
+            if (a < 0 || !(scan.subjectSlots >> kCourseSubjectInfoKeys.slots[a] & 1) || !f.wants(a)) {
+                json.skip_value();
+                continue;
+            }
+            uint8_t slot = kCourseSubjectInfoKeys.slots[a];
+            yyjson_type type = json.peek();
+            if (type == YYJSON_TYPE_ARR && slot == kCsiTimetables) {
+                json.enter_array();
+                while (json.next_element()) {
+                    struct CourseNative* c = scan.rows.push();
+                    if (!c) return;
+                    scan_course_timetable(scan, c);
+                }
+                vals[a].tag = YYJSON_TYPE_ARR;
+            } else if (type == YYJSON_TYPE_OBJ && slot == kCsiLecturer) {
+                json.read_members(kLecturerKeys, lecturer, 2);
+                vals[a].tag = YYJSON_TYPE_OBJ;
+            } else if (type == YYJSON_TYPE_OBJ && slot == kCsiStartCourseHour) {
+                json.read_members(kIdKey, &startHourId, 1);
+                vals[a].tag = YYJSON_TYPE_OBJ;
+            } else if (type == YYJSON_TYPE_OBJ && slot == kCsiEndCourseHour) {
+                json.read_members(kIdKey, &endHourId, 1);
+                vals[a].tag = YYJSON_TYPE_OBJ;
+            } else {
+                json.read_value(&vals[a]);
+            }
+            f.take(a, &vals[a]);
+        }
+        scan.subjectShape.finish(idx);
+
+        if (scan.rows.size() == first) {
+            // No timetables: one row from the fields at courseSubject level
+            struct CourseNative* c = scan.rows.push();
+            if (!c) return;
+            c->dayOfWeek = get_json_int(f[kCsiDayOfWeek]);
+
+            yyjson_val* startHour = f[kCsiStartCourseHour];
+            if (yyjson_is_obj(startHour)) c->startCourseHour = get_json_int(&startHourId);
+            else if (startHour) c->startCourseHour = get_json_int(startHour);
+
+            yyjson_val* endHour = f[kCsiEndCourseHour];
+            if (yyjson_is_obj(endHour)) c->endCourseHour = get_json_int(&endHourId);
+            else if (endHour) c->endCourseHour = get_json_int(endHour);
+
+            yyjson_val* roomVal = f[kCsiRoom];
+            if (yyjson_is_str(roomVal)) c->room = (char*)yyjson_get_str(roomVal);
+        }
+
+        char* classCode = (char*)yyjson_get_str(f[kCsiClassCode]);
+        char* className = (char*)yyjson_get_str(f[kCsiClassName]);
+        char* lecturerName = scan.wants(NEKKO_COURSE_FIELD_LECTURER_NAME) ? (char*)yyjson_get_str(&lecturer[0]) : nullptr;
+        char* lecturerEmail = scan.wants(NEKKO_COURSE_FIELD_LECTURER_EMAIL) ? (char*)yyjson_get_str(&lecturer[1]) : nullptr;
+        for (size_t i = first; i < scan.rows.size(); i++) {
+            struct CourseNative& c = scan.rows[i];
+            c.classCode = classCode;
+            c.className = className;
+            c.lecturerName = lecturerName;
+            c.lecturerEmail = lecturerEmail;
+        }
+    }
+
+    // One course item: a row per timetable of its courseSubject, or a
+    // single row when it has none (or is not an object at all).
+    static void scan_course_item(CourseScan& scan) {
+        JsonCursor& json = scan.json;
+        size_t first = scan.rows.size();
+        FieldSlots f(kCourseItemKeys);
+        yyjson_val vals[std::size(kCourseItemAliases)];
+        if (json.enter_object()) {
+            const char* key;
+            size_t len, idx = 0;
+            while (json.next_key(&key, &len)) {
+                int a = scan.itemShape.find(kCourseItemKeys, idx++, key, len);
+                if (a < 0 || !(scan.itemSlots >> kCourseItemKeys.slots[a] & 1) || !f.wants(a)) {
+                    json.skip_value();
+                    continue;
+                }
+                if (kCourseItemKeys.slots[a] == kCiCourseSubject && json.peek() == YYJSON_TYPE_OBJ) {
+                    scan_course_subject(scan);
+                    vals[a].tag = YYJSON_TYPE_OBJ;
+                } else {
+                    json.read_value(&vals[a]);
+                }
+                f.take(a, &vals[a]);
+            }
+            scan.itemShape.finish(idx);
+        } else {
+            json.skip_value();
+        }
+        if (scan.rows.size() == first && !scan.rows.push()) return;
+
+        int id = get_json_int(f[kCiId]);
+        // ZERO-COPY: strings point into the in-situ buffer
+        char* subjectName = (char*)yyjson_get_str(f[kCiName]);
+        char* subjectCode = (char*)yyjson_get_str(f[kCiCode]);
+        int credits = get_json_int(f[kCiCredits]);
+        char* status = (char*)yyjson_get_str(f[kCiStatus]);
+
+        double grade = 0.0;
+        bool hasGrade = false;
+        yyjson_val* gradeVal = f[kCiGrade];
+        if (gradeVal && !yyjson_is_null(gradeVal)) {
+            grade = yyjson_get_num(gradeVal);
+            hasGrade = true;
+        }
+
+        for (size_t i = first; i < scan.rows.size(); i++) {
+            struct CourseNative& c = scan.rows[i];
+            c.id = id;
+            c.courseCode = subjectCode;
+            c.courseName = subjectName;
+            c.credits = credits;
+            c.status = status;
+            c.hasGrade = hasGrade;
+            c.grade = grade;
+        }
+    }
+
+    // Steps into the root array; otherwise says why it is not one.
+    static const char* enter_course_array(CourseScan& scan) {
+        JsonCursor& json = scan.json;
+        if (json.enter_array()) return nullptr;
+        json.skip_value();
+        return json.failed() ? "Failed to parse JSON" : "Root is not an array";
+    }
+
+    // Every item from the cursor to the end of the root array.
+    static void scan_course_items(CourseScan& scan) {
+        while (scan.json.next_element() && !scan.rows.oom() && !cancel_requested(scan.cancel)) {
+            scan_course_item(scan);
+        }
+    }
+
+    static const char* course_scan_error(const CourseScan& scan) {
+        if (scan.json.failed()) return "Failed to parse JSON";
+        return scan.rows.oom() ? "Out of memory" : nullptr;
+    }
+
+    static void finish_course_scan(struct CourseResult* result, CourseScan& scan) {
+        NekkoArena* arena = result->arena;
+        if (const char* error = course_scan_error(scan)) {
+            result->errorMessage = nekko_arena_strdup(arena, error);
+            return;
+        }
+
+        result->count = (int)scan.rows.size();
+        if (result->count > 0) {
+            result->courses = arena_array<struct CourseNative>(arena, result->count);
+            memcpy(result->courses, scan.rows.data(), scan.rows.size() * sizeof(struct CourseNative));
+        }
+    }
+
+    // `opt.borrow` means json_str has YYJSON_PADDING_SIZE writable bytes
+    // after json_len (nekko_alloc_buffer). Otherwise the input is copied into
+    // the result's arena first, and the strings borrow from that copy.
+    static struct CourseResult* parse_courses_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct CourseResult* result = new_result<struct CourseResult>(json_len, opt.borrow ? 0 : json_len + YYJSON_PADDING_SIZE);
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        if (!json_str) {
+            result->errorMessage = nekko_arena_strdup(arena, "Null JSON string");
+            return result;
+        }
+
+        CtxCall ctxCall(opt.ctx);
+        char* insitu = opt.borrow ? (char*)json_str : arena_padded_copy(arena, json_str, json_len);
+        CourseScan scan = {JsonCursor(insitu, json_len), CourseRows(opt.ctx ? &opt.ctx->alc : &kMallocAlc, json_len / kCourseRowBytes + 1), {}, {}, {}};
+        project_course_scan(scan, call_fields(opt, NEKKO_ENTITY_COURSE));
+        scan.cancel = opt.cancel;
+        if (const char* error = enter_course_array(scan)) {
+            result->errorMessage = nekko_arena_strdup(arena, error);
+        } else {
+            scan_course_items(scan);
+            finish_course_scan(result, scan);
+        }
+        return unless_cancelled(result, opt);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseResult* parse_courses(const char* json_str) {
+        return parse_courses_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseResult* parse_courses_bytes(const uint8_t* data, size_t len) {
+        return parse_courses_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    // Without NEKKO_CTX_BORROW_STRINGS the input is copied like parse_courses,
+    // so `data` needs no padding.
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseResult* parse_courses_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_courses_impl((const char*)data, len, ctx_options(ctx));
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseResult* parse_courses_encoded(const uint8_t* body, size_t len, const char* encoding) {
+        return parse_encoded<struct CourseResult>(body, len, encoding, parse_courses_impl);
+    }
+
+    // --- Columnar Courses ---
+    // The course scan, laid out one array per field (CourseColumnsResult).
+    // Strings are copied into one blob, as UTF-8 or transcoded to UTF-16;
+    // rows of a course point at the same strings, so a string repeated from
+    // the row before is stored once.
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void free_course_columns_result(struct CourseColumnsResult* result) {
+        if (!result) return;
+        nekko_arena_release(result->arena);
+    }
+
+    static int32_t* course_int_column(NekkoArena* arena, CourseRows& rows, int CourseNative::*field) {
+        int32_t* col = arena_array<int32_t>(arena, rows.size());
+        if (col) for (size_t i = 0; i < rows.size(); i++) col[i] = rows[i].*field;
+        return col;
+    }
+
+    static int64_t* course_date_column(NekkoArena* arena, CourseRows& rows, long long CourseNative::*field) {
+        int64_t* col = arena_array<int64_t>(arena, rows.size());
+        if (col) for (size_t i = 0; i < rows.size(); i++) col[i] = rows[i].*field;
+        return col;
+    }
+
+    // In NEKKO_COURSE_* order.
+    static char* CourseNative::* const kCourseStringFields[NEKKO_COURSE_STRING_COLUMNS] = {
+        &CourseNative::courseCode, &CourseNative::courseName, &CourseNative::classCode,
+        &CourseNative::className, &CourseNative::room, &CourseNative::building,
+        &CourseNative::campus, &CourseNative::lecturerName, &CourseNative::lecturerEmail,
+        &CourseNative::status,
+    };
+
+    // Transcodes the strings the UTF-8 pass below laid out, in the same
+    // order, rewriting offsets and lengths in code units. The UTF-8 size
+    // bounds the UTF-16 one, so one allocation of it is enough.
+    static bool course_string_columns16(struct CourseColumnsResult* result, CourseRows& rows, size_t size) {
+        size_t count = rows.size();
+        result->strings16 = (uint16_t*)nekko_arena_calloc(result->arena, utf16_max_units(size), sizeof(uint16_t));
+        if (!result->strings16) return false;
+        size_t units = 0;
+        for (int k = 0; k < NEKKO_COURSE_STRING_COLUMNS; k++) {
+            char* CourseNative::*field = kCourseStringFields[k];
+            uint32_t* offsets = result->stringOffsets + k * count;
+            int32_t* lengths = result->stringLengths + k * count;
+            for (size_t i = 0; i < count; i++) {
+                const char* str = rows[i].*field;
+                if (!str) continue;
+                if (i > 0 && str == rows[i - 1].*field) {
+                    offsets[i] = offsets[i - 1];
+                    lengths[i] = lengths[i - 1];
+                    continue;
+                }
+                size_t n = utf8_to_utf16(str, (size_t)lengths[i], result->strings16 + units);
+                offsets[i] = (uint32_t)units;
+                lengths[i] = (int32_t)n;
+                units += n;
+            }
+        }
+        result->stringsSize = units;
+        return true;
+    }
+
+    // Offsets and lengths first, which also sizes the blob; then the copy.
+    static bool course_string_columns(struct CourseColumnsResult* result, CourseRows& rows, bool utf16) {
+        NekkoArena* arena = result->arena;
+        size_t count = rows.size();
+        size_t cells = count * NEKKO_COURSE_STRING_COLUMNS;
+        result->stringOffsets = arena_array<uint32_t>(arena, cells);
+        result->stringLengths = arena_array<int32_t>(arena, cells);
+        if (!result->stringOffsets || !result->stringLengths) return false;
+
+        size_t size = 0;
+        for (int k = 0; k < NEKKO_COURSE_STRING_COLUMNS; k++) {
+            char* CourseNative::*field = kCourseStringFields[k];
+            uint32_t* offsets = result->stringOffsets + k * count;
+            int32_t* lengths = result->stringLengths + k * count;
+            for (size_t i = 0; i < count; i++) {
+                const char* str = rows[i].*field;
+                if (!str) {
+                    offsets[i] = 0;
+                    lengths[i] = -1;
+                } else if (i > 0 && str == rows[i - 1].*field) {
+                    offsets[i] = offsets[i - 1];
+                    lengths[i] = lengths[i - 1];
+                } else {
+                    size_t len = strlen(str);
+                    if (len > INT32_MAX || size + len + 1 > UINT32_MAX) return false;
+                    offsets[i] = (uint32_t)size;
+                    lengths[i] = (int32_t)len;
+                    size += len + 1;
+                }
+            }
+        }
+
+        if (size == 0) return true;
+        if (utf16) return course_string_columns16(result, rows, size);
+        result->stringsSize = size;
+        result->strings = (char*)nekko_arena_alloc(arena, size);
+        if (!result->strings) return false;
+        for (int k = 0; k < NEKKO_COURSE_STRING_COLUMNS; k++) {
+            char* CourseNative::*field = kCourseStringFields[k];
+            const uint32_t* offsets = result->stringOffsets + k * count;
+            const int32_t* lengths = result->stringLengths + k * count;
+            for (size_t i = 0; i < count; i++) {
+                if (lengths[i] < 0 || (i > 0 && offsets[i] == offsets[i - 1] && lengths[i - 1] >= 0)) continue;
+                memcpy(result->strings + offsets[i], rows[i].*field, (size_t)lengths[i] + 1);
+            }
+        }
+        return true;
+    }
+
+    static bool course_columns(struct CourseColumnsResult* result, CourseRows& rows, bool utf16) {
+        NekkoArena* arena = result->arena;
+        size_t count = rows.size();
+        result->count = (int)count;
+        if (count == 0) return true;
+
+        result->id = course_int_column(arena, rows, &CourseNative::id);
+        result->dayOfWeek = course_int_column(arena, rows, &CourseNative::dayOfWeek);
+        result->startCourseHour = course_int_column(arena, rows, &CourseNative::startCourseHour);
+        result->endCourseHour = course_int_column(arena, rows, &CourseNative::endCourseHour);
+        result->credits = course_int_column(arena, rows, &CourseNative::credits);
+        result->fromWeek = course_int_column(arena, rows, &CourseNative::fromWeek);
+        result->toWeek = course_int_column(arena, rows, &CourseNative::toWeek);
+        result->startDate = course_date_column(arena, rows, &CourseNative::startDate);
+        result->endDate = course_date_column(arena, rows, &CourseNative::endDate);
+        result->grade = arena_array<double>(arena, count);
+        result->hasGrade = arena_array<uint8_t>(arena, count);
+        if (!result->id || !result->dayOfWeek || !result->startCourseHour || !result->endCourseHour ||
+            !result->credits || !result->fromWeek || !result->toWeek || !result->startDate ||
+            !result->endDate || !result->grade || !result->hasGrade) {
+            return false;
+        }
+        for (size_t i = 0; i < count; i++) {
+            result->grade[i] = rows[i].grade;
+            result->hasGrade[i] = rows[i].hasGrade;
+        }
+        return course_string_columns(result, rows, utf16);
+    }
+
+    static struct CourseColumnsResult* parse_courses_columns_impl(uint8_t* data, size_t len, bool utf16) {
+        struct CourseColumnsResult* result = new_result<struct CourseColumnsResult>(len);
+        NekkoArena* arena = result->arena;
+        if (!data) {
+            result->errorMessage = nekko_arena_strdup(arena, "Null JSON string");
+            return result;
+        }
+
+        CourseScan scan = {JsonCursor((char*)data, len), CourseRows(&kMallocAlc, len / kCourseRowBytes + 1), {}, {}, {}};
+        const char* error = enter_course_array(scan);
+        if (!error) {
+            scan_course_items(scan);
+            error = course_scan_error(scan);
+        }
+        if (!error && !course_columns(result, scan.rows, utf16)) error = "Out of memory";
+        if (error) {
+            // Drop whatever columns were built: an error result has none.
+            NekkoArena* fresh = nekko_arena_recycle(arena);
+            result = (struct CourseColumnsResult*)nekko_arena_calloc(fresh, 1, sizeof(*result));
+            result->arena = fresh;
+            result->errorMessage = nekko_arena_strdup(fresh, error);
+        }
+        return result;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseColumnsResult* parse_courses_columns(uint8_t* data, size_t len) {
+        return parse_courses_columns_impl(data, len, false);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseColumnsResult* parse_courses_columns_utf16(uint8_t* data, size_t len) {
+        return parse_courses_columns_impl(data, len, true);
+    }
+
+    // --- Native Notification Generator ---
+
+    struct TempHour {
+        int id;
+        int h;
+        int m;
+        char* str;
+    };
+
+    // Titles and bodies are formatted copies, so nothing borrows from the
+    // input once this returns; `opt.borrow` only decides whether the courses
+    // document can be parsed insitu.
+    static struct NotificationResult* generate_notifications_impl(
+        const char* courses_json, size_t courses_len,
+        const char* hours_json, size_t hours_len,
+        long long semester_start_millis, const ParseOptions& opt
+    ) {
+        // One notification per week per timetable: the output is several
+        // times the size of the input.
+        struct NotificationResult* result = new_result<struct NotificationResult>(courses_len * 4);
+        NekkoArena* arena = result->arena;
+        
+        if (!courses_json || !hours_json) {
+             result->errorMessage = nekko_arena_strdup(arena, "Invalid input JSONs");
+             return result;
+        }
+
+        CtxCall ctxCall(opt.ctx);
+        yyjson_doc *docCourses = read_json(courses_json, courses_len, YYJSON_READ_STOP_WHEN_DONE, opt);
+        yyjson_doc *docHours = read_json(hours_json, hours_len, 0, ParseOptions{false, opt.ctx});
+        
+        if (!docCourses || !docHours) {
+            result->errorMessage = nekko_arena_strdup(arena, "Failed to parse JSONs");
+            if (docCourses) yyjson_doc_free(docCourses);
+            if (docHours) yyjson_doc_free(docHours);
+            return result;
         }
         
         yyjson_val *hRoot = yyjson_doc_get_root(docHours);
@@ -689,7 +1376,8 @@ extern "C" {
         if (yyjson_is_obj(hRoot)) hContent = yyjson_obj_get(hRoot, "content");
         
         size_t hCount = yyjson_arr_size(hContent);
-        struct TempHour* tempHours = (struct TempHour*)calloc(hCount, sizeof(struct TempHour));
+        ScratchScope scratch;
+        struct TempHour* tempHours = arena_array<struct TempHour>(scratch.arena(), hCount);
         
         size_t h_idx, h_max;
         yyjson_val *hItem;
@@ -714,6 +1402,7 @@ extern "C" {
         };
 
         yyjson_arr_foreach(cRoot, c_idx, c_max, cItem) {
+             if (cancel_requested(opt.cancel)) break;
              yyjson_val *courseSubject = yyjson_obj_get(cItem, "courseSubject");
              if (!courseSubject) continue;
              
@@ -730,11 +1419,12 @@ extern "C" {
         }
         
         result->count = (int)total_notifs;
-        result->notifications = (struct NotificationNative*)calloc(result->count, sizeof(struct NotificationNative));
+        result->notifications = arena_array<struct NotificationNative>(arena, result->count);
         
         size_t current_n_idx = 0;
         
         yyjson_arr_foreach(cRoot, c_idx, c_max, cItem) {
+             if (cancel_requested(opt.cancel)) break;
              yyjson_val *courseSubject = yyjson_obj_get(cItem, "courseSubject");
              if (!courseSubject) continue;
              
@@ -792,273 +1482,101 @@ extern "C" {
                            n->triggerTime = trigger_time;
                            n->id = (int)((trigger_time / 1000) % 2147483647); 
                            
-                           n->title = format_string("Lịch học: %s", subjectName);
-                           n->body = format_string("Phòng: %s | Giờ: %s", roomName, timeStr);
+                           n->title = nekko_arena_printf(arena, "Lịch học: %s", subjectName);
+                           n->body = nekko_arena_printf(arena, "Phòng: %s | Giờ: %s", roomName, timeStr);
                       }
                  }
              }
         }
         
-        free(tempHours);
         yyjson_doc_free(docHours);
         yyjson_doc_free(docCourses);
-        return result;
+        return unless_cancelled(result, opt);
     }
 
-    // --- CourseHour ---
-    struct CourseHourNative {
-        int id;
-        char* name;
-        char* startString;
-        char* endString;
-        int indexNumber;
-    };
-    
-    struct CourseHourResult {
-        int count;
-        struct CourseHourNative* hours;
-        char* errorMessage;
-    };
-    
-    // --- Register Period ---
-    struct SemesterRegisterPeriodNative {
-        int id;
-        char* name;
-        long long startRegisterTime;
-        long long endRegisterTime;
-        long long endUnRegisterTime;
-        // String fallbacks
-        char* startRegisterTimeString;
-        char* endRegisterTimeString;
-        char* endUnRegisterTimeString;
-    };
-
-    // --- Semester ---
-    struct SemesterNative {
-        int id;
-        char* semesterCode;
-        char* semesterName;
-        long long startDate;
-        long long endDate;
-        bool isCurrent;
-        int ordinalNumbers;
-        int registerPeriodsCount; // NEW
-        struct SemesterRegisterPeriodNative* registerPeriods; // NEW
-    };
-    
-    // --- SchoolYear ---
-    struct SchoolYearNative {
-        int id;
-        char* name;
-        char* code;
-        int year;
-        bool current;
-        long long startDate;
-        long long endDate;
-        char* displayName;
-        int semestersCount;
-        struct SemesterNative* semesters;
-    };
-    
-    struct SchoolYearResult {
-        int count;
-        struct SchoolYearNative* years;
-        char* errorMessage;
-    };
-
-    struct SemesterResult {
-        struct SemesterNative* semester; // Single object check
-        char* errorMessage;
-    };
-    
-    // --- User ---
-    struct UserNative {
-        char* studentId; // username
-        char* fullName; // displayName
-        char* email;
-        int id;
-    };
-    
-    struct UserResult {
-         struct UserNative* user;
-         char* errorMessage;
-    };
-
-    // --- Registration Data ---
-    struct TimetableNative {
-        int id;
-        long long startDate;
-        long long endDate;
-        int fromWeek;
-        int toWeek;
-        int dayOfWeek;
-        int startHour;
-        int endHour;
-        char* roomName;
-        char* teacherName;
-        int roomId; // Added
-        int startHourId; // Added
-        int endHourId; // Added
-    };
-
-    struct CourseSubjectNative {
-        int id;
-        char* code;
-        char* name;
-        char* displayCode;
-        int numberStudent;
-        int maxStudent;
-        int numberRegisted; // numberStudent usually
-        bool isSelected;
-        bool isFull;
-        bool isOverlap;
-        int timetablesCount;
-        struct TimetableNative* timetables;
-        int credits;
-        char* status; // "new", "full", etc.
-        int subjectId; // Added
-    };
-
-    struct SubjectRegistrationNative {
-        char* subjectName;
-        int numberOfCredit;
-        int courseSubjectsCount;
-        struct CourseSubjectNative* courseSubjects;
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NotificationResult* generate_notifications(
+        const char* courses_json,
+        const char* hours_json,
+        long long semester_start_millis
+    ) {
+        return generate_notifications_impl(
+            courses_json, courses_json ? strlen(courses_json) : 0,
+            hours_json, hours_json ? strlen(hours_json) : 0,
+            semester_start_millis, ParseOptions{});
+    }
 
-    struct RegistrationPeriodNative {
-        int id;
-        int subjectsCount;
-        struct SubjectRegistrationNative* subjects;
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NotificationResult* generate_notifications_bytes(
+        const uint8_t* courses, size_t courses_len,
+        const uint8_t* hours, size_t hours_len,
+        long long semester_start_millis
+    ) {
+        return generate_notifications_impl(
+            (const char*)courses, courses_len,
+            (const char*)hours, hours_len,
+            semester_start_millis, ParseOptions{true, nullptr});
+    }
 
-    struct RegistrationResult {
-        struct RegistrationPeriodNative* data;
-        char* errorMessage;
-    };
+    // Only the courses document is parsed insitu, and only with
+    // NEKKO_CTX_BORROW_STRINGS; the hours document is never modified.
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NotificationResult* generate_notifications_ctx(
+        nekko_ctx* ctx,
+        uint8_t* courses, size_t courses_len,
+        uint8_t* hours, size_t hours_len,
+        long long semester_start_millis
+    ) {
+        return generate_notifications_impl(
+            (const char*)courses, courses_len,
+            (const char*)hours, hours_len,
+            semester_start_millis, ctx_options(ctx));
+    }
 
     // --- Free Functions ---
     __attribute__((visibility("default"))) __attribute__((used))
     void free_course_hour_result(struct CourseHourResult* result) {
-         if (!result) return;
-         if (result->hours) {
-             for(int i=0; i<result->count; i++) {
-                 free(result->hours[i].name);
-                 free(result->hours[i].startString);
-                 free(result->hours[i].endString);
-             }
-             free(result->hours);
-         }
-         free(result->errorMessage);
-         free(result);
+        if (!result) return;
+        nekko_arena_release(result->arena);
     }
 
     __attribute__((visibility("default"))) __attribute__((used))
     void free_school_year_result(struct SchoolYearResult* result) {
-         if (!result) return;
-         if (result->years) {
-             for(int i=0; i<result->count; i++) {
-                 free(result->years[i].name);
-                 free(result->years[i].code);
-                 free(result->years[i].displayName);
-                 if (result->years[i].semesters) {
-                     for(int j=0; j<result->years[i].semestersCount; j++) {
-                         free(result->years[i].semesters[j].semesterCode);
-                         free(result->years[i].semesters[j].semesterName);
-                         if (result->years[i].semesters[j].registerPeriods) {
-                             for(int k=0; k<result->years[i].semesters[j].registerPeriodsCount; k++) {
-                                 free(result->years[i].semesters[j].registerPeriods[k].name);
-                                 free(result->years[i].semesters[j].registerPeriods[k].startRegisterTimeString);
-                                 free(result->years[i].semesters[j].registerPeriods[k].endRegisterTimeString);
-                                 free(result->years[i].semesters[j].registerPeriods[k].endUnRegisterTimeString);
-                             }
-                             free(result->years[i].semesters[j].registerPeriods);
-                         }
-                     }
-                     free(result->years[i].semesters);
-                 }
-             }
-             free(result->years);
-         }
-         free(result->errorMessage);
-         free(result);
+        if (!result) return;
+        nekko_arena_release(result->arena);
     }
     
     __attribute__((visibility("default"))) __attribute__((used))
     void free_semester_result(struct SemesterResult* result) {
-         if (!result) return;
-         if (result->semester) {
-             free(result->semester->semesterCode);
-             free(result->semester->semesterName);
-             if (result->semester->registerPeriods) {
-                 for(int k=0; k<result->semester->registerPeriodsCount; k++) {
-                     free(result->semester->registerPeriods[k].name);
-                     free(result->semester->registerPeriods[k].startRegisterTimeString);
-                     free(result->semester->registerPeriods[k].endRegisterTimeString);
-                     free(result->semester->registerPeriods[k].endUnRegisterTimeString);
-                 }
-                 free(result->semester->registerPeriods);
-             }
-             free(result->semester);
-         }
-         free(result->errorMessage);
-         free(result);
+        if (!result) return;
+        nekko_arena_release(result->arena);
     }
 
     __attribute__((visibility("default"))) __attribute__((used))
     void free_user_result(struct UserResult* result) {
         if (!result) return;
-        if (result->user) {
-            free(result->user->studentId);
-            free(result->user->fullName);
-            free(result->user->email);
-            free(result->user);
-        }
-        free(result->errorMessage);
-        free(result);
+        nekko_arena_release(result->arena);
     }
 
     __attribute__((visibility("default"))) __attribute__((used))
     void free_registration_result(struct RegistrationResult* result) {
         if (!result) return;
-        if (result->data) {
-             for(int i=0; i<result->data->subjectsCount; i++) {
-                 struct SubjectRegistrationNative* s = &result->data->subjects[i];
-                 free(s->subjectName);
-                 if (s->courseSubjects) {
-                     for(int j=0; j<s->courseSubjectsCount; j++) {
-                         struct CourseSubjectNative* c = &s->courseSubjects[j];
-                         free(c->code);
-                         free(c->name);
-                         free(c->displayCode);
-                         free(c->status);
-                         if (c->timetables) {
-                             for(int k=0; k<c->timetablesCount; k++) {
-                                 free(c->timetables[k].roomName);
-                                 free(c->timetables[k].teacherName);
-                             }
-                             free(c->timetables);
-                         }
-                     }
-                     free(s->courseSubjects);
-                 }
-             }
-             free(result->data->subjects);
-             free(result->data);
-        }
-        free(result->errorMessage);
-        free(result);
+        nekko_arena_release(result->arena);
     }
 
     // --- Parsers ---
 
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct CourseHourResult* parse_course_hours(const char* json_str) {
-        struct CourseHourResult* result = (struct CourseHourResult*)calloc(1, sizeof(struct CourseHourResult));
-        if (!json_str) { result->errorMessage = strdup("Null JSON"); return result; }
+    static struct CourseHourResult* parse_course_hours_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct CourseHourResult* result = new_result<struct CourseHourResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringPool pool(arena, json_len);
+        StringSink strings = call_strings(arena, opt, pool);
+        CtxCall ctxCall(opt.ctx);
+        if (!json_str) { result->errorMessage = nekko_arena_strdup(arena, "Null JSON"); return result; }
         
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
-        if (!doc) { result->errorMessage = strdup("Parse Error"); return result; }
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
+        if (!doc) { result->errorMessage = nekko_arena_strdup(arena, "Parse Error"); return result; }
         
         yyjson_val *root = yyjson_doc_get_root(doc);
         // Root could be list or map {"content": []}
@@ -1068,36 +1586,49 @@ extern "C" {
         }
         
         if (!yyjson_is_arr(arr)) {
-           result->errorMessage = strdup("Not an array");
+           result->errorMessage = nekko_arena_strdup(arena, "Not an array");
            yyjson_doc_free(doc);
            return result;
         }
         
-        result->count = (int)yyjson_arr_size(arr);
-        result->hours = (struct CourseHourNative*)calloc(result->count, sizeof(struct CourseHourNative));
-        
-        size_t idx, max;
-        yyjson_val *item;
-        yyjson_arr_foreach(arr, idx, max, item) {
-            struct CourseHourNative* h = &result->hours[idx];
-            h->id = get_json_int(yyjson_obj_get(item, "id"));
-            h->name = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "name")));
-            h->startString = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "startString")));
-            h->endString = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "endString")));
-            h->indexNumber = get_json_int(yyjson_obj_get(item, "indexNumber"));
-        }
+        DecodeEnv env(arena, strings, nekko_ctx_fields(opt.ctx), opt.cancel);
+        result->hours = Decoder<CourseHourNative>::decode_array(arr, &result->count, env);
         
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
-    
+
     __attribute__((visibility("default"))) __attribute__((used))
-    struct SchoolYearResult* parse_school_years(const char* json_str) {
-        struct SchoolYearResult* result = (struct SchoolYearResult*)calloc(1, sizeof(struct SchoolYearResult));
-         if (!json_str) { result->errorMessage = strdup("Null JSON"); return result; }
+    struct CourseHourResult* parse_course_hours(const char* json_str) {
+        return parse_course_hours_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseHourResult* parse_course_hours_bytes(const uint8_t* data, size_t len) {
+        return parse_course_hours_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseHourResult* parse_course_hours_borrowed(uint8_t* data, size_t len) {
+        return parse_course_hours_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseHourResult* parse_course_hours_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_course_hours_impl((const char*)data, len, ctx_options(ctx));
+    }
+    
+    static struct SchoolYearResult* parse_school_years_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct SchoolYearResult* result = new_result<struct SchoolYearResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringPool pool(arena, json_len);
+        StringSink strings = call_strings(arena, opt, pool);
+        CtxCall ctxCall(opt.ctx);
+         if (!json_str) { result->errorMessage = nekko_arena_strdup(arena, "Null JSON"); return result; }
         
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
-        if (!doc) { result->errorMessage = strdup("Parse Error"); return result; }
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
+        if (!doc) { result->errorMessage = nekko_arena_strdup(arena, "Parse Error"); return result; }
         
         yyjson_val *root = yyjson_doc_get_root(doc);
         yyjson_val *arr = root;
@@ -1106,160 +1637,107 @@ extern "C" {
         }
         
         if (!yyjson_is_arr(arr)) {
-           result->errorMessage = strdup("Not an array");
+           result->errorMessage = nekko_arena_strdup(arena, "Not an array");
            yyjson_doc_free(doc);
            return result;
         }
         
-        result->count = (int)yyjson_arr_size(arr);
-        result->years = (struct SchoolYearNative*)calloc(result->count, sizeof(struct SchoolYearNative));
-        
-        size_t idx, max;
-        yyjson_val *item;
-        yyjson_arr_foreach(arr, idx, max, item) {
-            struct SchoolYearNative* sy = &result->years[idx];
-            sy->id = get_json_int(yyjson_obj_get(item, "id"));
-            sy->name = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "name")));
-            sy->code = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "code")));
-            sy->displayName = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "displayName")));
-            sy->year = get_json_int(yyjson_obj_get(item, "year"));
-            sy->current = yyjson_get_bool(yyjson_obj_get(item, "current"));
-            sy->startDate = get_json_int64(yyjson_obj_get(item, "startDate"));
-            sy->endDate = get_json_int64(yyjson_obj_get(item, "endDate"));
-            
-            yyjson_val *sems = yyjson_obj_get(item, "semesters");
-            if (yyjson_is_arr(sems)) {
-                sy->semestersCount = (int)yyjson_arr_size(sems);
-                sy->semesters = (struct SemesterNative*)calloc(sy->semestersCount, sizeof(struct SemesterNative));
-                size_t s_idx, s_max;
-                yyjson_val *semItem;
-                yyjson_arr_foreach(sems, s_idx, s_max, semItem) {
-                     struct SemesterNative* s = &sy->semesters[s_idx];
-                     s->id = get_json_int(yyjson_obj_get(semItem, "id"));
-                     s->semesterCode = safe_strdup(yyjson_get_str(yyjson_obj_get(semItem, "semesterCode")));
-                     s->semesterName = safe_strdup(yyjson_get_str(yyjson_obj_get(semItem, "semesterName")));
-                     s->startDate = get_json_int64(yyjson_obj_get(semItem, "startDate"));
-                     if (s->startDate == 0) s->startDate = get_json_int64(yyjson_obj_get(semItem, "StartDate"));
-                     s->endDate = get_json_int64(yyjson_obj_get(semItem, "endDate"));
-                     if (s->endDate == 0) s->endDate = get_json_int64(yyjson_obj_get(semItem, "EndDate"));
-                     s->isCurrent = yyjson_get_bool(yyjson_obj_get(semItem, "isCurrent"));
-                     s->ordinalNumbers = get_json_int(yyjson_obj_get(semItem, "ordinalNumbers"));
-                     
-                     yyjson_val *regPeriods = yyjson_obj_get(semItem, "semesterRegisterPeriods");
-                     if (yyjson_is_arr(regPeriods)) {
-                         s->registerPeriodsCount = (int)yyjson_arr_size(regPeriods);
-                         s->registerPeriods = (struct SemesterRegisterPeriodNative*)calloc(s->registerPeriodsCount, sizeof(struct SemesterRegisterPeriodNative));
-                         size_t rp_idx, rp_max;
-                         yyjson_val *rpItem;
-                         yyjson_arr_foreach(regPeriods, rp_idx, rp_max, rpItem) {
-                             struct SemesterRegisterPeriodNative* rp = &s->registerPeriods[rp_idx];
-                             rp->id = get_json_int(yyjson_obj_get(rpItem, "id"));
-                             rp->name = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "name")));
-                             rp->startRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "startRegisterTime"));
-                             if (rp->startRegisterTime == 0) rp->startRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "StartRegisterTime"));
-                             rp->endRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "endRegisterTime"));
-                             if (rp->endRegisterTime == 0) rp->endRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "EndRegisterTime"));
-                             rp->endUnRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "endUnRegisterTime"));
-                             if (rp->endUnRegisterTime == 0) rp->endUnRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "EndUnRegisterTime"));
-                             
-                             rp->startRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "startRegisterTimeString")));
-                             if (!rp->startRegisterTimeString) rp->startRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "StartRegisterTimeString")));
-                             rp->endRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "endRegisterTimeString")));
-                             if (!rp->endRegisterTimeString) rp->endRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "EndRegisterTimeString")));
-                             rp->endUnRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "endUnRegisterTimeString")));
-                             if (!rp->endUnRegisterTimeString) rp->endUnRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "EndUnRegisterTimeString")));
-                         }
-                     }
-                }
-            }
-        }
+        DecodeEnv env(arena, strings, nekko_ctx_fields(opt.ctx), opt.cancel);
+        result->years = Decoder<SchoolYearNative>::decode_array(arr, &result->count, env);
         
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
-    
+
     __attribute__((visibility("default"))) __attribute__((used))
-    struct SemesterResult* parse_semester(const char* json_str) {
-        struct SemesterResult* result = (struct SemesterResult*)calloc(1, sizeof(struct SemesterResult));
-        if (!json_str) { result->errorMessage = strdup("Null JSON"); return result; }
+    struct SchoolYearResult* parse_school_years(const char* json_str) {
+        return parse_school_years_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct SchoolYearResult* parse_school_years_bytes(const uint8_t* data, size_t len) {
+        return parse_school_years_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct SchoolYearResult* parse_school_years_borrowed(uint8_t* data, size_t len) {
+        return parse_school_years_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct SchoolYearResult* parse_school_years_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_school_years_impl((const char*)data, len, ctx_options(ctx));
+    }
+    
+    static struct SemesterResult* parse_semester_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct SemesterResult* result = new_result<struct SemesterResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringPool pool(arena, json_len);
+        StringSink strings = call_strings(arena, opt, pool);
+        CtxCall ctxCall(opt.ctx);
+        if (!json_str) { result->errorMessage = nekko_arena_strdup(arena, "Null JSON"); return result; }
         
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
-        if (!doc) { result->errorMessage = strdup("Parse Error"); return result; }
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
+        if (!doc) { result->errorMessage = nekko_arena_strdup(arena, "Parse Error"); return result; }
         
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!root || !yyjson_is_obj(root)) {
-            result->errorMessage = strdup("Not an object");
+            result->errorMessage = nekko_arena_strdup(arena, "Not an object");
             yyjson_doc_free(doc);
             return result;
         }
         
-        result->semester = (struct SemesterNative*)calloc(1, sizeof(struct SemesterNative));
-        struct SemesterNative* s = result->semester;
-        s->id = get_json_int(yyjson_obj_get(root, "id"));
-        s->semesterCode = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "semesterCode")));
-        s->semesterName = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "semesterName")));
-         s->startDate = get_json_int64(yyjson_obj_get(root, "startDate"));
-         s->endDate = get_json_int64(yyjson_obj_get(root, "endDate"));
-         s->isCurrent = yyjson_get_bool(yyjson_obj_get(root, "isCurrent"));
-         s->ordinalNumbers = get_json_int(yyjson_obj_get(root, "ordinalNumbers"));
-         
-         yyjson_val *regPeriods = yyjson_obj_get(root, "semesterRegisterPeriods");
-         if (yyjson_is_arr(regPeriods)) {
-             s->registerPeriodsCount = (int)yyjson_arr_size(regPeriods);
-             s->registerPeriods = (struct SemesterRegisterPeriodNative*)calloc(s->registerPeriodsCount, sizeof(struct SemesterRegisterPeriodNative));
-             size_t rp_idx, rp_max;
-             yyjson_val *rpItem;
-             yyjson_arr_foreach(regPeriods, rp_idx, rp_max, rpItem) {
-                 struct SemesterRegisterPeriodNative* rp = &s->registerPeriods[rp_idx];
-                 rp->id = get_json_int(yyjson_obj_get(rpItem, "id"));
-                 if (rp->id == 0) rp->id = get_json_int(yyjson_obj_get(rpItem, "Id"));
-                 
-                 rp->name = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "name")));
-                 if (!rp->name) rp->name = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "Name")));
-                 
-                 rp->startRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "startRegisterTime"));
-                 if (rp->startRegisterTime == 0) rp->startRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "StartRegisterTime"));
-                 
-                 rp->endRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "endRegisterTime"));
-                 if (rp->endRegisterTime == 0) rp->endRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "EndRegisterTime"));
-                 
-                 rp->endUnRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "endUnRegisterTime"));
-                 if (rp->endUnRegisterTime == 0) rp->endUnRegisterTime = get_json_int64(yyjson_obj_get(rpItem, "EndUnRegisterTime"));
-                 
-                 rp->startRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "startRegisterTimeString")));
-                 if (!rp->startRegisterTimeString) rp->startRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "StartRegisterTimeString")));
-                 
-                 rp->endRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "endRegisterTimeString")));
-                 if (!rp->endRegisterTimeString) rp->endRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "EndRegisterTimeString")));
-                 
-                 rp->endUnRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "endUnRegisterTimeString")));
-                 if (!rp->endUnRegisterTimeString) rp->endUnRegisterTimeString = safe_strdup(yyjson_get_str(yyjson_obj_get(rpItem, "EndUnRegisterTimeString")));
-             }
-         }
+        result->semester = arena_array<struct SemesterNative>(arena, 1);
+        DecodeEnv env(arena, strings, nekko_ctx_fields(opt.ctx), opt.cancel);
+        Decoder<SemesterNative>::decode(root, result->semester, env);
 
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
-    
+
     __attribute__((visibility("default"))) __attribute__((used))
-    struct UserResult* parse_user(const char* json_str) {
-        struct UserResult* result = (struct UserResult*)calloc(1, sizeof(struct UserResult));
-        if (!json_str) { result->errorMessage = strdup("Null JSON"); return result; }
+    struct SemesterResult* parse_semester(const char* json_str) {
+        return parse_semester_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct SemesterResult* parse_semester_bytes(const uint8_t* data, size_t len) {
+        return parse_semester_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct SemesterResult* parse_semester_borrowed(uint8_t* data, size_t len) {
+        return parse_semester_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct SemesterResult* parse_semester_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_semester_impl((const char*)data, len, ctx_options(ctx));
+    }
+    
+    static struct UserResult* parse_user_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct UserResult* result = new_result<struct UserResult>(json_len);
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringSink strings = {arena, opt.borrow};
+        CtxCall ctxCall(opt.ctx);
+        if (!json_str) { result->errorMessage = nekko_arena_strdup(arena, "Null JSON"); return result; }
         
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
-        if (!doc) { result->errorMessage = strdup("Parse Error"); return result; }
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
+        if (!doc) { result->errorMessage = nekko_arena_strdup(arena, "Parse Error"); return result; }
         
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!root || !yyjson_is_obj(root)) {
-             result->errorMessage = strdup("Not an object");
+             result->errorMessage = nekko_arena_strdup(arena, "Not an object");
              yyjson_doc_free(doc);
              return result;
         }
         
-        result->user = (struct UserNative*)calloc(1, sizeof(struct UserNative));
-        result->user->studentId = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "username")));
-        result->user->fullName = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "displayName")));
-        result->user->email = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "email")));
+        result->user = arena_array<struct UserNative>(arena, 1);
+        result->user->studentId = strings.take(yyjson_get_str(yyjson_obj_get(root, "username")));
+        result->user->fullName = strings.take(yyjson_get_str(yyjson_obj_get(root, "displayName")));
+        result->user->email = strings.take(yyjson_get_str(yyjson_obj_get(root, "email")));
         
         yyjson_val *person = yyjson_obj_get(root, "person");
         if (!person) person = yyjson_obj_get(root, "Person");
@@ -1274,72 +1752,107 @@ extern "C" {
         }
         
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
 
-    // --- Token ---
-    struct TokenResponseNative {
-        char* access_token;
-        char* token_type;
-        char* refresh_token;
-        char* scope;
-        int expires_in;
-    };
-    
-    struct TokenResponseResult {
-        struct TokenResponseNative* token;
-        char* errorMessage;
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct UserResult* parse_user(const char* json_str) {
+        return parse_user_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct UserResult* parse_user_bytes(const uint8_t* data, size_t len) {
+        return parse_user_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct UserResult* parse_user_borrowed(uint8_t* data, size_t len) {
+        return parse_user_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct UserResult* parse_user_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_user_impl((const char*)data, len, ctx_options(ctx));
+    }
 
     __attribute__((visibility("default"))) __attribute__((used))
     void free_token_result(struct TokenResponseResult* result) {
         if (!result) return;
-        if (result->token) {
-            free(result->token->access_token);
-            free(result->token->token_type);
-            free(result->token->refresh_token);
-            free(result->token->scope);
-            free(result->token);
-        }
-        free(result->errorMessage);
-        free(result);
+        nekko_arena_release(result->arena);
     }
     
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct TokenResponseResult* parse_token(const char* json_str) {
-        struct TokenResponseResult* result = (struct TokenResponseResult*)calloc(1, sizeof(struct TokenResponseResult));
-        if (!json_str) { result->errorMessage = strdup("Null JSON"); return result; }
+    static struct TokenResponseResult* parse_token_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct TokenResponseResult* result = new_result<struct TokenResponseResult>(json_len);
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringSink strings = {arena, opt.borrow};
+        CtxCall ctxCall(opt.ctx);
+        if (!json_str) { result->errorMessage = nekko_arena_strdup(arena, "Null JSON"); return result; }
         
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
-        if (!doc) { result->errorMessage = strdup("Parse Error"); return result; }
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
+        if (!doc) { result->errorMessage = nekko_arena_strdup(arena, "Parse Error"); return result; }
         
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!root || !yyjson_is_obj(root)) {
-             result->errorMessage = strdup("Not an object");
+             result->errorMessage = nekko_arena_strdup(arena, "Not an object");
              yyjson_doc_free(doc);
              return result;
         }
         
-        result->token = (struct TokenResponseNative*)calloc(1, sizeof(struct TokenResponseNative));
-        result->token->access_token = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "access_token")));
-        result->token->token_type = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "token_type")));
-        result->token->refresh_token = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "refresh_token")));
-        result->token->scope = safe_strdup(yyjson_get_str(yyjson_obj_get(root, "scope")));
-        result->token->expires_in = get_json_int(yyjson_obj_get(root, "expires_in"));
+        result->token = arena_array<struct TokenResponseNative>(arena, 1);
+        DecodeEnv env(arena, strings);
+        Decoder<TokenResponseNative>::decode(root, result->token, env);
         
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
 
     __attribute__((visibility("default"))) __attribute__((used))
-    struct RegistrationResult* parse_registration_data(const char* json_str) {
-        struct RegistrationResult* result = (struct RegistrationResult*)calloc(1, sizeof(struct RegistrationResult));
-        if (!json_str) { result->errorMessage = strdup("Null JSON"); return result; }
-        
-        yyjson_doc *doc = yyjson_read_opts((char*)json_str, strlen(json_str), YYJSON_READ_STOP_WHEN_DONE, NULL, NULL);
-        if (!doc) { result->errorMessage = strdup("Parse Error"); return result; }
-        
-        yyjson_val *root = yyjson_doc_get_root(doc);
+    struct TokenResponseResult* parse_token(const char* json_str) {
+        return parse_token_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct TokenResponseResult* parse_token_bytes(const uint8_t* data, size_t len) {
+        return parse_token_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct TokenResponseResult* parse_token_borrowed(uint8_t* data, size_t len) {
+        return parse_token_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct TokenResponseResult* parse_token_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_token_impl((const char*)data, len, ctx_options(ctx));
+    }
+
+    // --- Registration field tables ---
+    // The envelope around the subject list; subjects and everything under
+    // them are described in native-schema.h. PascalCase first, as there.
+
+    enum { kRegRootId, kRegRootView, kRegRootMessage, kRegRootSlots };
+    constexpr KeyAlias kRegistrationRootAliases[] = {
+        {"Id", kRegRootId, FieldKind::Int},
+        {"id", kRegRootId, FieldKind::Int},
+        {"CourseRegisterViewObject", kRegRootView, FieldKind::Any},
+        {"courseRegisterViewObject", kRegRootView, FieldKind::Any},
+        {"message", kRegRootMessage, FieldKind::Any},
+    };
+    constexpr auto kRegistrationRootKeys = make_key_table<kRegRootSlots>(kRegistrationRootAliases);
+
+    constexpr KeyAlias kRegistrationViewAliases[] = {
+        {"ListSubjectRegistrationDtos", 0, FieldKind::Any},
+        {"listSubjectRegistrationDtos", 0, FieldKind::Any},
+    };
+    constexpr auto kRegistrationViewKeys = make_key_table<1>(kRegistrationViewAliases);
+
+    // Finds the subject list in a registration document and reads the
+    // period id. Returns the error the document carries instead, if any:
+    // static, in `buf`, or the server's own message, pointing into the doc.
+    // `*subjects` is the list when there is one, even if not an array.
+    static const char* registration_envelope(yyjson_val* root, int* id, yyjson_val** subjects, char (&buf)[128]) {
+        *subjects = nullptr;
         if (!root || !yyjson_is_obj(root)) {
              const char* typeStr = "unknown";
              if (yyjson_is_arr(root)) typeStr = "array";
@@ -1347,150 +1860,620 @@ extern "C" {
              else if (yyjson_is_num(root)) typeStr = "number";
              else if (yyjson_is_null(root)) typeStr = "null";
              else if (yyjson_is_bool(root)) typeStr = "bool";
-             
-             char buf[128];
+
              snprintf(buf, sizeof(buf), "Not an object (Actual: %s)", typeStr);
-             result->errorMessage = strdup(buf);
-             yyjson_doc_free(doc);
-             return result;
+             return buf;
+        }
+
+        ObjFields rootFields(kRegistrationRootKeys, root);
+        *id = get_json_int(rootFields[kRegRootId]);
+
+        yyjson_val *viewObj = rootFields[kRegRootView];
+        if (!viewObj || !yyjson_is_obj(viewObj)) {
+             yyjson_val* msg = rootFields[kRegRootMessage];
+             return msg ? yyjson_get_str(msg) : "Missing CourseRegisterViewObject";
         }
+        *subjects = ObjFields(kRegistrationViewKeys, viewObj)[0];
+        return *subjects ? nullptr : "Missing ListSubjectRegistrationDtos";
+    }
 
-        result->data = (struct RegistrationPeriodNative*)calloc(1, sizeof(struct RegistrationPeriodNative));
+    // A subject that states no credits of its own takes its first class
+    // section's. Needs that section decoded with at least its credits.
+    static void registration_credits_fallback(struct SubjectRegistrationNative* s) {
+        if (s->numberOfCredit == 0 && s->courseSubjectsCount > 0 && s->courseSubjects) {
+            s->numberOfCredit = s->courseSubjects[0].credits;
+        }
+    }
+
+    // Parallel subjects (NEKKO_CTX_PARALLEL). Below kParallelMinSubjects
+    // the hand-off costs more than it saves; chunks of kParallelChunk and up
+    // keep threads that finish early busy without a chunk per subject.
+    constexpr size_t kParallelMinSubjects = 16;
+    constexpr size_t kParallelChunk = 8;
+    constexpr size_t kParallelMaxChunks = 4 * (WorkerPool::kMaxThreads + 1);
+
+    // decode_array for the subject list, with the subjects shared out to
+    // the worker pool. The slots are allocated up front and each chunk of
+    // them is filled by one thread into an arena of its own, merged into
+    // `env.arena` at the end. Workers leave strings pointing into the DOM;
+    // a pool or arena copy is then taken here, in subject order, so
+    // interning hands out the ids a serial decode would.
+    static struct SubjectRegistrationNative* decode_subjects_parallel(yyjson_val* list, int* count, DecodeEnv& env,
+                                                                      const uint64_t* fields) {
+        using Subjects = Decoder<SubjectRegistrationNative>;
+        *count = 0;
+        size_t n = yyjson_arr_size(list);
+        auto* subjects = arena_array<struct SubjectRegistrationNative>(env.arena, n);
+        if (!subjects) return nullptr;
+        *count = (int)n;
+
+        size_t threads = WorkerPool::shared().size() + 1;
+        size_t chunks = (n + kParallelChunk - 1) / kParallelChunk;
+        if (chunks > 4 * threads) chunks = 4 * threads;
+        size_t per = (n + chunks - 1) / chunks;
+        chunks = (n + per - 1) / per;
+
+        // Elements can only be reached front to back, so note where each
+        // chunk starts.
+        yyjson_val* starts[kParallelMaxChunks];
+        NekkoArena* arenas[kParallelMaxChunks] = {};
+        size_t idx, max;
+        yyjson_val* item;
+        yyjson_arr_foreach(list, idx, max, item) {
+            if (idx % per == 0) starts[idx / per] = item;
+        }
+
+        auto decode_chunk = [&](size_t c, DecodeEnv& chunkEnv) {
+            ShapeHint* hint = chunkEnv.hint_for(&Subjects::kTable);
+            size_t end = (c + 1) * per < n ? (c + 1) * per : n;
+            yyjson_val* val = starts[c];
+            for (size_t i = c * per; i < end && !chunkEnv.cancelled(); i++, val = unsafe_yyjson_get_next(val)) {
+                Subjects::decode(val, &subjects[i], chunkEnv, hint);
+            }
+        };
+        WorkerPool::shared().parallel_for(chunks, [&](size_t c) {
+            arenas[c] = nekko_arena_create(per * 512);     // a subject with a few sections
+            if (!arenas[c]) return;
+            DecodeEnv chunkEnv(arenas[c], StringSink{arenas[c], true}, fields, env.cancel());
+            decode_chunk(c, chunkEnv);
+        });
+
+        DecodeEnv serialEnv(env.arena, StringSink{env.arena, true}, fields, env.cancel());
+        for (size_t c = 0; c < chunks; c++) {
+            if (arenas[c]) nekko_arena_merge(env.arena, arenas[c]);
+            else decode_chunk(c, serialEnv);    // out of memory on that thread
+        }
+
+        // A cancelled decode is about to be thrown away.
+        if ((!env.strings.borrow || env.strings.pool) && !env.cancelled()) {
+            RetakeStrings retake{env.strings};
+            for (size_t i = 0; i < n; i++) BlobWalk<SubjectRegistrationNative>::walk(subjects[i], retake);
+        }
+        return subjects;
+    }
+
+    // Fills `result` from a parsed document; shared by the one-shot and the
+    // chunked entry points. `parallel` allows decode_subjects_parallel;
+    // `cancel` is checked between subjects.
+    static void build_registration_data(struct RegistrationResult* result, yyjson_doc* doc, const StringSink& strings,
+                                        const uint64_t* fields, bool parallel = false, NekkoCancel* cancel = nullptr) {
+        NekkoArena* arena = result->arena;
+        yyjson_val *root = yyjson_doc_get_root(doc);
+        char buf[128];
+        int id = 0;
+        yyjson_val* listSubject;
+        const char* error = registration_envelope(root, &id, &listSubject, buf);
+        if (!yyjson_is_obj(root)) {
+             result->errorMessage = nekko_arena_strdup(arena, error);
+             return;
+        }
+
+        result->data = arena_array<struct RegistrationPeriodNative>(arena, 1);
         struct RegistrationPeriodNative* period = result->data;
+        period->id = id;
+
+        if (listSubject && yyjson_is_arr(listSubject)) {
+            DecodeEnv env(arena, strings, fields, cancel);
+            if (parallel && yyjson_arr_size(listSubject) >= kParallelMinSubjects && WorkerPool::shared().size() > 0) {
+                period->subjects = decode_subjects_parallel(listSubject, &period->subjectsCount, env, fields);
+            } else {
+                period->subjects = Decoder<SubjectRegistrationNative>::decode_array(listSubject, &period->subjectsCount, env);
+            }
+            bool credits = env.fields_for(NEKKO_ENTITY_SUBJECT) >> NEKKO_SUBJECT_FIELD_CREDITS & 1;
+            for (int i = 0; credits && i < period->subjectsCount; i++) {
+                registration_credits_fallback(&period->subjects[i]);
+            }
+        }
+        if (error) result->errorMessage = nekko_arena_strdup(arena, error); // always owned
+    }
+
+    static struct RegistrationResult* parse_registration_data_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct RegistrationResult* result = new_result<struct RegistrationResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        CtxCall ctxCall(opt.ctx);
+        if (!json_str) { result->errorMessage = nekko_arena_strdup(arena, "Null JSON"); return result; }
+        
+        yyjson_doc *doc = read_json(json_str, json_len, YYJSON_READ_STOP_WHEN_DONE, opt);
+        if (!doc) { result->errorMessage = nekko_arena_strdup(arena, "Parse Error"); return result; }
         
-        period->id = get_json_int(yyjson_obj_get(root, "Id"));
-        if (period->id == 0) period->id = get_json_int(yyjson_obj_get(root, "id"));
+        StringPool pool(arena, json_len);
+        build_registration_data(result, doc, call_strings(arena, opt, pool), nekko_ctx_fields(opt.ctx),
+                                nekko_ctx_parallel(opt.ctx), opt.cancel);
+        yyjson_doc_free(doc);
+        return unless_cancelled(result, opt);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* parse_registration_data(const char* json_str) {
+        return parse_registration_data_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
 
-        yyjson_val *viewObj = yyjson_obj_get(root, "CourseRegisterViewObject");
-        if (!viewObj) viewObj = yyjson_obj_get(root, "courseRegisterViewObject");
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* parse_registration_data_bytes(const uint8_t* data, size_t len) {
+        return parse_registration_data_impl((const char*)data, len, ParseOptions{});
+    }
 
-        if (viewObj && yyjson_is_obj(viewObj)) {
-            yyjson_val *listSubject = yyjson_obj_get(viewObj, "ListSubjectRegistrationDtos");
-            if (!listSubject) listSubject = yyjson_obj_get(viewObj, "listSubjectRegistrationDtos");
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* parse_registration_data_borrowed(uint8_t* data, size_t len) {
+        return parse_registration_data_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
 
-            if (listSubject && yyjson_is_arr(listSubject)) {
-                period->subjectsCount = (int)yyjson_arr_size(listSubject);
-                period->subjects = (struct SubjectRegistrationNative*)calloc(period->subjectsCount, sizeof(struct SubjectRegistrationNative));
-                
-                size_t s_idx, s_max;
-                yyjson_val *sItem;
-                yyjson_arr_foreach(listSubject, s_idx, s_max, sItem) {
-                    struct SubjectRegistrationNative* s = &period->subjects[s_idx];
-                    s->subjectName = safe_strdup(yyjson_get_str(yyjson_obj_get(sItem, "SubjectName")));
-                    if (!s->subjectName) s->subjectName = safe_strdup(yyjson_get_str(yyjson_obj_get(sItem, "subjectName")));
-                    
-                    s->numberOfCredit = get_json_int(yyjson_obj_get(sItem, "NumberOfCredit"));
-                    if (s->numberOfCredit == 0) s->numberOfCredit = get_json_int(yyjson_obj_get(sItem, "numberOfCredit"));
-                    if (s->numberOfCredit == 0) s->numberOfCredit = get_json_int(yyjson_obj_get(sItem, "Credits"));
-                    if (s->numberOfCredit == 0) s->numberOfCredit = get_json_int(yyjson_obj_get(sItem, "credits"));
-                    
-                    yyjson_val *courseSubjects = yyjson_obj_get(sItem, "CourseSubjectDtos");
-                    if (!courseSubjects) courseSubjects = yyjson_obj_get(sItem, "courseSubjectDtos");
-                    
-                    if (yyjson_is_arr(courseSubjects)) {
-                         s->courseSubjectsCount = (int)yyjson_arr_size(courseSubjects);
-                         s->courseSubjects = (struct CourseSubjectNative*)calloc(s->courseSubjectsCount, sizeof(struct CourseSubjectNative));
-                         
-                         size_t c_idx, c_max;
-                         yyjson_val *cItem;
-                         yyjson_arr_foreach(courseSubjects, c_idx, c_max, cItem) {
-                             struct CourseSubjectNative* c = &s->courseSubjects[c_idx];
-                             c->id = get_json_int(yyjson_obj_get(cItem, "Id"));
-                             if (c->id == 0) c->id = get_json_int(yyjson_obj_get(cItem, "id"));
-
-                             c->code = safe_strdup(yyjson_get_str(yyjson_obj_get(cItem, "Code")));
-                             if (!c->code) c->code = safe_strdup(yyjson_get_str(yyjson_obj_get(cItem, "code")));
-
-                             c->displayCode = safe_strdup(yyjson_get_str(yyjson_obj_get(cItem, "DisplayCode")));
-                             if (!c->displayCode) c->displayCode = safe_strdup(yyjson_get_str(yyjson_obj_get(cItem, "displayCode"))); // fallback
-
-                             c->maxStudent = get_json_int(yyjson_obj_get(cItem, "MaxStudent"));
-                             if (c->maxStudent == 0) c->maxStudent = get_json_int(yyjson_obj_get(cItem, "maxStudent"));
-
-                             c->numberStudent = get_json_int(yyjson_obj_get(cItem, "NumberStudent"));
-                             if (c->numberStudent == 0) c->numberStudent = get_json_int(yyjson_obj_get(cItem, "numberStudent"));
-
-                             c->isSelected = yyjson_get_bool(yyjson_obj_get(cItem, "IsSelected"));
-                             // no fallback needed for bool if false is default, but yyjson_get_bool returns false if not found.
-                             // check camelCase:
-                             if (!c->isSelected && yyjson_obj_get(cItem, "isSelected")) c->isSelected = yyjson_get_bool(yyjson_obj_get(cItem, "isSelected"));
-
-                             c->isFull = yyjson_get_bool(yyjson_obj_get(cItem, "IsFullClass"));
-                             if (!c->isFull && yyjson_obj_get(cItem, "isFullClass")) c->isFull = yyjson_get_bool(yyjson_obj_get(cItem, "isFullClass"));
-
-                             c->isOverlap = yyjson_get_bool(yyjson_obj_get(cItem, "IsOvelapTime"));
-                             if (!c->isOverlap && yyjson_obj_get(cItem, "isOvelapTime")) c->isOverlap = yyjson_get_bool(yyjson_obj_get(cItem, "isOvelapTime"));
-
-                             c->subjectId = get_json_int(yyjson_obj_get(cItem, "SubjectId"));
-                             if (c->subjectId == 0) c->subjectId = get_json_int(yyjson_obj_get(cItem, "subjectId"));
-
-
-                             c->credits = get_json_int(yyjson_obj_get(cItem, "NumberOfCredit"));
-                             if (c->credits == 0) c->credits = get_json_int(yyjson_obj_get(cItem, "numberOfCredit"));
-
-                             c->status = safe_strdup(yyjson_get_str(yyjson_obj_get(cItem, "Status")));
-                             if (!c->status) c->status = safe_strdup(yyjson_get_str(yyjson_obj_get(cItem, "status")));
-
-                             yyjson_val *timetables = yyjson_obj_get(cItem, "Timetables");
-                             if (!timetables) timetables = yyjson_obj_get(cItem, "timetables");
-                             if (yyjson_is_arr(timetables)) {
-                                 c->timetablesCount = (int)yyjson_arr_size(timetables);
-                                 c->timetables = (struct TimetableNative*)calloc(c->timetablesCount, sizeof(struct TimetableNative));
-                                 size_t t_idx, t_max;
-                                 yyjson_val *tItem;
-                                 yyjson_arr_foreach(timetables, t_idx, t_max, tItem) {
-                                     struct TimetableNative* t = &c->timetables[t_idx];
-                                     t->id = get_json_int(yyjson_obj_get(tItem, "id"));
-                                     t->startDate = get_json_int64(yyjson_obj_get(tItem, "startDate"));
-                                     t->endDate = get_json_int64(yyjson_obj_get(tItem, "endDate"));
-                                     t->fromWeek = get_json_int(yyjson_obj_get(tItem, "fromWeek"));
-                                     t->toWeek = get_json_int(yyjson_obj_get(tItem, "toWeek"));
-                                     t->dayOfWeek = get_json_int(yyjson_obj_get(tItem, "weekIndex"));
-                                     
-                                     yyjson_val *startH = yyjson_obj_get(tItem, "startHour");
-                                     if (yyjson_is_obj(startH)) {
-                                         t->startHour = get_json_int(yyjson_obj_get(startH, "indexNumber"));
-                                         t->startHourId = get_json_int(yyjson_obj_get(startH, "id"));
-                                     }
-                                     
-                                     yyjson_val *endH = yyjson_obj_get(tItem, "endHour");
-                                     if (yyjson_is_obj(endH)) {
-                                         t->endHour = get_json_int(yyjson_obj_get(endH, "indexNumber"));
-                                         t->endHourId = get_json_int(yyjson_obj_get(endH, "id"));
-                                     }
-                                     
-                                     yyjson_val *roomObj = yyjson_obj_get(tItem, "room");
-                                     if (roomObj && yyjson_is_obj(roomObj)) {
-                                          t->roomId = get_json_int(yyjson_obj_get(roomObj, "id"));
-                                     }
-
-                                     t->roomName = safe_strdup(yyjson_get_str(yyjson_obj_get(tItem, "roomName")));
-                                     t->teacherName = safe_strdup(yyjson_get_str(yyjson_obj_get(tItem, "teacherName")));
-                                 }
-                             }
-                         }
-                     }
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* parse_registration_data_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_registration_data_impl((const char*)data, len, ctx_options(ctx));
+    }
 
-                     if (s->numberOfCredit == 0 && s->courseSubjectsCount > 0) {
-                         s->numberOfCredit = s->courseSubjects[0].credits;
-                     }
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* parse_registration_data_encoded(const uint8_t* body, size_t len, const char* encoding) {
+        return parse_encoded<struct RegistrationResult>(body, len, encoding, parse_registration_data_impl);
+    }
+
+    // --- Registration pages ---
+    // The handle keeps the body and a JsonCursor that has read it only as
+    // far as the subjects asked for so far. Subjects are indexed as byte
+    // spans on the way, passed over with skip_value() so their text stays
+    // as sent, and each is parsed on its own when a page or an expansion
+    // needs it. The first page therefore costs the same whatever follows it.
+
+    struct SubjectSpan {
+        size_t start;
+        size_t end;
+    };
+
+    struct NekkoRegistration {
+        char* buf;                  // padded body, malloc'd; the cursor reads it in place
+        JsonCursor json;
+        bool listing;               // the cursor is inside the subject list
+        bool rootObject;            // results get data, as from parse_registration_data
+        int id;
+        bool pascalId;              // "Id" seen, which "id" does not override
+        yyjson_val message;         // the server's message, when it sent one
+        SubjectSpan* spans;
+        int count;
+        int cap;
+        const char* error;          // static, in errorBuf, or in `buf`
+        char errorBuf[128];
+    };
+
+    static bool key_is(const char* key, size_t len, const char* name) {
+        return strlen(name) == len && memcmp(key, name, len) == 0;
+    }
+
+    // Reads members of the object the cursor is in until the one named
+    // `pascal` or `camel` (returned true, cursor at its value) or the end of
+    // the object (false); with no names, to the end. On the way, root
+    // members update the envelope.
+    static bool registration_find(struct NekkoRegistration* reg, const char* pascal, const char* camel, bool root) {
+        JsonCursor& json = reg->json;
+        const char* key;
+        size_t len;
+        while (json.next_key(&key, &len)) {
+            if (pascal && (key_is(key, len, pascal) || key_is(key, len, camel))) return true;
+            bool pascalId = root && key_is(key, len, "Id");
+            if (pascalId || (root && key_is(key, len, "id") && !reg->pascalId)) {
+                yyjson_val v = {};
+                json.read_value(&v);
+                reg->id = get_json_int(&v);
+                reg->pascalId |= pascalId;
+            } else if (root && key_is(key, len, "message") && !unsafe_yyjson_get_type(&reg->message)) {
+                json.read_value(&reg->message);
+            } else {
+                json.skip_value();
+            }
+        }
+        return false;
+    }
+
+    // After the list: the rest of the envelope, for an id or a message that
+    // comes after it, then whatever error the envelope as a whole carries.
+    static void registration_finish(struct NekkoRegistration* reg) {
+        JsonCursor& json = reg->json;
+        reg->listing = false;
+        registration_find(reg, nullptr, nullptr, false);
+        registration_find(reg, nullptr, nullptr, true);
+        if (json.failed()) {
+            reg->error = "Parse Error";
+        }
+    }
+
+    static void registration_fail(struct NekkoRegistration* reg, const char* error) {
+        reg->listing = false;
+        reg->error = error;
+    }
+
+    // Moves the cursor to the first subject, or settles the error the
+    // envelope carries instead.
+    static void registration_enter(struct NekkoRegistration* reg) {
+        JsonCursor& json = reg->json;
+        yyjson_type type = json.peek();
+        if (!json.enter_object()) {
+            const char* typeStr = "unknown";
+            if (type == YYJSON_TYPE_ARR) typeStr = "array";
+            else if (type == YYJSON_TYPE_STR) typeStr = "string";
+            else if (type == YYJSON_TYPE_NUM) typeStr = "number";
+            else if (type == YYJSON_TYPE_NULL) typeStr = "null";
+            else if (type == YYJSON_TYPE_BOOL) typeStr = "bool";
+            if (type == YYJSON_TYPE_NONE) {
+                reg->error = "Parse Error";
+            } else {
+                snprintf(reg->errorBuf, sizeof(reg->errorBuf), "Not an object (Actual: %s)", typeStr);
+                reg->error = reg->errorBuf;
+            }
+            return;
+        }
+        reg->rootObject = true;
+
+        bool view = registration_find(reg, "CourseRegisterViewObject", "courseRegisterViewObject", true);
+        if (view && json.enter_object()) {
+            if (registration_find(reg, "ListSubjectRegistrationDtos", "listSubjectRegistrationDtos", false)) {
+                // A list that is not an array has no subjects, and no error.
+                if (json.enter_array()) {
+                    reg->listing = true;
+                    return;
                 }
-            } else if (!listSubject) {
-                result->errorMessage = strdup("Missing ListSubjectRegistrationDtos");
+                json.skip_value();
+                registration_find(reg, nullptr, nullptr, false);
+            } else if (!json.failed()) {
+                reg->error = "Missing ListSubjectRegistrationDtos";
             }
+            registration_find(reg, nullptr, nullptr, true);
         } else {
-             yyjson_val* msg = yyjson_obj_get(root, "message");
-             if (msg) {
-                 result->errorMessage = safe_strdup(yyjson_get_str(msg));
-             } else {
-                 result->errorMessage = strdup("Missing CourseRegisterViewObject");
-             }
+            if (view) {
+                json.skip_value();
+                registration_find(reg, nullptr, nullptr, true);
+            }
+            const char* msg = yyjson_get_str(&reg->message);
+            bool message = unsafe_yyjson_get_type(&reg->message) != YYJSON_TYPE_NONE;
+            reg->error = message ? msg : "Missing CourseRegisterViewObject";
+        }
+        if (json.failed()) {
+            // As from parse_registration_data: an error and no data.
+            reg->rootObject = false;
+            reg->error = "Parse Error";
+        }
+    }
+
+    // Indexes subjects until there are `want` of them or the list ends.
+    static void registration_index(struct NekkoRegistration* reg, int want) {
+        JsonCursor& json = reg->json;
+        while (reg->listing && reg->count < want) {
+            if (!json.next_element()) {
+                registration_finish(reg);
+                return;
+            }
+            if (reg->count == reg->cap) {
+                int cap = reg->cap ? reg->cap * 2 : 64;
+                SubjectSpan* grown = (SubjectSpan*)realloc(reg->spans, cap * sizeof(SubjectSpan));
+                if (!grown) return registration_fail(reg, "Out of memory");
+                reg->spans = grown;
+                reg->cap = cap;
+            }
+            size_t start = (size_t)(json.token() - reg->buf);
+            json.skip_value();
+            if (json.failed()) return registration_fail(reg, "Parse Error");
+            reg->spans[reg->count++] = {start, (size_t)(json.token() - reg->buf)};
+        }
+    }
+
+    // Takes over `buf`, also when no handle can be made.
+    static struct NekkoRegistration* registration_open(char* buf, size_t len) {
+        struct NekkoRegistration* reg = (struct NekkoRegistration*)calloc(1, sizeof(struct NekkoRegistration));
+        if (!reg) {
+            free(buf);
+            return nullptr;
+        }
+        reg->buf = buf;
+        new (&reg->json) JsonCursor(buf, len);
+        registration_enter(reg);
+        return reg;
+    }
+
+    // A result for `count` subjects of `reg`; nullptr when out of memory.
+    // It carries the handle's error, if any, and has data wherever
+    // parse_registration_data would.
+    static struct RegistrationResult* registration_result(const struct NekkoRegistration* reg, int count) {
+        struct RegistrationResult* result = new_result<struct RegistrationResult>(
+            0, sizeof(struct RegistrationPeriodNative) + count * sizeof(struct SubjectRegistrationNative));
+        if (!result) return nullptr;
+        if (reg->error) result->errorMessage = nekko_arena_strdup(result->arena, reg->error);
+        if (reg->rootObject) {
+            result->data = arena_array<struct RegistrationPeriodNative>(result->arena, 1);
+            if (result->data) result->data->id = reg->id;
+        }
+        if (result->data && count > 0) {
+            result->data->subjects = arena_array<struct SubjectRegistrationNative>(result->arena, count);
+            if (result->data->subjects) result->data->subjectsCount = count;
         }
-        
-        yyjson_doc_free(doc);
         return result;
     }
 
+    // Parses subject `index` on its own; nullptr if it is not an object.
+    // Spans were validated when indexed, so the parse cannot fail on them.
+    static yyjson_doc* registration_subject_doc(const struct NekkoRegistration* reg, int index, const yyjson_alc* alc) {
+        const SubjectSpan& span = reg->spans[index];
+        yyjson_doc* doc = yyjson_read_opts(reg->buf + span.start, span.end - span.start, 0, alc, nullptr);
+        if (doc && !yyjson_is_obj(yyjson_doc_get_root(doc))) {
+            yyjson_doc_free(doc);
+            return nullptr;
+        }
+        return doc;
+    }
+
+    static char* padded_buffer(const uint8_t* data, size_t len) {
+        char* buf = (char*)malloc(len + YYJSON_PADDING_SIZE);
+        if (!buf) return nullptr;
+        memcpy(buf, data, len);
+        memset(buf + len, 0, YYJSON_PADDING_SIZE);
+        return buf;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoRegistration* nekko_registration_open(const uint8_t* data, size_t len) {
+        if (!data) return nullptr;
+        char* buf = padded_buffer(data, len);
+        return buf ? registration_open(buf, len) : nullptr;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoRegistration* nekko_registration_open_buffer(uint8_t* buf, size_t len) {
+        if (!buf) return nullptr;
+        return registration_open((char*)buf, len);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    const char* nekko_registration_error(const struct NekkoRegistration* reg) {
+        return reg ? reg->error : "Out of memory";
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    int nekko_registration_count(struct NekkoRegistration* reg) {
+        if (!reg) return 0;
+        registration_index(reg, INT_MAX);
+        return reg->count;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* nekko_registration_page(struct NekkoRegistration* reg, int offset, int limit) {
+        if (!reg) return nullptr;
+        if (offset < 0) offset = 0;
+        int want = limit < 0 || limit > INT_MAX - offset ? INT_MAX : offset + limit;
+        registration_index(reg, want);
+        int n = reg->count > offset ? (want < reg->count ? want : reg->count) - offset : 0;
+
+        struct RegistrationResult* result = registration_result(reg, n);
+        if (!result || !result->data || !result->data->subjects) return result;
+        NekkoArena* arena = result->arena;
+        struct RegistrationPeriodNative* period = result->data;
+
+        // Sections are left in the body: only their count, and the first
+        // one's credits for subjects without their own, are read.
+        uint64_t fields[NEKKO_ENTITY_COUNT];
+        for (uint64_t& f : fields) f = NEKKO_FIELDS_ALL;
+        fields[NEKKO_ENTITY_SUBJECT] &= ~(1ull << NEKKO_SUBJECT_FIELD_COURSE_SUBJECTS);
+        fields[NEKKO_ENTITY_COURSE_SUBJECT] = 1ull << NEKKO_COURSE_SUBJECT_FIELD_CREDITS;
+        StringPool pool(arena);
+        DecodeEnv env(arena, StringSink{arena, false, &pool}, fields);
+        // One allocator for the page, so consecutive subjects reuse memory.
+        yyjson_alc* alc = yyjson_alc_dyn_new();
+
+        // No ShapeHint: it keeps keys of the previous subject, whose doc is
+        // gone by then.
+        using SubjectDecoder = Decoder<SubjectRegistrationNative>;
+        for (int i = 0; i < n; i++) {
+            yyjson_doc* doc = registration_subject_doc(reg, offset + i, alc);
+            if (!doc) continue;
+            yyjson_val* obj = yyjson_doc_get_root(doc);
+            struct SubjectRegistrationNative* s = &period->subjects[i];
+            SubjectDecoder::decode(obj, s, env);
+            yyjson_val* sections = ObjFields(SubjectDecoder::kTable, obj)[NEKKO_SUBJECT_FIELD_COURSE_SUBJECTS];
+            s->courseSubjectsCount = yyjson_is_arr(sections) ? (int)yyjson_arr_size(sections) : 0;
+            if (s->numberOfCredit == 0 && s->courseSubjectsCount > 0) {
+                struct CourseSubjectNative first = {};
+                Decoder<CourseSubjectNative>::decode(yyjson_arr_get_first(sections), &first, env);
+                s->numberOfCredit = first.credits;
+            }
+            yyjson_doc_free(doc);
+        }
+        yyjson_alc_dyn_free(alc);
+        return result;
+    }
+
+    // Subjects offset .. offset + n - 1 (all indexed) in full, sections and
+    // timetables included.
+    static struct RegistrationResult* registration_subjects(const struct NekkoRegistration* reg, int offset, int n) {
+        struct RegistrationResult* result = registration_result(reg, n);
+        if (!result || !result->data || !result->data->subjects) return result;
+        NekkoArena* arena = result->arena;
+        StringPool pool(arena);
+        yyjson_alc* alc = yyjson_alc_dyn_new();
+        for (int i = 0; i < n; i++) {
+            yyjson_doc* doc = registration_subject_doc(reg, offset + i, alc);
+            if (!doc) continue;
+            // Per document: its key-order hints point into this one.
+            DecodeEnv env(arena, StringSink{arena, false, &pool});
+            struct SubjectRegistrationNative* s = &result->data->subjects[i];
+            Decoder<SubjectRegistrationNative>::decode(yyjson_doc_get_root(doc), s, env);
+            registration_credits_fallback(s);
+            yyjson_doc_free(doc);
+        }
+        yyjson_alc_dyn_free(alc);
+        return result;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* nekko_registration_subject(struct NekkoRegistration* reg, int index) {
+        if (!reg) return nullptr;
+        if (index >= 0 && index < INT_MAX) registration_index(reg, index + 1);
+        bool inRange = index >= 0 && index < reg->count;
+        return registration_subjects(reg, index, inRange ? 1 : 0);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void nekko_registration_close(struct NekkoRegistration* reg) {
+        if (!reg) return;
+        free(reg->spans);
+        free(reg->buf);
+        free(reg);
+    }
+
+    // --- Batched delivery ---
+    // The course scan and the registration handle, stopping every
+    // `batch_size` records to hand what they have to the caller's callback
+    // as a result of its own.
+
+    constexpr char* CourseNative::* kCourseStrings[] = {
+        &CourseNative::courseCode, &CourseNative::courseName, &CourseNative::classCode,
+        &CourseNative::className, &CourseNative::room, &CourseNative::building, &CourseNative::campus,
+        &CourseNative::lecturerName, &CourseNative::lecturerEmail, &CourseNative::status,
+    };
+
+    // Passes the rows `scan` holds to `fn`, their strings copied out of the
+    // body, and empties it. With an error the rows are dropped instead, as
+    // parse_courses drops them.
+    static void emit_course_batch(CourseScan& scan, const char* error, bool last, nekko_course_batch_fn fn,
+                                  void* user) {
+        size_t n = error ? 0 : scan.rows.size();
+        struct CourseResult* batch = new_result<struct CourseResult>(0, n * sizeof(struct CourseNative));
+        if (batch && error) {
+            batch->errorMessage = nekko_arena_strdup(batch->arena, error);
+        } else if (batch && n > 0) {
+            NekkoArena* arena = batch->arena;
+            batch->courses = arena_array<struct CourseNative>(arena, n);
+            if (batch->courses) {
+                memcpy(batch->courses, scan.rows.data(), n * sizeof(struct CourseNative));
+                batch->count = (int)n;
+                StringPool pool(arena);
+                StringSink strings{arena, false, &pool};
+                for (size_t i = 0; i < n; i++) {
+                    for (char* CourseNative::* field : kCourseStrings) {
+                        batch->courses[i].*field = strings.take(batch->courses[i].*field);
+                    }
+                }
+            }
+        }
+        scan.rows.clear();
+        fn(user, batch, last);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void parse_courses_batched(const uint8_t* data, size_t len, int batch_size, nekko_course_batch_fn fn,
+                               void* user) {
+        if (!fn) return;
+        size_t per = batch_size > 0 ? (size_t)batch_size : 1;
+        char* buf = data ? padded_buffer(data, len) : nullptr;
+        CourseScan scan = {JsonCursor(buf, buf ? len : 0), CourseRows(&kMallocAlc, per + per / 2), {}, {}, {}};
+        if (!buf) {
+            emit_course_batch(scan, data ? "Out of memory" : "Null JSON string", true, fn, user);
+            return;
+        }
+        if (const char* error = enter_course_array(scan)) {
+            emit_course_batch(scan, error, true, fn, user);
+        } else {
+            // A course's rows stay together, so a batch can run over.
+            while (scan.json.next_element() && !scan.rows.oom()) {
+                scan_course_item(scan);
+                if (scan.rows.size() >= per) emit_course_batch(scan, nullptr, false, fn, user);
+            }
+            emit_course_batch(scan, course_scan_error(scan), true, fn, user);
+        }
+        free(buf);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void parse_registration_data_batched(const uint8_t* data, size_t len, int batch_size,
+                                         nekko_registration_batch_fn fn, void* user) {
+        if (!fn) return;
+        int per = batch_size > 0 ? batch_size : 1;
+        struct NekkoRegistration* reg = data ? nekko_registration_open(data, len) : nullptr;
+        if (!reg) {
+            struct RegistrationResult* result = new_result<struct RegistrationResult>(0);
+            if (result) result->errorMessage = nekko_arena_strdup(result->arena, data ? "Out of memory" : "Null JSON");
+            fn(user, result, true);
+            return;
+        }
+        for (int offset = 0;; offset += per) {
+            int end = offset > INT_MAX - per ? INT_MAX : offset + per;
+            // One subject further, to know whether this batch is the last.
+            registration_index(reg, end == INT_MAX ? end : end + 1);
+            bool last = reg->count <= end;
+            int n = (last ? reg->count : end) - offset;
+            fn(user, registration_subjects(reg, offset, n > 0 ? n : 0), last);
+            if (last) break;
+        }
+        nekko_registration_close(reg);
+    }
+
+    // --- Background parses ---
+
+    using ParseJob = void* (*)(uint8_t* buf, size_t len, const char* encoding, NekkoCancel* cancel);
+
+    static ParseJob parse_job_for(int kind) {
+        switch (kind) {
+            case NEKKO_PARSE_COURSES:
+                return [](uint8_t* b, size_t n, const char* e, NekkoCancel* c) -> void* {
+                    return parse_job<struct CourseResult>(b, n, e, c, parse_courses_impl);
+                };
+            case NEKKO_PARSE_COURSE_HOURS:
+                return [](uint8_t* b, size_t n, const char* e, NekkoCancel* c) -> void* {
+                    return parse_job<struct CourseHourResult>(b, n, e, c, parse_course_hours_impl);
+                };
+            case NEKKO_PARSE_SCHOOL_YEARS:
+                return [](uint8_t* b, size_t n, const char* e, NekkoCancel* c) -> void* {
+                    return parse_job<struct SchoolYearResult>(b, n, e, c, parse_school_years_impl);
+                };
+            case NEKKO_PARSE_SEMESTER:
+                return [](uint8_t* b, size_t n, const char* e, NekkoCancel* c) -> void* {
+                    return parse_job<struct SemesterResult>(b, n, e, c, parse_semester_impl);
+                };
+            case NEKKO_PARSE_REGISTRATION:
+                return [](uint8_t* b, size_t n, const char* e, NekkoCancel* c) -> void* {
+                    return parse_job<struct RegistrationResult>(b, n, e, c, parse_registration_data_impl);
+                };
+            default:
+                return nullptr;
+        }
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    bool nekko_submit_parse(int kind, uint8_t* buf, size_t len, const char* encoding, NekkoCancel* cancel,
+                            nekko_parse_done_fn done, void* user) {
+        ParseJob parse = parse_job_for(kind);
+        if (!parse || !done) {
+            free(buf);
+            return false;
+        }
+        bool encoded = encoding != nullptr;
+        bool queued = WorkerPool::shared().submit([=, enc = std::string(encoded ? encoding : "")] {
+            void* result = parse(buf, len, encoded ? enc.c_str() : nullptr, cancel);
+            // Out of memory is the only other way to get no result.
+            int status = !result && cancel_requested(cancel) ? NEKKO_JOB_CANCELLED : NEKKO_JOB_DONE;
+            done(user, kind, status, result);
+        });
+        if (!queued) free(buf);
+        return queued;
+    }
+
     // Legacy test function
     __attribute__((visibility("default"))) __attribute__((used))
     int parse_json_test(const char* json_str) {
@@ -1499,144 +2482,473 @@ extern "C" {
     }
 
 
-    struct RegistrationActionResult {
-        int status;
-        char* message;
-    };
-
     __attribute__((visibility("default"))) __attribute__((used))
     void free_registration_action_result(struct RegistrationActionResult* result) {
         if (!result) return;
-        free(result->message);
-        free(result);
+        nekko_arena_release(result->arena);
     }
 
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct RegistrationActionResult* parse_registration_action(const char* json_str) {
-        struct RegistrationActionResult* result = (struct RegistrationActionResult*)calloc(1, sizeof(struct RegistrationActionResult));
+    static struct RegistrationActionResult* parse_registration_action_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct RegistrationActionResult* result = new_result<struct RegistrationActionResult>(json_len);
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringSink strings = {arena, opt.borrow};
+        CtxCall ctxCall(opt.ctx);
         if (!json_str) { return result; }
         
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
         if (!doc) { return result; }
         
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!root || !yyjson_is_obj(root)) { yyjson_doc_free(doc); return result; }
 
-        result->status = get_json_int(yyjson_obj_get(root, "status"));
-        if (result->status == 0) result->status = get_json_int(yyjson_obj_get(root, "Status"));
-
-        yyjson_val* msg = yyjson_obj_get(root, "message");
-        if (!msg) msg = yyjson_obj_get(root, "Message");
-        if (msg) result->message = safe_strdup(yyjson_get_str(msg));
+        DecodeEnv env(arena, strings);
+        Decoder<RegistrationActionResult>::decode(root, result, env);
 
         yyjson_doc_free(doc);
-        return result;
+        return unless_cancelled(result, opt);
     }
 
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationActionResult* parse_registration_action(const char* json_str) {
+        return parse_registration_action_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
 
-    // --- Student Mark Structs ---
-    struct StudentMarkNative {
-        char* subjectCode;
-        char* subjectName;
-        int numberOfCredit;
-        double mark;            // tongkethocphan
-        double markQT;          // diemquatrinh
-        double markTHI;         // diemthi
-        char* charMark;         // diemchu
-        int studyTime;          // lanhoc
-        int examRound;          // lanthi
-        bool isCalculateMark;   // tinhdiem
-        char* semesterCode;
-        char* semesterName;
-        int semesterId;         // New field for sorting
-    };
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationActionResult* parse_registration_action_bytes(const uint8_t* data, size_t len) {
+        return parse_registration_action_impl((const char*)data, len, ParseOptions{});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationActionResult* parse_registration_action_borrowed(uint8_t* data, size_t len) {
+        return parse_registration_action_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationActionResult* parse_registration_action_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_registration_action_impl((const char*)data, len, ctx_options(ctx));
+    }
 
-    struct StudentMarkResult {
-        int count;
-        struct StudentMarkNative* marks;
-        char* errorMessage;
-    };
 
     // --- Exported Helper for Freeing StudentMarkResult ---
     __attribute__((visibility("default"))) __attribute__((used))
     void free_student_mark_result(struct StudentMarkResult* result) {
         if (!result) return;
-        if (result->marks) {
-            // Strings allocated via safe_strdup MUST be freed
-            for (int i = 0; i < result->count; ++i) {
-                struct StudentMarkNative* m = &result->marks[i];
-                free(m->subjectCode);
-                free(m->subjectName);
-                free(m->charMark);
-                free(m->semesterCode);
-                free(m->semesterName);
-            }
-            free(result->marks);
-        }
-        free(result->errorMessage);
-        free(result);
+        nekko_arena_release(result->arena);
     }
 
     // --- Parser for Student Marks ---
-    __attribute__((visibility("default"))) __attribute__((used))
-    struct StudentMarkResult* parse_student_marks(const char* json_str) {
-        struct StudentMarkResult* result = (struct StudentMarkResult*)calloc(1, sizeof(struct StudentMarkResult));
+    static struct StudentMarkResult* parse_student_marks_impl(const char* json_str, size_t json_len, const ParseOptions& opt) {
+        struct StudentMarkResult* result = new_result<struct StudentMarkResult>(json_len, local_pool_bytes(json_len, opt));
+        NekkoArena* arena = result->arena;
+        result->stringsBorrowed = opt.borrow;
+        StringPool pool(arena, json_len);
+        StringSink strings = call_strings(arena, opt, pool);
+        CtxCall ctxCall(opt.ctx);
         if (!json_str) {
-            result->errorMessage = strdup("Null JSON string");
+            result->errorMessage = nekko_arena_strdup(arena, "Null JSON string");
             return result;
         }
 
-        yyjson_doc *doc = yyjson_read(json_str, strlen(json_str), 0);
+        yyjson_doc *doc = read_json(json_str, json_len, 0, opt);
         if (!doc) {
-            result->errorMessage = strdup("Failed to parse JSON");
+            result->errorMessage = nekko_arena_strdup(arena, "Failed to parse JSON");
             return result;
         }
 
         yyjson_val *root = yyjson_doc_get_root(doc);
         if (!yyjson_is_arr(root)) {
-             result->errorMessage = strdup("Root is not an array");
+             result->errorMessage = nekko_arena_strdup(arena, "Root is not an array");
              yyjson_doc_free(doc);
              return result;
         }
 
-        result->count = (int)yyjson_arr_size(root);
-        result->marks = (struct StudentMarkNative*)calloc(result->count, sizeof(struct StudentMarkNative));
+        DecodeEnv env(arena, strings, nekko_ctx_fields(opt.ctx), opt.cancel);
+        result->marks = Decoder<StudentMarkNative>::decode_array(root, &result->count, env);
 
-        size_t idx, max;
-        yyjson_val *item;
-        yyjson_arr_foreach(root, idx, max, item) {
-                struct StudentMarkNative* mark = &result->marks[idx];
+        yyjson_doc_free(doc);
+        return unless_cancelled(result, opt);
+    }
 
-                mark->mark = yyjson_get_num(yyjson_obj_get(item, "mark"));
-                mark->markQT = yyjson_get_num(yyjson_obj_get(item, "markQT"));
-                mark->markTHI = yyjson_get_num(yyjson_obj_get(item, "markTHI"));
-                
-                mark->charMark = safe_strdup(yyjson_get_str(yyjson_obj_get(item, "charMark")));
-                mark->studyTime = get_json_int(yyjson_obj_get(item, "studyTime"));
-                mark->examRound = get_json_int(yyjson_obj_get(item, "examRound"));
-
-                yyjson_val *subject = yyjson_obj_get(item, "subject");
-                if (subject) {
-                    mark->subjectCode = safe_strdup(yyjson_get_str(yyjson_obj_get(subject, "subjectCode")));
-                    mark->subjectName = safe_strdup(yyjson_get_str(yyjson_obj_get(subject, "subjectName")));
-                    mark->numberOfCredit = get_json_int(yyjson_obj_get(subject, "numberOfCredit"));
-                    mark->isCalculateMark = yyjson_get_bool(yyjson_obj_get(subject, "isCalculateMark"));
-                }
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct StudentMarkResult* parse_student_marks(const char* json_str) {
+        return parse_student_marks_impl(json_str, json_str ? strlen(json_str) : 0, ParseOptions{});
+    }
 
-                yyjson_val *semester = yyjson_obj_get(item, "semester");
-                if (semester) {
-                    mark->semesterCode = safe_strdup(yyjson_get_str(yyjson_obj_get(semester, "semesterCode")));
-                    mark->semesterName = safe_strdup(yyjson_get_str(yyjson_obj_get(semester, "semesterName")));
-                    mark->semesterId = get_json_int(yyjson_obj_get(semester, "id"));
-                }
-        }
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct StudentMarkResult* parse_student_marks_bytes(const uint8_t* data, size_t len) {
+        return parse_student_marks_impl((const char*)data, len, ParseOptions{});
+    }
 
-        yyjson_doc_free(doc);
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct StudentMarkResult* parse_student_marks_borrowed(uint8_t* data, size_t len) {
+        return parse_student_marks_impl((const char*)data, len, ParseOptions{true, nullptr});
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct StudentMarkResult* parse_student_marks_ctx(nekko_ctx* ctx, uint8_t* data, size_t len) {
+        return parse_student_marks_impl((const char*)data, len, ctx_options(ctx));
+    }
+
+    // --- Chunked Parsing ---
+    // parse_x_begin / parse_x_feed / parse_x_finish take a body as it comes
+    // off the network. With the length known up front the body lands in a
+    // buffer in the result's arena and is parsed as far as it has arrived on
+    // each feed: yyjson's incremental reader for the DOM parsers, whole
+    // course items for the cursor. Strings then point into that buffer and
+    // finish only has to read the tail. Without a length the chunks are just
+    // collected and parsed at finish like parse_x_bytes.
+
+    enum class StreamKind { Courses, ExamRooms, Registration };
+
+    // A parse step runs once this much has arrived since the last one. Both
+    // readers restart the value that was cut off, so smaller steps mostly
+    // redo work.
+    constexpr size_t kStreamStep = 16 * 1024;
+
+    enum class CourseStreamState { Root, Items, Done };
+
+    struct NekkoStream {
+        StreamKind kind;
+        size_t declared;        // 0: unknown, `buf` is malloc'd and grows
+        char* buf;              // declared: in the result's arena
+        size_t cap;             // unknown length only
+        size_t len;             // bytes received
+        size_t stepped;         // `len` at the last parse step
+        bool tooLong;
+
+        void* result;           // declared only, until finish hands it over
+        NekkoArena* arena;
+
+        // Exam rooms, registration
+        yyjson_incr_state* incr;
+        yyjson_read_flag flags;
+        yyjson_doc* doc;
+        bool incrFailed;
+
+        // Courses
+        CourseScan* scan;
+        CourseStreamState scanState;
+    };
+
+    static NekkoStream* stream_new(StreamKind kind, size_t len) {
+        NekkoStream* s = new (std::nothrow) NekkoStream{};
+        if (!s) return nullptr;
+        s->kind = kind;
+        s->declared = len;
+        return s;
+    }
+
+    static void stream_free(NekkoStream* s) {
+        if (s->incr) yyjson_incr_free(s->incr);
+        if (s->doc) yyjson_doc_free(s->doc);
+        delete s->scan;
+        if (!s->declared) free(s->buf);
+        if (s->result) nekko_arena_release(s->arena);
+        delete s;
+    }
+
+    // For a declared length: the result being built (from new_result,
+    // sized for the body) and the body buffer in its arena.
+    static bool stream_adopt(NekkoStream* s, void* result, NekkoArena* arena) {
+        s->result = result;
+        s->arena = arena;
+        s->buf = (char*)nekko_arena_alloc(arena, s->declared + YYJSON_PADDING_SIZE);
+        return s->buf != nullptr;
+    }
+
+    // Hands the result over to the caller and frees the rest.
+    static void* stream_take(NekkoStream* s) {
+        void* result = s->result;
+        s->result = nullptr;
+        stream_free(s);
         return result;
     }
 
+    static bool stream_append(NekkoStream* s, const uint8_t* data, size_t len) {
+        if (s->tooLong) return false;
+        if (s->declared) {
+            if (len > s->declared - s->len) {
+                // What was parsed insitu cannot be parsed again, so there
+                // is no falling back to a bigger buffer.
+                s->tooLong = true;
+                return false;
+            }
+        } else if (len > s->cap - s->len) {
+            size_t cap = s->cap ? s->cap * 2 : kStreamStep;
+            if (cap < s->len + len) cap = s->len + len;
+            char* grown = (char*)realloc(s->buf, cap + YYJSON_PADDING_SIZE);
+            if (!grown) return false;
+            s->buf = grown;
+            s->cap = cap;
+        }
+        if (len) memcpy(s->buf + s->len, data, len);
+        s->len += len;
+        return true;
+    }
+
+    static bool stream_step_due(const NekkoStream* s) {
+        return s->declared && s->len && (s->len - s->stepped >= kStreamStep || s->len == s->declared);
+    }
+
+    // Unknown length: the body is complete and gets its padding now.
+    static char* stream_body(NekkoStream* s) {
+        if (!s->buf) return (char*)"";
+        memset(s->buf + s->len, 0, YYJSON_PADDING_SIZE);
+        return s->buf;
+    }
+
+    // The DOM parsers: feed the incremental reader whatever has arrived.
+    static NekkoStream* dom_stream_begin(NekkoStream* s, yyjson_read_flag flags) {
+        s->flags = flags;
+        s->incr = yyjson_incr_new(s->buf, s->declared, flags | YYJSON_READ_INSITU, NULL);
+        if (s->incr) return s;
+        stream_free(s);
+        return nullptr;
+    }
+
+    static void dom_stream_step(NekkoStream* s) {
+        if (s->doc || s->incrFailed) return;
+        yyjson_read_err err;
+        s->doc = yyjson_incr_read(s->incr, s->len, &err);
+        s->stepped = s->len;
+        if (!s->doc && err.code != YYJSON_READ_ERROR_MORE) s->incrFailed = true;
+    }
+
+    static bool dom_stream_feed(NekkoStream* s, const uint8_t* data, size_t len) {
+        if (!stream_append(s, data, len)) return false;
+        if (stream_step_due(s)) dom_stream_step(s);
+        return !s->incrFailed;
+    }
+
+    // The error for a body the reader could not finish, or nullptr.
+    static const char* dom_stream_end(NekkoStream* s, const char* parseError) {
+        if (s->tooLong) return "Body longer than declared length";
+        if (!s->doc && s->len && s->stepped != s->len) dom_stream_step(s);
+        if (!s->doc) return s->len < s->declared && !s->incrFailed ? "Body shorter than declared length" : parseError;
+        if (!(s->flags & YYJSON_READ_STOP_WHEN_DONE)) {
+            // The reader hands the document over as soon as the root closes,
+            // so whatever arrived after it is checked here.
+            for (size_t i = yyjson_doc_get_read_size(s->doc); i < s->len; i++) {
+                char c = s->buf[i];
+                if (c != ' ' && c != '\n' && c != '\r' && c != '\t') return parseError;
+            }
+        }
+        return nullptr;
+    }
+
+    // Courses: scan each item once all of it has arrived. Items are probed
+    // with skip_value() first, as scanning writes into the buffer and cannot
+    // be undone when the item turns out to be cut off.
+    static void course_stream_step(NekkoStream* s) {
+        CourseScan& scan = *s->scan;
+        JsonCursor& json = scan.json;
+        const char* end = s->buf + s->len;
+        memset(s->buf + s->len, 0, YYJSON_PADDING_SIZE);
+        s->stepped = s->len;
+        if (s->scanState == CourseStreamState::Root) {
+            // Anything but an array is left for finish to report.
+            if (!json.enter_array()) return;
+            s->scanState = CourseStreamState::Items;
+        }
+        while (s->scanState == CourseStreamState::Items) {
+            JsonCursor::Mark before = json.mark();
+            if (!json.next_element()) {
+                if (json.failed()) json.rewind(before);     // no comma or bracket yet
+                else s->scanState = CourseStreamState::Done;
+                return;
+            }
+            JsonCursor::Mark item = json.mark();
+            json.skip_value();
+            // The byte after the item has to be in too: a number or a
+            // literal at the very end could still grow.
+            if (json.failed() || json.token() == end) {
+                json.rewind(before);
+                return;
+            }
+            json.rewind(item);
+            scan_course_item(scan);
+            if (json.failed() || scan.rows.oom()) s->scanState = CourseStreamState::Done;
+        }
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoStream* parse_courses_begin(size_t len) {
+        NekkoStream* s = stream_new(StreamKind::Courses, len);
+        if (!s || !len) return s;
+        struct CourseResult* result = new_result<struct CourseResult>(len, len + YYJSON_PADDING_SIZE);
+        if (result && stream_adopt(s, result, result->arena)) {
+            memset(s->buf, 0, YYJSON_PADDING_SIZE);
+            s->scan = new (std::nothrow) CourseScan{JsonCursor(s->buf, len), CourseRows(&kMallocAlc, len / kCourseRowBytes + 1), {}, {}, {}};
+            if (s->scan) return s;
+        }
+        stream_free(s);
+        return nullptr;
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    bool parse_courses_feed(struct NekkoStream* s, const uint8_t* data, size_t len) {
+        if (!s || s->kind != StreamKind::Courses || !stream_append(s, data, len)) return false;
+        if (stream_step_due(s)) course_stream_step(s);
+        return !s->scan || !s->scan->rows.oom();
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct CourseResult* parse_courses_finish(struct NekkoStream* s) {
+        if (!s || s->kind != StreamKind::Courses) return nullptr;
+        if (!s->declared) {
+            struct CourseResult* result = parse_courses_impl(stream_body(s), s->len, ParseOptions{});
+            stream_free(s);
+            return result;
+        }
+
+        struct CourseResult* result = (struct CourseResult*)s->result;
+        CourseScan& scan = *s->scan;
+        if (s->tooLong) {
+            result->errorMessage = nekko_arena_strdup(result->arena, "Body longer than declared length");
+            return (struct CourseResult*)stream_take(s);
+        }
+        memset(s->buf + s->len, 0, YYJSON_PADDING_SIZE);
+        if (s->scanState == CourseStreamState::Root) {
+            if (const char* error = enter_course_array(scan)) {
+                result->errorMessage = nekko_arena_strdup(result->arena, error);
+                return (struct CourseResult*)stream_take(s);
+            }
+        }
+        if (s->scanState != CourseStreamState::Done) scan_course_items(scan);
+        if (scan.json.failed() && s->len < s->declared) {
+            result->errorMessage = nekko_arena_strdup(result->arena, "Body shorter than declared length");
+        } else {
+            finish_course_scan(result, scan);
+        }
+        return (struct CourseResult*)stream_take(s);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoStream* parse_exam_rooms_begin(size_t len) {
+        NekkoStream* s = stream_new(StreamKind::ExamRooms, len);
+        if (!s || !len) return s;
+        struct ExamRoomResult* result = new_result<struct ExamRoomResult>(len, len + YYJSON_PADDING_SIZE);
+        if (!result || !stream_adopt(s, result, result->arena)) {
+            stream_free(s);
+            return nullptr;
+        }
+        return dom_stream_begin(s, 0);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    bool parse_exam_rooms_feed(struct NekkoStream* s, const uint8_t* data, size_t len) {
+        if (!s || s->kind != StreamKind::ExamRooms) return false;
+        return dom_stream_feed(s, data, len);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct ExamRoomResult* parse_exam_rooms_finish(struct NekkoStream* s) {
+        if (!s || s->kind != StreamKind::ExamRooms) return nullptr;
+        if (!s->declared) {
+            struct ExamRoomResult* result = parse_exam_rooms_impl(stream_body(s), s->len, ParseOptions{});
+            stream_free(s);
+            return result;
+        }
+
+        struct ExamRoomResult* result = (struct ExamRoomResult*)s->result;
+        if (const char* error = dom_stream_end(s, "Failed to parse JSON")) {
+            result->errorMessage = nekko_arena_strdup(result->arena, error);
+        } else {
+            // The body lives in the result's arena: nothing to copy.
+            build_exam_rooms(result, s->doc, StringSink{result->arena, true}, NEKKO_FIELDS_ALL);
+        }
+        return (struct ExamRoomResult*)stream_take(s);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoStream* parse_registration_data_begin(size_t len) {
+        NekkoStream* s = stream_new(StreamKind::Registration, len);
+        if (!s || !len) return s;
+        struct RegistrationResult* result = new_result<struct RegistrationResult>(len, len + YYJSON_PADDING_SIZE);
+        if (!result || !stream_adopt(s, result, result->arena)) {
+            stream_free(s);
+            return nullptr;
+        }
+        return dom_stream_begin(s, YYJSON_READ_STOP_WHEN_DONE);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    bool parse_registration_data_feed(struct NekkoStream* s, const uint8_t* data, size_t len) {
+        if (!s || s->kind != StreamKind::Registration) return false;
+        return dom_stream_feed(s, data, len);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct RegistrationResult* parse_registration_data_finish(struct NekkoStream* s) {
+        if (!s || s->kind != StreamKind::Registration) return nullptr;
+        if (!s->declared) {
+            struct RegistrationResult* result = parse_registration_data_impl(stream_body(s), s->len, ParseOptions{});
+            stream_free(s);
+            return result;
+        }
+
+        struct RegistrationResult* result = (struct RegistrationResult*)s->result;
+        if (const char* error = dom_stream_end(s, "Parse Error")) {
+            result->errorMessage = nekko_arena_strdup(result->arena, error);
+        } else {
+            // The body lives in the result's arena: nothing to copy.
+            build_registration_data(result, s->doc, StringSink{result->arena, true}, nullptr);
+        }
+        return (struct RegistrationResult*)stream_take(s);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void nekko_stream_cancel(struct NekkoStream* s) {
+        if (s) stream_free(s);
+    }
+
+    // --- Flat Results ---
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoBlob* parse_exam_schedules_flat(uint8_t* data, size_t len) {
+        return parse_flat<struct ExamScheduleResult, FlatExamSchedules>(
+                data, len, NEKKO_BLOB_EXAM_SCHEDULES, parse_exam_schedules_impl);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoBlob* parse_school_years_flat(uint8_t* data, size_t len) {
+        return parse_flat<struct SchoolYearResult, FlatSchoolYears>(
+                data, len, NEKKO_BLOB_SCHOOL_YEARS, parse_school_years_impl);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    struct NekkoBlob* parse_registration_data_flat(uint8_t* data, size_t len) {
+        return parse_flat<struct RegistrationResult, FlatRegistration>(
+                data, len, NEKKO_BLOB_REGISTRATION, parse_registration_data_impl);
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    bool nekko_blob_relocate(struct NekkoBlob* blob, size_t len) {
+        if (!blob || len < sizeof(NekkoBlob)) return false;
+        if (blob->magic != NEKKO_BLOB_MAGIC || blob->version != NEKKO_BLOB_VERSION ||
+            blob->pointerSize != sizeof(void*) || blob->size > len) {
+            return false;
+        }
+        switch (blob->kind) {
+            case NEKKO_BLOB_EXAM_SCHEDULES:
+                return blob_relocate<struct ExamScheduleResult, FlatExamSchedules>(blob);
+            case NEKKO_BLOB_SCHOOL_YEARS:
+                return blob_relocate<struct SchoolYearResult, FlatSchoolYears>(blob);
+            case NEKKO_BLOB_REGISTRATION:
+                return blob_relocate<struct RegistrationResult, FlatRegistration>(blob);
+            default:
+                return false;
+        }
+    }
+
+    __attribute__((visibility("default"))) __attribute__((used))
+    void nekko_blob_free(struct NekkoBlob* blob) {
+        free(blob);
+    }
+
 }
 
+#ifdef __ANDROID__
 extern "C" JNIEXPORT jstring JNICALL
 Java_com_nekkochan_tlucalendar_MainActivity_stringFromJNI(
         JNIEnv* env,
@@ -1644,3 +2956,4 @@ Java_com_nekkochan_tlucalendar_MainActivity_stringFromJNI(
     std::string hello = "Hello from C++ with yyjson " YYJSON_VERSION_STRING;
     return env->NewStringUTF(hello.c_str());
 }
+#endif
@@ -0,0 +1,997 @@
+// Shared FFI layout for nekkoFramework.
+// Every struct here is mirrored field-by-field in lib/core/native/native_parser.dart,
+// so any change must be made on both sides.
+//
+// Each *Result owns a NekkoArena (arena.h) holding the result and everything it
+// points to. Dart treats `arena` as opaque; free_*_result releases it in one go.
+//
+// `stringsBorrowed` is set when the result's strings point into the caller's
+// input buffer (parse_*_borrowed, parse_courses_bytes, and parse_*_ctx with
+// NEKKO_CTX_BORROW_STRINGS). That buffer must then stay alive, unmodified,
+// until free_*_result; it may be released right after the call otherwise. Error messages are always owned by the result.
+#ifndef NEKKO_NATIVE_LIB_H
+#define NEKKO_NATIVE_LIB_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+struct NekkoArena;
+struct nekko_ctx;
+struct NekkoStream;
+struct NekkoDoc;
+struct NekkoRegistration;
+
+extern "C" {
+
+    // --- Data Structures ---
+    
+    struct BookingStatusNative {
+        int id;
+        char* name;
+    };
+
+    struct ExamPeriodNative {
+        int id;
+        char* examPeriodCode;
+        char* name;
+        long long startDate;
+        long long endDate;
+        int numberOfExamDays;
+        struct BookingStatusNative bookingStatus;
+    };
+
+    struct ExamScheduleNative {
+        int id;
+        char* name;
+        int displayOrder;
+        bool voided;
+        int examPeriodsCount;
+        struct ExamPeriodNative* examPeriods; // Array
+    };
+
+    // Result container to easily pass array back
+    struct ExamScheduleResult {
+        int count;
+        struct ExamScheduleNative* schedules; // Array
+        char* errorMessage; // Null if success
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- Notification Structs ---
+    struct NotificationNative {
+        long long triggerTime;
+        char* title;
+        char* body;
+        int id; // Unique ID for notification
+    };
+
+    struct NotificationResult {
+        int count;
+        struct NotificationNative* notifications;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- ExamRoom Structs ---
+    struct ExamRoomNative {
+        int id;
+        char* subjectName;
+        char* examPeriodCode;
+        char* examCode;
+        char* studentCode;
+        long long examDate; // Milliseconds
+        char* examTime;
+        char* roomName;
+        char* roomBuilding;
+        char* examMethod;
+        char* notes;
+        int numberExpectedStudent;
+        int source;     // parse_exam_rooms_batch: index of the input it came from; else 0
+        unsigned long long sources;     // parse_exam_rooms_batch: bit i set for each input i listing it
+    };
+
+    struct ExamRoomResult {
+        int count;
+        struct ExamRoomNative* rooms;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- Course Structs ---
+    struct CourseNative {
+        int id;
+        char* courseCode;
+        char* courseName;
+        char* classCode;
+        char* className;
+        int dayOfWeek;
+        int startCourseHour;
+        int endCourseHour;
+        char* room;
+        char* building;
+        char* campus;
+        int credits;
+        long long startDate;
+        long long endDate;
+        int fromWeek;
+        int toWeek;
+        char* lecturerName;
+        char* lecturerEmail;
+        char* status;
+        double grade; // nullable in Dart, 0 or -1 if null? Using -1.0 as sentinel or strict?
+        bool hasGrade;
+    };
+
+    struct CourseResult {
+        int count;
+        struct CourseNative* courses;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // Columnar courses (parse_courses_columns): the rows of a CourseResult
+    // as one contiguous array per field, `count` entries each, so Dart can
+    // map a column with asTypedList instead of reading rows field by field.
+    // String field k of row i is stringLengths[k * count + i] bytes at
+    // strings + stringOffsets[k * count + i], NUL-terminated; a length of -1
+    // is null. Consecutive rows of one course share their strings.
+    //
+    // From parse_courses_columns_utf16 the strings are UTF-16 instead, the
+    // code units Dart strings are made of: `strings` is null and
+    // `strings16` holds them, with offsets, lengths and stringsSize counted
+    // in code units and no terminators.
+    enum CourseStringColumn {
+        NEKKO_COURSE_CODE,
+        NEKKO_COURSE_NAME,
+        NEKKO_COURSE_CLASS_CODE,
+        NEKKO_COURSE_CLASS_NAME,
+        NEKKO_COURSE_ROOM,
+        NEKKO_COURSE_BUILDING,
+        NEKKO_COURSE_CAMPUS,
+        NEKKO_COURSE_LECTURER_NAME,
+        NEKKO_COURSE_LECTURER_EMAIL,
+        NEKKO_COURSE_STATUS,
+        NEKKO_COURSE_STRING_COLUMNS
+    };
+
+    struct CourseColumnsResult {
+        int count;
+        int32_t* id;
+        int32_t* dayOfWeek;
+        int32_t* startCourseHour;
+        int32_t* endCourseHour;
+        int32_t* credits;
+        int32_t* fromWeek;
+        int32_t* toWeek;
+        int64_t* startDate;
+        int64_t* endDate;
+        double* grade;
+        uint8_t* hasGrade;
+        uint32_t* stringOffsets;    // NEKKO_COURSE_STRING_COLUMNS * count
+        int32_t* stringLengths;     // NEKKO_COURSE_STRING_COLUMNS * count
+        char* strings;
+        uint16_t* strings16;
+        size_t stringsSize;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- CourseHour ---
+    struct CourseHourNative {
+        int id;
+        char* name;
+        char* startString;
+        char* endString;
+        int indexNumber;
+    };
+    
+    struct CourseHourResult {
+        int count;
+        struct CourseHourNative* hours;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+    
+    // --- Register Period ---
+    struct SemesterRegisterPeriodNative {
+        int id;
+        char* name;
+        long long startRegisterTime;
+        long long endRegisterTime;
+        long long endUnRegisterTime;
+        // String fallbacks
+        char* startRegisterTimeString;
+        char* endRegisterTimeString;
+        char* endUnRegisterTimeString;
+    };
+
+    // --- Semester ---
+    struct SemesterNative {
+        int id;
+        char* semesterCode;
+        char* semesterName;
+        long long startDate;
+        long long endDate;
+        bool isCurrent;
+        int ordinalNumbers;
+        int registerPeriodsCount; // NEW
+        struct SemesterRegisterPeriodNative* registerPeriods; // NEW
+    };
+    
+    // --- SchoolYear ---
+    struct SchoolYearNative {
+        int id;
+        char* name;
+        char* code;
+        int year;
+        bool current;
+        long long startDate;
+        long long endDate;
+        char* displayName;
+        int semestersCount;
+        struct SemesterNative* semesters;
+    };
+    
+    struct SchoolYearResult {
+        int count;
+        struct SchoolYearNative* years;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    struct SemesterResult {
+        struct SemesterNative* semester; // Single object check
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+    
+    // --- User ---
+    struct UserNative {
+        char* studentId; // username
+        char* fullName; // displayName
+        char* email;
+        int id;
+    };
+    
+    struct UserResult {
+         struct UserNative* user;
+         char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- Registration Data ---
+    struct TimetableNative {
+        int id;
+        long long startDate;
+        long long endDate;
+        int fromWeek;
+        int toWeek;
+        int dayOfWeek;
+        int startHour;
+        int endHour;
+        char* roomName;
+        char* teacherName;
+        int roomId; // Added
+        int startHourId; // Added
+        int endHourId; // Added
+    };
+
+    struct CourseSubjectNative {
+        int id;
+        char* code;
+        char* name;
+        char* displayCode;
+        int numberStudent;
+        int maxStudent;
+        int numberRegisted; // numberStudent usually
+        bool isSelected;
+        bool isFull;
+        bool isOverlap;
+        int timetablesCount;
+        struct TimetableNative* timetables;
+        int credits;
+        char* status; // "new", "full", etc.
+        int subjectId; // Added
+    };
+
+    struct SubjectRegistrationNative {
+        char* subjectName;
+        int numberOfCredit;
+        int courseSubjectsCount;
+        struct CourseSubjectNative* courseSubjects;
+    };
+
+    struct RegistrationPeriodNative {
+        int id;
+        int subjectsCount;
+        struct SubjectRegistrationNative* subjects;
+    };
+
+    struct RegistrationResult {
+        struct RegistrationPeriodNative* data;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- Flat results ---
+    // One allocation holding a whole result (see flat_blob.h). The root
+    // *Result sits at `root` bytes from the header; its pointers, and all
+    // below it, are valid while the blob lives at address `base`.
+    #define NEKKO_BLOB_MAGIC 0x31424B4Eu    // "NKB1"
+    #define NEKKO_BLOB_VERSION 1
+
+    enum NekkoBlobKind {
+        NEKKO_BLOB_EXAM_SCHEDULES = 1,      // root: ExamScheduleResult
+        NEKKO_BLOB_SCHOOL_YEARS = 2,        // root: SchoolYearResult
+        NEKKO_BLOB_REGISTRATION = 3,        // root: RegistrationResult
+    };
+
+    struct NekkoBlob {
+        uint32_t magic;
+        uint16_t version;
+        uint8_t kind;               // NekkoBlobKind
+        uint8_t pointerSize;        // of the process that wrote it
+        uint64_t size;              // whole blob, header included
+        uint64_t base;
+        uint64_t root;
+    };
+
+    // --- Token ---
+    struct TokenResponseNative {
+        char* access_token;
+        char* token_type;
+        char* refresh_token;
+        char* scope;
+        int expires_in;
+    };
+    
+    struct TokenResponseResult {
+        struct TokenResponseNative* token;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    struct RegistrationActionResult {
+        int status;
+        char* message;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- Student Mark Structs ---
+    struct StudentMarkNative {
+        char* subjectCode;
+        char* subjectName;
+        int numberOfCredit;
+        double mark;            // tongkethocphan
+        double markQT;          // diemquatrinh
+        double markTHI;         // diemthi
+        char* charMark;         // diemchu
+        int studyTime;          // lanhoc
+        int examRound;          // lanthi
+        bool isCalculateMark;   // tinhdiem
+        char* semesterCode;
+        char* semesterName;
+        int semesterId;         // New field for sorting
+    };
+
+    struct StudentMarkResult {
+        int count;
+        struct StudentMarkNative* marks;
+        char* errorMessage;
+        struct NekkoArena* arena;
+        bool stringsBorrowed;
+    };
+
+    // --- Exported Functions ---
+    // Each parser has two entry points: `parse_x(json_str)` takes a
+    // NUL-terminated string, `parse_x_bytes(data, len)` takes `len` bytes with
+    // no terminator. Buffers passed to parse_courses_bytes,
+    // generate_notifications_bytes and every `parse_x_borrowed(data, len)`
+    // must come from nekko_alloc_buffer (or carry YYJSON_PADDING_SIZE writable
+    // bytes after `len`): they are parsed insitu. The _borrowed variants are
+    // the opt-in zero-copy mode: no string is copied, see stringsBorrowed.
+    //
+    // `parse_x_ctx(ctx, data, len)` behaves like parse_x_bytes but reads the
+    // DOM through a reusable nekko_ctx, so repeated calls stop allocating once
+    // the context has seen a payload of that size. With
+    // NEKKO_CTX_BORROW_STRINGS set it behaves like parse_x_borrowed instead,
+    // and `data` must be padded as above. A context may be used by one thread
+    // at a time; separate contexts are independent and can run concurrently.
+    //
+    // Strings a parser copies are interned: a value repeated through the
+    // payload is stored once and every field holding it gets the same
+    // pointer. With NEKKO_CTX_INTERN_STRINGS (which overrides
+    // NEKKO_CTX_BORROW_STRINGS) the pool belongs to the context instead of
+    // the result, so consecutive calls share it: the strings then live until
+    // nekko_ctx_clear_strings or nekko_ctx_destroy, not free_x_result. Every
+    // interned string is preceded by a uint32 id, 4-aligned, counting the
+    // pool's strings from 0; in a context's pool the same string keeps its id
+    // until the pool is cleared. Courses and notifications are not interned,
+    // nor are user, token and registration-action strings, which are copied
+    // (or borrowed) as before and carry no id.
+    //
+    // NEKKO_CTX_PARALLEL lets a parser on the context spread one large
+    // payload over a small pool of native threads shared by the library
+    // (currently the subjects of parse_registration_data_ctx). The result is
+    // the same as without it, interned ids included; the call still returns
+    // only when it is complete, and still uses the context from one thread.
+    const char* get_yyjson_version();
+
+    uint8_t* nekko_alloc_buffer(size_t len);
+    void nekko_free_buffer(uint8_t* buf);
+
+    enum {
+        NEKKO_CTX_BORROW_STRINGS = 1 << 0,
+        NEKKO_CTX_INTERN_STRINGS = 1 << 1,
+        NEKKO_CTX_PARALLEL = 1 << 2,
+    };
+
+    struct nekko_ctx* nekko_ctx_create(void);
+    void nekko_ctx_destroy(struct nekko_ctx* ctx);
+    void nekko_ctx_set_flags(struct nekko_ctx* ctx, uint32_t flags);
+    void nekko_ctx_clear_strings(struct nekko_ctx* ctx);
+
+    // --- Field projection ---
+    // A context can be told which fields of an entity its caller reads:
+    // nekko_ctx_set_fields(ctx, entity, mask) with bit `1 << NEKKO_X_FIELD_Y`
+    // set for each field wanted. Parsers on that context then leave every
+    // other field of that entity zero or null without coercing or copying
+    // it, and do not descend into nested objects and arrays left out, so a
+    // view needing a few columns pays for those alone. The course scanner
+    // does not even read the skipped values. Every field is wanted until
+    // set otherwise; NEKKO_FIELDS_ALL restores that. The mask stays until
+    // changed, for every parser run on the context.
+    //
+    // Entities without an entry here (booking statuses, users, tokens,
+    // registration actions) are always read whole.
+    #define NEKKO_FIELDS_ALL (~(uint64_t)0)
+
+    enum NekkoEntity {
+        NEKKO_ENTITY_COURSE,            // CourseNative
+        NEKKO_ENTITY_EXAM_ROOM,         // ExamRoomNative
+        NEKKO_ENTITY_EXAM_SCHEDULE,     // ExamScheduleNative
+        NEKKO_ENTITY_EXAM_PERIOD,       // ExamPeriodNative
+        NEKKO_ENTITY_COURSE_HOUR,       // CourseHourNative
+        NEKKO_ENTITY_SCHOOL_YEAR,       // SchoolYearNative
+        NEKKO_ENTITY_SEMESTER,          // SemesterNative
+        NEKKO_ENTITY_REGISTER_PERIOD,   // SemesterRegisterPeriodNative
+        NEKKO_ENTITY_SUBJECT,           // SubjectRegistrationNative
+        NEKKO_ENTITY_COURSE_SUBJECT,    // CourseSubjectNative
+        NEKKO_ENTITY_TIMETABLE,         // TimetableNative
+        NEKKO_ENTITY_STUDENT_MARK,      // StudentMarkNative
+        NEKKO_ENTITY_COUNT
+    };
+
+    enum NekkoCourseField {
+        NEKKO_COURSE_FIELD_ID,
+        NEKKO_COURSE_FIELD_CODE,
+        NEKKO_COURSE_FIELD_NAME,
+        NEKKO_COURSE_FIELD_CLASS_CODE,
+        NEKKO_COURSE_FIELD_CLASS_NAME,
+        NEKKO_COURSE_FIELD_DAY_OF_WEEK,
+        NEKKO_COURSE_FIELD_START_HOUR,
+        NEKKO_COURSE_FIELD_END_HOUR,
+        NEKKO_COURSE_FIELD_ROOM,
+        NEKKO_COURSE_FIELD_BUILDING,
+        NEKKO_COURSE_FIELD_CAMPUS,
+        NEKKO_COURSE_FIELD_CREDITS,
+        NEKKO_COURSE_FIELD_START_DATE,
+        NEKKO_COURSE_FIELD_END_DATE,
+        NEKKO_COURSE_FIELD_FROM_WEEK,
+        NEKKO_COURSE_FIELD_TO_WEEK,
+        NEKKO_COURSE_FIELD_LECTURER_NAME,
+        NEKKO_COURSE_FIELD_LECTURER_EMAIL,
+        NEKKO_COURSE_FIELD_STATUS,
+        NEKKO_COURSE_FIELD_GRADE,           // grade and hasGrade
+    };
+
+    enum NekkoExamRoomField {
+        NEKKO_EXAM_ROOM_FIELD_ID,
+        NEKKO_EXAM_ROOM_FIELD_SUBJECT_NAME,
+        NEKKO_EXAM_ROOM_FIELD_EXAM_PERIOD_CODE,
+        NEKKO_EXAM_ROOM_FIELD_EXAM_CODE,
+        NEKKO_EXAM_ROOM_FIELD_STUDENT_CODE,
+        NEKKO_EXAM_ROOM_FIELD_EXAM_DATE,
+        NEKKO_EXAM_ROOM_FIELD_EXAM_TIME,
+        NEKKO_EXAM_ROOM_FIELD_ROOM_NAME,
+        NEKKO_EXAM_ROOM_FIELD_ROOM_BUILDING,
+        NEKKO_EXAM_ROOM_FIELD_EXAM_METHOD,
+        NEKKO_EXAM_ROOM_FIELD_NOTES,
+        NEKKO_EXAM_ROOM_FIELD_EXPECTED_STUDENTS,
+    };
+
+    enum NekkoExamScheduleField {
+        NEKKO_EXAM_SCHEDULE_FIELD_ID,
+        NEKKO_EXAM_SCHEDULE_FIELD_NAME,
+        NEKKO_EXAM_SCHEDULE_FIELD_DISPLAY_ORDER,
+        NEKKO_EXAM_SCHEDULE_FIELD_VOIDED,
+        NEKKO_EXAM_SCHEDULE_FIELD_PERIODS,
+    };
+
+    enum NekkoExamPeriodField {
+        NEKKO_EXAM_PERIOD_FIELD_ID,
+        NEKKO_EXAM_PERIOD_FIELD_CODE,
+        NEKKO_EXAM_PERIOD_FIELD_NAME,
+        NEKKO_EXAM_PERIOD_FIELD_START_DATE,
+        NEKKO_EXAM_PERIOD_FIELD_END_DATE,
+        NEKKO_EXAM_PERIOD_FIELD_EXAM_DAYS,
+        NEKKO_EXAM_PERIOD_FIELD_BOOKING_STATUS,
+    };
+
+    enum NekkoCourseHourField {
+        NEKKO_COURSE_HOUR_FIELD_ID,
+        NEKKO_COURSE_HOUR_FIELD_NAME,
+        NEKKO_COURSE_HOUR_FIELD_START_STRING,
+        NEKKO_COURSE_HOUR_FIELD_END_STRING,
+        NEKKO_COURSE_HOUR_FIELD_INDEX_NUMBER,
+    };
+
+    enum NekkoSchoolYearField {
+        NEKKO_SCHOOL_YEAR_FIELD_ID,
+        NEKKO_SCHOOL_YEAR_FIELD_NAME,
+        NEKKO_SCHOOL_YEAR_FIELD_CODE,
+        NEKKO_SCHOOL_YEAR_FIELD_DISPLAY_NAME,
+        NEKKO_SCHOOL_YEAR_FIELD_YEAR,
+        NEKKO_SCHOOL_YEAR_FIELD_CURRENT,
+        NEKKO_SCHOOL_YEAR_FIELD_START_DATE,
+        NEKKO_SCHOOL_YEAR_FIELD_END_DATE,
+        NEKKO_SCHOOL_YEAR_FIELD_SEMESTERS,
+    };
+
+    enum NekkoSemesterField {
+        NEKKO_SEMESTER_FIELD_ID,
+        NEKKO_SEMESTER_FIELD_CODE,
+        NEKKO_SEMESTER_FIELD_NAME,
+        NEKKO_SEMESTER_FIELD_START_DATE,
+        NEKKO_SEMESTER_FIELD_END_DATE,
+        NEKKO_SEMESTER_FIELD_CURRENT,
+        NEKKO_SEMESTER_FIELD_ORDINAL_NUMBERS,
+        NEKKO_SEMESTER_FIELD_REGISTER_PERIODS,
+    };
+
+    enum NekkoRegisterPeriodField {
+        NEKKO_REGISTER_PERIOD_FIELD_ID,
+        NEKKO_REGISTER_PERIOD_FIELD_NAME,
+        NEKKO_REGISTER_PERIOD_FIELD_START,
+        NEKKO_REGISTER_PERIOD_FIELD_END,
+        NEKKO_REGISTER_PERIOD_FIELD_END_UNREGISTER,
+        NEKKO_REGISTER_PERIOD_FIELD_START_STRING,
+        NEKKO_REGISTER_PERIOD_FIELD_END_STRING,
+        NEKKO_REGISTER_PERIOD_FIELD_END_UNREGISTER_STRING,
+    };
+
+    enum NekkoSubjectField {
+        NEKKO_SUBJECT_FIELD_NAME,
+        NEKKO_SUBJECT_FIELD_CREDITS,
+        NEKKO_SUBJECT_FIELD_COURSE_SUBJECTS,
+    };
+
+    enum NekkoCourseSubjectField {
+        NEKKO_COURSE_SUBJECT_FIELD_ID,
+        NEKKO_COURSE_SUBJECT_FIELD_CODE,
+        NEKKO_COURSE_SUBJECT_FIELD_NAME,
+        NEKKO_COURSE_SUBJECT_FIELD_DISPLAY_CODE,
+        NEKKO_COURSE_SUBJECT_FIELD_MAX_STUDENT,
+        NEKKO_COURSE_SUBJECT_FIELD_NUMBER_STUDENT,
+        NEKKO_COURSE_SUBJECT_FIELD_SELECTED,
+        NEKKO_COURSE_SUBJECT_FIELD_FULL,
+        NEKKO_COURSE_SUBJECT_FIELD_OVERLAP,
+        NEKKO_COURSE_SUBJECT_FIELD_SUBJECT_ID,
+        NEKKO_COURSE_SUBJECT_FIELD_CREDITS,
+        NEKKO_COURSE_SUBJECT_FIELD_STATUS,
+        NEKKO_COURSE_SUBJECT_FIELD_TIMETABLES,
+    };
+
+    enum NekkoTimetableField {
+        NEKKO_TIMETABLE_FIELD_ID,
+        NEKKO_TIMETABLE_FIELD_START_DATE,
+        NEKKO_TIMETABLE_FIELD_END_DATE,
+        NEKKO_TIMETABLE_FIELD_FROM_WEEK,
+        NEKKO_TIMETABLE_FIELD_TO_WEEK,
+        NEKKO_TIMETABLE_FIELD_DAY_OF_WEEK,
+        NEKKO_TIMETABLE_FIELD_START_HOUR,   // startHour and startHourId
+        NEKKO_TIMETABLE_FIELD_END_HOUR,     // endHour and endHourId
+        NEKKO_TIMETABLE_FIELD_ROOM_ID,
+        NEKKO_TIMETABLE_FIELD_ROOM_NAME,
+        NEKKO_TIMETABLE_FIELD_TEACHER_NAME,
+    };
+
+    enum NekkoStudentMarkField {
+        NEKKO_STUDENT_MARK_FIELD_MARK,
+        NEKKO_STUDENT_MARK_FIELD_MARK_QT,
+        NEKKO_STUDENT_MARK_FIELD_MARK_THI,
+        NEKKO_STUDENT_MARK_FIELD_CHAR_MARK,
+        NEKKO_STUDENT_MARK_FIELD_STUDY_TIME,
+        NEKKO_STUDENT_MARK_FIELD_EXAM_ROUND,
+        NEKKO_STUDENT_MARK_FIELD_SUBJECT,   // subjectCode, subjectName, numberOfCredit, isCalculateMark
+        NEKKO_STUDENT_MARK_FIELD_SEMESTER,  // semesterCode, semesterName, semesterId
+    };
+
+    void nekko_ctx_set_fields(struct nekko_ctx* ctx, uint32_t entity, uint64_t fields);
+
+    struct ExamScheduleResult* parse_exam_schedules(const char* json_str);
+    struct ExamScheduleResult* parse_exam_schedules_bytes(const uint8_t* data, size_t len);
+    struct ExamScheduleResult* parse_exam_schedules_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct ExamScheduleResult* parse_exam_schedules_borrowed(uint8_t* data, size_t len);
+    void free_exam_schedule_result(struct ExamScheduleResult* result);
+
+    struct ExamRoomResult* parse_exam_rooms(const char* json_str);
+    struct ExamRoomResult* parse_exam_rooms_bytes(const uint8_t* data, size_t len);
+    struct ExamRoomResult* parse_exam_rooms_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct ExamRoomResult* parse_exam_rooms_borrowed(uint8_t* data, size_t len);
+    void free_exam_room_result(struct ExamRoomResult* result);
+
+    // Exam rooms for several responses at once (one per exam period and
+    // round): the `n` documents bufs[i] / lens[i], at most
+    // NEKKO_EXAM_ROOM_BATCH_MAX, are parsed in parallel into one result,
+    // freed with free_exam_room_result. Rows are de-duplicated by id across
+    // all inputs and come in input order: `source` is the first input that
+    // listed the room and `sources` has bit i set for every input i that
+    // did, so the rows with bit i set are exactly the rooms of input i.
+    // Rows without an id are all kept. An input that does not parse adds no
+    // rows, and errorMessage is set only when none parses. Inputs are only
+    // read and may be freed as soon as this returns.
+    enum { NEKKO_EXAM_ROOM_BATCH_MAX = 64 };
+    struct ExamRoomResult* parse_exam_rooms_batch(const uint8_t** bufs, const size_t* lens, int n);
+
+    struct CourseResult* parse_courses(const char* json_str);
+    struct CourseResult* parse_courses_bytes(const uint8_t* data, size_t len);
+    struct CourseResult* parse_courses_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    void free_course_result(struct CourseResult* result);
+
+    // `data` is a nekko_alloc_buffer and is parsed in place, which leaves
+    // it clobbered; the result owns its strings, so it may be released right
+    // after the call.
+    struct CourseColumnsResult* parse_courses_columns(uint8_t* data, size_t len);
+    struct CourseColumnsResult* parse_courses_columns_utf16(uint8_t* data, size_t len);
+    void free_course_columns_result(struct CourseColumnsResult* result);
+
+    struct NotificationResult* generate_notifications(
+        const char* courses_json,
+        const char* hours_json,
+        long long semester_start_millis);
+    struct NotificationResult* generate_notifications_bytes(
+        const uint8_t* courses, size_t courses_len,
+        const uint8_t* hours, size_t hours_len,
+        long long semester_start_millis);
+    struct NotificationResult* generate_notifications_ctx(
+        struct nekko_ctx* ctx,
+        uint8_t* courses, size_t courses_len,
+        uint8_t* hours, size_t hours_len,
+        long long semester_start_millis);
+    void free_notification_result(struct NotificationResult* result);
+
+    struct CourseHourResult* parse_course_hours(const char* json_str);
+    struct CourseHourResult* parse_course_hours_bytes(const uint8_t* data, size_t len);
+    struct CourseHourResult* parse_course_hours_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct CourseHourResult* parse_course_hours_borrowed(uint8_t* data, size_t len);
+    void free_course_hour_result(struct CourseHourResult* result);
+
+    struct SchoolYearResult* parse_school_years(const char* json_str);
+    struct SchoolYearResult* parse_school_years_bytes(const uint8_t* data, size_t len);
+    struct SchoolYearResult* parse_school_years_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct SchoolYearResult* parse_school_years_borrowed(uint8_t* data, size_t len);
+    void free_school_year_result(struct SchoolYearResult* result);
+
+    struct SemesterResult* parse_semester(const char* json_str);
+    struct SemesterResult* parse_semester_bytes(const uint8_t* data, size_t len);
+    struct SemesterResult* parse_semester_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct SemesterResult* parse_semester_borrowed(uint8_t* data, size_t len);
+    void free_semester_result(struct SemesterResult* result);
+
+    struct UserResult* parse_user(const char* json_str);
+    struct UserResult* parse_user_bytes(const uint8_t* data, size_t len);
+    struct UserResult* parse_user_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct UserResult* parse_user_borrowed(uint8_t* data, size_t len);
+    void free_user_result(struct UserResult* result);
+
+    struct TokenResponseResult* parse_token(const char* json_str);
+    struct TokenResponseResult* parse_token_bytes(const uint8_t* data, size_t len);
+    struct TokenResponseResult* parse_token_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct TokenResponseResult* parse_token_borrowed(uint8_t* data, size_t len);
+    void free_token_result(struct TokenResponseResult* result);
+
+    struct RegistrationResult* parse_registration_data(const char* json_str);
+    struct RegistrationResult* parse_registration_data_bytes(const uint8_t* data, size_t len);
+    struct RegistrationResult* parse_registration_data_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct RegistrationResult* parse_registration_data_borrowed(uint8_t* data, size_t len);
+    void free_registration_result(struct RegistrationResult* result);
+
+    struct RegistrationActionResult* parse_registration_action(const char* json_str);
+    struct RegistrationActionResult* parse_registration_action_bytes(const uint8_t* data, size_t len);
+    struct RegistrationActionResult* parse_registration_action_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct RegistrationActionResult* parse_registration_action_borrowed(uint8_t* data, size_t len);
+    void free_registration_action_result(struct RegistrationActionResult* result);
+
+    struct StudentMarkResult* parse_student_marks(const char* json_str);
+    struct StudentMarkResult* parse_student_marks_bytes(const uint8_t* data, size_t len);
+    struct StudentMarkResult* parse_student_marks_ctx(struct nekko_ctx* ctx, uint8_t* data, size_t len);
+    struct StudentMarkResult* parse_student_marks_borrowed(uint8_t* data, size_t len);
+    void free_student_mark_result(struct StudentMarkResult* result);
+
+    // Chunked parsing, for bodies read off the network piece by piece:
+    //
+    //     s = parse_x_begin(content_length);
+    //     for each chunk: parse_x_feed(s, chunk, chunk_len);
+    //     result = parse_x_finish(s);     // frees s
+    //
+    // With `content_length` known, each feed parses as far as the body has
+    // arrived, so finish only has the tail left to read. The body must then
+    // be exactly that long: a longer one is refused at the feed that
+    // overflows it, a shorter one fails at finish. Pass 0 when the length is
+    // unknown (a compressed response, say): the chunks are collected and
+    // parsed at finish instead. `chunk` is copied and may be reused at once;
+    // the result owns its strings (stringsBorrowed is false).
+    //
+    // feed returns false once the body can no longer parse; finish then
+    // carries the error. nekko_stream_cancel drops a stream that will not be
+    // finished. A stream goes only to the feed and finish of the parser that
+    // began it, and is used by one thread at a time.
+    struct NekkoStream* parse_courses_begin(size_t len);
+    bool parse_courses_feed(struct NekkoStream* stream, const uint8_t* chunk, size_t chunk_len);
+    struct CourseResult* parse_courses_finish(struct NekkoStream* stream);
+
+    struct NekkoStream* parse_exam_rooms_begin(size_t len);
+    bool parse_exam_rooms_feed(struct NekkoStream* stream, const uint8_t* chunk, size_t chunk_len);
+    struct ExamRoomResult* parse_exam_rooms_finish(struct NekkoStream* stream);
+
+    struct NekkoStream* parse_registration_data_begin(size_t len);
+    bool parse_registration_data_feed(struct NekkoStream* stream, const uint8_t* chunk, size_t chunk_len);
+    struct RegistrationResult* parse_registration_data_finish(struct NekkoStream* stream);
+
+    void nekko_stream_cancel(struct NekkoStream* stream);
+
+    // Flat results: the result of the matching parser as one NekkoBlob, or
+    // nullptr when out of memory. A parse error is carried in the root's
+    // errorMessage as usual. `data` is a nekko_alloc_buffer parsed in place,
+    // which leaves it clobbered; the blob borrows nothing from it.
+    //
+    // A blob is freed with nekko_blob_free, never with free_*_result. After
+    // copying one (to another isolate, or back from disk) call
+    // nekko_blob_relocate on the copy before reading it: it checks the
+    // header against this build and `len`, then moves every pointer, making
+    // sure each stays inside the blob. false means the copy is not a usable
+    // blob, and it must not be read or relocated again.
+    struct NekkoBlob* parse_exam_schedules_flat(uint8_t* data, size_t len);
+    struct NekkoBlob* parse_school_years_flat(uint8_t* data, size_t len);
+    struct NekkoBlob* parse_registration_data_flat(uint8_t* data, size_t len);
+    bool nekko_blob_relocate(struct NekkoBlob* blob, size_t len);
+    void nekko_blob_free(struct NekkoBlob* blob);
+
+    // Compressed bodies, for responses read with the HTTP client's own
+    // decompression off. `encoding` is the Content-Encoding header: nullptr,
+    // "" or "identity" for none, "gzip", "deflate", or "br" where
+    // nekko_body_encoding_supported says so (br needs libbrotlidec at build
+    // time; decode it in Dart otherwise).
+    //
+    // parse_x_encoded decodes straight into the buffer the parser reads in
+    // place, which the result then owns: `body` may be released right after
+    // the call and stringsBorrowed is false. A body that does not decode is
+    // reported in errorMessage like a parse error.
+    //
+    // nekko_decode_body does the decoding alone, for the other parsers: it
+    // returns a padded buffer for parse_x_borrowed, released with
+    // nekko_free_buffer, or nullptr (and *out_len 0) if the body does not
+    // decode.
+    bool nekko_body_encoding_supported(const char* encoding);
+    uint8_t* nekko_decode_body(const uint8_t* body, size_t len, const char* encoding, size_t* out_len);
+
+    struct CourseResult* parse_courses_encoded(const uint8_t* body, size_t len, const char* encoding);
+    struct ExamRoomResult* parse_exam_rooms_encoded(const uint8_t* body, size_t len, const char* encoding);
+    struct RegistrationResult* parse_registration_data_encoded(const uint8_t* body, size_t len, const char* encoding);
+
+    // Registration pages, for lists too long to convert in one go:
+    //
+    //     reg = nekko_registration_open(data, len);
+    //     page = nekko_registration_page(reg, offset, limit);   // as rows scroll in
+    //     one = nekko_registration_subject(reg, index);         // when a subject opens
+    //     nekko_registration_close(reg);
+    //
+    // The body is read only as far as the subjects asked for, and only those
+    // are converted, so the first page costs the same however long the list
+    // is. Pages and subjects are RegistrationResults with the data
+    // parse_registration_data would give for those subjects. In a page each
+    // subject has its courseSubjectsCount but courseSubjects NULL; the
+    // subject call fills them, timetables included, for one subject.
+    // Indexes run over the whole list: a page past the end is empty, and a
+    // negative limit reads to the end. nekko_registration_count reads the
+    // rest of the list (passing over it, not converting it).
+    //
+    // Open copies `data`; open_buffer takes over a nekko_alloc_buffer. Both
+    // return nullptr only for a null body or when out of memory. A body that
+    // is not a subject list gives a handle with nekko_registration_error set
+    // and that error in every result's errorMessage. One that goes bad
+    // further in is reported once the read reaches that point, and from
+    // then on in every result too, next to the subjects read before it.
+    //
+    // Results own their strings and may outlive the handle. Reading moves
+    // the handle on, so it is used by one thread at a time.
+    struct NekkoRegistration* nekko_registration_open(const uint8_t* data, size_t len);
+    struct NekkoRegistration* nekko_registration_open_buffer(uint8_t* buf, size_t len);
+    const char* nekko_registration_error(const struct NekkoRegistration* reg);
+    int nekko_registration_count(struct NekkoRegistration* reg);
+    struct RegistrationResult* nekko_registration_page(struct NekkoRegistration* reg, int offset, int limit);
+    struct RegistrationResult* nekko_registration_subject(struct NekkoRegistration* reg, int index);
+    void nekko_registration_close(struct NekkoRegistration* reg);
+
+    // Batched delivery, for screens that show rows while the rest parse:
+    //
+    //     parse_courses_batched(data, len, 64, on_batch, user);
+    //
+    // parses the body and calls on_batch(user, batch, last) each time it has
+    // read `batch_size` more records, without waiting for the rest of the
+    // body. A batch is a result of its own holding just those records, with
+    // the data the one-shot parser gives for them; it owns its strings and
+    // the receiver frees it with free_x_result, on any thread. Rows of one
+    // course are never split, so a course batch can run a little over.
+    //
+    // The final call has `last` set. Its batch may be empty, and carries
+    // the error if the body goes bad (batches before it stay good, though
+    // the one-shot parser would have returned none of their records). A
+    // batch is nullptr only when out of memory. The call returns after the
+    // last batch; `data` is copied and may be released right away.
+    //
+    // The callback runs on the parsing thread. Dart passes a
+    // NativeCallable.listener and calls this from a helper isolate, so the
+    // batches reach the UI isolate while the parse is still running.
+    typedef void (*nekko_course_batch_fn)(void* user, struct CourseResult* batch, bool last);
+    typedef void (*nekko_registration_batch_fn)(void* user, struct RegistrationResult* batch, bool last);
+    void parse_courses_batched(const uint8_t* data, size_t len, int batch_size, nekko_course_batch_fn fn, void* user);
+    void parse_registration_data_batched(const uint8_t* data, size_t len, int batch_size,
+                                         nekko_registration_batch_fn fn, void* user);
+
+    // --- Documents ---
+    // A response parsed once and kept, for code that asks it many small
+    // questions rather than wanting one of the parsers' results:
+    //
+    //     doc = nekko_doc_open(data, len);
+    //     if (nekko_doc_error(doc)) { ... }
+    //     nekko_doc_int64(doc, "/data/0/id", &id);
+    //     n = nekko_doc_extract_int64(doc, "/data", "/id", ids, NULL, cap);
+    //     nekko_doc_close(doc);
+    //
+    // nekko_doc_open copies `data`; nekko_doc_open_buffer takes over a
+    // nekko_alloc_buffer instead (the doc frees it, also when the open
+    // fails); nekko_doc_open_encoded decodes a compressed body as
+    // parse_x_encoded does. The doc is nullptr only when out of memory. A
+    // body that does not parse still gives a doc, with nekko_doc_error set
+    // and every query coming back empty; a good one has no error.
+    //
+    // Paths are RFC 6901 JSON Pointers, NUL-terminated: "" is the root,
+    // "/a/0" member "a" then element 0, "~1" and "~0" stand for "/" and
+    // "~" in a key. A pointer that names nothing reads as NONE, and the
+    // typed getters return false or nullptr for it.
+    //
+    // int64 reads numbers (reals truncated), booleans as 0 or 1, and
+    // strings holding nothing but a number; double the same. Strings point
+    // into the doc, NUL-terminated, valid until nekko_doc_close.
+    // nekko_doc_write returns the JSON text of a value, released with
+    // nekko_free_buffer. nekko_doc_size is the length of an array or the
+    // member count of an object, and 0 for anything else.
+    //
+    // The extract calls read one field out of every element of the array at
+    // `array_ptr`: `field_ptr` is a pointer relative to the element ("" for
+    // the element itself). The first min(length, cap) slots of `out` are
+    // filled, 0 or nullptr where the element has no such field or it does
+    // not read as the type asked for, and flagged in `present` (or `lens`
+    // set) when these are not NULL. They return the array's length, 0 when
+    // `array_ptr` is not an array, so a short `out` can be sized and retried.
+    //
+    // A doc never changes once open: any number of threads may query one at
+    // once, until it is closed.
+    enum NekkoValueType {
+        NEKKO_VALUE_NONE = 0,
+        NEKKO_VALUE_NULL,
+        NEKKO_VALUE_BOOL,
+        NEKKO_VALUE_NUMBER,
+        NEKKO_VALUE_STRING,
+        NEKKO_VALUE_ARRAY,
+        NEKKO_VALUE_OBJECT,
+    };
+
+    struct NekkoDoc* nekko_doc_open(const uint8_t* data, size_t len);
+    struct NekkoDoc* nekko_doc_open_buffer(uint8_t* buf, size_t len);
+    struct NekkoDoc* nekko_doc_open_encoded(const uint8_t* body, size_t len, const char* encoding);
+    const char* nekko_doc_error(const struct NekkoDoc* doc);
+    void nekko_doc_close(struct NekkoDoc* doc);
+
+    int nekko_doc_type(const struct NekkoDoc* doc, const char* ptr);
+    size_t nekko_doc_size(const struct NekkoDoc* doc, const char* ptr);
+    bool nekko_doc_int64(const struct NekkoDoc* doc, const char* ptr, int64_t* out);
+    bool nekko_doc_double(const struct NekkoDoc* doc, const char* ptr, double* out);
+    const char* nekko_doc_string(const struct NekkoDoc* doc, const char* ptr, size_t* len);
+    uint8_t* nekko_doc_write(const struct NekkoDoc* doc, const char* ptr, size_t* len);
+
+    size_t nekko_doc_extract_int64(const struct NekkoDoc* doc, const char* array_ptr, const char* field_ptr,
+                                   int64_t* out, uint8_t* present, size_t cap);
+    size_t nekko_doc_extract_double(const struct NekkoDoc* doc, const char* array_ptr, const char* field_ptr,
+                                    double* out, uint8_t* present, size_t cap);
+    size_t nekko_doc_extract_string(const struct NekkoDoc* doc, const char* array_ptr, const char* field_ptr,
+                                    const char** out, uint32_t* lens, size_t cap);
+
+    // --- Cancellation ---
+    // A token stops a parse that is no longer wanted:
+    //
+    //     cancel = nekko_cancel_create(5000);     // 5 s deadline; 0 for none
+    //     nekko_ctx_set_cancel(ctx, cancel);
+    //     result = parse_registration_data_ctx(ctx, data, len);
+    //     if (!result && nekko_cancelled(cancel)) { ... }
+    //
+    // nekko_cancel(token), from any thread, or the deadline passing makes
+    // the parse stop at the next array element, release everything it
+    // built and return nullptr, which nekko_cancelled tells apart from
+    // running out of memory. A parse that finished first returns its
+    // result as usual. Reading the document itself is not interrupted, so
+    // a parse cancelled during the read stops once it is done. Once fired,
+    // a token stays fired.
+    //
+    // A token set on a context is checked by every parse_x_ctx and by
+    // generate_notifications_ctx. parse_user_ctx, parse_token_ctx and
+    // parse_registration_action_ctx read a single object with no array in
+    // it, so they check once, when done. It stays set until replaced or set
+    // to NULL, and must outlive every call that can see it.
+    struct NekkoCancel;
+
+    struct NekkoCancel* nekko_cancel_create(int64_t timeout_ms);
+    void nekko_cancel(struct NekkoCancel* cancel);
+    bool nekko_cancelled(struct NekkoCancel* cancel);
+    void nekko_cancel_destroy(struct NekkoCancel* cancel);
+    void nekko_ctx_set_cancel(struct nekko_ctx* ctx, struct NekkoCancel* cancel);
+
+    // --- Background parses ---
+    // nekko_submit_parse queues a parse on the library's worker threads and
+    // returns at once:
+    //
+    //     buf = nekko_alloc_buffer(len); memcpy(buf, body, len);
+    //     nekko_submit_parse(NEKKO_PARSE_COURSES, buf, len, NULL, NULL, on_done, user);
+    //
+    // When the parse is done, on_done(user, kind, NEKKO_JOB_DONE, result) is
+    // called on the worker thread with what the matching parse_x_bytes
+    // would have returned: a CourseResult* for NEKKO_PARSE_COURSES and so
+    // on, nullptr only when out of memory. The result owns its strings; the
+    // receiver frees it with the matching free_x_result, on any thread.
+    //
+    // With a `cancel` token (NULL for none), a job whose token fires before
+    // or while it runs stops as the Cancellation section describes and
+    // reports NEKKO_JOB_CANCELLED with a null result instead. The token must
+    // outlive the job, i.e. stay until `done` has been called.
+    //
+    // `buf` is a nekko_alloc_buffer the job takes over and frees, also when
+    // submission fails. `encoding` is a Content-Encoding as parse_x_encoded
+    // takes it (copied), or NULL for a plain body. Submission fails, without
+    // a call to `done`, for an unknown kind or a null `done`.
+    //
+    // Dart passes a NativeCallable.listener as `done`, so the result reaches
+    // the submitting isolate as an event without an isolate of its own.
+    enum NekkoParseKind {
+        NEKKO_PARSE_COURSES = 0,
+        NEKKO_PARSE_COURSE_HOURS = 1,
+        NEKKO_PARSE_SCHOOL_YEARS = 2,
+        NEKKO_PARSE_SEMESTER = 3,
+        NEKKO_PARSE_REGISTRATION = 4,
+    };
+
+    enum NekkoJobStatus {
+        NEKKO_JOB_DONE = 0,
+        NEKKO_JOB_CANCELLED = 1,
+    };
+
+    typedef void (*nekko_parse_done_fn)(void* user, int kind, int status, void* result);
+    bool nekko_submit_parse(int kind, uint8_t* buf, size_t len, const char* encoding, struct NekkoCancel* cancel,
+                            nekko_parse_done_fn done, void* user);
+
+}
+
+#endif // NEKKO_NATIVE_LIB_H
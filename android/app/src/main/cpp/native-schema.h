@@ -0,0 +1,389 @@
+// JSON shape of every *Native struct decoded through schema.h, one
+// descriptor per entity. Keys are listed in priority order: when an object
+// carries two spellings of a field, the first one holding a value wins.
+#ifndef NEKKO_NATIVE_SCHEMA_H
+#define NEKKO_NATIVE_SCHEMA_H
+
+#include <tuple>
+
+#include "flat_blob.h"
+#include "native-lib.h"
+#include "schema.h"
+
+// --- Exam schedules ---
+
+template <>
+struct Schema<BookingStatusNative> {
+    using T = BookingStatusNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::name>("name"),
+    };
+};
+
+template <>
+struct Schema<ExamPeriodNative> {
+    using T = ExamPeriodNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_EXAM_PERIOD;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::examPeriodCode>("examPeriodCode"),
+        field<&T::name>("name"),
+        field<&T::startDate>("startDate"),
+        field<&T::endDate>("endDate"),
+        field<&T::numberOfExamDays>("numberOfExamDays"),
+        field<&T::bookingStatus>("bookingStatus"),
+    };
+};
+
+template <>
+struct Schema<ExamScheduleNative> {
+    using T = ExamScheduleNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_EXAM_SCHEDULE;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::name>("name"),
+        field<&T::displayOrder>("displayOrder"),
+        field<&T::voided>("voided"),
+        array<&T::examPeriods, &T::examPeriodsCount>("examPeriods"),
+    };
+};
+
+// --- Course hours ---
+
+template <>
+struct Schema<CourseHourNative> {
+    using T = CourseHourNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_COURSE_HOUR;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::name>("name"),
+        field<&T::startString>("startString"),
+        field<&T::endString>("endString"),
+        field<&T::indexNumber>("indexNumber"),
+    };
+};
+
+// --- School years and semesters ---
+// Register periods come camelCase from the current API, PascalCase from
+// older deployments; so do semester dates.
+
+template <>
+struct Schema<SemesterRegisterPeriodNative> {
+    using T = SemesterRegisterPeriodNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_REGISTER_PERIOD;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id", "Id"),
+        field<&T::name>("name", "Name"),
+        field<&T::startRegisterTime>("startRegisterTime", "StartRegisterTime"),
+        field<&T::endRegisterTime>("endRegisterTime", "EndRegisterTime"),
+        field<&T::endUnRegisterTime>("endUnRegisterTime", "EndUnRegisterTime"),
+        field<&T::startRegisterTimeString>("startRegisterTimeString", "StartRegisterTimeString"),
+        field<&T::endRegisterTimeString>("endRegisterTimeString", "EndRegisterTimeString"),
+        field<&T::endUnRegisterTimeString>("endUnRegisterTimeString", "EndUnRegisterTimeString"),
+    };
+};
+
+template <>
+struct Schema<SemesterNative> {
+    using T = SemesterNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_SEMESTER;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::semesterCode>("semesterCode"),
+        field<&T::semesterName>("semesterName"),
+        field<&T::startDate>("startDate", "StartDate"),
+        field<&T::endDate>("endDate", "EndDate"),
+        field<&T::isCurrent>("isCurrent"),
+        field<&T::ordinalNumbers>("ordinalNumbers"),
+        array<&T::registerPeriods, &T::registerPeriodsCount>("semesterRegisterPeriods"),
+    };
+};
+
+template <>
+struct Schema<SchoolYearNative> {
+    using T = SchoolYearNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_SCHOOL_YEAR;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::name>("name"),
+        field<&T::code>("code"),
+        field<&T::displayName>("displayName"),
+        field<&T::year>("year"),
+        field<&T::current>("current"),
+        field<&T::startDate>("startDate"),
+        field<&T::endDate>("endDate"),
+        array<&T::semesters, &T::semestersCount>("semesters"),
+    };
+};
+
+// --- Token ---
+
+template <>
+struct Schema<TokenResponseNative> {
+    using T = TokenResponseNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::access_token>("access_token"),
+        field<&T::token_type>("token_type"),
+        field<&T::refresh_token>("refresh_token"),
+        field<&T::scope>("scope"),
+        field<&T::expires_in>("expires_in"),
+    };
+};
+
+// --- Registration ---
+// The API has served both PascalCase and camelCase over time, PascalCase
+// first. Timetables have only ever been camelCase.
+
+struct TimetableStartHour {
+    using T = TimetableNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::startHour>("indexNumber"),
+        field<&T::startHourId>("id"),
+    };
+};
+
+struct TimetableEndHour {
+    using T = TimetableNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::endHour>("indexNumber"),
+        field<&T::endHourId>("id"),
+    };
+};
+
+struct TimetableRoom {
+    using T = TimetableNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::roomId>("id"),
+    };
+};
+
+template <>
+struct Schema<TimetableNative> {
+    using T = TimetableNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_TIMETABLE;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("id"),
+        field<&T::startDate>("startDate"),
+        field<&T::endDate>("endDate"),
+        field<&T::fromWeek>("fromWeek"),
+        field<&T::toWeek>("toWeek"),
+        field<&T::dayOfWeek>("weekIndex"),
+        embed<TimetableStartHour>("startHour"),
+        embed<TimetableEndHour>("endHour"),
+        embed<TimetableRoom>("room"),
+        field<&T::roomName>("roomName"),
+        field<&T::teacherName>("teacherName"),
+    };
+};
+
+template <>
+struct Schema<CourseSubjectNative> {
+    using T = CourseSubjectNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_COURSE_SUBJECT;
+    static constexpr auto fields = std::tuple{
+        field<&T::id>("Id", "id"),
+        field<&T::code>("Code", "code"),
+        field<&T::name>(),      // never sent; listed so flat_blob.h sees the pointer
+        field<&T::displayCode>("DisplayCode", "displayCode"),
+        field<&T::maxStudent>("MaxStudent", "maxStudent"),
+        field<&T::numberStudent>("NumberStudent", "numberStudent"),
+        field<&T::isSelected>("IsSelected", "isSelected"),
+        field<&T::isFull>("IsFullClass", "isFullClass"),
+        field<&T::isOverlap>("IsOvelapTime", "isOvelapTime"),   // sic, as the API spells it
+        field<&T::subjectId>("SubjectId", "subjectId"),
+        field<&T::credits>("NumberOfCredit", "numberOfCredit"),
+        field<&T::status>("Status", "status"),
+        array<&T::timetables, &T::timetablesCount>("Timetables", "timetables"),
+    };
+};
+
+template <>
+struct Schema<SubjectRegistrationNative> {
+    using T = SubjectRegistrationNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_SUBJECT;
+    static constexpr auto fields = std::tuple{
+        field<&T::subjectName>("SubjectName", "subjectName"),
+        field<&T::numberOfCredit>("NumberOfCredit", "numberOfCredit", "Credits", "credits"),
+        array<&T::courseSubjects, &T::courseSubjectsCount>("CourseSubjectDtos", "courseSubjectDtos"),
+    };
+};
+
+template <>
+struct Schema<RegistrationActionResult> {
+    using T = RegistrationActionResult;
+    static constexpr auto fields = std::tuple{
+        field<&T::status>("status", "Status"),
+        field<&T::message>("message", "Message"),
+    };
+};
+
+// --- Student marks ---
+
+struct StudentMarkSubject {
+    using T = StudentMarkNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::subjectCode>("subjectCode"),
+        field<&T::subjectName>("subjectName"),
+        field<&T::numberOfCredit>("numberOfCredit"),
+        field<&T::isCalculateMark>("isCalculateMark"),
+    };
+};
+
+struct StudentMarkSemester {
+    using T = StudentMarkNative;
+    static constexpr auto fields = std::tuple{
+        field<&T::semesterCode>("semesterCode"),
+        field<&T::semesterName>("semesterName"),
+        field<&T::semesterId>("id"),
+    };
+};
+
+template <>
+struct Schema<StudentMarkNative> {
+    using T = StudentMarkNative;
+    static constexpr NekkoEntity kEntity = NEKKO_ENTITY_STUDENT_MARK;
+    static constexpr auto fields = std::tuple{
+        field<&T::mark>("mark"),
+        field<&T::markQT>("markQT"),
+        field<&T::markTHI>("markTHI"),
+        field<&T::charMark>("charMark"),
+        field<&T::studyTime>("studyTime"),
+        field<&T::examRound>("examRound"),
+        embed<StudentMarkSubject>("subject"),
+        embed<StudentMarkSemester>("semester"),
+    };
+};
+
+// --- Flat results ---
+// Result roots for flat_blob.h. These are never decoded, so they list no
+// keys; they only say where the pointers are.
+
+struct FlatExamSchedules {
+    using T = ExamScheduleResult;
+    static constexpr auto fields = std::tuple{
+        array<&T::schedules, &T::count>(),
+        field<&T::errorMessage>(),
+    };
+};
+
+struct FlatSchoolYears {
+    using T = SchoolYearResult;
+    static constexpr auto fields = std::tuple{
+        array<&T::years, &T::count>(),
+        field<&T::errorMessage>(),
+    };
+};
+
+struct FlatRegistrationPeriod {
+    using T = RegistrationPeriodNative;
+    static constexpr auto fields = std::tuple{
+        array<&T::subjects, &T::subjectsCount>(),
+    };
+};
+
+struct FlatRegistration {
+    using T = RegistrationResult;
+    static constexpr auto fields = std::tuple{
+        ref<&T::data, FlatRegistrationPeriod>(),
+        field<&T::errorMessage>(),
+    };
+};
+
+// --- Projection ---
+// The field enums of native-lib.h count the descriptors above in order.
+
+template <typename T, auto Member>
+constexpr bool bit_is(int bit) { return field_bit<Schema<T>, Member>() == bit; }
+
+template <typename T, typename Sub>
+constexpr bool embed_bit_is(int bit) { return embed_bit<Schema<T>, Sub>() == bit; }
+
+static_assert(bit_is<ExamScheduleNative, &ExamScheduleNative::id>(NEKKO_EXAM_SCHEDULE_FIELD_ID));
+static_assert(bit_is<ExamScheduleNative, &ExamScheduleNative::name>(NEKKO_EXAM_SCHEDULE_FIELD_NAME));
+static_assert(bit_is<ExamScheduleNative, &ExamScheduleNative::displayOrder>(NEKKO_EXAM_SCHEDULE_FIELD_DISPLAY_ORDER));
+static_assert(bit_is<ExamScheduleNative, &ExamScheduleNative::voided>(NEKKO_EXAM_SCHEDULE_FIELD_VOIDED));
+static_assert(bit_is<ExamScheduleNative, &ExamScheduleNative::examPeriods>(NEKKO_EXAM_SCHEDULE_FIELD_PERIODS));
+
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::id>(NEKKO_EXAM_PERIOD_FIELD_ID));
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::examPeriodCode>(NEKKO_EXAM_PERIOD_FIELD_CODE));
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::name>(NEKKO_EXAM_PERIOD_FIELD_NAME));
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::startDate>(NEKKO_EXAM_PERIOD_FIELD_START_DATE));
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::endDate>(NEKKO_EXAM_PERIOD_FIELD_END_DATE));
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::numberOfExamDays>(NEKKO_EXAM_PERIOD_FIELD_EXAM_DAYS));
+static_assert(bit_is<ExamPeriodNative, &ExamPeriodNative::bookingStatus>(NEKKO_EXAM_PERIOD_FIELD_BOOKING_STATUS));
+
+static_assert(bit_is<CourseHourNative, &CourseHourNative::id>(NEKKO_COURSE_HOUR_FIELD_ID));
+static_assert(bit_is<CourseHourNative, &CourseHourNative::name>(NEKKO_COURSE_HOUR_FIELD_NAME));
+static_assert(bit_is<CourseHourNative, &CourseHourNative::startString>(NEKKO_COURSE_HOUR_FIELD_START_STRING));
+static_assert(bit_is<CourseHourNative, &CourseHourNative::endString>(NEKKO_COURSE_HOUR_FIELD_END_STRING));
+static_assert(bit_is<CourseHourNative, &CourseHourNative::indexNumber>(NEKKO_COURSE_HOUR_FIELD_INDEX_NUMBER));
+
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::id>(NEKKO_SCHOOL_YEAR_FIELD_ID));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::name>(NEKKO_SCHOOL_YEAR_FIELD_NAME));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::code>(NEKKO_SCHOOL_YEAR_FIELD_CODE));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::displayName>(NEKKO_SCHOOL_YEAR_FIELD_DISPLAY_NAME));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::year>(NEKKO_SCHOOL_YEAR_FIELD_YEAR));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::current>(NEKKO_SCHOOL_YEAR_FIELD_CURRENT));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::startDate>(NEKKO_SCHOOL_YEAR_FIELD_START_DATE));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::endDate>(NEKKO_SCHOOL_YEAR_FIELD_END_DATE));
+static_assert(bit_is<SchoolYearNative, &SchoolYearNative::semesters>(NEKKO_SCHOOL_YEAR_FIELD_SEMESTERS));
+
+static_assert(bit_is<SemesterNative, &SemesterNative::id>(NEKKO_SEMESTER_FIELD_ID));
+static_assert(bit_is<SemesterNative, &SemesterNative::semesterCode>(NEKKO_SEMESTER_FIELD_CODE));
+static_assert(bit_is<SemesterNative, &SemesterNative::semesterName>(NEKKO_SEMESTER_FIELD_NAME));
+static_assert(bit_is<SemesterNative, &SemesterNative::startDate>(NEKKO_SEMESTER_FIELD_START_DATE));
+static_assert(bit_is<SemesterNative, &SemesterNative::endDate>(NEKKO_SEMESTER_FIELD_END_DATE));
+static_assert(bit_is<SemesterNative, &SemesterNative::isCurrent>(NEKKO_SEMESTER_FIELD_CURRENT));
+static_assert(bit_is<SemesterNative, &SemesterNative::ordinalNumbers>(NEKKO_SEMESTER_FIELD_ORDINAL_NUMBERS));
+static_assert(bit_is<SemesterNative, &SemesterNative::registerPeriods>(NEKKO_SEMESTER_FIELD_REGISTER_PERIODS));
+
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::id>(NEKKO_REGISTER_PERIOD_FIELD_ID));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::name>(NEKKO_REGISTER_PERIOD_FIELD_NAME));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::startRegisterTime>(NEKKO_REGISTER_PERIOD_FIELD_START));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::endRegisterTime>(NEKKO_REGISTER_PERIOD_FIELD_END));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::endUnRegisterTime>(NEKKO_REGISTER_PERIOD_FIELD_END_UNREGISTER));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::startRegisterTimeString>(NEKKO_REGISTER_PERIOD_FIELD_START_STRING));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::endRegisterTimeString>(NEKKO_REGISTER_PERIOD_FIELD_END_STRING));
+static_assert(bit_is<SemesterRegisterPeriodNative, &SemesterRegisterPeriodNative::endUnRegisterTimeString>(NEKKO_REGISTER_PERIOD_FIELD_END_UNREGISTER_STRING));
+
+static_assert(bit_is<SubjectRegistrationNative, &SubjectRegistrationNative::subjectName>(NEKKO_SUBJECT_FIELD_NAME));
+static_assert(bit_is<SubjectRegistrationNative, &SubjectRegistrationNative::numberOfCredit>(NEKKO_SUBJECT_FIELD_CREDITS));
+static_assert(bit_is<SubjectRegistrationNative, &SubjectRegistrationNative::courseSubjects>(NEKKO_SUBJECT_FIELD_COURSE_SUBJECTS));
+
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::id>(NEKKO_COURSE_SUBJECT_FIELD_ID));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::code>(NEKKO_COURSE_SUBJECT_FIELD_CODE));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::name>(NEKKO_COURSE_SUBJECT_FIELD_NAME));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::displayCode>(NEKKO_COURSE_SUBJECT_FIELD_DISPLAY_CODE));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::maxStudent>(NEKKO_COURSE_SUBJECT_FIELD_MAX_STUDENT));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::numberStudent>(NEKKO_COURSE_SUBJECT_FIELD_NUMBER_STUDENT));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::isSelected>(NEKKO_COURSE_SUBJECT_FIELD_SELECTED));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::isFull>(NEKKO_COURSE_SUBJECT_FIELD_FULL));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::isOverlap>(NEKKO_COURSE_SUBJECT_FIELD_OVERLAP));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::subjectId>(NEKKO_COURSE_SUBJECT_FIELD_SUBJECT_ID));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::credits>(NEKKO_COURSE_SUBJECT_FIELD_CREDITS));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::status>(NEKKO_COURSE_SUBJECT_FIELD_STATUS));
+static_assert(bit_is<CourseSubjectNative, &CourseSubjectNative::timetables>(NEKKO_COURSE_SUBJECT_FIELD_TIMETABLES));
+
+static_assert(bit_is<TimetableNative, &TimetableNative::id>(NEKKO_TIMETABLE_FIELD_ID));
+static_assert(bit_is<TimetableNative, &TimetableNative::startDate>(NEKKO_TIMETABLE_FIELD_START_DATE));
+static_assert(bit_is<TimetableNative, &TimetableNative::endDate>(NEKKO_TIMETABLE_FIELD_END_DATE));
+static_assert(bit_is<TimetableNative, &TimetableNative::fromWeek>(NEKKO_TIMETABLE_FIELD_FROM_WEEK));
+static_assert(bit_is<TimetableNative, &TimetableNative::toWeek>(NEKKO_TIMETABLE_FIELD_TO_WEEK));
+static_assert(bit_is<TimetableNative, &TimetableNative::dayOfWeek>(NEKKO_TIMETABLE_FIELD_DAY_OF_WEEK));
+static_assert(embed_bit_is<TimetableNative, TimetableStartHour>(NEKKO_TIMETABLE_FIELD_START_HOUR));
+static_assert(embed_bit_is<TimetableNative, TimetableEndHour>(NEKKO_TIMETABLE_FIELD_END_HOUR));
+static_assert(embed_bit_is<TimetableNative, TimetableRoom>(NEKKO_TIMETABLE_FIELD_ROOM_ID));
+static_assert(bit_is<TimetableNative, &TimetableNative::roomName>(NEKKO_TIMETABLE_FIELD_ROOM_NAME));
+static_assert(bit_is<TimetableNative, &TimetableNative::teacherName>(NEKKO_TIMETABLE_FIELD_TEACHER_NAME));
+
+static_assert(bit_is<StudentMarkNative, &StudentMarkNative::mark>(NEKKO_STUDENT_MARK_FIELD_MARK));
+static_assert(bit_is<StudentMarkNative, &StudentMarkNative::markQT>(NEKKO_STUDENT_MARK_FIELD_MARK_QT));
+static_assert(bit_is<StudentMarkNative, &StudentMarkNative::markTHI>(NEKKO_STUDENT_MARK_FIELD_MARK_THI));
+static_assert(bit_is<StudentMarkNative, &StudentMarkNative::charMark>(NEKKO_STUDENT_MARK_FIELD_CHAR_MARK));
+static_assert(bit_is<StudentMarkNative, &StudentMarkNative::studyTime>(NEKKO_STUDENT_MARK_FIELD_STUDY_TIME));
+static_assert(bit_is<StudentMarkNative, &StudentMarkNative::examRound>(NEKKO_STUDENT_MARK_FIELD_EXAM_ROUND));
+static_assert(embed_bit_is<StudentMarkNative, StudentMarkSubject>(NEKKO_STUDENT_MARK_FIELD_SUBJECT));
+static_assert(embed_bit_is<StudentMarkNative, StudentMarkSemester>(NEKKO_STUDENT_MARK_FIELD_SEMESTER));
+
+#endif // NEKKO_NATIVE_SCHEMA_H
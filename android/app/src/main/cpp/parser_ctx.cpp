@@ -0,0 +1,204 @@
+#include "parser_ctx.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include "native-lib.h"
+
+namespace {
+    constexpr size_t kAlign = 16;
+    constexpr size_t kMinRegion = 4096;
+    // A payload needing less than half the region gives memory back; one
+    // that needs more grows it. Anything in between keeps the region as is.
+    constexpr size_t kShrinkRatio = 2;
+
+    constexpr size_t align_up(size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+    bool in_region(const nekko_ctx* ctx, const void* p) {
+        return ctx->region && (const char*)p >= ctx->region &&
+               (const char*)p < ctx->region + ctx->capacity;
+    }
+
+    // Allocations that do not fit the region go to malloc with a size header,
+    // so the context can tell how much heap the call held at its peak.
+    void* overflow_alloc(nekko_ctx* ctx, size_t size) {
+        char* p = (char*)malloc(kAlign + size);
+        if (!p) return nullptr;
+        *(size_t*)p = size;
+        ctx->overflowLive += size;
+        if (ctx->overflowLive > ctx->overflowPeak) ctx->overflowPeak = ctx->overflowLive;
+        return p + kAlign;
+    }
+
+    void overflow_free(nekko_ctx* ctx, void* ptr) {
+        char* p = (char*)ptr - kAlign;
+        ctx->overflowLive -= *(size_t*)p;
+        free(p);
+    }
+
+    void* ctx_malloc(void* opaque, size_t size) {
+        nekko_ctx* ctx = (nekko_ctx*)opaque;
+        size_t need = align_up(size);
+        if (ctx->used + need <= ctx->capacity) {
+            void* p = ctx->region + ctx->used;
+            ctx->used += need;
+            if (ctx->used > ctx->highWater) ctx->highWater = ctx->used;
+            return p;
+        }
+        return overflow_alloc(ctx, size);
+    }
+
+    void ctx_free(void* opaque, void* ptr) {
+        nekko_ctx* ctx = (nekko_ctx*)opaque;
+        if (!ptr) return;
+        // Region memory is reclaimed wholesale by the next nekko_ctx_begin().
+        if (in_region(ctx, ptr)) return;
+        overflow_free(ctx, ptr);
+    }
+
+    // yyjson grows its value pool with realloc, and that pool is almost always
+    // the newest region allocation, so it can usually be extended in place.
+    void* ctx_realloc(void* opaque, void* ptr, size_t oldSize, size_t size) {
+        nekko_ctx* ctx = (nekko_ctx*)opaque;
+        if (!ptr) return ctx_malloc(opaque, size);
+        if (in_region(ctx, ptr)) {
+            size_t offset = (size_t)((char*)ptr - ctx->region);
+            if (offset + align_up(oldSize) == ctx->used && offset + align_up(size) <= ctx->capacity) {
+                ctx->used = offset + align_up(size);
+                if (ctx->used > ctx->highWater) ctx->highWater = ctx->used;
+                return ptr;
+            }
+        }
+        void* moved = ctx_malloc(opaque, size);
+        if (moved) {
+            memcpy(moved, ptr, oldSize < size ? oldSize : size);
+            ctx_free(opaque, ptr);
+        }
+        return moved;
+    }
+}
+
+void nekko_ctx_begin(nekko_ctx* ctx) {
+    size_t demand = ctx->lastDemand;
+    bool grow = demand > ctx->capacity;
+    bool shrink = ctx->capacity > kMinRegion && demand < ctx->capacity / kShrinkRatio;
+    if (grow || shrink) {
+        // A little headroom so a payload that grew slightly still fits.
+        size_t size = demand + demand / 4;
+        if (size < kMinRegion) size = kMinRegion;
+        size = align_up(size);
+        char* region = (char*)malloc(size);
+        if (region) {
+            free(ctx->region);
+            ctx->region = region;
+            ctx->capacity = size;
+        }
+    }
+    ctx->used = 0;
+    ctx->highWater = 0;
+    ctx->overflowLive = 0;
+    ctx->overflowPeak = 0;
+}
+
+void nekko_ctx_end(nekko_ctx* ctx) {
+    // An upper bound on what the call needed at once: region space that a
+    // moved allocation left behind is counted too, which is what gives the
+    // next region its slack.
+    ctx->lastDemand = ctx->highWater + ctx->overflowPeak;
+}
+
+StringPool* nekko_ctx_strings(nekko_ctx* ctx) {
+    if (!ctx || !(ctx->flags & NEKKO_CTX_INTERN_STRINGS)) return nullptr;
+    return ctx->strings;
+}
+
+const uint64_t* nekko_ctx_fields(const nekko_ctx* ctx) {
+    return ctx ? ctx->fields : nullptr;
+}
+
+bool nekko_ctx_parallel(const nekko_ctx* ctx) {
+    return ctx && (ctx->flags & NEKKO_CTX_PARALLEL);
+}
+
+NekkoCancel* nekko_ctx_cancel(const nekko_ctx* ctx) {
+    return ctx ? ctx->cancel : nullptr;
+}
+
+// --- Scratch ---
+
+namespace {
+    thread_local NekkoArena* tScratch = nullptr;
+
+    // Releases the thread's scratch arena when the thread exits.
+    struct ScratchOwner {
+        ~ScratchOwner() {
+            nekko_arena_release(tScratch);
+            tScratch = nullptr;
+        }
+    };
+    thread_local ScratchOwner tScratchOwner;
+}
+
+ScratchScope::ScratchScope() {
+    (void)&tScratchOwner;
+    if (!tScratch) tScratch = nekko_arena_create(0);
+    arena_ = tScratch;
+}
+
+ScratchScope::~ScratchScope() {
+    tScratch = nekko_arena_recycle(arena_);
+}
+
+// --- Context API ---
+
+extern "C" {
+
+__attribute__((visibility("default"))) __attribute__((used))
+nekko_ctx* nekko_ctx_create(void) {
+    nekko_ctx* ctx = (nekko_ctx*)calloc(1, sizeof(nekko_ctx));
+    if (!ctx) return nullptr;
+    // Made up front, so a context set to intern always has its pool.
+    ctx->strings = new (std::nothrow) StringPool();
+    if (!ctx->strings) {
+        free(ctx);
+        return nullptr;
+    }
+    for (uint64_t& f : ctx->fields) f = NEKKO_FIELDS_ALL;
+    ctx->alc.malloc = ctx_malloc;
+    ctx->alc.realloc = ctx_realloc;
+    ctx->alc.free = ctx_free;
+    ctx->alc.ctx = ctx;
+    return ctx;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_ctx_destroy(nekko_ctx* ctx) {
+    if (!ctx) return;
+    delete ctx->strings;
+    free(ctx->region);
+    free(ctx);
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_ctx_set_flags(nekko_ctx* ctx, uint32_t flags) {
+    if (ctx) ctx->flags = flags;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_ctx_clear_strings(nekko_ctx* ctx) {
+    if (ctx) ctx->strings->clear();
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_ctx_set_fields(nekko_ctx* ctx, uint32_t entity, uint64_t fields) {
+    if (ctx && entity < NEKKO_ENTITY_COUNT) ctx->fields[entity] = fields;
+}
+
+__attribute__((visibility("default"))) __attribute__((used))
+void nekko_ctx_set_cancel(nekko_ctx* ctx, NekkoCancel* cancel) {
+    if (ctx) ctx->cancel = cancel;
+}
+
+}
@@ -0,0 +1,72 @@
+// Internal side of nekko_ctx (declared opaque in native-lib.h).
+#ifndef NEKKO_PARSER_CTX_H
+#define NEKKO_PARSER_CTX_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "arena.h"
+#include "native-lib.h"
+#include "string_pool.h"
+#include "yyjson.h"
+
+// A reusable parse context. Its yyjson allocator serves every DOM from one
+// region that is kept between calls and resized to what the previous parse
+// actually needed, so repeated parses of similar payloads do no malloc for
+// the DOM at all. A context is not thread-safe; use one per thread.
+struct nekko_ctx {
+    yyjson_alc alc;
+    uint32_t flags;         // NEKKO_CTX_* from native-lib.h
+
+    char* region;
+    size_t capacity;
+    size_t used;            // bump offset into region
+    size_t highWater;       // max `used` during the current call
+    size_t overflowLive;    // bytes that did not fit and went to malloc
+    size_t overflowPeak;
+    size_t lastDemand;      // highWater + overflowPeak of the previous call
+
+    StringPool* strings;    // used with NEKKO_CTX_INTERN_STRINGS
+    uint64_t fields[NEKKO_ENTITY_COUNT];    // nekko_ctx_set_fields, by NekkoEntity
+    NekkoCancel* cancel;    // nekko_ctx_set_cancel
+};
+
+// Bracket one parse call. begin() resizes the region from the previous call
+// and rewinds it; every DOM read with ctx->alc must be freed before end().
+void nekko_ctx_begin(nekko_ctx* ctx);
+void nekko_ctx_end(nekko_ctx* ctx);
+
+// The pool results parsed on `ctx` intern their strings into, kept until
+// nekko_ctx_clear_strings or nekko_ctx_destroy; nullptr when `ctx` is null
+// or does not have NEKKO_CTX_INTERN_STRINGS set.
+StringPool* nekko_ctx_strings(nekko_ctx* ctx);
+
+// The field mask of each NekkoEntity for parsers on `ctx`, indexed by
+// entity; nullptr, meaning every field, when `ctx` is null.
+const uint64_t* nekko_ctx_fields(const nekko_ctx* ctx);
+
+// Whether parsers on `ctx` may spread one call over the worker pool
+// (NEKKO_CTX_PARALLEL); false for a null `ctx`.
+bool nekko_ctx_parallel(const nekko_ctx* ctx);
+
+// The token parsers on `ctx` check (nekko_ctx_set_cancel); nullptr when
+// `ctx` is null or has none.
+NekkoCancel* nekko_ctx_cancel(const nekko_ctx* ctx);
+
+// Per-thread arena for temporaries that die before a parser returns. The
+// arena is rewound when the scope closes and keeps its memory for the next
+// call on the same thread. Scopes must not nest.
+class ScratchScope {
+public:
+    ScratchScope();
+    ~ScratchScope();
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    NekkoArena* arena() const { return arena_; }
+
+private:
+    NekkoArena* arena_;
+};
+
+#endif // NEKKO_PARSER_CTX_H
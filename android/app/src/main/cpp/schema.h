@@ -0,0 +1,318 @@
+// Declarative parsers for the *Native structs.
+//
+// Each entity describes its JSON once, as a Schema<T> specialisation listing
+// its fields: which member, which keys (in priority order), and whether the
+// member is a scalar, a nested struct, an array of structs or a sub-object
+// flattened onto T. Decoder<T> turns that list into a KeyTable at compile
+// time and into one straight-line sequence of stores per object, so every
+// entity gets the single-pass dispatch and key-order hints of field_table.h
+// without a hand-written loop. Coercion follows the member type:
+//
+//   int        get_json_int        long long   get_json_int64
+//   double     yyjson_get_num      bool        yyjson_get_bool
+//   char*      StringSink::take (interned, copied or borrowed, per call)
+//
+// Descriptors live in native-schema.h. Parsers with logic beyond "read these
+// fields" (fallbacks between fields, derived values) decode what they can
+// with a schema and do the rest by hand.
+//
+// A schema naming a NekkoEntity (`kEntity`) can be projected: bit i of the
+// entity's mask in DecodeEnv stands for field i of `fields`, and a field
+// whose bit is clear is never stored, so its value is neither coerced nor
+// copied and a nested object or array behind it is not descended into.
+#ifndef NEKKO_SCHEMA_H
+#define NEKKO_SCHEMA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "arena.h"
+#include "cancel.h"
+#include "field_table.h"
+#include "string_pool.h"
+#include "yyjson.h"
+
+template <typename T>
+T* arena_array(NekkoArena* arena, size_t count) {
+    return (T*)nekko_arena_calloc(arena, count, sizeof(T));
+}
+
+// Where a result's strings live: copied into its arena, interned through
+// `pool` (string_pool.h), or (borrow) pointing straight into an input
+// buffer parsed with YYJSON_READ_INSITU.
+struct StringSink {
+    NekkoArena* arena;
+    bool borrow;
+    StringPool* pool = nullptr;
+
+    char* take(const char* s) const {
+        if (!s) return nullptr;
+        if (pool) return pool->intern(s, strlen(s));
+        if (borrow) return (char*)s;
+        return nekko_arena_strdup(arena, s);
+    }
+};
+
+// Specialised per entity in native-schema.h with a `fields` tuple.
+template <typename T>
+struct Schema;
+
+namespace schema_detail {
+    template <typename M>
+    struct member_of;
+
+    template <typename C, typename M>
+    struct member_of<M C::*> {
+        using owner = C;
+        using type = M;
+    };
+
+    template <auto Member>
+    using member_t = typename member_of<decltype(Member)>::type;
+
+    template <typename>
+    inline constexpr bool kUnsupported = false;
+
+    template <typename V>
+    constexpr FieldKind scalar_kind() {
+        if constexpr (std::is_same_v<V, int>) return FieldKind::Int;
+        else if constexpr (std::is_same_v<V, long long>) return FieldKind::Int64;
+        else if constexpr (std::is_same_v<V, bool>) return FieldKind::Bool;
+        else if constexpr (std::is_same_v<V, char*>) return FieldKind::Str;
+        else if constexpr (std::is_same_v<V, double>) return FieldKind::Any;
+        else static_assert(kUnsupported<V>, "no coercion for this member type");
+    }
+}
+
+// --- Descriptors ---
+
+template <auto Member, size_t NKeys>
+struct ScalarField {
+    std::array<const char*, NKeys> keys;
+    static constexpr auto kMember = Member;
+    static constexpr FieldKind kKind = schema_detail::scalar_kind<schema_detail::member_t<Member>>();
+};
+
+// A struct member decoded with its own Schema.
+template <auto Member, size_t NKeys>
+struct ObjectField {
+    std::array<const char*, NKeys> keys;
+    static constexpr auto kMember = Member;
+    static constexpr FieldKind kKind = FieldKind::Any;
+};
+
+// An arena array of structs plus its int count.
+template <auto Items, auto Count, size_t NKeys>
+struct ArrayField {
+    std::array<const char*, NKeys> keys;
+    static constexpr auto kMember = Items;
+    static constexpr FieldKind kKind = FieldKind::Any;
+};
+
+// A nested JSON object whose fields land on the enclosing struct, described
+// by `Sub`, a struct with its own `fields` over the same T.
+template <typename Sub, size_t NKeys>
+struct EmbedField {
+    std::array<const char*, NKeys> keys;
+    using Embedded = Sub;
+    static constexpr FieldKind kKind = FieldKind::Any;
+};
+
+template <auto Member, typename... K>
+constexpr auto field(K... keys) {
+    if constexpr (std::is_class_v<schema_detail::member_t<Member>>) {
+        return ObjectField<Member, sizeof...(K)>{{keys...}};
+    } else {
+        return ScalarField<Member, sizeof...(K)>{{keys...}};
+    }
+}
+
+template <auto Items, auto Count, typename... K>
+constexpr auto array(K... keys) {
+    return ArrayField<Items, Count, sizeof...(K)>{{keys...}};
+}
+
+template <typename Sub, typename... K>
+constexpr auto embed(K... keys) {
+    return EmbedField<Sub, sizeof...(K)>{{keys...}};
+}
+
+// Position of the field for `Member` (an array's items, for an array) in
+// S::fields, which is its bit in a projection mask; -1 if it has none.
+template <typename S, auto Member>
+constexpr int field_bit() {
+    int bit = -1, i = 0;
+    std::apply([&](const auto&... f) {
+        ((void)[&] {
+            using F = std::decay_t<decltype(f)>;
+            if constexpr (requires { F::kMember; }) {
+                if constexpr (std::is_same_v<std::decay_t<decltype(F::kMember)>, decltype(Member)>) {
+                    if (F::kMember == Member) bit = i;
+                }
+            }
+            i++;
+        }(), ...);
+    }, S::fields);
+    return bit;
+}
+
+// Same, for the embed described by `Sub`.
+template <typename S, typename Sub>
+constexpr int embed_bit() {
+    int bit = -1, i = 0;
+    std::apply([&](const auto&... f) {
+        ((void)[&] {
+            using F = std::decay_t<decltype(f)>;
+            if constexpr (requires { typename F::Embedded; }) {
+                if (std::is_same_v<typename F::Embedded, Sub>) bit = i;
+            }
+            i++;
+        }(), ...);
+    }, S::fields);
+    return bit;
+}
+
+// --- Engine ---
+
+// Per-document decoding state. Arrays of the same entity share one key-order
+// hint however deeply they are nested (every section of every subject, say).
+class DecodeEnv {
+public:
+    // `fields` holds a mask per NekkoEntity (nekko_ctx_fields); nullptr
+    // decodes every field. Arrays stop early once `cancel` fires, leaving
+    // the rest of their elements zero.
+    DecodeEnv(NekkoArena* arena, StringSink strings, const uint64_t* fields = nullptr,
+              NekkoCancel* cancel = nullptr)
+        : arena(arena), strings(strings), fields_(fields), cancel_(cancel) {}
+
+    NekkoArena* const arena;
+    const StringSink strings;
+
+    // The fields of `entity` to decode; all of them for -1 (no entity).
+    uint64_t fields_for(int entity) const {
+        return fields_ && entity >= 0 ? fields_[entity] : ~(uint64_t)0;
+    }
+
+    NekkoCancel* cancel() const { return cancel_; }
+    bool cancelled() const { return cancel_requested(cancel_); }
+
+    // nullptr once every hint is taken; decoding then just hashes every key.
+    ShapeHint* hint_for(const void* entity) {
+        for (size_t i = 0; i < count_; i++) {
+            if (entities_[i] == entity) return &hints_[i];
+        }
+        if (count_ == kMaxEntities) return nullptr;
+        entities_[count_] = entity;
+        return &hints_[count_++];
+    }
+
+private:
+    static constexpr size_t kMaxEntities = 8;
+
+    const uint64_t* fields_;
+    NekkoCancel* cancel_;
+    const void* entities_[kMaxEntities] = {};
+    ShapeHint hints_[kMaxEntities];
+    size_t count_ = 0;
+};
+
+template <typename T, typename S = Schema<T>>
+class Decoder {
+    using Fields = std::decay_t<decltype(S::fields)>;
+    static constexpr size_t kSlots = std::tuple_size_v<Fields>;
+    static_assert(kSlots <= 64, "projection masks have 64 bits");
+
+    static constexpr int entity() {
+        if constexpr (requires { S::kEntity; }) return (int)S::kEntity;
+        else return -1;
+    }
+
+    static constexpr size_t alias_count() {
+        return std::apply([](const auto&... f) { return (f.keys.size() + ... + 0); }, S::fields);
+    }
+    static constexpr size_t kAliases = alias_count();
+
+    static constexpr std::array<KeyAlias, kAliases> aliases() {
+        std::array<KeyAlias, kAliases> out = {};
+        size_t n = 0;
+        uint8_t slot = 0;
+        std::apply([&](const auto&... f) {
+            ((void)[&] {
+                for (const char* k : f.keys) out[n++] = {k, slot, f.kKind};
+                slot++;
+            }(), ...);
+        }, S::fields);
+        return out;
+    }
+
+public:
+    static constexpr auto kTable = make_key_table<kSlots>(aliases());
+
+    static void decode(yyjson_val* obj, T* out, DecodeEnv& env, ShapeHint* hint = nullptr) {
+        uint64_t mask = env.fields_for(entity());
+        if (hint) {
+            store(ObjFields(kTable, obj, *hint), mask, out, env, std::make_index_sequence<kSlots>{});
+        } else {
+            store(ObjFields(kTable, obj), mask, out, env, std::make_index_sequence<kSlots>{});
+        }
+    }
+
+    // Fills an arena array with one T per element of `arr`; nullptr (and a
+    // zero count) for anything that is not a non-empty array.
+    static T* decode_array(yyjson_val* arr, int* count, DecodeEnv& env) {
+        *count = 0;
+        if (!yyjson_is_arr(arr)) return nullptr;
+        size_t n = yyjson_arr_size(arr);
+        T* items = arena_array<T>(env.arena, n);
+        if (!items) return nullptr;
+        *count = (int)n;
+        ShapeHint* hint = env.hint_for(&kTable);
+        size_t idx, max;
+        yyjson_val* item;
+        yyjson_arr_foreach(arr, idx, max, item) {
+            if (env.cancelled()) break;
+            decode(item, &items[idx], env, hint);
+        }
+        return items;
+    }
+
+private:
+    template <typename F, size_t... I>
+    static void store(const F& fields, uint64_t mask, T* out, DecodeEnv& env, std::index_sequence<I...>) {
+        ((mask >> I & 1 ? apply(std::get<I>(S::fields), fields[I], out, env) : void()), ...);
+    }
+
+    template <auto Member, size_t N>
+    static void apply(const ScalarField<Member, N>&, yyjson_val* v, T* out, DecodeEnv& env) {
+        if (!v) return;
+        using V = schema_detail::member_t<Member>;
+        if constexpr (std::is_same_v<V, int>) out->*Member = get_json_int(v);
+        else if constexpr (std::is_same_v<V, long long>) out->*Member = get_json_int64(v);
+        else if constexpr (std::is_same_v<V, bool>) out->*Member = yyjson_get_bool(v);
+        else if constexpr (std::is_same_v<V, double>) out->*Member = yyjson_get_num(v);
+        else out->*Member = env.strings.take(yyjson_get_str(v));
+    }
+
+    template <auto Member, size_t N>
+    static void apply(const ObjectField<Member, N>&, yyjson_val* v, T* out, DecodeEnv& env) {
+        if (yyjson_is_obj(v)) Decoder<schema_detail::member_t<Member>>::decode(v, &(out->*Member), env);
+    }
+
+    template <auto Items, auto Count, size_t N>
+    static void apply(const ArrayField<Items, Count, N>&, yyjson_val* v, T* out, DecodeEnv& env) {
+        using Item = std::remove_pointer_t<schema_detail::member_t<Items>>;
+        if (yyjson_is_arr(v)) out->*Items = Decoder<Item>::decode_array(v, &(out->*Count), env);
+    }
+
+    template <typename Sub, size_t N>
+    static void apply(const EmbedField<Sub, N>&, yyjson_val* v, T* out, DecodeEnv& env) {
+        if (yyjson_is_obj(v)) Decoder<T, Sub>::decode(v, out, env);
+    }
+};
+
+#endif // NEKKO_SCHEMA_H
@@ -0,0 +1,82 @@
+#include "string_pool.h"
+
+#include <cstdlib>
+
+namespace {
+    constexpr size_t kMinSlots = 8;
+    constexpr size_t kOwnedMinSlots = 64;
+    constexpr size_t kBytesPerString = 48;
+
+    // FNV-1a; the strings are short, mostly under 40 bytes.
+    uint32_t hash_bytes(const char* s, size_t len) {
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < len; i++) h = (h ^ (uint8_t)s[i]) * 16777619u;
+        return h;
+    }
+}
+
+StringPool::~StringPool() {
+    if (!owned_) return;    // the table lives in `home_`
+    free(slots_);
+    nekko_arena_release(home_);
+}
+
+void StringPool::clear() {
+    if (slots_) memset(slots_, 0, (mask_ + 1) * sizeof(Slot));
+    count_ = 0;
+    // nullptr when out of memory; intern() then starts a new one.
+    if (owned_) home_ = nekko_arena_recycle(home_);
+}
+
+size_t StringPool::slots_for(size_t inputLen) {
+    size_t want = inputLen / kBytesPerString * 2;
+    size_t slots = kMinSlots;
+    while (slots < want && slots < ((size_t)1 << 30)) slots *= 2;
+    return slots;
+}
+
+// Doubles the table, keeping it at most half full. A pool with a home arena
+// takes the table from it, like the strings, and leaves the old one there:
+// the pool lives no longer than one parse, so it costs no heap call. Only
+// the pool a context keeps uses malloc, as clear() recycles its arena.
+bool StringPool::grow() {
+    size_t cap = slots_ ? (mask_ + 1) * 2 : owned_ ? kOwnedMinSlots : firstSlots_;
+    Slot* slots = owned_ ? (Slot*)calloc(cap, sizeof(Slot)) : (Slot*)nekko_arena_calloc(home_, cap, sizeof(Slot));
+    if (!slots) return false;
+    for (size_t i = 0; slots_ && i <= mask_; i++) {
+        if (!slots_[i]) continue;
+        size_t j = hash_bytes(slots_[i], string_pool_len(slots_[i])) & (cap - 1);
+        while (slots[j]) j = (j + 1) & (cap - 1);
+        slots[j] = slots_[i];
+    }
+    if (owned_) free(slots_);
+    slots_ = slots;
+    mask_ = cap - 1;
+    return true;
+}
+
+char* StringPool::intern(const char* s, size_t len) {
+    if (len > UINT32_MAX || count_ == UINT32_MAX) return nullptr;
+    if ((count_ + 1) * 2 > mask_ + 1 && !grow()) return nullptr;
+
+    size_t i = hash_bytes(s, len) & mask_;
+    for (; slots_[i]; i = (i + 1) & mask_) {
+        const char* slot = slots_[i];
+        if (string_pool_len(slot) == len && memcmp(slot, s, len) == 0) return (char*)slot;
+    }
+
+    if (!home_ && owned_) home_ = nekko_arena_create(0);
+    if (!home_) return nullptr;
+    // The length and id sit just before the characters, 4-aligned so Dart
+    // can read the id as a Uint32.
+    const size_t header = 2 * sizeof(uint32_t);
+    char* copy = (char*)nekko_arena_alloc_aligned(home_, header + len + 1, alignof(uint32_t));
+    if (!copy) return nullptr;
+    uint32_t words[2] = {(uint32_t)len, count_++};
+    memcpy(copy, words, header);
+    copy += header;
+    memcpy(copy, s, len);
+    copy[len] = '\0';
+    slots_[i] = copy;
+    return copy;
+}
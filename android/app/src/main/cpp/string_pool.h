@@ -0,0 +1,78 @@
+// Interned strings: equal strings taken through one StringPool come back as
+// the same pointer, copied once. Payloads repeat a few hundred distinct
+// values (buildings, rooms, lecturers, statuses, subject names) across
+// thousands of fields, so this is most of their string bytes.
+//
+// Each copy is preceded by its length and then its id, a uint32 numbering
+// the pool's strings from 0 in the order they were first seen
+// (string_pool_id). A pool kept across calls (NEKKO_CTX_INTERN_STRINGS)
+// hands out the same id for the same string every time, so Dart can keep
+// the decoded String per id.
+#ifndef NEKKO_STRING_POOL_H
+#define NEKKO_STRING_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "arena.h"
+
+class StringPool {
+public:
+    // Copies go to `home`, which must outlive every use of them, and so
+    // does the slot table, sized from `inputLen`, the payload the strings
+    // come from, so that it rarely needs to grow.
+    explicit StringPool(NekkoArena* home, size_t inputLen = 0) : home_(home), firstSlots_(slots_for(inputLen)) {}
+    // Copies go to an arena of the pool's own, kept until clear().
+    StringPool() : owned_(true) {}
+    ~StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // The pooled copy of `s`, NUL-terminated; nullptr when out of memory.
+    char* intern(const char* s, size_t len);
+
+    uint32_t count() const { return count_; }
+
+    // Bytes of the first slot table StringPool(home, inputLen) takes from
+    // `home`, for sizing the arena up front.
+    static size_t table_bytes(size_t inputLen) { return slots_for(inputLen) * sizeof(Slot); }
+
+    // Forgets every string, and frees them if the pool owns its arena.
+    // Ids start again from 0.
+    void clear();
+
+private:
+    // A pooled copy; nullptr when empty. The length is stored in front of
+    // it (string_pool_len), and the hash is taken again when the table grows.
+    using Slot = const char*;
+
+    // The first table for a payload of `inputLen` bytes: room for about one
+    // distinct string per 48 bytes of JSON, at most half full.
+    static size_t slots_for(size_t inputLen);
+
+    bool grow();
+
+    NekkoArena* home_ = nullptr;    // owned: created on first use
+    bool owned_ = false;
+    size_t firstSlots_ = 0;
+    Slot* slots_ = nullptr;
+    size_t mask_ = 0;       // slot count - 1
+    uint32_t count_ = 0;
+};
+
+// The id stored in front of a string from StringPool::intern.
+inline uint32_t string_pool_id(const char* s) {
+    uint32_t id;
+    memcpy(&id, s - sizeof(id), sizeof(id));
+    return id;
+}
+
+// The length stored in front of the id.
+inline uint32_t string_pool_len(const char* s) {
+    uint32_t len;
+    memcpy(&len, s - 2 * sizeof(len), sizeof(len));
+    return len;
+}
+
+#endif // NEKKO_STRING_POOL_H
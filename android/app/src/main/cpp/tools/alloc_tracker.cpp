@@ -0,0 +1,111 @@
+#include "alloc_tracker.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+
+namespace {
+    std::atomic<uint64_t> g_allocs{0};
+    std::atomic<uint64_t> g_frees{0};
+    std::atomic<int64_t> g_live{0};
+    std::atomic<int64_t> g_peak{0};
+    std::atomic<int64_t> g_base{0};
+
+    inline void note_alloc(size_t size) {
+        g_allocs.fetch_add(1, std::memory_order_relaxed);
+        int64_t live = g_live.fetch_add((int64_t)size, std::memory_order_relaxed) + (int64_t)size;
+        int64_t peak = g_peak.load(std::memory_order_relaxed);
+        while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+        }
+    }
+
+    inline void note_free(size_t size) {
+        g_frees.fetch_add(1, std::memory_order_relaxed);
+        g_live.fetch_sub((int64_t)size, std::memory_order_relaxed);
+    }
+}
+
+#if defined(__GLIBC__)
+
+#include <malloc.h>
+
+extern "C" {
+    void* __libc_malloc(size_t size);
+    void* __libc_calloc(size_t n, size_t size);
+    void* __libc_realloc(void* ptr, size_t size);
+    void* __libc_memalign(size_t alignment, size_t size);
+    void __libc_free(void* ptr);
+
+    void* malloc(size_t size) {
+        void* p = __libc_malloc(size);
+        if (p) note_alloc(malloc_usable_size(p));
+        return p;
+    }
+
+    void* calloc(size_t n, size_t size) {
+        void* p = __libc_calloc(n, size);
+        if (p) note_alloc(malloc_usable_size(p));
+        return p;
+    }
+
+    void* realloc(void* ptr, size_t size) {
+        size_t old = ptr ? malloc_usable_size(ptr) : 0;
+        void* p = __libc_realloc(ptr, size);
+        if (p) {
+            if (ptr) note_free(old);
+            note_alloc(malloc_usable_size(p));
+        } else if (ptr && size == 0) {
+            note_free(old);
+        }
+        return p;
+    }
+
+    void* memalign(size_t alignment, size_t size) {
+        void* p = __libc_memalign(alignment, size);
+        if (p) note_alloc(malloc_usable_size(p));
+        return p;
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) {
+        return memalign(alignment, size);
+    }
+
+    int posix_memalign(void** out, size_t alignment, size_t size) {
+        void* p = memalign(alignment, size);
+        if (!p) return ENOMEM;
+        *out = p;
+        return 0;
+    }
+
+    void free(void* ptr) {
+        if (!ptr) return;
+        note_free(malloc_usable_size(ptr));
+        __libc_free(ptr);
+    }
+}
+
+bool alloc_tracker_available() { return true; }
+
+#else
+
+bool alloc_tracker_available() { return false; }
+
+#endif
+
+void alloc_tracker_reset() {
+    g_allocs.store(0, std::memory_order_relaxed);
+    g_frees.store(0, std::memory_order_relaxed);
+    int64_t live = g_live.load(std::memory_order_relaxed);
+    g_base.store(live, std::memory_order_relaxed);
+    g_peak.store(live, std::memory_order_relaxed);
+}
+
+AllocStats alloc_tracker_snapshot() {
+    AllocStats s;
+    int64_t base = g_base.load(std::memory_order_relaxed);
+    s.allocs = g_allocs.load(std::memory_order_relaxed);
+    s.frees = g_frees.load(std::memory_order_relaxed);
+    s.peakBytes = g_peak.load(std::memory_order_relaxed) - base;
+    s.liveBytes = g_live.load(std::memory_order_relaxed) - base;
+    return s;
+}
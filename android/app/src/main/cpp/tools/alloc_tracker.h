@@ -0,0 +1,22 @@
+// Process-wide heap accounting for the host tools.
+// On glibc the malloc family is interposed so every allocation made by the
+// parser core (strdup, yyjson's default allocator, calloc'd arrays) is counted.
+#ifndef NEKKO_TOOLS_ALLOC_TRACKER_H
+#define NEKKO_TOOLS_ALLOC_TRACKER_H
+
+#include <stdint.h>
+
+struct AllocStats {
+    uint64_t allocs;     // malloc/calloc/realloc/memalign calls since reset
+    uint64_t frees;      // free calls (non-null) since reset
+    int64_t peakBytes;   // highest live heap since reset, relative to reset
+    int64_t liveBytes;   // live heap now, relative to reset
+};
+
+// False when the platform has no interposition support (stats stay zero).
+bool alloc_tracker_available();
+
+void alloc_tracker_reset();
+AllocStats alloc_tracker_snapshot();
+
+#endif // NEKKO_TOOLS_ALLOC_TRACKER_H
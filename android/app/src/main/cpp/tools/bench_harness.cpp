@@ -0,0 +1,515 @@
+#include "bench_harness.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <mutex>
+
+#include "alloc_tracker.h"
+#include "native-lib.h"
+#include "yyjson.h"
+
+namespace {
+    // --- Runners: parse, check, free ---
+    // The harness hands out padded buffers, so every runner uses the
+    // length-delimited *_bytes entry point the app uses.
+
+    bool run_exam_schedules(char* json, size_t len, char*, size_t) {
+        ExamScheduleResult* r = parse_exam_schedules_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_exam_schedule_result(r);
+        return ok;
+    }
+
+    bool run_exam_rooms(char* json, size_t len, char*, size_t) {
+        ExamRoomResult* r = parse_exam_rooms_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_exam_room_result(r);
+        return ok;
+    }
+
+    bool run_courses(char* json, size_t len, char*, size_t) {
+        CourseResult* r = parse_courses_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_course_result(r);
+        return ok;
+    }
+
+    bool run_courses_columns(char* json, size_t len, char*, size_t) {
+        CourseColumnsResult* r = parse_courses_columns((uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_course_columns_result(r);
+        return ok;
+    }
+
+    bool run_courses_columns_utf16(char* json, size_t len, char*, size_t) {
+        CourseColumnsResult* r = parse_courses_columns_utf16((uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_course_columns_result(r);
+        return ok;
+    }
+
+    bool run_notifications(char* json, size_t len, char* aux, size_t auxLen) {
+        NotificationResult* r = generate_notifications_bytes((const uint8_t*)json, len,
+                                                             (const uint8_t*)aux, auxLen,
+                                                             1725210000000LL);
+        bool ok = r && !r->errorMessage;
+        free_notification_result(r);
+        return ok;
+    }
+
+    bool run_course_hours(char* json, size_t len, char*, size_t) {
+        CourseHourResult* r = parse_course_hours_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_course_hour_result(r);
+        return ok;
+    }
+
+    bool run_school_years(char* json, size_t len, char*, size_t) {
+        SchoolYearResult* r = parse_school_years_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_school_year_result(r);
+        return ok;
+    }
+
+    bool run_semester(char* json, size_t len, char*, size_t) {
+        SemesterResult* r = parse_semester_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_semester_result(r);
+        return ok;
+    }
+
+    bool run_user(char* json, size_t len, char*, size_t) {
+        UserResult* r = parse_user_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_user_result(r);
+        return ok;
+    }
+
+    bool run_token(char* json, size_t len, char*, size_t) {
+        TokenResponseResult* r = parse_token_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_token_result(r);
+        return ok;
+    }
+
+    bool run_registration(char* json, size_t len, char*, size_t) {
+        RegistrationResult* r = parse_registration_data_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_registration_result(r);
+        return ok;
+    }
+
+    bool run_registration_action(char* json, size_t len, char*, size_t) {
+        RegistrationActionResult* r = parse_registration_action_bytes((const uint8_t*)json, len);
+        bool ok = r != nullptr;
+        free_registration_action_result(r);
+        return ok;
+    }
+
+    bool run_student_marks(char* json, size_t len, char*, size_t) {
+        StudentMarkResult* r = parse_student_marks_bytes((const uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_student_mark_result(r);
+        return ok;
+    }
+
+    // Zero-copy variants: strings borrow from the (padded, insitu) input.
+
+    bool run_exam_rooms_borrowed(char* json, size_t len, char*, size_t) {
+        ExamRoomResult* r = parse_exam_rooms_borrowed((uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_exam_room_result(r);
+        return ok;
+    }
+
+    bool run_school_years_borrowed(char* json, size_t len, char*, size_t) {
+        SchoolYearResult* r = parse_school_years_borrowed((uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_school_year_result(r);
+        return ok;
+    }
+
+    bool run_registration_borrowed(char* json, size_t len, char*, size_t) {
+        RegistrationResult* r = parse_registration_data_borrowed((uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_registration_result(r);
+        return ok;
+    }
+
+    bool run_student_marks_borrowed(char* json, size_t len, char*, size_t) {
+        StudentMarkResult* r = parse_student_marks_borrowed((uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_student_mark_result(r);
+        return ok;
+    }
+
+    // Context variants: one long-lived nekko_ctx, as a caller reusing it for
+    // repeated parses would hold. Strings are copied (no borrow flag).
+
+    nekko_ctx* bench_ctx() {
+        static nekko_ctx* ctx = nekko_ctx_create();
+        return ctx;
+    }
+
+    bool run_exam_rooms_ctx(char* json, size_t len, char*, size_t) {
+        ExamRoomResult* r = parse_exam_rooms_ctx(bench_ctx(), (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_exam_room_result(r);
+        return ok;
+    }
+
+    bool run_courses_ctx(char* json, size_t len, char*, size_t) {
+        CourseResult* r = parse_courses_ctx(bench_ctx(), (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_course_result(r);
+        return ok;
+    }
+
+    bool run_notifications_ctx(char* json, size_t len, char* aux, size_t auxLen) {
+        NotificationResult* r = generate_notifications_ctx(
+            bench_ctx(), (uint8_t*)json, len, (uint8_t*)aux, auxLen, 1725210000000LL);
+        bool ok = r && !r->errorMessage;
+        free_notification_result(r);
+        return ok;
+    }
+
+    bool run_registration_ctx(char* json, size_t len, char*, size_t) {
+        RegistrationResult* r = parse_registration_data_ctx(bench_ctx(), (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_registration_result(r);
+        return ok;
+    }
+
+    bool run_student_marks_ctx(char* json, size_t len, char*, size_t) {
+        StudentMarkResult* r = parse_student_marks_ctx(bench_ctx(), (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_student_mark_result(r);
+        return ok;
+    }
+
+    // Projected variants: a context asking for what one screen shows. The
+    // today widget needs a course's times and room; the registration list
+    // needs names and seat counts, not timetables. Compare with the _ctx
+    // rows: strings are copied, as there.
+
+    constexpr uint64_t bits(std::initializer_list<int> fields) {
+        uint64_t mask = 0;
+        for (int f : fields) mask |= 1ull << f;
+        return mask;
+    }
+
+    // One context per row, so each sizes its region for its own payload.
+    nekko_ctx* projected_ctx() {
+        nekko_ctx* ctx = nekko_ctx_create();
+        nekko_ctx_set_fields(ctx, NEKKO_ENTITY_COURSE, bits({
+            NEKKO_COURSE_FIELD_NAME, NEKKO_COURSE_FIELD_DAY_OF_WEEK, NEKKO_COURSE_FIELD_START_HOUR,
+            NEKKO_COURSE_FIELD_END_HOUR, NEKKO_COURSE_FIELD_ROOM, NEKKO_COURSE_FIELD_BUILDING,
+            NEKKO_COURSE_FIELD_START_DATE, NEKKO_COURSE_FIELD_END_DATE, NEKKO_COURSE_FIELD_FROM_WEEK,
+            NEKKO_COURSE_FIELD_TO_WEEK}));
+        nekko_ctx_set_fields(ctx, NEKKO_ENTITY_SUBJECT, bits({
+            NEKKO_SUBJECT_FIELD_NAME, NEKKO_SUBJECT_FIELD_CREDITS, NEKKO_SUBJECT_FIELD_COURSE_SUBJECTS}));
+        nekko_ctx_set_fields(ctx, NEKKO_ENTITY_COURSE_SUBJECT, bits({
+            NEKKO_COURSE_SUBJECT_FIELD_ID, NEKKO_COURSE_SUBJECT_FIELD_DISPLAY_CODE,
+            NEKKO_COURSE_SUBJECT_FIELD_MAX_STUDENT, NEKKO_COURSE_SUBJECT_FIELD_NUMBER_STUDENT}));
+        return ctx;
+    }
+
+    bool run_courses_today(char* json, size_t len, char*, size_t) {
+        static nekko_ctx* ctx = projected_ctx();
+        CourseResult* r = parse_courses_ctx(ctx, (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_course_result(r);
+        return ok;
+    }
+
+    bool run_registration_list(char* json, size_t len, char*, size_t) {
+        static nekko_ctx* ctx = projected_ctx();
+        RegistrationResult* r = parse_registration_data_ctx(ctx, (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_registration_result(r);
+        return ok;
+    }
+
+    // Document variant: the registration body opened as a doc and asked
+    // for the two subject columns the list shows, instead of parsed whole.
+
+    bool run_registration_doc(char* json, size_t len, char*, size_t) {
+        constexpr size_t kCap = 1024;
+        static const char* names[kCap];
+        static int64_t credits[kCap];
+        NekkoDoc* doc = nekko_doc_open((const uint8_t*)json, len);
+        // Pointers are literal, so the server's PascalCase is tried first.
+        bool pascal = nekko_doc_type(doc, "/CourseRegisterViewObject") == NEKKO_VALUE_OBJECT;
+        const char* subjects = pascal ? "/CourseRegisterViewObject/ListSubjectRegistrationDtos"
+                                      : "/courseRegisterViewObject/listSubjectRegistrationDtos";
+        bool ok = doc && !nekko_doc_error(doc) &&
+                  nekko_doc_extract_string(doc, subjects, pascal ? "/SubjectName" : "/subjectName",
+                                           names, nullptr, kCap) > 0 &&
+                  nekko_doc_extract_int64(doc, subjects, pascal ? "/NumberOfCredit" : "/numberOfCredit",
+                                          credits, nullptr, kCap) > 0;
+        nekko_doc_close(doc);
+        return ok;
+    }
+
+    // Paged variant: what the registration screen waits for before its
+    // first rows, a handle and one page of subjects with sections left in
+    // the body. Compare with registration, which converts everything. The
+    // handle reads its body in place, so the copy open makes is counted
+    // too; the app hands over its buffer instead (open_buffer).
+
+    bool run_registration_page(char* json, size_t len, char*, size_t) {
+        NekkoRegistration* reg = nekko_registration_open((const uint8_t*)json, len);
+        RegistrationResult* page = nekko_registration_page(reg, 0, 20);
+        bool ok = page && !page->errorMessage && nekko_registration_count(reg) > 0;
+        free_registration_result(page);
+        nekko_registration_close(reg);
+        return ok;
+    }
+
+    // Parallel variant: registration_ctx with the subjects shared out to
+    // the worker pool. Same result; on a single core it is registration_ctx
+    // plus the hand-off.
+
+    bool run_registration_parallel(char* json, size_t len, char*, size_t) {
+        static nekko_ctx* ctx = [] {
+            nekko_ctx* c = nekko_ctx_create();
+            nekko_ctx_set_flags(c, NEKKO_CTX_PARALLEL);
+            return c;
+        }();
+        RegistrationResult* r = parse_registration_data_ctx(ctx, (uint8_t*)json, len);
+        bool ok = r && !r->errorMessage;
+        free_registration_result(r);
+        return ok;
+    }
+
+    // Batched variants: every batch is freed as it arrives, as the Dart
+    // side does once it has converted it. A bad batch fails the run.
+
+    constexpr int kBenchBatch = 16;
+
+    template <typename R>
+    void bench_batch(void* user, R* batch, bool, void (*free_result)(R*)) {
+        if (!batch || batch->errorMessage) *(bool*)user = false;
+        free_result(batch);
+    }
+
+    bool run_courses_batched(char* json, size_t len, char*, size_t) {
+        bool ok = true;
+        parse_courses_batched((const uint8_t*)json, len, kBenchBatch,
+                              [](void* user, CourseResult* batch, bool last) {
+                                  bench_batch(user, batch, last, free_course_result);
+                              }, &ok);
+        return ok;
+    }
+
+    bool run_registration_batched(char* json, size_t len, char*, size_t) {
+        bool ok = true;
+        parse_registration_data_batched((const uint8_t*)json, len, kBenchBatch,
+                                        [](void* user, RegistrationResult* batch, bool last) {
+                                            bench_batch(user, batch, last, free_registration_result);
+                                        }, &ok);
+        return ok;
+    }
+
+    // Background variant: submitted and waited for, so it measures the
+    // parse plus the hand-off to a pool thread and back.
+
+    struct JobWait {
+        std::mutex lock;
+        std::condition_variable cv;
+        bool finished = false;
+        bool ok = false;
+    };
+
+    bool run_courses_job(char* json, size_t len, char*, size_t) {
+        uint8_t* buf = nekko_alloc_buffer(len);
+        if (!buf) return false;
+        memcpy(buf, json, len);
+        JobWait wait;
+        auto done = [](void* user, int, int, void* result) {
+            JobWait* w = (JobWait*)user;
+            CourseResult* r = (CourseResult*)result;
+            bool ok = r && !r->errorMessage;
+            free_course_result(r);
+            // Notified under the lock: `w` goes as soon as the waiter wakes.
+            std::lock_guard<std::mutex> guard(w->lock);
+            w->ok = ok;
+            w->finished = true;
+            w->cv.notify_one();
+        };
+        if (!nekko_submit_parse(NEKKO_PARSE_COURSES, buf, len, nullptr, nullptr, done, &wait)) return false;
+        std::unique_lock<std::mutex> lk(wait.lock);
+        wait.cv.wait(lk, [&] { return wait.finished; });
+        return wait.ok;
+    }
+
+    // Chunked variants: the body fed in network-sized pieces with its
+    // length declared up front, then finished. Measures the whole cost; in
+    // the app all but the last step overlaps the download.
+
+    constexpr size_t kBenchChunk = 16 * 1024;
+
+    template <typename R>
+    R* run_stream(const char* json, size_t len, NekkoStream* (*begin)(size_t),
+                  bool (*feed)(NekkoStream*, const uint8_t*, size_t), R* (*finish)(NekkoStream*)) {
+        NekkoStream* s = begin(len);
+        for (size_t off = 0; off < len; off += kBenchChunk) {
+            size_t n = len - off < kBenchChunk ? len - off : kBenchChunk;
+            if (!feed(s, (const uint8_t*)json + off, n)) break;
+        }
+        return finish(s);
+    }
+
+    bool run_courses_stream(char* json, size_t len, char*, size_t) {
+        CourseResult* r = run_stream(json, len, parse_courses_begin, parse_courses_feed, parse_courses_finish);
+        bool ok = r && !r->errorMessage;
+        free_course_result(r);
+        return ok;
+    }
+
+    bool run_exam_rooms_stream(char* json, size_t len, char*, size_t) {
+        ExamRoomResult* r = run_stream(json, len, parse_exam_rooms_begin, parse_exam_rooms_feed, parse_exam_rooms_finish);
+        bool ok = r && !r->errorMessage;
+        free_exam_room_result(r);
+        return ok;
+    }
+
+    bool run_registration_stream(char* json, size_t len, char*, size_t) {
+        RegistrationResult* r = run_stream(json, len, parse_registration_data_begin, parse_registration_data_feed,
+                                           parse_registration_data_finish);
+        bool ok = r && !r->errorMessage;
+        free_registration_result(r);
+        return ok;
+    }
+
+    // Flat variants: the in-place parse plus the copy into one blob (no
+    // relocation; that only happens on the receiving side).
+
+    bool run_school_years_flat(char* json, size_t len, char*, size_t) {
+        NekkoBlob* b = parse_school_years_flat((uint8_t*)json, len);
+        bool ok = b && !((SchoolYearResult*)((char*)b + b->root))->errorMessage;
+        nekko_blob_free(b);
+        return ok;
+    }
+
+    bool run_registration_flat(char* json, size_t len, char*, size_t) {
+        NekkoBlob* b = parse_registration_data_flat((uint8_t*)json, len);
+        bool ok = b && !((RegistrationResult*)((char*)b + b->root))->errorMessage;
+        nekko_blob_free(b);
+        return ok;
+    }
+
+    // Writable copy with the tail padding insitu parsing expects.
+    struct ScratchBuffer {
+        char* data = nullptr;
+        size_t cap = 0;
+
+        ~ScratchBuffer() { ::free(data); }
+
+        char* load(const std::string& src) {
+            size_t need = src.size() + YYJSON_PADDING_SIZE + 1;
+            if (need > cap) {
+                ::free(data);
+                data = (char*)malloc(need);
+                cap = need;
+            }
+            memcpy(data, src.data(), src.size());
+            memset(data + src.size(), 0, YYJSON_PADDING_SIZE + 1);
+            return data;
+        }
+    };
+}
+
+const std::vector<ParserEntry>& parser_registry() {
+    static const std::vector<ParserEntry> entries = {
+        {"exam_schedules", false, run_exam_schedules},
+        {"exam_rooms", false, run_exam_rooms},
+        {"courses", false, run_courses},
+        {"courses_columns", false, run_courses_columns},
+        {"courses_columns_utf16", false, run_courses_columns_utf16},
+        {"notifications", true, run_notifications},
+        {"course_hours", false, run_course_hours},
+        {"school_years", false, run_school_years},
+        {"semester", false, run_semester},
+        {"user", false, run_user},
+        {"token", false, run_token},
+        {"registration", false, run_registration},
+        {"registration_action", false, run_registration_action},
+        {"student_marks", false, run_student_marks},
+        {"exam_rooms_borrowed", false, run_exam_rooms_borrowed},
+        {"school_years_borrowed", false, run_school_years_borrowed},
+        {"registration_borrowed", false, run_registration_borrowed},
+        {"student_marks_borrowed", false, run_student_marks_borrowed},
+        {"exam_rooms_ctx", false, run_exam_rooms_ctx},
+        {"courses_ctx", false, run_courses_ctx},
+        {"notifications_ctx", true, run_notifications_ctx},
+        {"registration_ctx", false, run_registration_ctx},
+        {"student_marks_ctx", false, run_student_marks_ctx},
+        {"courses_stream", false, run_courses_stream},
+        {"exam_rooms_stream", false, run_exam_rooms_stream},
+        {"registration_stream", false, run_registration_stream},
+        {"school_years_flat", false, run_school_years_flat},
+        {"registration_flat", false, run_registration_flat},
+        {"courses_today", false, run_courses_today},
+        {"registration_list", false, run_registration_list},
+        {"registration_doc", false, run_registration_doc},
+        {"registration_page", false, run_registration_page},
+        {"registration_parallel", false, run_registration_parallel},
+        {"courses_batched", false, run_courses_batched},
+        {"registration_batched", false, run_registration_batched},
+        {"courses_job", false, run_courses_job},
+    };
+    return entries;
+}
+
+const ParserEntry* find_parser(const std::string& name) {
+    for (const ParserEntry& e : parser_registry()) {
+        if (name == e.name) return &e;
+    }
+    return nullptr;
+}
+
+Measurement measure_parser(const ParserEntry& parser,
+                           const std::string& json,
+                           const std::string& aux,
+                           double minMillis) {
+    using Clock = std::chrono::steady_clock;
+    Measurement m = {};
+    ScratchBuffer a, b;
+
+    // Two warm-up calls first, so parsers that keep state between calls (the
+    // _ctx rows size their region on the second) are measured in steady
+    // state; then one instrumented pass for heap numbers.
+    char* ja = nullptr;
+    char* jb = nullptr;
+    for (int warm = 0; warm < 3; warm++) {
+        ja = a.load(json);
+        jb = parser.needsAux ? b.load(aux) : nullptr;
+        if (warm < 2) parser.run(ja, json.size(), jb, aux.size());
+    }
+    alloc_tracker_reset();
+    m.ok = parser.run(ja, json.size(), jb, aux.size());
+    AllocStats stats = alloc_tracker_snapshot();
+    m.allocsPerOp = stats.allocs;
+    m.peakBytes = stats.peakBytes;
+    m.leakedBytes = stats.liveBytes;
+
+    Clock::duration spent = Clock::duration::zero();
+    const auto budget = std::chrono::duration<double, std::milli>(minMillis);
+    while (m.iters < 3 || spent < budget) {
+        ja = a.load(json);
+        jb = parser.needsAux ? b.load(aux) : nullptr;
+        auto t0 = Clock::now();
+        parser.run(ja, json.size(), jb, aux.size());
+        spent += Clock::now() - t0;
+        m.iters++;
+    }
+
+    double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(spent).count();
+    m.nsPerOp = ns / (double)m.iters;
+    m.mbPerSec = m.nsPerOp > 0 ? (double)(json.size() + aux.size()) * 1e3 / m.nsPerOp : 0;
+    return m;
+}
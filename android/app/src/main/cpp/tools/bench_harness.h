@@ -0,0 +1,38 @@
+// Parser registry and measurement loop shared by the host tools.
+#ifndef NEKKO_TOOLS_BENCH_HARNESS_H
+#define NEKKO_TOOLS_BENCH_HARNESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+// One exported entry point. `run` parses `json` (and `aux` when `needsAux`),
+// frees the result, and reports whether the parser returned without error.
+// Both buffers are NUL-terminated, writable and padded, so insitu parsers
+// may modify them.
+struct ParserEntry {
+    const char* name;
+    bool needsAux;
+    bool (*run)(char* json, size_t len, char* aux, size_t auxLen);
+};
+
+const std::vector<ParserEntry>& parser_registry();
+const ParserEntry* find_parser(const std::string& name);
+
+struct Measurement {
+    uint64_t iters;
+    double nsPerOp;       // parse + free
+    double mbPerSec;      // input bytes (json + aux) per second
+    uint64_t allocsPerOp;
+    int64_t peakBytes;
+    int64_t leakedBytes;  // live heap left behind by one parse + free
+    bool ok;
+};
+
+Measurement measure_parser(const ParserEntry& parser,
+                           const std::string& json,
+                           const std::string& aux,
+                           double minMillis);
+
+#endif // NEKKO_TOOLS_BENCH_HARNESS_H
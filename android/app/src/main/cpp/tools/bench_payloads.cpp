@@ -0,0 +1,405 @@
+#include "bench_payloads.h"
+
+#include <cstdio>
+
+// --- Fixture data ---
+
+namespace {
+    const char* kSubjects[] = {
+        "Lập trình hướng đối tượng",
+        "Cấu trúc dữ liệu và giải thuật",
+        "Hệ quản trị cơ sở dữ liệu",
+        "Mạng máy tính",
+        "Giải tích 1",
+        "Đại số tuyến tính",
+        "Tư tưởng Hồ Chí Minh",
+        "Kỹ thuật phần mềm",
+    };
+    const char* kLecturers[] = {
+        "Nguyễn Văn An", "Trần Thị Bích Ngọc", "Lê Hoàng Đức", "Phạm Thu Hương",
+    };
+    const char* kBuildings[] = {"A2", "B5", "C1", "TL"};
+
+    const long long kSemesterStart = 1725210000000LL; // 2024-09-01
+    const long long kDay = 86400000LL;
+
+    int tier(BenchSize size, int small, int typical, int worst) {
+        switch (size) {
+            case BenchSize::Small: return small;
+            case BenchSize::Typical: return typical;
+            default: return worst;
+        }
+    }
+
+    std::string room_name(int i) {
+        return std::to_string(200 + (i % 30)) + "-" + kBuildings[i % 4];
+    }
+
+    // Keys the parsers never read; the worst tier pads objects with these to
+    // exercise the linear key scans.
+    void write_noise(JsonWriter& w, BenchSize size, int seed) {
+        if (size != BenchSize::Worst) return;
+        char k[24];
+        for (int i = 0; i < 12; i++) {
+            snprintf(k, sizeof(k), "extraField%02d", i);
+            w.key(k).str(std::string("giá trị phụ ") + std::to_string(seed + i));
+        }
+    }
+
+    void write_course_timetables(JsonWriter& w, int i, int timetables) {
+        w.key("timetables").begin_arr();
+        for (int t = 0; t < timetables; t++) {
+            w.begin_obj();
+            w.key("id").num(i * 100 + t);
+            w.key("weekIndex").num(2 + (i + t) % 6);
+            w.key("fromWeek").num(1 + t);
+            w.key("toWeek").num(15);
+            w.key("startDate").num(kSemesterStart + t * 7 * kDay);
+            w.key("endDate").num(kSemesterStart + 105 * kDay);
+            w.key("startHour").begin_obj().key("id").num(1 + (t * 3) % 12).key("indexNumber").num(1 + (t * 3) % 12).end_obj();
+            w.key("endHour").begin_obj().key("id").num(3 + (t * 3) % 12).key("indexNumber").num(3 + (t * 3) % 12).end_obj();
+            w.key("room").begin_obj()
+                .key("id").num(300 + i)
+                .key("name").str(room_name(i + t))
+                .key("building").begin_obj().key("name").str(kBuildings[(i + t) % 4]).end_obj()
+                .end_obj();
+            w.key("campus").str("Cơ sở Hà Nội");
+            w.end_obj();
+        }
+        w.end_arr();
+    }
+
+    std::string courses_json(BenchSize size, int items, int timetables) {
+        JsonWriter w;
+        w.begin_arr();
+        for (int i = 0; i < items; i++) {
+            w.begin_obj();
+            w.key("id").num(10000 + i);
+            w.key("subjectName").str(kSubjects[i % 8]);
+            w.key("subjectCode").str("CSE" + std::to_string(400 + i));
+            w.key("numberOfCredit").num(2 + i % 3);
+            w.key("status").str(i % 5 == 0 ? "Hoàn thành" : "Đang học");
+            if (i % 4 == 0) w.key("grade").real(7.5 + (i % 3));
+            else w.key("grade").null();
+            write_noise(w, size, i);
+            w.key("courseSubject").begin_obj();
+            w.key("classCode").str("64KTPM" + std::to_string(1 + i % 4));
+            w.key("className").str(std::string(kSubjects[i % 8]) + " - Nhóm " + std::to_string(1 + i % 4));
+            w.key("lecturer").begin_obj()
+                .key("name").str(kLecturers[i % 4])
+                .key("email").str("giangvien" + std::to_string(i % 4) + "@tlu.edu.vn")
+                .end_obj();
+            write_course_timetables(w, i, timetables);
+            w.end_obj();
+            w.end_obj();
+        }
+        w.end_arr();
+        return w.take();
+    }
+
+    std::string course_hours_json(int hours) {
+        JsonWriter w;
+        w.begin_obj().key("content").begin_arr();
+        for (int i = 0; i < hours; i++) {
+            int startMin = 7 * 60 + i * 55;
+            int endMin = startMin + 50;
+            char start[8], end[8];
+            snprintf(start, sizeof(start), "%02d:%02d", (startMin / 60) % 24, startMin % 60);
+            snprintf(end, sizeof(end), "%02d:%02d", (endMin / 60) % 24, endMin % 60);
+            w.begin_obj();
+            w.key("id").num(i + 1);
+            w.key("name").str("Tiết " + std::to_string(i + 1));
+            w.key("startString").str(start);
+            w.key("endString").str(end);
+            w.key("indexNumber").num(i + 1);
+            w.end_obj();
+        }
+        w.end_arr().key("totalElements").num(hours).end_obj();
+        return w.take();
+    }
+
+    void write_register_period(JsonWriter& w, int i, bool pascal) {
+        w.begin_obj();
+        w.key(pascal ? "Id" : "id").num(500 + i);
+        w.key(pascal ? "Name" : "name").str("Đợt đăng ký " + std::to_string(i + 1));
+        w.key(pascal ? "StartRegisterTime" : "startRegisterTime").num(kSemesterStart - (20 - i) * kDay);
+        w.key(pascal ? "EndRegisterTime" : "endRegisterTime").num(kSemesterStart - (10 - i) * kDay);
+        w.key(pascal ? "EndUnRegisterTime" : "endUnRegisterTime").num(kSemesterStart - (5 - i) * kDay);
+        w.key(pascal ? "StartRegisterTimeString" : "startRegisterTimeString").str("12/08/2024 08:00");
+        w.key(pascal ? "EndRegisterTimeString" : "endRegisterTimeString").str("22/08/2024 17:00");
+        w.key(pascal ? "EndUnRegisterTimeString" : "endUnRegisterTimeString").str("27/08/2024 17:00");
+        w.end_obj();
+    }
+
+    void write_semester_body(JsonWriter& w, int i, int periods, bool pascal) {
+        w.key("id").num(40 + i);
+        w.key("semesterCode").str("2_2024_2025_" + std::to_string(i));
+        w.key("semesterName").str("Học kỳ " + std::to_string(1 + i % 3) + " năm học 2024-2025");
+        w.key("startDate").num(kSemesterStart + i * 120 * kDay);
+        w.key("endDate").num(kSemesterStart + (i * 120 + 110) * kDay);
+        w.key("isCurrent").boolean(i == 0);
+        w.key("ordinalNumbers").num(1 + i % 3);
+        w.key("semesterRegisterPeriods").begin_arr();
+        for (int p = 0; p < periods; p++) write_register_period(w, p, pascal);
+        w.end_arr();
+    }
+}
+
+const char* bench_size_name(BenchSize size) {
+    switch (size) {
+        case BenchSize::Small: return "small";
+        case BenchSize::Typical: return "typical";
+        default: return "worst";
+    }
+}
+
+BenchPayload bench_payload_exam_schedules(BenchSize size) {
+    int schedules = tier(size, 1, 4, 120);
+    int periods = tier(size, 1, 3, 12);
+    JsonWriter w;
+    w.begin_arr();
+    for (int i = 0; i < schedules; i++) {
+        w.begin_obj();
+        w.key("id").num(i + 1);
+        w.key("name").str("Lịch thi học kỳ " + std::to_string(1 + i % 3));
+        w.key("displayOrder").num(i);
+        w.key("voided").boolean(false);
+        write_noise(w, size, i);
+        w.key("examPeriods").begin_arr();
+        for (int p = 0; p < periods; p++) {
+            w.begin_obj();
+            w.key("id").num(i * 100 + p);
+            w.key("examPeriodCode").str("DT" + std::to_string(p + 1) + "_HK1_2024");
+            w.key("name").str("Đợt thi " + std::to_string(p + 1));
+            w.key("startDate").num(kSemesterStart + (110 + p * 7) * kDay);
+            w.key("endDate").num(kSemesterStart + (116 + p * 7) * kDay);
+            w.key("numberOfExamDays").num(6);
+            w.key("bookingStatus").begin_obj().key("id").num(1).key("name").str("Đã duyệt").end_obj();
+            w.end_obj();
+        }
+        w.end_arr();
+        w.end_obj();
+    }
+    w.end_arr();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_exam_rooms(BenchSize size) {
+    int rooms = tier(size, 1, 12, 2000);
+    JsonWriter w;
+    w.begin_arr();
+    for (int i = 0; i < rooms; i++) {
+        w.begin_obj();
+        w.key("id").num(70000 + i);
+        w.key("subjectName").str(kSubjects[i % 8]);
+        w.key("examPeriodCode").str("DT1_HK1_2024");
+        w.key("examCode").str("EX" + std::to_string(1000 + i));
+        w.key("studentCode").str("2251172" + std::to_string(100 + i % 900));
+        write_noise(w, size, i);
+        w.key("examRoom").begin_obj();
+        w.key("examDate").num(kSemesterStart + (112 + i % 10) * kDay);
+        // Every third room lacks startHour so the roomCode fallback runs.
+        if (i % 3 != 0) {
+            w.key("startHour").begin_obj().key("startString").str("07:30").end_obj();
+        }
+        w.key("roomCode").str("CSE" + std::to_string(400 + i % 50) + "_08-11-2025_10-12_" + room_name(i));
+        w.key("room").begin_obj()
+            .key("name").str(room_name(i))
+            .key("building").begin_obj().key("name").str(kBuildings[i % 4]).end_obj()
+            .end_obj();
+        w.key("examMethod").begin_obj().key("name").str(i % 2 ? "Tự luận" : "Trắc nghiệm").end_obj();
+        w.key("notes").str(i % 7 == 0 ? "Mang theo thẻ sinh viên" : "");
+        w.key("numberExpectedStudent").num(40 + i % 20);
+        w.end_obj();
+        w.end_obj();
+    }
+    w.end_arr();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_courses(BenchSize size) {
+    return {courses_json(size, tier(size, 1, 10, 400), tier(size, 1, 2, 6)), ""};
+}
+
+BenchPayload bench_payload_notifications(BenchSize size) {
+    return {courses_json(size, tier(size, 1, 10, 400), tier(size, 1, 2, 6)), course_hours_json(16)};
+}
+
+BenchPayload bench_payload_course_hours(BenchSize size) {
+    return {course_hours_json(tier(size, 1, 16, 400)), ""};
+}
+
+BenchPayload bench_payload_school_years(BenchSize size) {
+    int years = tier(size, 1, 6, 60);
+    int sems = tier(size, 1, 3, 3);
+    int periods = tier(size, 1, 2, 10);
+    JsonWriter w;
+    w.begin_obj().key("content").begin_arr();
+    for (int y = 0; y < years; y++) {
+        w.begin_obj();
+        w.key("id").num(y + 1);
+        w.key("name").str("Năm học " + std::to_string(2019 + y) + "-" + std::to_string(2020 + y));
+        w.key("code").str(std::to_string(2019 + y) + "_" + std::to_string(2020 + y));
+        w.key("displayName").str(std::to_string(2019 + y) + "-" + std::to_string(2020 + y));
+        w.key("year").num(2019 + y);
+        w.key("current").boolean(y == years - 1);
+        w.key("startDate").num(kSemesterStart + (y - years) * 365 * kDay);
+        w.key("endDate").num(kSemesterStart + (y - years + 1) * 365 * kDay);
+        write_noise(w, size, y);
+        w.key("semesters").begin_arr();
+        for (int s = 0; s < sems; s++) {
+            w.begin_obj();
+            write_semester_body(w, y * 3 + s, periods, false);
+            w.end_obj();
+        }
+        w.end_arr();
+        w.end_obj();
+    }
+    w.end_arr().end_obj();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_semester(BenchSize size) {
+    JsonWriter w;
+    w.begin_obj();
+    write_semester_body(w, 0, tier(size, 0, 2, 200), size == BenchSize::Worst);
+    write_noise(w, size, 0);
+    w.end_obj();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_user(BenchSize size) {
+    JsonWriter w;
+    w.begin_obj();
+    write_noise(w, size, 0);
+    w.key("username").str("2251172123");
+    w.key("displayName").str("Nguyễn Thị Minh Anh");
+    w.key("email").str("2251172123@e.tlu.edu.vn");
+    if (size != BenchSize::Small) {
+        w.key("roles").begin_arr();
+        for (int i = 0; i < tier(size, 0, 2, 50); i++) w.str("ROLE_STUDENT_" + std::to_string(i));
+        w.end_arr();
+    }
+    // The worst tier uses the PascalCase variant so both fallbacks run.
+    w.key(size == BenchSize::Worst ? "Person" : "person").begin_obj()
+        .key(size == BenchSize::Worst ? "Id" : "id").num(98765)
+        .key("fullName").str("Nguyễn Thị Minh Anh")
+        .end_obj();
+    w.end_obj();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_token(BenchSize size) {
+    std::string access(tier(size, 32, 900, 8000), 'a');
+    JsonWriter w;
+    w.begin_obj();
+    w.key("access_token").str(access);
+    w.key("token_type").str("bearer");
+    w.key("refresh_token").str(std::string(tier(size, 32, 900, 8000), 'r'));
+    w.key("expires_in").num(86399);
+    w.key("scope").str("read write trust");
+    write_noise(w, size, 0);
+    w.end_obj();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_registration(BenchSize size) {
+    int subjects = tier(size, 1, 40, 400);
+    int sections = tier(size, 1, 6, 20);
+    int timetables = tier(size, 1, 2, 3);
+    // The server sends PascalCase; the worst tier uses camelCase so every
+    // field goes through its fallback lookup.
+    bool pascal = size != BenchSize::Worst;
+    JsonWriter w;
+    w.begin_obj();
+    w.key(pascal ? "Id" : "id").num(77);
+    w.key(pascal ? "CourseRegisterViewObject" : "courseRegisterViewObject").begin_obj();
+    w.key(pascal ? "ListSubjectRegistrationDtos" : "listSubjectRegistrationDtos").begin_arr();
+    for (int s = 0; s < subjects; s++) {
+        w.begin_obj();
+        w.key(pascal ? "SubjectName" : "subjectName").str(kSubjects[s % 8]);
+        w.key(pascal ? "NumberOfCredit" : "numberOfCredit").num(2 + s % 3);
+        write_noise(w, size, s);
+        w.key(pascal ? "CourseSubjectDtos" : "courseSubjectDtos").begin_arr();
+        for (int c = 0; c < sections; c++) {
+            int id = s * 100 + c;
+            w.begin_obj();
+            w.key(pascal ? "Id" : "id").num(id);
+            w.key(pascal ? "Code" : "code").str("CSE" + std::to_string(400 + s) + "." + std::to_string(c + 1));
+            w.key(pascal ? "DisplayCode" : "displayCode").str(std::string(kSubjects[s % 8]) + "-" + std::to_string(c + 1));
+            w.key(pascal ? "MaxStudent" : "maxStudent").num(60);
+            w.key(pascal ? "NumberStudent" : "numberStudent").num((id * 7) % 61);
+            w.key(pascal ? "IsSelected" : "isSelected").boolean(c == 0);
+            w.key(pascal ? "IsFullClass" : "isFullClass").boolean((id * 7) % 61 == 60);
+            w.key(pascal ? "IsOvelapTime" : "isOvelapTime").boolean(c % 5 == 4);
+            w.key(pascal ? "SubjectId" : "subjectId").num(900 + s);
+            w.key(pascal ? "NumberOfCredit" : "numberOfCredit").num(2 + s % 3);
+            w.key(pascal ? "Status" : "status").str(c % 3 ? "new" : "full");
+            write_noise(w, size, id);
+            w.key(pascal ? "Timetables" : "timetables").begin_arr();
+            for (int t = 0; t < timetables; t++) {
+                w.begin_obj();
+                w.key("id").num(id * 10 + t);
+                w.key("startDate").num(kSemesterStart);
+                w.key("endDate").num(kSemesterStart + 105 * kDay);
+                w.key("fromWeek").num(1);
+                w.key("toWeek").num(15);
+                w.key("weekIndex").num(2 + (c + t) % 6);
+                w.key("startHour").begin_obj().key("id").num(1 + t * 3).key("indexNumber").num(1 + t * 3).end_obj();
+                w.key("endHour").begin_obj().key("id").num(3 + t * 3).key("indexNumber").num(3 + t * 3).end_obj();
+                w.key("room").begin_obj().key("id").num(300 + c).end_obj();
+                w.key("roomName").str(room_name(c + t));
+                w.key("teacherName").str(kLecturers[(s + c) % 4]);
+                w.end_obj();
+            }
+            w.end_arr();
+            w.end_obj();
+        }
+        w.end_arr();
+        w.end_obj();
+    }
+    w.end_arr();
+    w.end_obj();
+    w.end_obj();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_registration_action(BenchSize size) {
+    JsonWriter w;
+    w.begin_obj();
+    write_noise(w, size, 0);
+    w.key(size == BenchSize::Worst ? "Status" : "status").num(200);
+    w.key(size == BenchSize::Worst ? "Message" : "message").str("Đăng ký thành công lớp học phần");
+    w.end_obj();
+    return {w.take(), ""};
+}
+
+BenchPayload bench_payload_student_marks(BenchSize size) {
+    int marks = tier(size, 1, 60, 2000);
+    JsonWriter w;
+    w.begin_arr();
+    for (int i = 0; i < marks; i++) {
+        w.begin_obj();
+        w.key("mark").real(6.0 + (i % 40) / 10.0);
+        w.key("markQT").real(7.0 + (i % 30) / 10.0);
+        w.key("markTHI").real(5.5 + (i % 45) / 10.0);
+        w.key("charMark").str(i % 3 ? "B+" : "A");
+        w.key("studyTime").num(1);
+        w.key("examRound").num(1 + i % 2);
+        write_noise(w, size, i);
+        w.key("subject").begin_obj()
+            .key("subjectCode").str("CSE" + std::to_string(400 + i))
+            .key("subjectName").str(kSubjects[i % 8])
+            .key("numberOfCredit").num(2 + i % 3)
+            .key("isCalculateMark").boolean(i % 9 != 0)
+            .end_obj();
+        w.key("semester").begin_obj()
+            .key("id").num(40 + i / 8)
+            .key("semesterCode").str("1_2024_2025")
+            .key("semesterName").str("Học kỳ 1 năm học 2024-2025")
+            .end_obj();
+        w.end_obj();
+    }
+    w.end_arr();
+    return {w.take(), ""};
+}
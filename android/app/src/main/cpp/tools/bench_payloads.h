@@ -0,0 +1,34 @@
+// Payload fixtures for nekko_bench, shaped like the TLU API responses each
+// parser consumes. Sizes are fixed per tier so runs are comparable.
+#ifndef NEKKO_TOOLS_BENCH_PAYLOADS_H
+#define NEKKO_TOOLS_BENCH_PAYLOADS_H
+
+#include <string>
+
+#include "json_writer.h"
+
+enum class BenchSize { Small, Typical, Worst };
+
+const char* bench_size_name(BenchSize size);
+
+// One JSON body per endpoint. `aux` is only used by generate_notifications
+// (course hours JSON).
+struct BenchPayload {
+    std::string json;
+    std::string aux;
+};
+
+BenchPayload bench_payload_exam_schedules(BenchSize size);
+BenchPayload bench_payload_exam_rooms(BenchSize size);
+BenchPayload bench_payload_courses(BenchSize size);
+BenchPayload bench_payload_notifications(BenchSize size);
+BenchPayload bench_payload_course_hours(BenchSize size);
+BenchPayload bench_payload_school_years(BenchSize size);
+BenchPayload bench_payload_semester(BenchSize size);
+BenchPayload bench_payload_user(BenchSize size);
+BenchPayload bench_payload_token(BenchSize size);
+BenchPayload bench_payload_registration(BenchSize size);
+BenchPayload bench_payload_registration_action(BenchSize size);
+BenchPayload bench_payload_student_marks(BenchSize size);
+
+#endif // NEKKO_TOOLS_BENCH_PAYLOADS_H
@@ -0,0 +1,65 @@
+#include "json_writer.h"
+
+#include <cstdio>
+
+void JsonWriter::sep() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (!first.empty()) {
+        if (!first.back()) buf += ',';
+        first.back() = false;
+    }
+}
+
+JsonWriter& JsonWriter::begin_obj() { sep(); buf += '{'; first.push_back(true); return *this; }
+JsonWriter& JsonWriter::end_obj() { buf += '}'; first.pop_back(); return *this; }
+JsonWriter& JsonWriter::begin_arr() { sep(); buf += '['; first.push_back(true); return *this; }
+JsonWriter& JsonWriter::end_arr() { buf += ']'; first.pop_back(); return *this; }
+
+JsonWriter& JsonWriter::key(const char* k) {
+    sep();
+    buf += '"';
+    buf += k;
+    buf += "\":";
+    afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::str(const std::string& v) {
+    sep();
+    buf += '"';
+    for (unsigned char c : v) {
+        switch (c) {
+            case '"': buf += "\\\""; break;
+            case '\\': buf += "\\\\"; break;
+            case '\n': buf += "\\n"; break;
+            case '\r': buf += "\\r"; break;
+            case '\t': buf += "\\t"; break;
+            default:
+                if (c < 0x20) {
+                    char esc[8];
+                    snprintf(esc, sizeof(esc), "\\u%04x", c);
+                    buf += esc;
+                } else {
+                    buf += (char)c;
+                }
+        }
+    }
+    buf += '"';
+    return *this;
+}
+
+JsonWriter& JsonWriter::num(long long v) { sep(); buf += std::to_string(v); return *this; }
+
+JsonWriter& JsonWriter::real(double v) {
+    sep();
+    char tmp[32];
+    snprintf(tmp, sizeof(tmp), "%.2f", v);
+    buf += tmp;
+    return *this;
+}
+
+JsonWriter& JsonWriter::boolean(bool v) { sep(); buf += v ? "true" : "false"; return *this; }
+JsonWriter& JsonWriter::null() { sep(); buf += "null"; return *this; }
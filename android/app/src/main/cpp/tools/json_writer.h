@@ -0,0 +1,32 @@
+// Minimal streaming JSON writer for the host tools' payload builders.
+#ifndef NEKKO_TOOLS_JSON_WRITER_H
+#define NEKKO_TOOLS_JSON_WRITER_H
+
+#include <string>
+#include <vector>
+
+// Appends tokens directly to a string (no DOM); commas are inserted automatically.
+class JsonWriter {
+public:
+    JsonWriter& begin_obj();
+    JsonWriter& end_obj();
+    JsonWriter& begin_arr();
+    JsonWriter& end_arr();
+    JsonWriter& key(const char* k);
+    JsonWriter& str(const std::string& v);
+    JsonWriter& num(long long v);
+    JsonWriter& real(double v);
+    JsonWriter& boolean(bool v);
+    JsonWriter& null();
+
+    const std::string& out() const { return buf; }
+    std::string take() { return std::move(buf); }
+
+private:
+    void sep();
+    std::string buf;
+    std::vector<bool> first;
+    bool afterKey = false;
+};
+
+#endif // NEKKO_TOOLS_JSON_WRITER_H
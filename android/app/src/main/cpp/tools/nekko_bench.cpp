@@ -0,0 +1,175 @@
+// nekko_bench: times every exported parser over small / typical / worst-case
+// payloads and reports ns/op, MB/s, allocations and peak heap per call.
+//
+//   nekko_bench [--filter <substr>] [--size small|typical|worst|all]
+//               [--scale <x>[,<x>...]] [--seed <n>] [--min-ms <n>] [--csv]
+//
+// --scale switches from the fixed fixtures to nekko_gen payloads at the given
+// multiples of a real semester (e.g. --scale 10,100,1000).
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "alloc_tracker.h"
+#include "bench_harness.h"
+#include "bench_payloads.h"
+#include "payload_gen.h"
+
+namespace {
+    struct PayloadSource {
+        const char* parser;
+        BenchPayload (*make)(BenchSize);
+        GenEndpoint gen;
+    };
+
+    const PayloadSource kSources[] = {
+        {"exam_schedules", bench_payload_exam_schedules, GenEndpoint::ExamSchedules},
+        {"exam_rooms", bench_payload_exam_rooms, GenEndpoint::ExamRooms},
+        {"courses", bench_payload_courses, GenEndpoint::Courses},
+        {"notifications", bench_payload_notifications, GenEndpoint::Courses},
+        {"course_hours", bench_payload_course_hours, GenEndpoint::CourseHours},
+        {"school_years", bench_payload_school_years, GenEndpoint::SchoolYears},
+        {"semester", bench_payload_semester, GenEndpoint::Semester},
+        {"user", bench_payload_user, GenEndpoint::User},
+        {"token", bench_payload_token, GenEndpoint::Token},
+        {"registration", bench_payload_registration, GenEndpoint::Registration},
+        {"registration_action", bench_payload_registration_action, GenEndpoint::RegistrationAction},
+        {"student_marks", bench_payload_student_marks, GenEndpoint::StudentMarks},
+        {"exam_rooms_borrowed", bench_payload_exam_rooms, GenEndpoint::ExamRooms},
+        {"school_years_borrowed", bench_payload_school_years, GenEndpoint::SchoolYears},
+        {"registration_borrowed", bench_payload_registration, GenEndpoint::Registration},
+        {"student_marks_borrowed", bench_payload_student_marks, GenEndpoint::StudentMarks},
+        {"exam_rooms_ctx", bench_payload_exam_rooms, GenEndpoint::ExamRooms},
+        {"courses_ctx", bench_payload_courses, GenEndpoint::Courses},
+        {"notifications_ctx", bench_payload_notifications, GenEndpoint::Courses},
+        {"registration_ctx", bench_payload_registration, GenEndpoint::Registration},
+        {"student_marks_ctx", bench_payload_student_marks, GenEndpoint::StudentMarks},
+        {"courses_stream", bench_payload_courses, GenEndpoint::Courses},
+        {"exam_rooms_stream", bench_payload_exam_rooms, GenEndpoint::ExamRooms},
+        {"registration_stream", bench_payload_registration, GenEndpoint::Registration},
+        {"courses_columns", bench_payload_courses, GenEndpoint::Courses},
+        {"courses_columns_utf16", bench_payload_courses, GenEndpoint::Courses},
+        {"school_years_flat", bench_payload_school_years, GenEndpoint::SchoolYears},
+        {"registration_flat", bench_payload_registration, GenEndpoint::Registration},
+        {"courses_today", bench_payload_courses, GenEndpoint::Courses},
+        {"registration_list", bench_payload_registration, GenEndpoint::Registration},
+        {"registration_doc", bench_payload_registration, GenEndpoint::Registration},
+        {"registration_page", bench_payload_registration, GenEndpoint::Registration},
+        {"registration_parallel", bench_payload_registration, GenEndpoint::Registration},
+        {"courses_batched", bench_payload_courses, GenEndpoint::Courses},
+        {"registration_batched", bench_payload_registration, GenEndpoint::Registration},
+        {"courses_job", bench_payload_courses, GenEndpoint::Courses},
+    };
+
+    // One row of the run: a payload plus the label shown in the size column.
+    struct BenchRun {
+        std::string label;
+        BenchPayload payload;
+    };
+
+    std::vector<BenchRun> make_runs(const PayloadSource& src,
+                                    const std::vector<BenchSize>& sizes,
+                                    const std::vector<double>& scales,
+                                    uint64_t seed) {
+        std::vector<BenchRun> runs;
+        if (scales.empty()) {
+            for (BenchSize size : sizes) runs.push_back({bench_size_name(size), src.make(size)});
+            return runs;
+        }
+        for (double scale : scales) {
+            GenOptions opt;
+            opt.seed = seed;
+            opt.scale = scale;
+            BenchPayload payload = {generate_payload(src.gen, opt), ""};
+            if (src.make == bench_payload_notifications) {
+                GenOptions hours;
+                hours.seed = seed;
+                payload.aux = generate_payload(GenEndpoint::CourseHours, hours);
+            }
+            char label[32];
+            snprintf(label, sizeof(label), "x%g", scale);
+            runs.push_back({label, std::move(payload)});
+        }
+        return runs;
+    }
+
+    void usage() {
+        fprintf(stderr,
+                "usage: nekko_bench [--filter <substr>] [--size small|typical|worst|all]\n"
+                "                   [--scale <x>[,<x>...]] [--seed <n>] [--min-ms <n>] [--csv]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    std::string filter;
+    std::string sizeArg = "all";
+    std::vector<double> scales;
+    uint64_t seed = 1;
+    double minMs = 200.0;
+    bool csv = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--filter") && i + 1 < argc) filter = argv[++i];
+        else if (!strcmp(argv[i], "--size") && i + 1 < argc) sizeArg = argv[++i];
+        else if (!strcmp(argv[i], "--scale") && i + 1 < argc) {
+            for (char* tok = strtok(argv[++i], ","); tok; tok = strtok(nullptr, ",")) {
+                scales.push_back(atof(tok));
+            }
+        }
+        else if (!strcmp(argv[i], "--seed") && i + 1 < argc) seed = strtoull(argv[++i], nullptr, 10);
+        else if (!strcmp(argv[i], "--min-ms") && i + 1 < argc) minMs = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--csv")) csv = true;
+        else { usage(); return 2; }
+    }
+
+    std::vector<BenchSize> sizes;
+    if (sizeArg == "all" || sizeArg == "small") sizes.push_back(BenchSize::Small);
+    if (sizeArg == "all" || sizeArg == "typical") sizes.push_back(BenchSize::Typical);
+    if (sizeArg == "all" || sizeArg == "worst") sizes.push_back(BenchSize::Worst);
+    if (sizes.empty()) { usage(); return 2; }
+
+    if (!alloc_tracker_available()) {
+        fprintf(stderr, "note: allocation tracking unavailable on this platform\n");
+    }
+
+    if (csv) {
+        printf("parser,size,bytes,iters,ns_per_op,mb_per_s,allocs_per_op,peak_bytes\n");
+    } else {
+        printf("%-24s %-8s %10s %8s %12s %9s %10s %12s\n",
+               "parser", "size", "bytes", "iters", "ns/op", "MB/s", "allocs/op", "peak bytes");
+    }
+
+    int failures = 0;
+    for (const PayloadSource& src : kSources) {
+        if (!filter.empty() && !strstr(src.parser, filter.c_str())) continue;
+        const ParserEntry* parser = find_parser(src.parser);
+        if (!parser) continue;
+
+        for (const BenchRun& run : make_runs(src, sizes, scales, seed)) {
+            const BenchPayload& payload = run.payload;
+            Measurement m = measure_parser(*parser, payload.json, payload.aux, minMs);
+            size_t bytes = payload.json.size() + payload.aux.size();
+
+            if (csv) {
+                printf("%s,%s,%zu,%llu,%.1f,%.2f,%llu,%lld\n",
+                       src.parser, run.label.c_str(), bytes,
+                       (unsigned long long)m.iters, m.nsPerOp, m.mbPerSec,
+                       (unsigned long long)m.allocsPerOp, (long long)m.peakBytes);
+            } else {
+                printf("%-24s %-8s %10zu %8llu %12.1f %9.2f %10llu %12lld%s\n",
+                       src.parser, run.label.c_str(), bytes,
+                       (unsigned long long)m.iters, m.nsPerOp, m.mbPerSec,
+                       (unsigned long long)m.allocsPerOp, (long long)m.peakBytes,
+                       m.ok ? "" : "  [parse error]");
+            }
+            if (m.leakedBytes != 0) {
+                fprintf(stderr, "warning: %s/%s leaked %lld bytes per call\n",
+                        src.parser, run.label.c_str(), (long long)m.leakedBytes);
+            }
+            if (!m.ok) failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
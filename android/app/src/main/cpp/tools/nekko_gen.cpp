@@ -0,0 +1,83 @@
+// nekko_gen: writes deterministic synthetic TLU payloads.
+//
+//   nekko_gen <endpoint|all> [--seed <n>] [--scale <x>] [--timetables <n>]
+//             [--subjects <m>] [--sections <k>] [--register-periods <n>]
+//             [--casing-mix <p>] [--vi-density <p>] [-o <file|dir>]
+//
+// With a single endpoint the JSON goes to stdout (or -o <file>); with `all`
+// one <endpoint>.json per endpoint is written into the -o directory.
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "payload_gen.h"
+
+namespace {
+    void usage() {
+        fprintf(stderr,
+                "usage: nekko_gen <endpoint|all> [--seed <n>] [--scale <x>] [--timetables <n>]\n"
+                "                 [--subjects <m>] [--sections <k>] [--register-periods <n>]\n"
+                "                 [--casing-mix <p>] [--vi-density <p>] [-o <file|dir>]\n"
+                "endpoints:");
+        for (int i = 0; i < kGenEndpointCount; i++) {
+            fprintf(stderr, " %s", gen_endpoint_name((GenEndpoint)i));
+        }
+        fprintf(stderr, "\n");
+    }
+
+    bool write_file(const std::string& path, const std::string& data) {
+        FILE* f = fopen(path.c_str(), "wb");
+        if (!f) {
+            fprintf(stderr, "cannot open %s\n", path.c_str());
+            return false;
+        }
+        bool ok = fwrite(data.data(), 1, data.size(), f) == data.size();
+        ok = fclose(f) == 0 && ok;
+        if (!ok) fprintf(stderr, "write failed: %s\n", path.c_str());
+        return ok;
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { usage(); return 2; }
+
+    const char* target = argv[1];
+    GenOptions opt;
+    std::string out;
+
+    for (int i = 2; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!v) { usage(); return 2; }
+        if (!strcmp(a, "--seed")) opt.seed = strtoull(v, nullptr, 10);
+        else if (!strcmp(a, "--scale")) opt.scale = atof(v);
+        else if (!strcmp(a, "--timetables")) opt.timetablesPerCourse = atoi(v);
+        else if (!strcmp(a, "--subjects")) opt.subjects = atoi(v);
+        else if (!strcmp(a, "--sections")) opt.sectionsPerSubject = atoi(v);
+        else if (!strcmp(a, "--register-periods")) opt.registerPeriods = atoi(v);
+        else if (!strcmp(a, "--casing-mix")) opt.casingMix = atof(v);
+        else if (!strcmp(a, "--vi-density")) opt.vietnameseDensity = atof(v);
+        else if (!strcmp(a, "-o")) out = v;
+        else { usage(); return 2; }
+        i++;
+    }
+
+    if (!strcmp(target, "all")) {
+        if (out.empty()) {
+            fprintf(stderr, "`all` needs -o <dir>\n");
+            return 2;
+        }
+        for (int i = 0; i < kGenEndpointCount; i++) {
+            GenEndpoint e = (GenEndpoint)i;
+            if (!write_file(out + "/" + gen_endpoint_name(e) + ".json", generate_payload(e, opt))) return 1;
+        }
+        return 0;
+    }
+
+    GenEndpoint endpoint;
+    if (!gen_endpoint_from_name(target, &endpoint)) { usage(); return 2; }
+    std::string json = generate_payload(endpoint, opt);
+    if (!out.empty()) return write_file(out, json) ? 0 : 1;
+    return fwrite(json.data(), 1, json.size(), stdout) == json.size() ? 0 : 1;
+}
@@ -0,0 +1,268 @@
+// nekko_replay: runs a directory of captured API responses through the
+// parsers and compares time and heap use against a checked-in baseline.
+//
+//   nekko_replay [<corpus-dir>] [--baseline <file>] [--tolerance <frac>]
+//                [--alloc-tolerance <frac>] [--peak-tolerance <frac>]
+//                [--rounds <n>] [--min-ms <n>] [--write-baseline]
+//
+// Corpus files are named `<parser>.<tag>.json`, where <parser> is a name from
+// parser_registry(). Parsers that take a second document (notifications) read
+// it from `<parser>.<tag>.aux.json`.
+//
+// Exit status is 0 when every file is within tolerance, 1 when any file is
+// slower, allocates more, or changes its ok/error outcome, and 2 on usage or
+// I/O errors. Files without a baseline entry are reported as "new" and do not
+// fail the run.
+//
+// Allocation counts are deterministic, so --alloc-tolerance defaults to 0.
+// Peak heap is measured with malloc_usable_size, which varies a little with
+// which free chunk glibc hands back, hence the looser --peak-tolerance.
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "alloc_tracker.h"
+#include "bench_harness.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+    const char kAuxSuffix[] = ".aux.json";
+    const char kJsonSuffix[] = ".json";
+
+    struct BaselineEntry {
+        double nsPerOp;
+        uint64_t allocsPerOp;
+        int64_t peakBytes;
+        bool ok;
+    };
+
+    struct ReplayFile {
+        std::string name;     // file name relative to the corpus dir
+        const ParserEntry* parser;
+        std::string json;
+        std::string aux;
+    };
+
+    bool ends_with(const std::string& s, const char* suffix) {
+        size_t n = strlen(suffix);
+        return s.size() >= n && s.compare(s.size() - n, n, suffix) == 0;
+    }
+
+    bool read_file(const fs::path& path, std::string* out) {
+        std::ifstream in(path, std::ios::binary);
+        if (!in) return false;
+        std::ostringstream ss;
+        ss << in.rdbuf();
+        *out = ss.str();
+        return true;
+    }
+
+    // Baseline format: one line per corpus file,
+    //   <file> <ns_per_op> <allocs_per_op> <peak_bytes> <ok>
+    // Blank lines and lines starting with '#' are ignored.
+    bool load_baseline(const fs::path& path, std::map<std::string, BaselineEntry>* out) {
+        std::ifstream in(path);
+        if (!in) return false;
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.empty() || line[0] == '#') continue;
+            std::istringstream ls(line);
+            std::string name;
+            BaselineEntry e;
+            int ok = 0;
+            long long peak = 0;
+            unsigned long long allocs = 0;
+            if (!(ls >> name >> e.nsPerOp >> allocs >> peak >> ok)) {
+                fprintf(stderr, "warning: ignoring malformed baseline line: %s\n", line.c_str());
+                continue;
+            }
+            e.allocsPerOp = allocs;
+            e.peakBytes = peak;
+            e.ok = ok != 0;
+            (*out)[name] = e;
+        }
+        return true;
+    }
+
+    bool write_baseline(const fs::path& path,
+                        const std::vector<std::pair<std::string, Measurement>>& rows) {
+        FILE* f = fopen(path.string().c_str(), "w");
+        if (!f) return false;
+        fprintf(f, "# nekko_replay baseline. Regenerate with: nekko_replay <corpus> --write-baseline\n");
+        fprintf(f, "# file ns_per_op allocs_per_op peak_bytes ok\n");
+        for (const auto& row : rows) {
+            const Measurement& m = row.second;
+            fprintf(f, "%s %.1f %llu %lld %d\n", row.first.c_str(), m.nsPerOp,
+                    (unsigned long long)m.allocsPerOp, (long long)m.peakBytes, m.ok ? 1 : 0);
+        }
+        fclose(f);
+        return true;
+    }
+
+    // Collects `<parser>.<tag>.json` files in name order so reports and the
+    // written baseline are stable across runs.
+    bool collect_corpus(const fs::path& dir, std::vector<ReplayFile>* out) {
+        std::error_code ec;
+        std::vector<std::string> names;
+        for (const fs::directory_entry& entry : fs::directory_iterator(dir, ec)) {
+            if (!entry.is_regular_file()) continue;
+            std::string name = entry.path().filename().string();
+            if (!ends_with(name, kJsonSuffix) || ends_with(name, kAuxSuffix)) continue;
+            names.push_back(name);
+        }
+        if (ec) {
+            fprintf(stderr, "error: cannot read %s: %s\n", dir.string().c_str(), ec.message().c_str());
+            return false;
+        }
+        std::sort(names.begin(), names.end());
+
+        for (const std::string& name : names) {
+            std::string parserName = name.substr(0, name.find('.'));
+            const ParserEntry* parser = find_parser(parserName);
+            if (!parser) {
+                fprintf(stderr, "warning: %s: no parser named '%s', skipped\n", name.c_str(), parserName.c_str());
+                continue;
+            }
+            ReplayFile file = {name, parser, "", ""};
+            if (!read_file(dir / name, &file.json)) {
+                fprintf(stderr, "error: cannot read %s\n", name.c_str());
+                return false;
+            }
+            if (parser->needsAux) {
+                std::string auxName = name.substr(0, name.size() - strlen(kJsonSuffix)) + kAuxSuffix;
+                if (!read_file(dir / auxName, &file.aux)) {
+                    fprintf(stderr, "error: %s needs %s\n", name.c_str(), auxName.c_str());
+                    return false;
+                }
+            }
+            out->push_back(std::move(file));
+        }
+        return true;
+    }
+
+    // Best of `rounds` runs: the minimum time is the least noisy estimate of
+    // what the code costs, and heap counts are identical between rounds.
+    Measurement measure_best(const ReplayFile& file, int rounds, double minMs) {
+        Measurement best = measure_parser(*file.parser, file.json, file.aux, minMs);
+        for (int r = 1; r < rounds; r++) {
+            Measurement m = measure_parser(*file.parser, file.json, file.aux, minMs);
+            if (m.nsPerOp < best.nsPerOp) best = m;
+        }
+        return best;
+    }
+
+    void usage() {
+        fprintf(stderr,
+                "usage: nekko_replay [<corpus-dir>] [--baseline <file>] [--tolerance <frac>]\n"
+                "                    [--alloc-tolerance <frac>] [--peak-tolerance <frac>]\n"
+                "                    [--rounds <n>] [--min-ms <n>] [--write-baseline]\n");
+    }
+}
+
+int main(int argc, char** argv) {
+    fs::path corpus = "tools/replay/corpus";
+    fs::path baselinePath;
+    double tolerance = 0.25;
+    double allocTolerance = 0.0;
+    double peakTolerance = 0.10;
+    int rounds = 5;
+    double minMs = 100.0;
+    bool writeMode = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "--baseline") && i + 1 < argc) baselinePath = argv[++i];
+        else if (!strcmp(argv[i], "--tolerance") && i + 1 < argc) tolerance = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--alloc-tolerance") && i + 1 < argc) allocTolerance = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--peak-tolerance") && i + 1 < argc) peakTolerance = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--rounds") && i + 1 < argc) rounds = atoi(argv[++i]);
+        else if (!strcmp(argv[i], "--min-ms") && i + 1 < argc) minMs = atof(argv[++i]);
+        else if (!strcmp(argv[i], "--write-baseline")) writeMode = true;
+        else if (argv[i][0] != '-') corpus = argv[i];
+        else { usage(); return 2; }
+    }
+    if (rounds < 1) rounds = 1;
+    // The baseline lives next to the corpus directory by default.
+    if (baselinePath.empty()) baselinePath = corpus.parent_path() / "baseline.txt";
+
+    std::vector<ReplayFile> files;
+    if (!collect_corpus(corpus, &files)) return 2;
+    if (files.empty()) {
+        fprintf(stderr, "error: no <parser>.<tag>.json files in %s\n", corpus.string().c_str());
+        return 2;
+    }
+
+    std::map<std::string, BaselineEntry> baseline;
+    if (!writeMode && !load_baseline(baselinePath, &baseline)) {
+        fprintf(stderr, "error: cannot read baseline %s (run with --write-baseline first)\n",
+                baselinePath.string().c_str());
+        return 2;
+    }
+    if (!alloc_tracker_available()) {
+        fprintf(stderr, "note: allocation tracking unavailable, heap checks skipped\n");
+    }
+
+    printf("%-36s %12s %12s %8s %10s %10s  %s\n",
+           "file", "ns/op", "base ns/op", "delta", "allocs/op", "base", "status");
+
+    std::vector<std::pair<std::string, Measurement>> rows;
+    int regressions = 0;
+    for (const ReplayFile& file : files) {
+        Measurement m = measure_best(file, rounds, minMs);
+        rows.push_back({file.name, m});
+        if (m.leakedBytes != 0) {
+            fprintf(stderr, "warning: %s leaked %lld bytes per call\n",
+                    file.name.c_str(), (long long)m.leakedBytes);
+        }
+
+        auto it = baseline.find(file.name);
+        if (it == baseline.end()) {
+            printf("%-36s %12.1f %12s %8s %10llu %10s  %s\n", file.name.c_str(), m.nsPerOp, "-", "-",
+                   (unsigned long long)m.allocsPerOp, "-", writeMode ? "recorded" : "new");
+            continue;
+        }
+
+        const BaselineEntry& base = it->second;
+        double delta = base.nsPerOp > 0 ? m.nsPerOp / base.nsPerOp - 1.0 : 0.0;
+        std::string status;
+        if (m.ok != base.ok) {
+            status = m.ok ? "now parses (was error)" : "now errors (was ok)";
+        } else if (delta > tolerance) {
+            status = "SLOWER";
+        } else if (alloc_tracker_available() &&
+                   (double)m.allocsPerOp > (double)base.allocsPerOp * (1.0 + allocTolerance)) {
+            status = "MORE ALLOCS";
+        } else if (alloc_tracker_available() &&
+                   (double)m.peakBytes > (double)base.peakBytes * (1.0 + peakTolerance)) {
+            status = "MORE PEAK HEAP";
+        }
+        if (!status.empty()) regressions++;
+
+        printf("%-36s %12.1f %12.1f %+7.1f%% %10llu %10llu  %s\n", file.name.c_str(), m.nsPerOp,
+               base.nsPerOp, delta * 100.0, (unsigned long long)m.allocsPerOp,
+               (unsigned long long)base.allocsPerOp, status.empty() ? "ok" : status.c_str());
+    }
+
+    if (writeMode) {
+        if (!write_baseline(baselinePath, rows)) {
+            fprintf(stderr, "error: cannot write %s\n", baselinePath.string().c_str());
+            return 2;
+        }
+        printf("wrote %s (%zu files)\n", baselinePath.string().c_str(), rows.size());
+        return 0;
+    }
+    if (regressions) {
+        printf("%d of %zu files regressed (tolerance: time %.0f%%, allocs %.0f%%, peak %.0f%%)\n",
+               regressions, files.size(), tolerance * 100.0, allocTolerance * 100.0,
+               peakTolerance * 100.0);
+        return 1;
+    }
+    return 0;
+}
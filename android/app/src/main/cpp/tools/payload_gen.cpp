@@ -0,0 +1,565 @@
+#include "payload_gen.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "json_writer.h"
+
+namespace {
+    // splitmix64: tiny, fast and identical on every platform.
+    class GenRng {
+    public:
+        explicit GenRng(uint64_t seed) : state(seed) {}
+
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        // Uniform in [lo, hi].
+        int range(int lo, int hi) {
+            return lo + (int)(next() % (uint64_t)(hi - lo + 1));
+        }
+
+        bool chance(double p) {
+            if (p <= 0.0) return false;
+            if (p >= 1.0) return true;
+            return (double)(next() >> 11) * (1.0 / 9007199254740992.0) < p;
+        }
+
+    private:
+        uint64_t state;
+    };
+
+    // Each word in its accented and unaccented spelling.
+    struct Word {
+        const char* vi;
+        const char* ascii;
+    };
+
+    const Word kFamily[] = {
+        {"Nguyễn", "Nguyen"}, {"Trần", "Tran"}, {"Lê", "Le"}, {"Phạm", "Pham"},
+        {"Hoàng", "Hoang"}, {"Vũ", "Vu"}, {"Đặng", "Dang"}, {"Bùi", "Bui"}, {"Đỗ", "Do"},
+    };
+    const Word kMiddle[] = {
+        {"Văn", "Van"}, {"Thị", "Thi"}, {"Hữu", "Huu"}, {"Minh", "Minh"},
+        {"Thu", "Thu"}, {"Đức", "Duc"}, {"Quang", "Quang"},
+    };
+    const Word kGiven[] = {
+        {"An", "An"}, {"Bình", "Binh"}, {"Cường", "Cuong"}, {"Dũng", "Dung"},
+        {"Hương", "Huong"}, {"Ngọc", "Ngoc"}, {"Phương", "Phuong"}, {"Quỳnh", "Quynh"},
+        {"Thắng", "Thang"}, {"Tuấn", "Tuan"}, {"Trang", "Trang"}, {"Việt", "Viet"},
+    };
+    const Word kSubjectWords[] = {
+        {"Lập", "Lap"}, {"trình", "trinh"}, {"hướng", "huong"}, {"đối", "doi"},
+        {"tượng", "tuong"}, {"Cấu", "Cau"}, {"trúc", "truc"}, {"dữ", "du"},
+        {"liệu", "lieu"}, {"giải", "giai"}, {"thuật", "thuat"}, {"Mạng", "Mang"},
+        {"máy", "may"}, {"tính", "tinh"}, {"Hệ", "He"}, {"điều", "dieu"},
+        {"hành", "hanh"}, {"Kỹ", "Ky"}, {"phần", "phan"}, {"mềm", "mem"},
+        {"Trí", "Tri"}, {"tuệ", "tue"}, {"nhân", "nhan"}, {"tạo", "tao"},
+        {"Xác", "Xac"}, {"suất", "suat"}, {"thống", "thong"}, {"kê", "ke"},
+        {"Kinh", "Kinh"}, {"tế", "te"}, {"học", "hoc"}, {"Vật", "Vat"},
+        {"lý", "ly"}, {"Toán", "Toan"}, {"rời", "roi"}, {"rạc", "rac"},
+    };
+    const char* kBuildings[] = {"A1", "A2", "B5", "C1", "TL", "K1"};
+
+    const long long kSemesterStart = 1725210000000LL; // 2024-09-01
+    const long long kDay = 86400000LL;
+
+    template <size_t N>
+    const Word& pick(GenRng& rng, const Word (&table)[N]) {
+        return table[rng.next() % N];
+    }
+
+    int scaled(double base, double scale) {
+        double v = std::floor(base * scale + 0.5);
+        return v < 1.0 ? 1 : (int)v;
+    }
+
+    // Per-endpoint generator state.
+    class Gen {
+    public:
+        Gen(GenEndpoint endpoint, const GenOptions& o)
+            : opt(o), rng(o.seed * 0x100000001B3ULL + (uint64_t)endpoint + 1) {
+            // A fixed subject catalog keeps names repeating the way real
+            // payloads do (same subject across sections, marks and exams).
+            for (int i = 0; i < 48; i++) catalog.push_back(make_subject_name());
+        }
+
+        const GenOptions& opt;
+        GenRng rng;
+        std::vector<std::string> catalog;
+
+        const char* word(const Word& w) {
+            return rng.chance(opt.vietnameseDensity) ? w.vi : w.ascii;
+        }
+
+        // Fixed phrase with an unaccented fallback.
+        const char* vi(const char* accented, const char* plain) {
+            return rng.chance(opt.vietnameseDensity) ? accented : plain;
+        }
+
+        bool alt() { return rng.chance(opt.casingMix); }
+
+        std::string make_subject_name() {
+            std::string s;
+            int words = rng.range(2, 5);
+            for (int i = 0; i < words; i++) {
+                if (i) s += ' ';
+                s += word(pick(rng, kSubjectWords));
+            }
+            if (rng.chance(0.3)) s += " " + std::to_string(rng.range(1, 3));
+            return s;
+        }
+
+        const std::string& subject(int i) { return catalog[(size_t)i % catalog.size()]; }
+
+        std::string person_name() {
+            std::string s = word(pick(rng, kFamily));
+            s += ' ';
+            s += word(pick(rng, kMiddle));
+            s += ' ';
+            s += word(pick(rng, kGiven));
+            return s;
+        }
+
+        // Note: every rng draw is its own statement. Operands of `+` are
+        // unsequenced, so two draws in one expression would make the output
+        // depend on the compiler.
+        std::string room_name() {
+            std::string s = std::to_string(rng.range(101, 512));
+            s += '-';
+            s += kBuildings[rng.next() % 6];
+            return s;
+        }
+
+        std::string student_code() {
+            return "22511" + std::to_string(rng.range(70000, 79999));
+        }
+
+        std::string subject_code(int i) {
+            static const char* prefixes[] = {"CSE", "MAT", "PHY", "ECO", "POL", "ENG"};
+            return std::string(prefixes[(size_t)i % 6]) + std::to_string(100 + (i * 37) % 400);
+        }
+
+        void maybe_str(JsonWriter& w, const char* key, const std::string& v, double nullChance) {
+            w.key(key);
+            if (rng.chance(nullChance)) w.null();
+            else w.str(v);
+        }
+    };
+
+    std::string time_string(int minutes) {
+        char buf[8];
+        snprintf(buf, sizeof(buf), "%02d:%02d", (minutes / 60) % 24, minutes % 60);
+        return buf;
+    }
+
+    // --- Endpoints ---
+
+    std::string gen_exam_schedules(Gen& g) {
+        int schedules = scaled(4, g.opt.scale);
+        JsonWriter w;
+        w.begin_arr();
+        for (int i = 0; i < schedules; i++) {
+            w.begin_obj();
+            w.key("id").num(i + 1);
+            w.key("name").str(std::string(g.vi("Lịch thi học kỳ ", "Lich thi hoc ky ")) + std::to_string(1 + i % 3));
+            w.key("displayOrder").num(i);
+            w.key("voided").boolean(g.rng.chance(0.05));
+            w.key("examPeriods").begin_arr();
+            int periods = g.rng.range(1, 4);
+            for (int p = 0; p < periods; p++) {
+                long long start = kSemesterStart + (long long)(100 + g.rng.range(0, 30)) * kDay;
+                w.begin_obj();
+                w.key("id").num(i * 10 + p + 1);
+                w.key("examPeriodCode").str("DT" + std::to_string(p + 1) + "_HK" + std::to_string(1 + i % 3));
+                w.key("name").str(std::string(g.vi("Đợt thi ", "Dot thi ")) + std::to_string(p + 1));
+                w.key("startDate").num(start);
+                w.key("endDate").num(start + 6 * kDay);
+                w.key("numberOfExamDays").num(g.rng.range(3, 10));
+                w.key("bookingStatus").begin_obj()
+                    .key("id").num(1 + p % 2)
+                    .key("name").str(p % 2 ? g.vi("Chưa mở", "Chua mo") : g.vi("Đã duyệt", "Da duyet"))
+                    .end_obj();
+                w.end_obj();
+            }
+            w.end_arr();
+            w.end_obj();
+        }
+        w.end_arr();
+        return w.take();
+    }
+
+    std::string gen_exam_rooms(Gen& g) {
+        int rooms = scaled(12, g.opt.scale);
+        std::string student = g.student_code();
+        JsonWriter w;
+        w.begin_arr();
+        for (int i = 0; i < rooms; i++) {
+            int subj = g.rng.range(0, 47);
+            std::string room = g.room_name();
+            int startMin = 7 * 60 + 150 * g.rng.range(0, 4);
+            long long examDate = kSemesterStart + (long long)(105 + g.rng.range(0, 25)) * kDay;
+
+            w.begin_obj();
+            w.key("id").num(100000 + i);
+            w.key("subjectName").str(g.subject(subj));
+            w.key("examPeriodCode").str("DT" + std::to_string(1 + i % 3) + "_HK1");
+            w.key("examCode").str("EX" + std::to_string(2000 + i));
+            w.key("studentCode").str(student);
+            w.key("examRoom").begin_obj();
+            w.key("examDate").num(examDate);
+            // Some rooms have no startHour; the parser then reads the time
+            // out of roomCode.
+            if (g.rng.chance(0.25)) w.key("startHour").null();
+            else w.key("startHour").begin_obj().key("startString").str(time_string(startMin)).end_obj();
+            w.key("roomCode").str(g.subject_code(subj) + "_08-11-2025_" +
+                                  std::to_string(startMin / 60) + "-" + std::to_string(startMin / 60 + 2) + "_" + room);
+            w.key("room").begin_obj()
+                .key("name").str(room)
+                .key("building").begin_obj().key("name").str(kBuildings[g.rng.next() % 6]).end_obj()
+                .end_obj();
+            w.key("examMethod").begin_obj()
+                .key("name").str(g.rng.chance(0.5) ? g.vi("Tự luận", "Tu luan") : g.vi("Trắc nghiệm", "Trac nghiem"))
+                .end_obj();
+            g.maybe_str(w, "notes", g.vi("Mang theo thẻ sinh viên", "Mang theo the sinh vien"), 0.6);
+            w.key("numberExpectedStudent").num(g.rng.range(20, 80));
+            w.end_obj();
+            w.end_obj();
+        }
+        w.end_arr();
+        return w.take();
+    }
+
+    std::string gen_courses(Gen& g) {
+        int courses = scaled(10, g.opt.scale);
+        JsonWriter w;
+        w.begin_arr();
+        for (int i = 0; i < courses; i++) {
+            int subj = g.rng.range(0, 47);
+            w.begin_obj();
+            w.key("id").num(20000 + i);
+            w.key("subjectName").str(g.subject(subj));
+            w.key("subjectCode").str(g.subject_code(subj));
+            w.key("numberOfCredit").num(g.rng.range(1, 4));
+            w.key("status").str(g.rng.chance(0.2) ? g.vi("Hoàn thành", "Hoan thanh") : g.vi("Đang học", "Dang hoc"));
+            if (g.rng.chance(0.3)) w.key("grade").real(4.0 + g.rng.range(0, 60) / 10.0);
+            else w.key("grade").null();
+
+            w.key("courseSubject").begin_obj();
+            std::string classCode = "6" + std::to_string(g.rng.range(3, 6));
+            classCode += "KTPM" + std::to_string(g.rng.range(1, 6));
+            std::string className = g.subject(subj) + " - " + g.vi("Nhóm ", "Nhom ");
+            className += std::to_string(g.rng.range(1, 9));
+            w.key("classCode").str(classCode);
+            w.key("className").str(className);
+            if (g.rng.chance(0.1)) {
+                w.key("lecturer").null();
+            } else {
+                w.key("lecturer").begin_obj()
+                    .key("name").str(g.person_name())
+                    .key("email").str("gv" + std::to_string(g.rng.range(100, 999)) + "@tlu.edu.vn")
+                    .end_obj();
+            }
+            w.key("timetables").begin_arr();
+            for (int t = 0; t < g.opt.timetablesPerCourse; t++) {
+                int from = g.rng.range(1, 8);
+                int startHour = g.rng.range(1, 13);
+                w.begin_obj();
+                w.key("id").num((long long)i * 1000 + t);
+                w.key("weekIndex").num(g.rng.range(2, 8));
+                w.key("fromWeek").num(from);
+                w.key("toWeek").num(from + g.rng.range(0, 10));
+                w.key("startDate").num(kSemesterStart + (long long)(from - 1) * 7 * kDay);
+                w.key("endDate").num(kSemesterStart + 105 * kDay);
+                w.key("startHour").begin_obj().key("id").num(startHour).key("indexNumber").num(startHour).end_obj();
+                w.key("endHour").begin_obj().key("id").num(startHour + 2).key("indexNumber").num(startHour + 2).end_obj();
+                w.key("room").begin_obj()
+                    .key("id").num(g.rng.range(1, 400))
+                    .key("name").str(g.room_name())
+                    .key("building").begin_obj().key("name").str(kBuildings[g.rng.next() % 6]).end_obj()
+                    .end_obj();
+                w.key("campus").str(g.vi("Cơ sở chính", "Co so chinh"));
+                w.end_obj();
+            }
+            w.end_arr();
+            w.end_obj();
+            w.end_obj();
+        }
+        w.end_arr();
+        return w.take();
+    }
+
+    std::string gen_course_hours(Gen& g) {
+        int hours = scaled(16, g.opt.scale);
+        JsonWriter w;
+        w.begin_obj().key("content").begin_arr();
+        for (int i = 0; i < hours; i++) {
+            int start = 7 * 60 + (i % 16) * 55;
+            w.begin_obj();
+            w.key("id").num(i + 1);
+            w.key("name").str(std::string(g.vi("Tiết ", "Tiet ")) + std::to_string(i + 1));
+            w.key("startString").str(time_string(start));
+            w.key("endString").str(time_string(start + 50));
+            w.key("indexNumber").num(i + 1);
+            w.end_obj();
+        }
+        w.end_arr().key("totalElements").num(hours).end_obj();
+        return w.take();
+    }
+
+    // `idAlt` controls whether Id/Name may flip casing too; only
+    // parse_semester reads those aliases.
+    void gen_register_periods(Gen& g, JsonWriter& w, int count, bool idAlt) {
+        w.key("semesterRegisterPeriods").begin_arr();
+        for (int p = 0; p < count; p++) {
+            bool a = g.alt();
+            long long start = kSemesterStart - (long long)(30 - p) * kDay;
+            w.begin_obj();
+            w.key(a && idAlt ? "Id" : "id").num(500 + p);
+            w.key(a && idAlt ? "Name" : "name").str(std::string(g.vi("Đợt đăng ký ", "Dot dang ky ")) + std::to_string(p + 1));
+            w.key(a ? "StartRegisterTime" : "startRegisterTime").num(start);
+            w.key(a ? "EndRegisterTime" : "endRegisterTime").num(start + 7 * kDay);
+            w.key(a ? "EndUnRegisterTime" : "endUnRegisterTime").num(start + 10 * kDay);
+            w.key(a ? "StartRegisterTimeString" : "startRegisterTimeString").str("12/08/2024 08:00");
+            w.key(a ? "EndRegisterTimeString" : "endRegisterTimeString").str("19/08/2024 17:00");
+            w.key(a ? "EndUnRegisterTimeString" : "endUnRegisterTimeString").str("22/08/2024 17:00");
+            w.end_obj();
+        }
+        w.end_arr();
+    }
+
+    void gen_semester_fields(Gen& g, JsonWriter& w, int id, int ordinal, bool datesAlt) {
+        bool a = datesAlt && g.alt();
+        long long start = kSemesterStart + (long long)(id % 50) * 120 * kDay;
+        w.key("id").num(id);
+        w.key("semesterCode").str(std::to_string(ordinal) + "_2024_2025");
+        std::string name = std::string(g.vi("Học kỳ ", "Hoc ky ")) + std::to_string(ordinal);
+        name += g.vi(" năm học 2024-2025", " nam hoc 2024-2025");
+        w.key("semesterName").str(name);
+        w.key(a ? "StartDate" : "startDate").num(start);
+        w.key(a ? "EndDate" : "endDate").num(start + 110 * kDay);
+        w.key("isCurrent").boolean(ordinal == 1 && id % 7 == 0);
+        w.key("ordinalNumbers").num(ordinal);
+    }
+
+    std::string gen_school_years(Gen& g) {
+        int years = scaled(6, g.opt.scale);
+        JsonWriter w;
+        w.begin_obj().key("content").begin_arr();
+        for (int y = 0; y < years; y++) {
+            int year = 2019 + y % 30;
+            w.begin_obj();
+            w.key("id").num(y + 1);
+            w.key("name").str(std::string(g.vi("Năm học ", "Nam hoc ")) + std::to_string(year) + "-" + std::to_string(year + 1));
+            w.key("code").str(std::to_string(year) + "_" + std::to_string(year + 1));
+            w.key("displayName").str(std::to_string(year) + "-" + std::to_string(year + 1));
+            w.key("year").num(year);
+            w.key("current").boolean(y == years - 1);
+            w.key("startDate").num(kSemesterStart - (long long)(years - y) * 365 * kDay);
+            w.key("endDate").num(kSemesterStart - (long long)(years - y - 1) * 365 * kDay);
+            w.key("semesters").begin_arr();
+            for (int s = 0; s < 3; s++) {
+                w.begin_obj();
+                gen_semester_fields(g, w, y * 3 + s + 1, s + 1, true);
+                gen_register_periods(g, w, g.opt.registerPeriods, false);
+                w.end_obj();
+            }
+            w.end_arr();
+            w.end_obj();
+        }
+        w.end_arr().key("totalElements").num(years).end_obj();
+        return w.take();
+    }
+
+    std::string gen_semester(Gen& g) {
+        JsonWriter w;
+        w.begin_obj();
+        gen_semester_fields(g, w, 42, 1, false);
+        gen_register_periods(g, w, scaled(g.opt.registerPeriods, g.opt.scale), true);
+        w.end_obj();
+        return w.take();
+    }
+
+    std::string gen_user(Gen& g) {
+        std::string name = g.person_name();
+        std::string code = g.student_code();
+        bool a = g.alt();
+        JsonWriter w;
+        w.begin_obj();
+        w.key("username").str(code);
+        w.key("displayName").str(name);
+        w.key("email").str(code + "@e.tlu.edu.vn");
+        w.key(a ? "Person" : "person").begin_obj()
+            .key(a ? "Id" : "id").num(g.rng.range(10000, 99999))
+            .key("fullName").str(name)
+            .end_obj();
+        w.end_obj();
+        return w.take();
+    }
+
+    std::string gen_token(Gen& g) {
+        static const char kAlphabet[] =
+            "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+        std::string access, refresh;
+        for (int i = 0; i < 900; i++) access += kAlphabet[g.rng.next() % 64];
+        for (int i = 0; i < 900; i++) refresh += kAlphabet[g.rng.next() % 64];
+        JsonWriter w;
+        w.begin_obj();
+        w.key("access_token").str(access);
+        w.key("token_type").str("bearer");
+        w.key("refresh_token").str(refresh);
+        w.key("expires_in").num(86399);
+        w.key("scope").str("read write trust");
+        w.end_obj();
+        return w.take();
+    }
+
+    std::string gen_registration(Gen& g) {
+        int subjects = g.opt.subjects > 0 ? g.opt.subjects : scaled(40, g.opt.scale);
+        // The server sends PascalCase; casingMix flips objects to camelCase.
+        bool rootAlt = g.alt();
+        JsonWriter w;
+        w.begin_obj();
+        w.key(rootAlt ? "id" : "Id").num(g.rng.range(1, 200));
+        w.key(rootAlt ? "courseRegisterViewObject" : "CourseRegisterViewObject").begin_obj();
+        w.key(rootAlt ? "listSubjectRegistrationDtos" : "ListSubjectRegistrationDtos").begin_arr();
+        for (int s = 0; s < subjects; s++) {
+            int subj = s % 48;
+            int credits = g.rng.range(1, 4);
+            bool a = g.alt();
+            w.begin_obj();
+            w.key(a ? "subjectName" : "SubjectName").str(g.subject(subj));
+            w.key(a ? "numberOfCredit" : "NumberOfCredit").num(credits);
+            w.key(a ? "courseSubjectDtos" : "CourseSubjectDtos").begin_arr();
+            for (int c = 0; c < g.opt.sectionsPerSubject; c++) {
+                bool ca = g.alt();
+                int max = 40 + 10 * g.rng.range(0, 4);
+                int registered = g.rng.range(0, max);
+                w.begin_obj();
+                w.key(ca ? "id" : "Id").num((long long)s * 100 + c + 1);
+                w.key(ca ? "code" : "Code").str(g.subject_code(subj) + "." + std::to_string(c + 1));
+                w.key(ca ? "displayCode" : "DisplayCode").str(g.subject(subj) + "-" + std::to_string(c + 1));
+                w.key(ca ? "maxStudent" : "MaxStudent").num(max);
+                w.key(ca ? "numberStudent" : "NumberStudent").num(registered);
+                w.key(ca ? "isSelected" : "IsSelected").boolean(g.rng.chance(0.05));
+                w.key(ca ? "isFullClass" : "IsFullClass").boolean(registered == max);
+                w.key(ca ? "isOvelapTime" : "IsOvelapTime").boolean(g.rng.chance(0.1));
+                w.key(ca ? "subjectId" : "SubjectId").num(1000 + subj);
+                w.key(ca ? "numberOfCredit" : "NumberOfCredit").num(credits);
+                w.key(ca ? "status" : "Status").str(registered == max ? "full" : "new");
+                w.key(ca ? "timetables" : "Timetables").begin_arr();
+                int timetables = g.rng.range(1, 3);
+                for (int t = 0; t < timetables; t++) {
+                    int startHour = g.rng.range(1, 13);
+                    w.begin_obj();
+                    w.key("id").num(((long long)s * 100 + c) * 10 + t);
+                    w.key("startDate").num(kSemesterStart);
+                    w.key("endDate").num(kSemesterStart + 105 * kDay);
+                    w.key("fromWeek").num(1);
+                    w.key("toWeek").num(15);
+                    w.key("weekIndex").num(g.rng.range(2, 8));
+                    w.key("startHour").begin_obj().key("id").num(startHour).key("indexNumber").num(startHour).end_obj();
+                    w.key("endHour").begin_obj().key("id").num(startHour + 2).key("indexNumber").num(startHour + 2).end_obj();
+                    w.key("room").begin_obj().key("id").num(g.rng.range(1, 400)).end_obj();
+                    w.key("roomName").str(g.room_name());
+                    w.key("teacherName").str(g.person_name());
+                    w.end_obj();
+                }
+                w.end_arr();
+                w.end_obj();
+            }
+            w.end_arr();
+            w.end_obj();
+        }
+        w.end_arr();
+        w.end_obj();
+        w.end_obj();
+        return w.take();
+    }
+
+    std::string gen_registration_action(Gen& g) {
+        bool a = g.alt();
+        JsonWriter w;
+        w.begin_obj();
+        w.key(a ? "Status" : "status").num(200);
+        w.key(a ? "Message" : "message").str(g.vi("Đăng ký thành công", "Dang ky thanh cong"));
+        w.end_obj();
+        return w.take();
+    }
+
+    std::string gen_student_marks(Gen& g) {
+        int marks = scaled(60, g.opt.scale);
+        static const char* kChar[] = {"A", "B+", "B", "C+", "C", "D+", "D", "F"};
+        JsonWriter w;
+        w.begin_arr();
+        for (int i = 0; i < marks; i++) {
+            int subj = g.rng.range(0, 47);
+            int semester = 1 + i / 8;
+            w.begin_obj();
+            w.key("mark").real(g.rng.range(30, 100) / 10.0);
+            w.key("markQT").real(g.rng.range(30, 100) / 10.0);
+            w.key("markTHI").real(g.rng.range(30, 100) / 10.0);
+            w.key("charMark").str(kChar[g.rng.next() % 8]);
+            w.key("studyTime").num(g.rng.chance(0.9) ? 1 : 2);
+            w.key("examRound").num(g.rng.chance(0.85) ? 1 : 2);
+            w.key("subject").begin_obj()
+                .key("subjectCode").str(g.subject_code(subj))
+                .key("subjectName").str(g.subject(subj))
+                .key("numberOfCredit").num(g.rng.range(1, 4))
+                .key("isCalculateMark").boolean(g.rng.chance(0.9))
+                .end_obj();
+            w.key("semester").begin_obj()
+                .key("id").num(semester)
+                .key("semesterCode").str(std::to_string(1 + semester % 3) + "_20" + std::to_string(20 + semester / 3))
+                .key("semesterName").str(std::string(g.vi("Học kỳ ", "Hoc ky ")) + std::to_string(1 + semester % 3))
+                .end_obj();
+            w.end_obj();
+        }
+        w.end_arr();
+        return w.take();
+    }
+
+    const char* kNames[kGenEndpointCount] = {
+        "exam_schedules", "exam_rooms", "courses", "course_hours", "school_years",
+        "semester", "user", "token", "registration", "registration_action",
+        "student_marks",
+    };
+}
+
+const char* gen_endpoint_name(GenEndpoint endpoint) {
+    return kNames[(int)endpoint];
+}
+
+bool gen_endpoint_from_name(const char* name, GenEndpoint* out) {
+    for (int i = 0; i < kGenEndpointCount; i++) {
+        if (!strcmp(name, kNames[i])) {
+            *out = (GenEndpoint)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string generate_payload(GenEndpoint endpoint, const GenOptions& options) {
+    Gen g(endpoint, options);
+    switch (endpoint) {
+        case GenEndpoint::ExamSchedules: return gen_exam_schedules(g);
+        case GenEndpoint::ExamRooms: return gen_exam_rooms(g);
+        case GenEndpoint::Courses: return gen_courses(g);
+        case GenEndpoint::CourseHours: return gen_course_hours(g);
+        case GenEndpoint::SchoolYears: return gen_school_years(g);
+        case GenEndpoint::Semester: return gen_semester(g);
+        case GenEndpoint::User: return gen_user(g);
+        case GenEndpoint::Token: return gen_token(g);
+        case GenEndpoint::Registration: return gen_registration(g);
+        case GenEndpoint::RegistrationAction: return gen_registration_action(g);
+        case GenEndpoint::StudentMarks: return gen_student_marks(g);
+    }
+    return std::string();
+}
@@ -0,0 +1,50 @@
+// Deterministic synthetic TLU payloads for scale testing.
+// The same options (including seed) always produce byte-identical output on
+// every platform: the generator uses its own PRNG and never the <random>
+// distributions, whose results are implementation-defined.
+#ifndef NEKKO_TOOLS_PAYLOAD_GEN_H
+#define NEKKO_TOOLS_PAYLOAD_GEN_H
+
+#include <stdint.h>
+#include <string>
+
+enum class GenEndpoint {
+    ExamSchedules,
+    ExamRooms,
+    Courses,
+    CourseHours,
+    SchoolYears,
+    Semester,
+    User,
+    Token,
+    Registration,
+    RegistrationAction,
+    StudentMarks,
+};
+
+constexpr int kGenEndpointCount = (int)GenEndpoint::StudentMarks + 1;
+
+// Scale 1.0 is one student's real semester (10 courses, 40 registration
+// subjects, 12 exam rooms, ...). Top-level array lengths are multiplied by
+// `scale`; the per-item knobs below stay as given.
+struct GenOptions {
+    uint64_t seed = 1;
+    double scale = 1.0;
+    int timetablesPerCourse = 2;   // N courseSubject.timetables per course
+    int subjects = 0;              // M ListSubjectRegistrationDtos; 0 = 40 * scale
+    int sectionsPerSubject = 6;    // K CourseSubjectDtos per subject
+    int registerPeriods = 2;       // semesterRegisterPeriods per semester
+    // Probability that an object uses the alternate key casing the parsers
+    // accept (camelCase where the server sends PascalCase and vice versa).
+    double casingMix = 0.0;
+    // Fraction of words drawn with Vietnamese diacritics instead of their
+    // unaccented ASCII spelling.
+    double vietnameseDensity = 0.8;
+};
+
+const char* gen_endpoint_name(GenEndpoint endpoint);
+bool gen_endpoint_from_name(const char* name, GenEndpoint* out);
+
+std::string generate_payload(GenEndpoint endpoint, const GenOptions& options);
+
+#endif // NEKKO_TOOLS_PAYLOAD_GEN_H
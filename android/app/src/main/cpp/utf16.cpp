@@ -0,0 +1,84 @@
+#include "utf16.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace {
+    constexpr size_t kBlock = 16;
+
+    bool is_cont(uint8_t c) { return (c & 0xC0) == 0x80; }
+
+    // Widens the 16 bytes at `src` into `out` and returns how many of them
+    // lead the block as ASCII (16 when all do). The bytes past that are
+    // written too; the caller overwrites them.
+    inline size_t ascii_block(const uint8_t* src, uint16_t* out) {
+#if defined(__SSE2__)
+        __m128i v = _mm_loadu_si128((const __m128i*)src);
+        __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128((__m128i*)out, _mm_unpacklo_epi8(v, zero));
+        _mm_storeu_si128((__m128i*)(out + 8), _mm_unpackhi_epi8(v, zero));
+        unsigned mask = (unsigned)_mm_movemask_epi8(v);
+        return mask ? (size_t)__builtin_ctz(mask) : kBlock;
+#elif defined(__ARM_NEON)
+        uint8x16_t v = vld1q_u8(src);
+        vst1q_u16(out, vmovl_u8(vget_low_u8(v)));
+        vst1q_u16(out + 8, vmovl_u8(vget_high_u8(v)));
+        // One nibble per byte, set where the high bit is.
+        uint8x16_t high = vreinterpretq_u8_s8(vshrq_n_s8(vreinterpretq_s8_u8(v), 7));
+        uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(high), 4)), 0);
+        return mask ? (size_t)__builtin_ctzll(mask) / 4 : kBlock;
+#else
+        size_t n = 0;
+        while (n < kBlock && src[n] < 0x80) {
+            out[n] = src[n];
+            n++;
+        }
+        return n;
+#endif
+    }
+}
+
+size_t utf8_to_utf16(const char* src, size_t len, uint16_t* out) {
+    const uint8_t* s = (const uint8_t*)src;
+    size_t i = 0, o = 0;
+    while (i < len) {
+        // o <= i, so 16 bytes left means room for 16 units.
+        if (len - i >= kBlock) {
+            size_t n = ascii_block(s + i, out + o);
+            i += n;
+            o += n;
+            if (n == kBlock) continue;
+        }
+        while (i < len && s[i] < 0x80) out[o++] = s[i++];
+        if (i == len) break;
+
+        uint8_t c = s[i];
+        size_t left = len - i;
+        if (c >= 0xC2 && c <= 0xDF && left >= 2 && is_cont(s[i + 1])) {
+            out[o++] = (uint16_t)((c & 0x1F) << 6 | (s[i + 1] & 0x3F));
+            i += 2;
+        } else if (c >= 0xE0 && c <= 0xEF && left >= 3 && is_cont(s[i + 1]) && is_cont(s[i + 2]) &&
+                   (c != 0xE0 || s[i + 1] >= 0xA0) &&     // overlong
+                   (c != 0xED || s[i + 1] < 0xA0)) {      // surrogate
+            out[o++] = (uint16_t)((c & 0x0F) << 12 | (s[i + 1] & 0x3F) << 6 | (s[i + 2] & 0x3F));
+            i += 3;
+        } else if (c >= 0xF0 && c <= 0xF4 && left >= 4 && is_cont(s[i + 1]) && is_cont(s[i + 2]) &&
+                   is_cont(s[i + 3]) &&
+                   (c != 0xF0 || s[i + 1] >= 0x90) &&     // overlong
+                   (c != 0xF4 || s[i + 1] < 0x90)) {      // past U+10FFFF
+            uint32_t cp = (uint32_t)(c & 0x07) << 18 | (uint32_t)(s[i + 1] & 0x3F) << 12 |
+                          (uint32_t)(s[i + 2] & 0x3F) << 6 | (s[i + 3] & 0x3F);
+            cp -= 0x10000;
+            out[o++] = (uint16_t)(0xD800 | cp >> 10);
+            out[o++] = (uint16_t)(0xDC00 | (cp & 0x3FF));
+            i += 4;
+        } else {
+            out[o++] = 0xFFFD;
+            i++;
+        }
+    }
+    return o;
+}
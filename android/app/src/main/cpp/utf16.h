@@ -0,0 +1,23 @@
+// UTF-8 to UTF-16 transcoding for strings handed to Dart, whose String is
+// UTF-16: a result carrying code units lets Dart build each string with
+// String.fromCharCodes over a view, without decoding UTF-8 field by field.
+//
+// Runs of ASCII go through 16 bytes at a time (SSE2 or NEON, whichever the
+// target has); the accented letters in between are decoded one sequence at
+// a time. Parser strings are valid UTF-8 already, but anything that is not
+// still comes out as one U+FFFD per offending byte rather than being read
+// past.
+#ifndef NEKKO_UTF16_H
+#define NEKKO_UTF16_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Never more code units than `len`: the room `out` needs at most.
+constexpr size_t utf16_max_units(size_t len) { return len; }
+
+// Transcodes `len` bytes of `src` into `out` and returns the number of code
+// units written. `out` must have room for utf16_max_units(len).
+size_t utf8_to_utf16(const char* src, size_t len, uint16_t* out);
+
+#endif // NEKKO_UTF16_H
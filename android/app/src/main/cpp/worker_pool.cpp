@@ -0,0 +1,145 @@
+#include "worker_pool.h"
+
+#include <algorithm>
+#include <atomic>
+
+// One parallel_for call. Lives on its caller's stack: the caller takes it
+// off the queue before returning, and waits until no worker is still
+// inside it.
+struct WorkerPool::Job {
+    const std::function<void(size_t)>* fn;
+    size_t n;
+    std::atomic<size_t> next{0};
+    size_t active = 0;      // workers inside work(); guarded by lock_
+};
+
+WorkerPool& WorkerPool::shared() {
+    // Leaked on purpose: joining threads from a static destructor at exit
+    // would race whatever parse is still running.
+    static WorkerPool* pool = [] {
+        size_t cores = std::thread::hardware_concurrency();
+        size_t threads = cores > 1 ? cores - 1 : 1;
+        return new WorkerPool(std::min(threads, kMaxThreads));
+    }();
+    return *pool;
+}
+
+WorkerPool::WorkerPool(size_t threads)
+    : spread_(std::thread::hardware_concurrency() > 1 ? threads : 0) {
+    tasks_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) tasks_.push_back(std::make_unique<Tasks>());
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) threads_.emplace_back([this, i] { run(i); });
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& t : threads_) t.join();
+}
+
+void WorkerPool::work(Job* job) {
+    for (size_t i; (i = job->next.fetch_add(1, std::memory_order_relaxed)) < job->n;) {
+        (*job->fn)(i);
+    }
+}
+
+WorkerPool::Job* WorkerPool::open_job() const {
+    for (Job* j : jobs_) {
+        if (j->next.load(std::memory_order_relaxed) < j->n) return j;
+    }
+    return nullptr;
+}
+
+bool WorkerPool::take(size_t self, std::function<void()>& task) {
+    size_t n = tasks_.size();
+    for (size_t k = 0; k < n; k++) {
+        Tasks& t = *tasks_[(self + k) % n];
+        std::lock_guard<std::mutex> guard(t.lock);
+        if (t.queue.empty()) continue;
+        if (k == 0) {
+            task = std::move(t.queue.back());
+            t.queue.pop_back();
+        } else {
+            task = std::move(t.queue.front());
+            t.queue.pop_front();
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
+void WorkerPool::run(size_t self) {
+    std::unique_lock<std::mutex> lk(lock_);
+    for (;;) {
+        Job* job = nullptr;
+        wake_.wait(lk, [&] {
+            if (stop_) return true;
+            job = open_job();
+            return job || queued_.load(std::memory_order_relaxed) > 0;
+        });
+        if (stop_) return;
+        if (!job) {
+            // A parallel_for caller is waiting on its job, so that goes
+            // first; a task only once none is open.
+            lk.unlock();
+            std::function<void()> task;
+            if (take(self, task)) task();
+            task = nullptr;
+            lk.lock();
+            continue;
+        }
+        job->active++;
+        lk.unlock();
+        work(job);
+        lk.lock();
+        // The caller waits on wake_ too, for this to reach 0.
+        if (--job->active == 0) wake_.notify_all();
+    }
+}
+
+bool WorkerPool::submit(std::function<void()> task) {
+    if (threads_.empty()) return false;
+    Tasks& t = *tasks_[nextQueue_.fetch_add(1, std::memory_order_relaxed) % tasks_.size()];
+    {
+        std::lock_guard<std::mutex> guard(t.lock);
+        t.queue.push_back(std::move(task));
+    }
+    {
+        // Raised under lock_, so a thread about to sleep sees it.
+        std::lock_guard<std::mutex> guard(lock_);
+        queued_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // wake_ also has parallel_for callers on it; notify_one could pick one.
+    wake_.notify_all();
+    return true;
+}
+
+void WorkerPool::parallel_for(size_t n, const std::function<void(size_t)>& fn) {
+    if (n == 0) return;
+    if (spread_ == 0 || n == 1) {
+        for (size_t i = 0; i < n; i++) fn(i);
+        return;
+    }
+
+    Job job;
+    job.fn = &fn;
+    job.n = n;
+    {
+        std::lock_guard<std::mutex> guard(lock_);
+        jobs_.push_back(&job);
+    }
+    wake_.notify_all();
+
+    work(&job);
+
+    // Every index is taken; once the job is off the queue no worker can
+    // join it, so the ones still inside are the last.
+    std::unique_lock<std::mutex> lk(lock_);
+    jobs_.erase(std::find(jobs_.begin(), jobs_.end(), &job));
+    wake_.wait(lk, [&] { return job.active == 0; });
+}
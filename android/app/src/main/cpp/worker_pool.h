@@ -0,0 +1,85 @@
+// A small pool of native threads for splitting one parse across cores.
+//
+// Parsers run on whichever thread Dart calls them from; a parser that has
+// independent pieces of work (the subjects of a registration payload, say)
+// hands them to parallel_for, which runs them on the pool's threads and on
+// the calling thread together and returns once all are done.
+//
+// The pool also runs whole parses for callers that do not want to wait on
+// them (submit). Each thread has a deque of its own: submitted tasks are
+// dealt out round robin, a thread takes the newest from its own deque and,
+// when that is empty, steals the oldest from another's, so one long parse
+// does not hold up the ones queued behind it.
+#ifndef NEKKO_WORKER_POOL_H
+#define NEKKO_WORKER_POOL_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkerPool {
+public:
+    // Shared by every parser; started on first use and never stopped, so
+    // its threads outlive any caller. One thread per core beyond the
+    // caller's, at most kMaxThreads, and at least one so that submitted
+    // tasks run on a single core too.
+    static WorkerPool& shared();
+
+    explicit WorkerPool(size_t threads);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    // Threads parallel_for spreads work over besides the caller's; 0 on a
+    // single core, where it runs everything on the caller.
+    size_t size() const { return spread_; }
+
+    // Calls fn(i) once for each i in [0, n), in no particular order, and
+    // returns when every call has. `fn` must not throw and must not call
+    // parallel_for itself. Several threads may call this at once.
+    void parallel_for(size_t n, const std::function<void(size_t)>& fn);
+
+    // Queues `task` to run once on one of the pool's threads and returns at
+    // once; false, with `task` dropped, on a pool without threads. `task`
+    // must not throw. Tasks not started when the pool is destroyed are
+    // dropped (the shared pool never is).
+    bool submit(std::function<void()> task);
+
+    static constexpr size_t kMaxThreads = 7;
+
+private:
+    struct Job;
+
+    // One thread's submitted tasks.
+    struct Tasks {
+        std::mutex lock;
+        std::deque<std::function<void()>> queue;
+    };
+
+    void run(size_t self);
+    // Runs indices of `job` until none are left.
+    static void work(Job* job);
+    // A parallel_for job with indices left, or nullptr; needs lock_.
+    Job* open_job() const;
+    // Pops a task for thread `self`: its own newest, else another's oldest.
+    bool take(size_t self, std::function<void()>& task);
+
+    std::mutex lock_;
+    std::condition_variable wake_;
+    std::deque<Job*> jobs_;
+    std::vector<std::unique_ptr<Tasks>> tasks_;
+    std::atomic<size_t> queued_{0};     // tasks in all deques; raised under lock_
+    std::atomic<size_t> nextQueue_{0};
+    std::vector<std::thread> threads_;
+    size_t spread_;
+    bool stop_ = false;
+};
+
+#endif // NEKKO_WORKER_POOL_H
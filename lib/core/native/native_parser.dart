@@ -1,7 +1,12 @@
+import 'dart:async';
+import 'dart:convert';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:isolate';
+import 'package:brotli/brotli.dart';
 import 'package:ffi/ffi.dart';
 import 'package:flutter/foundation.dart';
+import 'package:tlucalendar/core/network/network_client.dart';
 import 'package:tlucalendar/features/exam/data/models/exam_schedule_model.dart';
 import 'package:tlucalendar/features/exam/data/models/exam_room_model.dart';
 
@@ -67,6 +72,10 @@ final class ExamScheduleResult extends Struct {
   external Pointer<ExamScheduleNative> schedules; // Array ptr
 
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class ExamRoomNative extends Struct {
@@ -89,6 +98,12 @@ final class ExamRoomNative extends Struct {
 
   @Int32()
   external int numberExpectedStudent;
+
+  @Int32()
+  external int source; // Input index, for parse_exam_rooms_batch
+
+  @Uint64()
+  external int sources; // Bit i per input i listing it, for the batch
 }
 
 final class ExamRoomResult extends Struct {
@@ -98,6 +113,10 @@ final class ExamRoomResult extends Struct {
   external Pointer<ExamRoomNative> rooms;
 
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class CourseNative extends Struct {
@@ -149,6 +168,150 @@ final class CourseResult extends Struct {
 
   external Pointer<CourseNative> courses;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
+}
+
+// Columnar courses; see CourseColumnsResult in native-lib.h. String
+// columns, in NEKKO_COURSE_* order:
+const int kCourseCodeColumn = 0;
+const int kCourseNameColumn = 1;
+const int kCourseClassCodeColumn = 2;
+const int kCourseClassNameColumn = 3;
+const int kCourseRoomColumn = 4;
+const int kCourseBuildingColumn = 5;
+const int kCourseCampusColumn = 6;
+const int kCourseLecturerNameColumn = 7;
+const int kCourseLecturerEmailColumn = 8;
+const int kCourseStatusColumn = 9;
+const int kCourseStringColumns = 10;
+
+final class CourseColumnsResult extends Struct {
+  @Int32()
+  external int count;
+
+  external Pointer<Int32> id;
+  external Pointer<Int32> dayOfWeek;
+  external Pointer<Int32> startCourseHour;
+  external Pointer<Int32> endCourseHour;
+  external Pointer<Int32> credits;
+  external Pointer<Int32> fromWeek;
+  external Pointer<Int32> toWeek;
+  external Pointer<Int64> startDate;
+  external Pointer<Int64> endDate;
+  external Pointer<Double> grade;
+  external Pointer<Uint8> hasGrade;
+  external Pointer<Uint32> stringOffsets;
+  external Pointer<Int32> stringLengths;
+  external Pointer<Uint8> strings;
+  external Pointer<Uint16> strings16; // parse_courses_columns_utf16 only
+  @Size()
+  external int stringsSize;
+  external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Always false: strings live in the arena
+}
+
+/// Courses as one typed list per field, copied out of a
+/// [CourseColumnsResult] in a handful of memcpys. Filters and sorts can scan
+/// a column directly. Strings arrive as UTF-16 code units, so each one is
+/// built only when asked for, with no UTF-8 decoding.
+class CourseColumns {
+  final int length;
+  final Int32List id;
+  final Int32List dayOfWeek;
+  final Int32List startCourseHour;
+  final Int32List endCourseHour;
+  final Int32List credits;
+  final Int32List fromWeek;
+  final Int32List toWeek;
+  final Int64List startDate;
+  final Int64List endDate;
+  final Float64List grade;
+  final Uint8List hasGrade;
+  final Uint32List _stringOffsets;
+  final Int32List _stringLengths;
+  final Uint16List _strings;
+
+  CourseColumns._(CourseColumnsResult r)
+    : length = r.count,
+      id = Int32List.fromList(r.id.asTypedList(r.count)),
+      dayOfWeek = Int32List.fromList(r.dayOfWeek.asTypedList(r.count)),
+      startCourseHour = Int32List.fromList(
+        r.startCourseHour.asTypedList(r.count),
+      ),
+      endCourseHour = Int32List.fromList(r.endCourseHour.asTypedList(r.count)),
+      credits = Int32List.fromList(r.credits.asTypedList(r.count)),
+      fromWeek = Int32List.fromList(r.fromWeek.asTypedList(r.count)),
+      toWeek = Int32List.fromList(r.toWeek.asTypedList(r.count)),
+      startDate = Int64List.fromList(r.startDate.asTypedList(r.count)),
+      endDate = Int64List.fromList(r.endDate.asTypedList(r.count)),
+      grade = Float64List.fromList(r.grade.asTypedList(r.count)),
+      hasGrade = Uint8List.fromList(r.hasGrade.asTypedList(r.count)),
+      _stringOffsets = Uint32List.fromList(
+        r.stringOffsets.asTypedList(r.count * kCourseStringColumns),
+      ),
+      _stringLengths = Int32List.fromList(
+        r.stringLengths.asTypedList(r.count * kCourseStringColumns),
+      ),
+      _strings = r.stringsSize == 0
+          ? Uint16List(0)
+          : Uint16List.fromList(r.strings16.asTypedList(r.stringsSize));
+
+  static final CourseColumns empty = CourseColumns._empty();
+
+  CourseColumns._empty()
+    : length = 0,
+      id = Int32List(0),
+      dayOfWeek = Int32List(0),
+      startCourseHour = Int32List(0),
+      endCourseHour = Int32List(0),
+      credits = Int32List(0),
+      fromWeek = Int32List(0),
+      toWeek = Int32List(0),
+      startDate = Int64List(0),
+      endDate = Int64List(0),
+      grade = Float64List(0),
+      hasGrade = Uint8List(0),
+      _stringOffsets = Uint32List(0),
+      _stringLengths = Int32List(0),
+      _strings = Uint16List(0);
+
+  /// String [column] (kCourse*Column) of [row], or null.
+  String? string(int column, int row) {
+    final cell = column * length + row;
+    final len = _stringLengths[cell];
+    if (len < 0) return null;
+    final start = _stringOffsets[cell];
+    return String.fromCharCodes(_strings, start, start + len);
+  }
+
+  CourseModel courseAt(int row) => CourseModel(
+    id: id[row],
+    courseCode: string(kCourseCodeColumn, row) ?? '',
+    courseName: string(kCourseNameColumn, row) ?? '',
+    classCode: string(kCourseClassCodeColumn, row) ?? '',
+    className: string(kCourseClassNameColumn, row) ?? '',
+    dayOfWeek: dayOfWeek[row],
+    startCourseHour: startCourseHour[row],
+    endCourseHour: endCourseHour[row],
+    room: string(kCourseRoomColumn, row) ?? '',
+    building: string(kCourseBuildingColumn, row) ?? '',
+    campus: string(kCourseCampusColumn, row) ?? '',
+    credits: credits[row],
+    startDate: startDate[row],
+    endDate: endDate[row],
+    fromWeek: fromWeek[row],
+    toWeek: toWeek[row],
+    lecturerName: string(kCourseLecturerNameColumn, row),
+    lecturerEmail: string(kCourseLecturerEmailColumn, row),
+    status: string(kCourseStatusColumn, row) ?? 'N/A',
+    grade: hasGrade[row] != 0 ? grade[row] : null,
+  );
 }
 
 final class CourseHourNative extends Struct {
@@ -166,6 +329,10 @@ final class CourseHourResult extends Struct {
   external int count;
   external Pointer<CourseHourNative> hours;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class SemesterRegisterPeriodNative extends Struct {
@@ -205,6 +372,10 @@ final class SemesterNative extends Struct {
 final class SemesterResult extends Struct {
   external Pointer<SemesterNative> semester;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class SchoolYearNative extends Struct {
@@ -231,6 +402,10 @@ final class SchoolYearResult extends Struct {
   external int count;
   external Pointer<SchoolYearNative> years;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class UserNative extends Struct {
@@ -244,6 +419,10 @@ final class UserNative extends Struct {
 final class UserResult extends Struct {
   external Pointer<UserNative> user;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class TokenResponseNative extends Struct {
@@ -258,6 +437,10 @@ final class TokenResponseNative extends Struct {
 final class TokenResponseResult extends Struct {
   external Pointer<TokenResponseNative> token;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 // --- Registration Structs ---
@@ -336,12 +519,20 @@ final class RegistrationPeriodNative extends Struct {
 final class RegistrationResult extends Struct {
   external Pointer<RegistrationPeriodNative> data;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class RegistrationActionNative extends Struct {
   @Int32()
   external int status;
   external Pointer<Utf8> message;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 final class NotificationNative extends Struct {
@@ -358,6 +549,10 @@ final class NotificationResult extends Struct {
   external int count;
   external Pointer<NotificationNative> notifications;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
 }
 
 class NotificationNativeModel {
@@ -403,53 +598,173 @@ final class StudentMarkResult extends Struct {
   external int count;
   external Pointer<StudentMarkNative> marks;
   external Pointer<Utf8> errorMessage;
+
+  external Pointer<Void> arena; // Owned by native, released by free_*
+  @Bool()
+  external bool stringsBorrowed; // Strings point into the input buffer
+}
+
+// A flat result (flat_blob.h): this header, then the *Result named by kind,
+// [root] bytes in. Pointers are valid once nekko_blob_relocate has accepted
+// the copy being read.
+final class NekkoBlob extends Struct {
+  @Uint32()
+  external int magic;
+  @Uint16()
+  external int version;
+  @Uint8()
+  external int kind;
+  @Uint8()
+  external int pointerSize;
+  @Uint64()
+  external int size;
+  @Uint64()
+  external int base;
+  @Uint64()
+  external int root;
 }
 
 // --- Function Signatures ---
 
 typedef ParseExamDetailsFunc =
-    Pointer<ExamScheduleResult> Function(Pointer<Utf8>);
-typedef ParseExamDetails = Pointer<ExamScheduleResult> Function(Pointer<Utf8>);
-
-typedef ParseTokenFunc = Pointer<TokenResponseResult> Function(Pointer<Utf8>);
-typedef ParseToken = Pointer<TokenResponseResult> Function(Pointer<Utf8>);
+    Pointer<ExamScheduleResult> Function(Pointer<Uint8>, Size);
+typedef ParseExamDetails =
+    Pointer<ExamScheduleResult> Function(Pointer<Uint8>, int);
+
+typedef ParseTokenFunc =
+    Pointer<TokenResponseResult> Function(Pointer<Uint8>, Size);
+typedef ParseToken =
+    Pointer<TokenResponseResult> Function(Pointer<Uint8>, int);
 typedef FreeTokenResultFunc = Void Function(Pointer<TokenResponseResult>);
 typedef FreeTokenResult = void Function(Pointer<TokenResponseResult>);
 
-typedef ParseExamRoomsFunc = Pointer<ExamRoomResult> Function(Pointer<Utf8>);
-typedef ParseExamRooms = Pointer<ExamRoomResult> Function(Pointer<Utf8>);
+typedef ParseExamRoomsFunc =
+    Pointer<ExamRoomResult> Function(Pointer<Uint8>, Size);
+typedef ParseExamRooms =
+    Pointer<ExamRoomResult> Function(Pointer<Uint8>, int);
+
+typedef ParseExamRoomsBatchFunc =
+    Pointer<ExamRoomResult> Function(
+      Pointer<Pointer<Uint8>>,
+      Pointer<Size>,
+      Int32,
+    );
+typedef ParseExamRoomsBatch =
+    Pointer<ExamRoomResult> Function(
+      Pointer<Pointer<Uint8>>,
+      Pointer<Size>,
+      int,
+    );
 
 typedef FreeExamRoomResultFunc = Void Function(Pointer<ExamRoomResult>);
 typedef FreeExamRoomResult = void Function(Pointer<ExamRoomResult>);
 
+typedef FinishExamRoomsFunc = Pointer<ExamRoomResult> Function(Pointer<Void>);
+typedef FinishExamRooms = Pointer<ExamRoomResult> Function(Pointer<Void>);
+
 typedef FreeResultFunc = Void Function(Pointer<ExamScheduleResult>);
 typedef FreeResult = void Function(Pointer<ExamScheduleResult>);
 
 typedef GetVersionFunc = Pointer<Utf8> Function();
 typedef GetVersion = Pointer<Utf8> Function();
 
+typedef NekkoAllocBufferFunc = Pointer<Uint8> Function(Size);
+typedef NekkoAllocBuffer = Pointer<Uint8> Function(int);
+typedef NekkoFreeBufferFunc = Void Function(Pointer<Uint8>);
+typedef NekkoFreeBuffer = void Function(Pointer<Uint8>);
+
+typedef NekkoCtxCreateFunc = Pointer<Void> Function();
+typedef NekkoCtxCreate = Pointer<Void> Function();
+typedef NekkoCtxSetFlagsFunc = Void Function(Pointer<Void>, Uint32);
+typedef NekkoCtxSetFlags = void Function(Pointer<Void>, int);
+typedef NekkoCtxClearStringsFunc = Void Function(Pointer<Void>);
+typedef NekkoCtxClearStrings = void Function(Pointer<Void>);
+typedef NekkoCtxSetFieldsFunc = Void Function(Pointer<Void>, Uint32, Uint64);
+typedef NekkoCtxSetFields = void Function(Pointer<Void>, int, int);
+
+/// NEKKO_CTX_BORROW_STRINGS in native-lib.h.
+const int kNekkoCtxBorrowStrings = 1;
+
+/// NEKKO_CTX_INTERN_STRINGS in native-lib.h.
+const int kNekkoCtxInternStrings = 2;
+
+/// NEKKO_CTX_PARALLEL in native-lib.h.
+const int kNekkoCtxParallel = 4;
+
+/// NekkoEntity in native-lib.h: which entity nekko_ctx_set_fields projects.
+/// Field bits are `1 << NEKKO_X_FIELD_Y`, in the order the header lists them.
+const int kNekkoEntityCourse = 0;
+const int kNekkoEntityExamRoom = 1;
+const int kNekkoEntityExamSchedule = 2;
+const int kNekkoEntityExamPeriod = 3;
+const int kNekkoEntityCourseHour = 4;
+const int kNekkoEntitySchoolYear = 5;
+const int kNekkoEntitySemester = 6;
+const int kNekkoEntityRegisterPeriod = 7;
+const int kNekkoEntitySubject = 8;
+const int kNekkoEntityCourseSubject = 9;
+const int kNekkoEntityTimetable = 10;
+const int kNekkoEntityStudentMark = 11;
+
+/// NEKKO_FIELDS_ALL in native-lib.h (all 64 bits set).
+const int kNekkoFieldsAll = -1;
+
+// Chunked parsing (parse_x_begin / parse_x_feed / nekko_stream_cancel); the
+// stream handle is opaque.
+typedef NekkoEncodingSupportedFunc = Bool Function(Pointer<Utf8>);
+typedef NekkoEncodingSupported = bool Function(Pointer<Utf8>);
+
+typedef StreamBeginFunc = Pointer<Void> Function(Size);
+typedef StreamBegin = Pointer<Void> Function(int);
+typedef StreamFeedFunc = Bool Function(Pointer<Void>, Pointer<Uint8>, Size);
+typedef StreamFeed = bool Function(Pointer<Void>, Pointer<Uint8>, int);
+typedef StreamCancelFunc = Void Function(Pointer<Void>);
+typedef StreamCancel = void Function(Pointer<Void>);
+
 typedef ParseCountFunc = Int32 Function(Pointer<Utf8>);
 typedef ParseCount = int Function(Pointer<Utf8>);
 
-typedef ParseCoursesFunc = Pointer<CourseResult> Function(Pointer<Utf8>);
-typedef ParseCourses = Pointer<CourseResult> Function(Pointer<Utf8>);
+typedef ParseCoursesFunc =
+    Pointer<CourseResult> Function(Pointer<Uint8>, Size);
+typedef ParseCourses =
+    Pointer<CourseResult> Function(Pointer<Uint8>, int);
+
+typedef ParseCoursesEncodedFunc =
+    Pointer<CourseResult> Function(Pointer<Uint8>, Size, Pointer<Utf8>);
+typedef ParseCoursesEncoded =
+    Pointer<CourseResult> Function(Pointer<Uint8>, int, Pointer<Utf8>);
 
 typedef FreeCourseResultFunc = Void Function(Pointer<CourseResult>);
 typedef FreeCourseResult = void Function(Pointer<CourseResult>);
 
+typedef ParseCourseColumnsFunc =
+    Pointer<CourseColumnsResult> Function(Pointer<Uint8>, Size);
+typedef ParseCourseColumns =
+    Pointer<CourseColumnsResult> Function(Pointer<Uint8>, int);
+
+typedef FreeCourseColumnsResultFunc =
+    Void Function(Pointer<CourseColumnsResult>);
+typedef FreeCourseColumnsResult = void Function(Pointer<CourseColumnsResult>);
+
 typedef ParseCourseHoursFunc =
-    Pointer<CourseHourResult> Function(Pointer<Utf8>);
-typedef ParseCourseHours = Pointer<CourseHourResult> Function(Pointer<Utf8>);
+    Pointer<CourseHourResult> Function(Pointer<Uint8>, Size);
+typedef ParseCourseHours =
+    Pointer<CourseHourResult> Function(Pointer<Uint8>, int);
 
 typedef ParseSchoolYearsFunc =
-    Pointer<SchoolYearResult> Function(Pointer<Utf8>);
-typedef ParseSchoolYears = Pointer<SchoolYearResult> Function(Pointer<Utf8>);
+    Pointer<SchoolYearResult> Function(Pointer<Uint8>, Size);
+typedef ParseSchoolYears =
+    Pointer<SchoolYearResult> Function(Pointer<Uint8>, int);
 
-typedef ParseSemesterFunc = Pointer<SemesterResult> Function(Pointer<Utf8>);
-typedef ParseSemester = Pointer<SemesterResult> Function(Pointer<Utf8>);
+typedef ParseSemesterFunc =
+    Pointer<SemesterResult> Function(Pointer<Uint8>, Size);
+typedef ParseSemester =
+    Pointer<SemesterResult> Function(Pointer<Uint8>, int);
 
-typedef ParseUserFunc = Pointer<UserResult> Function(Pointer<Utf8>);
-typedef ParseUser = Pointer<UserResult> Function(Pointer<Utf8>);
+typedef ParseUserFunc =
+    Pointer<UserResult> Function(Pointer<Uint8>, Size);
+typedef ParseUser =
+    Pointer<UserResult> Function(Pointer<Uint8>, int);
 
 typedef FreeCourseHourResultFunc = Void Function(Pointer<CourseHourResult>);
 typedef FreeCourseHourResult = void Function(Pointer<CourseHourResult>);
@@ -464,29 +779,219 @@ typedef FreeUserResultFunc = Void Function(Pointer<UserResult>);
 typedef FreeUserResult = void Function(Pointer<UserResult>);
 
 typedef ParseRegistrationFunc =
-    Pointer<RegistrationResult> Function(Pointer<Utf8>);
-typedef ParseRegistration = Pointer<RegistrationResult> Function(Pointer<Utf8>);
+    Pointer<RegistrationResult> Function(Pointer<Uint8>, Size);
+typedef ParseRegistration =
+    Pointer<RegistrationResult> Function(Pointer<Uint8>, int);
+
+typedef ParseRegistrationCtxFunc =
+    Pointer<RegistrationResult> Function(Pointer<Void>, Pointer<Uint8>, Size);
+typedef ParseRegistrationCtx =
+    Pointer<RegistrationResult> Function(Pointer<Void>, Pointer<Uint8>, int);
 
 typedef FreeRegistrationResultFunc = Void Function(Pointer<RegistrationResult>);
 typedef FreeRegistrationResult = void Function(Pointer<RegistrationResult>);
 
+typedef FinishRegistrationFunc =
+    Pointer<RegistrationResult> Function(Pointer<Void>);
+typedef FinishRegistration =
+    Pointer<RegistrationResult> Function(Pointer<Void>);
+
 typedef ParseRegistrationActionFunc =
-    Pointer<RegistrationActionNative> Function(Pointer<Utf8>);
+    Pointer<RegistrationActionNative> Function(Pointer<Uint8>, Size);
 typedef ParseRegistrationAction =
-    Pointer<RegistrationActionNative> Function(Pointer<Utf8>);
+    Pointer<RegistrationActionNative> Function(Pointer<Uint8>, int);
 
 typedef FreeRegistrationActionResultFunc =
     Void Function(Pointer<RegistrationActionNative>);
 typedef FreeRegistrationActionResult =
     void Function(Pointer<RegistrationActionNative>);
 
+typedef ParseFlatFunc = Pointer<NekkoBlob> Function(Pointer<Uint8>, Size);
+typedef ParseFlat = Pointer<NekkoBlob> Function(Pointer<Uint8>, int);
+typedef NekkoBlobRelocateFunc = Bool Function(Pointer<NekkoBlob>, Size);
+typedef NekkoBlobRelocate = bool Function(Pointer<NekkoBlob>, int);
+typedef NekkoBlobFreeFunc = Void Function(Pointer<NekkoBlob>);
+typedef NekkoBlobFree = void Function(Pointer<NekkoBlob>);
+
 typedef ParseStudentMarksFunc =
-    Pointer<StudentMarkResult> Function(Pointer<Utf8>);
-typedef ParseStudentMarks = Pointer<StudentMarkResult> Function(Pointer<Utf8>);
+    Pointer<StudentMarkResult> Function(Pointer<Uint8>, Size);
+typedef ParseStudentMarks =
+    Pointer<StudentMarkResult> Function(Pointer<Uint8>, int);
 
 typedef FreeStudentMarkResultFunc = Void Function(Pointer<StudentMarkResult>);
 typedef FreeStudentMarkResult = void Function(Pointer<StudentMarkResult>);
 
+// Registration pages (nekko_registration_*); the handle is opaque.
+typedef NekkoRegistrationOpenBufferFunc =
+    Pointer<Void> Function(Pointer<Uint8>, Size);
+typedef NekkoRegistrationOpenBuffer =
+    Pointer<Void> Function(Pointer<Uint8>, int);
+typedef NekkoRegistrationErrorFunc = Pointer<Utf8> Function(Pointer<Void>);
+typedef NekkoRegistrationError = Pointer<Utf8> Function(Pointer<Void>);
+typedef NekkoRegistrationCountFunc = Int32 Function(Pointer<Void>);
+typedef NekkoRegistrationCount = int Function(Pointer<Void>);
+typedef NekkoRegistrationPageFunc =
+    Pointer<RegistrationResult> Function(Pointer<Void>, Int32, Int32);
+typedef NekkoRegistrationPage =
+    Pointer<RegistrationResult> Function(Pointer<Void>, int, int);
+typedef NekkoRegistrationSubjectFunc =
+    Pointer<RegistrationResult> Function(Pointer<Void>, Int32);
+typedef NekkoRegistrationSubject =
+    Pointer<RegistrationResult> Function(Pointer<Void>, int);
+typedef NekkoRegistrationCloseFunc = Void Function(Pointer<Void>);
+typedef NekkoRegistrationClose = void Function(Pointer<Void>);
+
+// Cancellation tokens (nekko_cancel_*); the token is opaque.
+typedef NekkoCancelCreateFunc = Pointer<Void> Function(Int64);
+typedef NekkoCancelCreate = Pointer<Void> Function(int);
+typedef NekkoCancelOpFunc = Void Function(Pointer<Void>);
+typedef NekkoCancelOp = void Function(Pointer<Void>);
+typedef NekkoCancelledFunc = Bool Function(Pointer<Void>);
+typedef NekkoCancelled = bool Function(Pointer<Void>);
+
+// Background parses (nekko_submit_parse).
+typedef ParseDoneCallback =
+    Void Function(Pointer<Void>, Int32, Int32, Pointer<Void>);
+typedef NekkoSubmitParseFunc =
+    Bool Function(
+      Int32,
+      Pointer<Uint8>,
+      Size,
+      Pointer<Utf8>,
+      Pointer<Void>,
+      Pointer<NativeFunction<ParseDoneCallback>>,
+      Pointer<Void>,
+    );
+typedef NekkoSubmitParse =
+    bool Function(
+      int,
+      Pointer<Uint8>,
+      int,
+      Pointer<Utf8>,
+      Pointer<Void>,
+      Pointer<NativeFunction<ParseDoneCallback>>,
+      Pointer<Void>,
+    );
+
+/// NekkoParseKind in native-lib.h: what nekko_submit_parse parses.
+const int kNekkoParseCourses = 0;
+const int kNekkoParseCourseHours = 1;
+const int kNekkoParseSchoolYears = 2;
+const int kNekkoParseSemester = 3;
+const int kNekkoParseRegistration = 4;
+
+/// NekkoJobStatus in native-lib.h: how a background parse ended.
+const int kNekkoJobDone = 0;
+const int kNekkoJobCancelled = 1;
+
+// A submitted parse: completed from the done callback, and the token it
+// holds on to until then.
+typedef _ParseJob = ({
+  Completer<({int status, Pointer<Void> result})> done,
+  NativeCancelToken? cancel,
+});
+
+// Batched delivery (parse_x_batched); the callbacks get each batch.
+typedef CourseBatchCallback =
+    Void Function(Pointer<Void>, Pointer<CourseResult>, Bool);
+typedef RegistrationBatchCallback =
+    Void Function(Pointer<Void>, Pointer<RegistrationResult>, Bool);
+typedef ParseBatchedFunc =
+    Void Function(Pointer<Uint8>, Size, Int32, Pointer<Void>, Pointer<Void>);
+typedef ParseBatched =
+    void Function(Pointer<Uint8>, int, int, Pointer<Void>, Pointer<Void>);
+
+// Documents (nekko_doc_*); the handle is opaque.
+typedef NekkoDocOpenBufferFunc = Pointer<Void> Function(Pointer<Uint8>, Size);
+typedef NekkoDocOpenBuffer = Pointer<Void> Function(Pointer<Uint8>, int);
+typedef NekkoDocErrorFunc = Pointer<Utf8> Function(Pointer<Void>);
+typedef NekkoDocError = Pointer<Utf8> Function(Pointer<Void>);
+typedef NekkoDocCloseFunc = Void Function(Pointer<Void>);
+typedef NekkoDocClose = void Function(Pointer<Void>);
+typedef NekkoDocTypeFunc = Int32 Function(Pointer<Void>, Pointer<Utf8>);
+typedef NekkoDocType = int Function(Pointer<Void>, Pointer<Utf8>);
+typedef NekkoDocSizeFunc = Size Function(Pointer<Void>, Pointer<Utf8>);
+typedef NekkoDocSize = int Function(Pointer<Void>, Pointer<Utf8>);
+typedef NekkoDocInt64Func =
+    Bool Function(Pointer<Void>, Pointer<Utf8>, Pointer<Int64>);
+typedef NekkoDocInt64 =
+    bool Function(Pointer<Void>, Pointer<Utf8>, Pointer<Int64>);
+typedef NekkoDocDoubleFunc =
+    Bool Function(Pointer<Void>, Pointer<Utf8>, Pointer<Double>);
+typedef NekkoDocDouble =
+    bool Function(Pointer<Void>, Pointer<Utf8>, Pointer<Double>);
+typedef NekkoDocStringFunc =
+    Pointer<Utf8> Function(Pointer<Void>, Pointer<Utf8>, Pointer<Size>);
+typedef NekkoDocString =
+    Pointer<Utf8> Function(Pointer<Void>, Pointer<Utf8>, Pointer<Size>);
+typedef NekkoDocWriteFunc =
+    Pointer<Uint8> Function(Pointer<Void>, Pointer<Utf8>, Pointer<Size>);
+typedef NekkoDocWrite =
+    Pointer<Uint8> Function(Pointer<Void>, Pointer<Utf8>, Pointer<Size>);
+typedef NekkoDocExtractInt64Func =
+    Size Function(
+      Pointer<Void>,
+      Pointer<Utf8>,
+      Pointer<Utf8>,
+      Pointer<Int64>,
+      Pointer<Uint8>,
+      Size,
+    );
+typedef NekkoDocExtractInt64 =
+    int Function(
+      Pointer<Void>,
+      Pointer<Utf8>,
+      Pointer<Utf8>,
+      Pointer<Int64>,
+      Pointer<Uint8>,
+      int,
+    );
+typedef NekkoDocExtractDoubleFunc =
+    Size Function(
+      Pointer<Void>,
+      Pointer<Utf8>,
+      Pointer<Utf8>,
+      Pointer<Double>,
+      Pointer<Uint8>,
+      Size,
+    );
+typedef NekkoDocExtractDouble =
+    int Function(
+      Pointer<Void>,
+      Pointer<Utf8>,
+      Pointer<Utf8>,
+      Pointer<Double>,
+      Pointer<Uint8>,
+      int,
+    );
+typedef NekkoDocExtractStringFunc =
+    Size Function(
+      Pointer<Void>,
+      Pointer<Utf8>,
+      Pointer<Utf8>,
+      Pointer<Pointer<Utf8>>,
+      Pointer<Uint32>,
+      Size,
+    );
+typedef NekkoDocExtractString =
+    int Function(
+      Pointer<Void>,
+      Pointer<Utf8>,
+      Pointer<Utf8>,
+      Pointer<Pointer<Utf8>>,
+      Pointer<Uint32>,
+      int,
+    );
+
+/// NekkoValueType in native-lib.h: what [NativeDocument.type] returns.
+const int kNekkoValueNone = 0;
+const int kNekkoValueNull = 1;
+const int kNekkoValueBool = 2;
+const int kNekkoValueNumber = 3;
+const int kNekkoValueString = 4;
+const int kNekkoValueArray = 5;
+const int kNekkoValueObject = 6;
+
 class NativeParser {
   static DynamicLibrary? _lib;
 
@@ -501,8 +1006,8 @@ class NativeParser {
   }
 
   // --- Cache Native Logic ---
-  static String? _cachedCoursesJson;
-  static String? _cachedHoursJson;
+  static Uint8List? _cachedCoursesJson;
+  static Uint8List? _cachedHoursJson;
 
   static void clearCache() {
     _cachedCoursesJson = null;
@@ -520,139 +1025,721 @@ class NativeParser {
     }
   }
 
+  // --- Input Buffers ---
+  // The *_bytes parsers take length-delimited UTF-8 with no terminator.
+  // Buffers come from nekko_alloc_buffer, which adds the tail padding the
+  // insitu parsers (courses, notifications) need to read without a copy.
+  static Pointer<Uint8> _toNativeBuffer(Uint8List bytes) {
+    final alloc = _library
+        .lookupFunction<NekkoAllocBufferFunc, NekkoAllocBuffer>(
+          'nekko_alloc_buffer',
+        );
+    final buf = alloc(bytes.length);
+    if (buf == nullptr) throw Exception("nekko_alloc_buffer failed");
+    buf.asTypedList(bytes.length).setAll(0, bytes);
+    return buf;
+  }
+
+  static void _freeBuffer(Pointer<Uint8> buf) {
+    final free = _library
+        .lookupFunction<NekkoFreeBufferFunc, NekkoFreeBuffer>(
+          'nekko_free_buffer',
+        );
+    free(buf);
+  }
+
+  // --- Compressed Bodies ---
+  // Bodies from NetworkClient.getEncoded are decoded natively by the
+  // parse_x_encoded parsers. br needs libbrotlidec in the native build, so
+  // where nekko_body_encoding_supported says no, the body is decoded here
+  // and goes to the plain parser instead; that is the decoded bytes, or
+  // null when the native side can take the body as is.
+  static Uint8List? _decodeUnsupported(EncodedBody body) {
+    final supported = _library
+        .lookupFunction<NekkoEncodingSupportedFunc, NekkoEncodingSupported>(
+          'nekko_body_encoding_supported',
+        );
+    final encoding = (body.encoding ?? '').toNativeUtf8();
+    try {
+      if (supported(encoding)) return null;
+    } finally {
+      malloc.free(encoding);
+    }
+    if (body.encoding?.trim().toLowerCase() == 'br') {
+      return Uint8List.fromList(brotli.decode(body.bytes));
+    }
+    throw Exception("Unsupported content encoding: ${body.encoding}");
+  }
+
+  // Runs [parse] on a native copy of [body] and its encoding name. The
+  // parse_x_encoded results own their strings, so both go right after.
+  static T _withEncodedBody<T>(
+    EncodedBody body,
+    T Function(Pointer<Uint8> buf, Pointer<Utf8> encoding) parse,
+  ) {
+    final buf = _toNativeBuffer(body.bytes);
+    final encoding = (body.encoding ?? '').toNativeUtf8();
+    try {
+      return parse(buf, encoding);
+    } finally {
+      malloc.free(encoding);
+      _freeBuffer(buf);
+    }
+  }
+
+  // --- Chunked Parsing ---
+  // Feeds a response body to parse_x_begin/parse_x_feed as it arrives, so
+  // the parse runs while the rest is still downloading; the caller then
+  // calls the matching parse_x_finish on the returned stream. [length]
+  // must be the exact body length or null; a Content-Length describing a
+  // compressed body does not qualify. Stops reading early once the parser
+  // reports the body cannot parse; finish then carries the error.
+  static Future<Pointer<Void>> _feedStream(
+    String parser,
+    Stream<List<int>> body,
+    int? length,
+  ) async {
+    final begin = _library.lookupFunction<StreamBeginFunc, StreamBegin>(
+      '${parser}_begin',
+    );
+    final feed = _library.lookupFunction<StreamFeedFunc, StreamFeed>(
+      '${parser}_feed',
+    );
+    final cancel = _library.lookupFunction<StreamCancelFunc, StreamCancel>(
+      'nekko_stream_cancel',
+    );
+    final alloc = _library
+        .lookupFunction<NekkoAllocBufferFunc, NekkoAllocBuffer>(
+          'nekko_alloc_buffer',
+        );
+
+    final stream = begin(length ?? 0);
+    if (stream == nullptr) throw Exception("${parser}_begin failed");
+    // One staging buffer for every chunk; feed copies out of it.
+    Pointer<Uint8> chunkBuf = nullptr;
+    int chunkCap = 0;
+    try {
+      await for (final chunk in body) {
+        if (chunk.length > chunkCap) {
+          if (chunkBuf != nullptr) _freeBuffer(chunkBuf);
+          chunkBuf = alloc(chunk.length);
+          if (chunkBuf == nullptr) throw Exception("nekko_alloc_buffer failed");
+          chunkCap = chunk.length;
+        }
+        chunkBuf.asTypedList(chunk.length).setAll(0, chunk);
+        if (!feed(stream, chunkBuf, chunk.length)) break;
+      }
+    } catch (_) {
+      cancel(stream);
+      rethrow;
+    } finally {
+      if (chunkBuf != nullptr) _freeBuffer(chunkBuf);
+    }
+    return stream;
+  }
+
+  // --- Parse Context ---
+  // The registration screen re-parses the same large payload on every
+  // refresh. A nekko_ctx keeps the DOM memory from one call to the next, so
+  // those calls stop hitting malloc. Statics are per isolate and this one is
+  // only used from the UI isolate, so it lives as long as the app.
+  static Pointer<Void>? _registrationCtx;
+
+  static Pointer<Void> get _registrationContext {
+    if (_registrationCtx != null) return _registrationCtx!;
+    final create = _library
+        .lookupFunction<NekkoCtxCreateFunc, NekkoCtxCreate>('nekko_ctx_create');
+    final setFlags = _library
+        .lookupFunction<NekkoCtxSetFlagsFunc, NekkoCtxSetFlags>(
+          'nekko_ctx_set_flags',
+        );
+    final ctx = create();
+    if (ctx == nullptr) throw Exception("nekko_ctx_create failed");
+    // The payload is re-pulled every few seconds while registration is open;
+    // its subjects are decoded on the native worker threads.
+    setFlags(ctx, kNekkoCtxInternStrings | kNekkoCtxParallel);
+    _registrationCtx = ctx;
+    return ctx;
+  }
+
+  // The context interns strings into a pool it keeps between calls, where
+  // a string keeps its id (the uint32 just before it), so each one is
+  // decoded once per pool rather than once per field per refresh.
+  static final List<String?> _registrationStrings = [];
+
+  // Past this many strings the pool starts over, so it cannot grow for
+  // the lifetime of the app.
+  static const int _kMaxRegistrationStrings = 1 << 16;
+
+  static String _registrationString(Pointer<Utf8> p) {
+    if (p == nullptr) return '';
+    final id = Pointer<Uint32>.fromAddress(p.address - 4).value;
+    if (id >= _registrationStrings.length) {
+      _registrationStrings.length = id + 1;
+    }
+    return _registrationStrings[id] ??= p.toDartString();
+  }
+
+  static void _trimRegistrationStrings() {
+    if (_registrationCtx == null ||
+        _registrationStrings.length <= _kMaxRegistrationStrings) {
+      return;
+    }
+    final clear = _library
+        .lookupFunction<NekkoCtxClearStringsFunc, NekkoCtxClearStrings>(
+          'nekko_ctx_clear_strings',
+        );
+    clear(_registrationCtx!);
+    _registrationStrings.clear();
+  }
+
   // --- Registration Binding ---
   static List<SubjectRegistrationModel> parseRegistrationData(
     String jsonString,
+  ) => parseRegistrationDataBytes(utf8.encode(jsonString));
+
+  static List<SubjectRegistrationModel> parseRegistrationDataBytes(
+    Uint8List bytes,
   ) {
     try {
+      // Largest payload in the app: through the reusable context, whose
+      // string pool outlives both the result and `buf`.
       final func = _library
-          .lookupFunction<ParseRegistrationFunc, ParseRegistration>(
-            'parse_registration_data',
+          .lookupFunction<ParseRegistrationCtxFunc, ParseRegistrationCtx>(
+            'parse_registration_data_ctx',
+          );
+      _trimRegistrationStrings();
+      final buf = _toNativeBuffer(bytes);
+      try {
+        return _readRegistrationResult(
+          func(_registrationContext, buf, bytes.length),
+          str: _registrationString,
+        );
+      } finally {
+        _freeBuffer(buf);
+      }
+    } catch (e) {
+      debugPrint("Native Parse Error (Registration): $e");
+      return [];
+    }
+  }
+
+  /// Parses a registration response body while it downloads; see
+  /// [_feedStream]. Pass [length] only when it is the decoded body length.
+  static Future<List<SubjectRegistrationModel>> parseRegistrationDataStream(
+    Stream<List<int>> body, {
+    int? length,
+  }) async {
+    try {
+      final stream = await _feedStream('parse_registration_data', body, length);
+      final finish = _library
+          .lookupFunction<FinishRegistrationFunc, FinishRegistration>(
+            'parse_registration_data_finish',
           );
-      final jsonPtr = jsonString.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      calloc.free(jsonPtr);
+      return _readRegistrationResult(finish(stream));
+    } catch (e) {
+      debugPrint("Native Parse Error (Registration): $e");
+      return [];
+    }
+  }
 
-      final result = resultPtr.ref;
-      if (result.errorMessage != nullptr) {
-        final errorMsg = result.errorMessage.toDartString();
-        debugPrint("Native Registration Error: $errorMsg");
-        final freeFunc = _library
-            .lookupFunction<FreeRegistrationResultFunc, FreeRegistrationResult>(
-              'free_registration_result',
-            );
-        freeFunc(resultPtr);
-        // Throwing exception so provider catches it
-        throw Exception("Native Parse Error: $errorMsg");
+  // --- Background Parses ---
+  // nekko_submit_parse runs a parse on the library's own worker threads and
+  // reports back through one NativeCallable.listener, so a parse costs no
+  // isolate and the body is not copied into one; only the conversion to
+  // models runs here. Jobs are told apart by the id passed as `user`.
+
+  static int _nextJob = 1;
+  static final Map<int, _ParseJob> _jobs = {};
+  static NativeCallable<ParseDoneCallback>? _parseDone;
+
+  static void _onParseDone(
+    Pointer<Void> user,
+    int kind,
+    int status,
+    Pointer<Void> result,
+  ) {
+    final job = _jobs.remove(user.address);
+    job?.cancel?._jobFinished();
+    job?.done.complete((status: status, result: result));
+    // Only a pending job keeps the isolate alive.
+    _parseDone!.keepIsolateAlive = _jobs.isNotEmpty;
+  }
+
+  // Submits [bytes] as a [kind] parse (encoded as [encoding], if given) and
+  // hands the result to [read], which converts and frees it. Throws
+  // [NativeParseCancelled] when [cancel] stopped the parse first.
+  static Future<T> _submitParse<T>(
+    int kind,
+    Uint8List bytes,
+    String? encoding,
+    T Function(Pointer<Void> result) read, {
+    NativeCancelToken? cancel,
+  }) async {
+    final submit = _library
+        .lookupFunction<NekkoSubmitParseFunc, NekkoSubmitParse>(
+          'nekko_submit_parse',
+        );
+    final done = _parseDone ??= NativeCallable<ParseDoneCallback>.listener(
+      _onParseDone,
+    );
+    final token = cancel?._startJob() ?? nullptr;
+    final id = _nextJob++;
+    final completer = Completer<({int status, Pointer<Void> result})>();
+    _jobs[id] = (done: completer, cancel: cancel);
+    done.keepIsolateAlive = true;
+
+    final Pointer<Utf8> enc = encoding == null
+        ? nullptr
+        : encoding.toNativeUtf8();
+    try {
+      // The job takes over the buffer, also when it is refused.
+      final buf = _toNativeBuffer(bytes);
+      if (!submit(
+        kind,
+        buf,
+        bytes.length,
+        enc,
+        token,
+        done.nativeFunction,
+        Pointer.fromAddress(id),
+      )) {
+        throw Exception("nekko_submit_parse refused kind $kind");
       }
+    } catch (e) {
+      _jobs.remove(id)?.cancel?._jobFinished();
+      done.keepIsolateAlive = _jobs.isNotEmpty;
+      rethrow;
+    } finally {
+      if (enc != nullptr) malloc.free(enc);
+    }
+    final job = await completer.future;
+    if (job.status == kNekkoJobCancelled) throw const NativeParseCancelled();
+    return read(job.result);
+  }
 
-      List<SubjectRegistrationModel> subjects = [];
-      if (result.data != nullptr) {
-        final period = result.data.ref;
-        final subjectsPtr = period.subjects;
-        final count = period.subjectsCount;
+  /// [parseCoursesEncoded], with the parse on the native worker threads.
+  /// Throws [NativeParseCancelled] if [cancel] stops it.
+  static Future<List<CourseModel>> parseCoursesAsync(
+    EncodedBody body, {
+    NativeCancelToken? cancel,
+  }) async {
+    if (body.bytes.isEmpty) return [];
+    try {
+      final bytes = _decodeUnsupported(body);
+      return await _submitParse(
+        kNekkoParseCourses,
+        bytes ?? body.bytes,
+        bytes == null ? body.encoding : null,
+        (result) => _readCourseResult(result.cast<CourseResult>()),
+        cancel: cancel,
+      );
+    } on NativeParseCancelled {
+      rethrow;
+    } catch (e) {
+      print("Native Logic Error (Courses): $e");
+      return [];
+    }
+  }
 
-        for (int i = 0; i < count; i++) {
-          final sNative = subjectsPtr[i];
-
-          List<CourseSubjectModel> courseSubjects = [];
-          final csPtr = sNative.courseSubjects;
-          final csCount = sNative.courseSubjectsCount;
-
-          for (int j = 0; j < csCount; j++) {
-            final csNative = csPtr[j];
-
-            List<TimetableModel> timetables = [];
-            final tPtr = csNative.timetables;
-            final tCount = csNative.timetablesCount;
-
-            for (int k = 0; k < tCount; k++) {
-              final tNative = tPtr[k];
-              timetables.add(
-                TimetableModel(
-                  id: tNative.id,
-                  startDate: tNative.startDate,
-                  endDate: tNative.endDate,
-                  fromWeek: tNative.fromWeek,
-                  toWeek: tNative.toWeek,
-                  dayOfWeek: tNative.dayOfWeek,
-                  startHour: tNative.startHour,
-                  endHour: tNative.endHour,
-                  roomId: tNative.roomId,
-                  startHourId: tNative.startHourId,
-                  endHourId: tNative.endHourId,
-                  roomName: tNative.roomName != nullptr
-                      ? tNative.roomName.toDartString()
-                      : '',
-                  teacherName: tNative.teacherName != nullptr
-                      ? tNative.teacherName.toDartString()
-                      : '',
-                ),
-              );
-            }
+  /// [parseCourseHours], with the parse on the native worker threads.
+  /// Throws [NativeParseCancelled] if [cancel] stops it.
+  static Future<List<CourseHour>> parseCourseHoursAsync(
+    String jsonStr, {
+    NativeCancelToken? cancel,
+  }) async {
+    final bytes = utf8.encode(jsonStr);
+    if (bytes.isEmpty) return [];
+    _cachedHoursJson = bytes; // Cache input
+    try {
+      return await _submitParse(
+        kNekkoParseCourseHours,
+        bytes,
+        null,
+        (result) => _readCourseHourResult(result.cast<CourseHourResult>()),
+        cancel: cancel,
+      );
+    } on NativeParseCancelled {
+      rethrow;
+    } catch (e) {
+      return [];
+    }
+  }
 
-            courseSubjects.add(
-              CourseSubjectModel(
-                id: csNative.id,
-                subjectId: csNative.subjectId,
-                code: csNative.code != nullptr
-                    ? csNative.code.toDartString()
-                    : '',
-                name: csNative.name != nullptr
-                    ? csNative.name.toDartString()
-                    : '',
-                displayCode: csNative.displayCode != nullptr
-                    ? csNative.displayCode.toDartString()
-                    : '',
-                numberStudent: csNative.numberStudent,
-                maxStudent: csNative.maxStudent,
-                isSelected: csNative.isSelected,
-                isFull: csNative.isFull,
-                isOverlap: csNative.isOverlap,
-                credits: csNative.credits,
-                status: csNative.status != nullptr
-                    ? csNative.status.toDartString()
-                    : '',
-                timetables: timetables,
+  /// [parseSchoolYears], with the parse on the native worker threads.
+  /// Throws [NativeParseCancelled] if [cancel] stops it.
+  static Future<List<SchoolYearModel>> parseSchoolYearsAsync(
+    String jsonStr, {
+    NativeCancelToken? cancel,
+  }) async {
+    final bytes = utf8.encode(jsonStr);
+    if (bytes.isEmpty) return [];
+    try {
+      return await _submitParse(
+        kNekkoParseSchoolYears,
+        bytes,
+        null,
+        (result) => _readSchoolYearResult(result.cast<SchoolYearResult>()),
+        cancel: cancel,
+      );
+    } on NativeParseCancelled {
+      rethrow;
+    } catch (e) {
+      return [];
+    }
+  }
+
+  /// [parseSemester], with the parse on the native worker threads.
+  /// Throws [NativeParseCancelled] if [cancel] stops it.
+  static Future<SemesterModel?> parseSemesterAsync(
+    String jsonStr, {
+    NativeCancelToken? cancel,
+  }) async {
+    final bytes = utf8.encode(jsonStr);
+    if (bytes.isEmpty) return null;
+    try {
+      return await _submitParse(
+        kNekkoParseSemester,
+        bytes,
+        null,
+        (result) => _readSemesterResult(result.cast<SemesterResult>()),
+        cancel: cancel,
+      );
+    } on NativeParseCancelled {
+      rethrow;
+    } catch (e) {
+      return null;
+    }
+  }
+
+  /// [parseRegistrationDataBytes], with the parse on the native worker
+  /// threads. Throws [NativeParseCancelled] if [cancel] stops it.
+  static Future<List<SubjectRegistrationModel>> parseRegistrationDataAsync(
+    Uint8List bytes, {
+    NativeCancelToken? cancel,
+  }) async {
+    if (bytes.isEmpty) return [];
+    try {
+      return await _submitParse(
+        kNekkoParseRegistration,
+        bytes,
+        null,
+        (result) => _readRegistrationResult(result.cast<RegistrationResult>()),
+        cancel: cancel,
+      );
+    } on NativeParseCancelled {
+      rethrow;
+    } catch (e) {
+      debugPrint("Native Parse Error (Registration): $e");
+      return [];
+    }
+  }
+
+  // --- Batched Delivery ---
+  // The parse_x_batched parsers call back every few records while they run.
+  // They run on a helper isolate and call back through a
+  // NativeCallable.listener, so each batch arrives here as an event while
+  // the rest of the body is still being parsed.
+
+  /// Courses of a response body, [batchSize] records at a time, as they
+  /// are parsed. A parse error ends the stream with an error event, after
+  /// whatever batches came before it.
+  static Stream<List<CourseModel>> parseCoursesBatched(
+    Uint8List bytes, {
+    int batchSize = 64,
+  }) {
+    if (bytes.isEmpty) return const Stream.empty();
+    final controller = StreamController<List<CourseModel>>();
+    late final NativeCallable<CourseBatchCallback> callback;
+    callback = NativeCallable<CourseBatchCallback>.listener((
+      Pointer<Void> _,
+      Pointer<CourseResult> batch,
+      bool last,
+    ) {
+      if (batch == nullptr) {
+        controller.addError(Exception("Native Parse Error: out of memory"));
+      } else {
+        final error = batch.ref.errorMessage != nullptr
+            ? batch.ref.errorMessage.toDartString()
+            : null;
+        final courses = _readCourseResult(batch);
+        if (error != null) {
+          controller.addError(Exception("Native Parse Error: $error"));
+        } else if (courses.isNotEmpty) {
+          controller.add(courses);
+        }
+      }
+      if (last) {
+        callback.close();
+        controller.close();
+      }
+    });
+    _runBatched(
+      'parse_courses_batched',
+      bytes,
+      batchSize,
+      callback.nativeFunction.cast(),
+    ).catchError((Object e) => _failBatched(controller, callback, e));
+    return controller.stream;
+  }
+
+  /// Registration subjects of a response body, [batchSize] at a time, as
+  /// they are parsed; see [parseCoursesBatched].
+  static Stream<List<SubjectRegistrationModel>> parseRegistrationDataBatched(
+    Uint8List bytes, {
+    int batchSize = 16,
+  }) {
+    final controller = StreamController<List<SubjectRegistrationModel>>();
+    late final NativeCallable<RegistrationBatchCallback> callback;
+    callback = NativeCallable<RegistrationBatchCallback>.listener((
+      Pointer<Void> _,
+      Pointer<RegistrationResult> batch,
+      bool last,
+    ) {
+      try {
+        final subjects = _readRegistrationResult(batch);
+        if (subjects.isNotEmpty) controller.add(subjects);
+      } catch (e) {
+        controller.addError(e);
+      }
+      if (last) {
+        callback.close();
+        controller.close();
+      }
+    });
+    _runBatched(
+      'parse_registration_data_batched',
+      bytes,
+      batchSize,
+      callback.nativeFunction.cast(),
+    ).catchError((Object e) => _failBatched(controller, callback, e));
+    return controller.stream;
+  }
+
+  // Calls [parser] on a native copy of [bytes] from a helper isolate and
+  // completes after its last callback.
+  static Future<void> _runBatched(
+    String parser,
+    Uint8List bytes,
+    int batchSize,
+    Pointer<Void> callback,
+  ) async {
+    final buf = _toNativeBuffer(bytes);
+    try {
+      await _parseBatchedOnIsolate(
+        parser,
+        buf.address,
+        bytes.length,
+        batchSize,
+        callback.address,
+      );
+    } finally {
+      _freeBuffer(buf);
+    }
+  }
+
+  // Only plain values reach the helper isolate; pointers do not cross.
+  static Future<void> _parseBatchedOnIsolate(
+    String parser,
+    int address,
+    int length,
+    int batchSize,
+    int callback,
+  ) => Isolate.run(() {
+    final parse = _library.lookupFunction<ParseBatchedFunc, ParseBatched>(
+      parser,
+    );
+    parse(
+      Pointer.fromAddress(address),
+      length,
+      batchSize,
+      Pointer.fromAddress(callback),
+      nullptr,
+    );
+  });
+
+  // The parser never ran (or the isolate died): no last batch is coming.
+  static void _failBatched(
+    StreamController<Object?> controller,
+    NativeCallable<Function> callback,
+    Object error,
+  ) {
+    callback.close();
+    if (controller.isClosed) return;
+    debugPrint("Native Logic Error (Batched): $error");
+    controller.addError(error);
+    controller.close();
+  }
+
+  static String _stringOrEmpty(Pointer<Utf8> p) =>
+      p != nullptr ? p.toDartString() : '';
+
+  // Converts and frees a RegistrationResult; throws on a parse error.
+  // [str] reads each string field.
+  static List<SubjectRegistrationModel> _readRegistrationResult(
+    Pointer<RegistrationResult> resultPtr, {
+    String Function(Pointer<Utf8>) str = _stringOrEmpty,
+  }) {
+    final freeFunc = _library
+        .lookupFunction<FreeRegistrationResultFunc, FreeRegistrationResult>(
+          'free_registration_result',
+        );
+    if (resultPtr == nullptr) throw Exception("Native Parse Error: no result");
+
+    final result = resultPtr.ref;
+    if (result.errorMessage != nullptr) {
+      final errorMsg = result.errorMessage.toDartString();
+      debugPrint("Native Registration Error: $errorMsg");
+      freeFunc(resultPtr);
+      // Throwing exception so provider catches it
+      throw Exception("Native Parse Error: $errorMsg");
+    }
+
+    List<SubjectRegistrationModel> subjects = [];
+    if (result.data != nullptr) {
+      final period = result.data.ref;
+      final subjectsPtr = period.subjects;
+      final count = period.subjectsCount;
+
+      for (int i = 0; i < count; i++) {
+        final sNative = subjectsPtr[i];
+
+        List<CourseSubjectModel> courseSubjects = [];
+        final csPtr = sNative.courseSubjects;
+        // Registration pages leave sections out but keep their count.
+        final csCount = csPtr == nullptr ? 0 : sNative.courseSubjectsCount;
+
+        for (int j = 0; j < csCount; j++) {
+          final csNative = csPtr[j];
+
+          List<TimetableModel> timetables = [];
+          final tPtr = csNative.timetables;
+          final tCount = csNative.timetablesCount;
+
+          for (int k = 0; k < tCount; k++) {
+            final tNative = tPtr[k];
+            timetables.add(
+              TimetableModel(
+                id: tNative.id,
+                startDate: tNative.startDate,
+                endDate: tNative.endDate,
+                fromWeek: tNative.fromWeek,
+                toWeek: tNative.toWeek,
+                dayOfWeek: tNative.dayOfWeek,
+                startHour: tNative.startHour,
+                endHour: tNative.endHour,
+                roomId: tNative.roomId,
+                startHourId: tNative.startHourId,
+                endHourId: tNative.endHourId,
+                roomName: str(tNative.roomName),
+                teacherName: str(tNative.teacherName),
               ),
             );
           }
 
-          subjects.add(
-            SubjectRegistrationModel(
-              subjectName: sNative.subjectName != nullptr
-                  ? sNative.subjectName.toDartString()
-                  : '',
-              numberOfCredit: sNative.numberOfCredit,
-              courseSubjects: courseSubjects,
+          courseSubjects.add(
+            CourseSubjectModel(
+              id: csNative.id,
+              subjectId: csNative.subjectId,
+              code: str(csNative.code),
+              name: str(csNative.name),
+              displayCode: str(csNative.displayCode),
+              numberStudent: csNative.numberStudent,
+              maxStudent: csNative.maxStudent,
+              isSelected: csNative.isSelected,
+              isFull: csNative.isFull,
+              isOverlap: csNative.isOverlap,
+              credits: csNative.credits,
+              status: str(csNative.status),
+              timetables: timetables,
             ),
           );
         }
+
+        subjects.add(
+          SubjectRegistrationModel(
+            subjectName: str(sNative.subjectName),
+            numberOfCredit: sNative.numberOfCredit,
+            courseSubjects: courseSubjects,
+          ),
+        );
       }
+    }
 
-      final freeFunc = _library
-          .lookupFunction<FreeRegistrationResultFunc, FreeRegistrationResult>(
-            'free_registration_result',
-          );
-      freeFunc(resultPtr);
-      return subjects;
-    } catch (e) {
-      debugPrint("Native Parse Error (Registration): $e");
-      return [];
+    freeFunc(resultPtr);
+    return subjects;
+  }
+
+  // --- Flat Results ---
+  // A registration response as one blob of bytes (NekkoBlob): cheap to send
+  // to another isolate or to write to disk, and read back with
+  // [readRegistrationBlob] without parsing JSON again.
+  static Uint8List flattenRegistrationData(Uint8List bytes) =>
+      _flatten('parse_registration_data_flat', bytes);
+
+  /// Reads a blob from [flattenRegistrationData]; throws if [blob] is not
+  /// one this build wrote, or carries a parse error.
+  static List<SubjectRegistrationModel> readRegistrationBlob(Uint8List blob) =>
+      _withBlob(
+        blob,
+        (root) => _readRegistrationResult(root.cast<RegistrationResult>()),
+      );
+
+  static Uint8List _flatten(String parser, Uint8List bytes) {
+    final parse = _library.lookupFunction<ParseFlatFunc, ParseFlat>(parser);
+    final free = _library.lookupFunction<NekkoBlobFreeFunc, NekkoBlobFree>(
+      'nekko_blob_free',
+    );
+    final buf = _toNativeBuffer(bytes);
+    try {
+      final blob = parse(buf, bytes.length);
+      if (blob == nullptr) throw Exception("$parser: out of memory");
+      try {
+        return Uint8List.fromList(
+          blob.cast<Uint8>().asTypedList(blob.ref.size),
+        );
+      } finally {
+        free(blob);
+      }
+    } finally {
+      _freeBuffer(buf);
+    }
+  }
+
+  // Copies [blob] to native memory, relocates it there and hands [read] its
+  // root. The root owns no arena, so free_x_result on it is a no-op; the
+  // copy goes when [read] returns.
+  static T _withBlob<T>(Uint8List blob, T Function(Pointer<Void> root) read) {
+    final relocate = _library
+        .lookupFunction<NekkoBlobRelocateFunc, NekkoBlobRelocate>(
+          'nekko_blob_relocate',
+        );
+    final buf = _toNativeBuffer(blob);
+    try {
+      final header = buf.cast<NekkoBlob>();
+      if (!relocate(header, blob.length)) {
+        throw Exception("Not a usable result blob");
+      }
+      return read(Pointer<Void>.fromAddress(buf.address + header.ref.root));
+    } finally {
+      _freeBuffer(buf);
     }
   }
 
   static ({bool success, String message, int status}) parseRegistrationAction(
     String jsonString,
-  ) {
+  ) => parseRegistrationActionBytes(utf8.encode(jsonString));
+
+  static ({bool success, String message, int status})
+  parseRegistrationActionBytes(Uint8List bytes) {
     try {
       final func = _library
           .lookupFunction<ParseRegistrationActionFunc, ParseRegistrationAction>(
-            'parse_registration_action',
+            'parse_registration_action_bytes',
           );
-      final jsonPtr = jsonString.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      calloc.free(jsonPtr);
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
 
       final result = resultPtr.ref;
       final status = result.status;
@@ -691,16 +1778,20 @@ class NativeParser {
       final func = _library
           .lookupFunction<
             Pointer<NotificationResult> Function(
-              Pointer<Utf8>,
-              Pointer<Utf8>,
+              Pointer<Uint8>,
+              Size,
+              Pointer<Uint8>,
+              Size,
               Int64,
             ),
             Pointer<NotificationResult> Function(
-              Pointer<Utf8>,
-              Pointer<Utf8>,
+              Pointer<Uint8>,
+              int,
+              Pointer<Uint8>,
+              int,
               int,
             )
-          >('generate_notifications');
+          >('generate_notifications_bytes');
 
       final freeFunc = _library
           .lookupFunction<
@@ -708,12 +1799,18 @@ class NativeParser {
             void Function(Pointer<NotificationResult>)
           >('free_notification_result');
 
-      final cPtr = coursesJson.toNativeUtf8();
-      final hPtr = hoursJson.toNativeUtf8();
+      final cPtr = _toNativeBuffer(coursesJson);
+      final hPtr = _toNativeBuffer(hoursJson);
 
       Pointer<NotificationResult>? resultPtr;
       try {
-        resultPtr = func(cPtr, hPtr, semesterStartMillis);
+        resultPtr = func(
+          cPtr,
+          coursesJson.length,
+          hPtr,
+          hoursJson.length,
+          semesterStartMillis,
+        );
 
         if (resultPtr == nullptr) return [];
 
@@ -745,8 +1842,8 @@ class NativeParser {
         freeFunc(resultPtr);
         return list;
       } finally {
-        malloc.free(cPtr);
-        malloc.free(hPtr);
+        _freeBuffer(cPtr);
+        _freeBuffer(hPtr);
       }
     } catch (e) {
       debugPrint("Native Logic Error (Notif): $e");
@@ -754,95 +1851,24 @@ class NativeParser {
     }
   }
 
-  static List<CourseModel> parseCourses(String jsonStr) {
-    if (jsonStr.isEmpty) return [];
-    _cachedCoursesJson = jsonStr; // Cache input
+  static List<CourseModel> parseCourses(String jsonStr) =>
+      parseCoursesBytes(utf8.encode(jsonStr));
+
+  static List<CourseModel> parseCoursesBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return [];
+    _cachedCoursesJson = bytes; // Cache input
     try {
       final func = _library.lookupFunction<ParseCoursesFunc, ParseCourses>(
-        'parse_courses',
+        'parse_courses_bytes',
       );
-      final freeFunc = _library
-          .lookupFunction<FreeCourseResultFunc, FreeCourseResult>(
-            'free_course_result',
-          );
 
-      final jsonPtr = jsonStr.toNativeUtf8();
-      Pointer<CourseResult>? resultPtr;
+      final buf = _toNativeBuffer(bytes);
       try {
-        resultPtr = func(jsonPtr);
-
-        if (resultPtr == nullptr) {
-          return [];
-        }
-
-        final result = resultPtr.ref;
-        if (result.errorMessage != nullptr) {
-          print(
-            "Native Parser Error (Courses): ${result.errorMessage.toDartString()}",
-          );
-          // Free result but strings are owned by jsonPtr so safe.
-          // errorMessage is strdup'd so C++ frees it.
-          freeFunc(resultPtr);
-          return [];
-        }
-
-        final List<CourseModel> list = [];
-        final count = result.count;
-        final coursesPtr = result.courses;
-
-        // Iterate and copy strings to Dart heap (Zero-Copy ends here)
-        for (int i = 0; i < count; i++) {
-          final cNative = coursesPtr[i];
-          list.add(
-            CourseModel(
-              id: cNative.id,
-              courseCode: cNative.courseCode != nullptr
-                  ? cNative.courseCode.toDartString()
-                  : '',
-              courseName: cNative.courseName != nullptr
-                  ? cNative.courseName.toDartString()
-                  : '',
-              classCode: cNative.classCode != nullptr
-                  ? cNative.classCode.toDartString()
-                  : '',
-              className: cNative.className != nullptr
-                  ? cNative.className.toDartString()
-                  : '',
-              dayOfWeek: cNative.dayOfWeek,
-              startCourseHour: cNative.startCourseHour,
-              endCourseHour: cNative.endCourseHour,
-              room: cNative.room != nullptr ? cNative.room.toDartString() : '',
-              building: cNative.building != nullptr
-                  ? cNative.building.toDartString()
-                  : '',
-              campus: cNative.campus != nullptr
-                  ? cNative.campus.toDartString()
-                  : '',
-              credits: cNative.credits,
-              startDate: cNative.startDate,
-              endDate: cNative.endDate,
-              fromWeek: cNative.fromWeek,
-              toWeek: cNative.toWeek,
-              lecturerName: cNative.lecturerName != nullptr
-                  ? cNative.lecturerName.toDartString()
-                  : null,
-              lecturerEmail: cNative.lecturerEmail != nullptr
-                  ? cNative.lecturerEmail.toDartString()
-                  : null,
-              status: cNative.status != nullptr
-                  ? cNative.status.toDartString()
-                  : 'N/A',
-              grade: cNative.hasGrade ? cNative.grade : null,
-            ),
-          );
-        }
-
-        freeFunc(resultPtr);
-        return list;
+        return _readCourseResult(func(buf, bytes.length));
       } finally {
         // Free JSON source buffer LAST.
         // C++ native strings were pointing into this buffer.
-        malloc.free(jsonPtr);
+        _freeBuffer(buf);
       }
     } catch (e) {
       print("Native Logic Error (Courses): $e");
@@ -850,102 +1876,350 @@ class NativeParser {
     }
   }
 
-  static List<ExamRoomModel> parseExamRooms(String jsonStr) {
-    if (jsonStr.isEmpty) return [];
+  /// Parses a courses response body as received (see
+  /// [NetworkClient.getEncoded]): gzip and deflate, and br where the
+  /// native build has it, are decoded natively straight into the parser's
+  /// buffer, so the body never becomes a Dart string. Other br builds
+  /// decode it here first.
+  static List<CourseModel> parseCoursesEncoded(EncodedBody body) {
+    if (body.bytes.isEmpty) return [];
     try {
-      final func = _library.lookupFunction<ParseExamRoomsFunc, ParseExamRooms>(
-        'parse_exam_rooms',
+      final bytes = _decodeUnsupported(body);
+      if (bytes != null) return parseCoursesBytes(bytes);
+
+      final func = _library
+          .lookupFunction<ParseCoursesEncodedFunc, ParseCoursesEncoded>(
+            'parse_courses_encoded',
+          );
+      return _withEncodedBody(
+        body,
+        (buf, encoding) => _readCourseResult(
+          func(buf, body.bytes.length, encoding),
+        ),
       );
-      final freeFunc = _library
-          .lookupFunction<FreeExamRoomResultFunc, FreeExamRoomResult>(
-            'free_exam_room_result',
-          );
+    } catch (e) {
+      print("Native Logic Error (Courses): $e");
+      return [];
+    }
+  }
 
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
+  /// Courses as columns rather than [CourseModel]s; see [CourseColumns].
+  /// A parse error reads as no courses.
+  static CourseColumns parseCourseColumns(Uint8List bytes) {
+    if (bytes.isEmpty) return CourseColumns.empty;
+    try {
+      final func = _library
+          .lookupFunction<ParseCourseColumnsFunc, ParseCourseColumns>(
+            'parse_courses_columns_utf16',
+          );
+      final freeFunc = _library
+          .lookupFunction<FreeCourseColumnsResultFunc, FreeCourseColumnsResult>(
+            'free_course_columns_result',
+          );
 
-      if (resultPtr == nullptr) {
-        print("Native parseExamRooms returned null");
-        return [];
+      // Parsed in place; the result keeps nothing pointing into `buf`.
+      final buf = _toNativeBuffer(bytes);
+      final Pointer<CourseColumnsResult> resultPtr;
+      try {
+        resultPtr = func(buf, bytes.length);
+      } finally {
+        _freeBuffer(buf);
       }
+      if (resultPtr == nullptr) return CourseColumns.empty;
+      try {
+        final result = resultPtr.ref;
+        if (result.errorMessage != nullptr) {
+          print(
+            "Native Parser Error (Courses): ${result.errorMessage.toDartString()}",
+          );
+          return CourseColumns.empty;
+        }
+        if (result.count == 0) return CourseColumns.empty;
+        return CourseColumns._(result);
+      } finally {
+        freeFunc(resultPtr);
+      }
+    } catch (e) {
+      print("Native Logic Error (Courses): $e");
+      return CourseColumns.empty;
+    }
+  }
 
+  // Converts and frees a CourseResult; a parse error reads as no courses.
+  static List<CourseModel> _readCourseResult(
+    Pointer<CourseResult> resultPtr,
+  ) {
+    if (resultPtr == nullptr) return [];
+    final freeFunc = _library
+        .lookupFunction<FreeCourseResultFunc, FreeCourseResult>(
+          'free_course_result',
+        );
+    try {
       final result = resultPtr.ref;
       if (result.errorMessage != nullptr) {
         print(
-          "Native Parser Error (ExamRooms): ${result.errorMessage.toDartString()}",
+          "Native Parser Error (Courses): ${result.errorMessage.toDartString()}",
         );
-        freeFunc(resultPtr);
         return [];
       }
 
-      final List<ExamRoomModel> list = [];
+      final List<CourseModel> list = [];
       final count = result.count;
-      final roomsPtr = result.rooms;
+      final coursesPtr = result.courses;
 
+      // Iterate and copy strings to Dart heap (Zero-Copy ends here)
       for (int i = 0; i < count; i++) {
-        final rNative = roomsPtr[i];
+        final cNative = coursesPtr[i];
         list.add(
-          ExamRoomModel(
-            id: rNative.id,
-            subjectName: rNative.subjectName != nullptr
-                ? rNative.subjectName.toDartString()
+          CourseModel(
+            id: cNative.id,
+            courseCode: cNative.courseCode != nullptr
+                ? cNative.courseCode.toDartString()
                 : '',
-            examPeriodCode: rNative.examPeriodCode != nullptr
-                ? rNative.examPeriodCode.toDartString()
+            courseName: cNative.courseName != nullptr
+                ? cNative.courseName.toDartString()
                 : '',
-            examCode: rNative.examCode != nullptr
-                ? rNative.examCode.toDartString()
-                : null,
-            studentCode: rNative.studentCode != nullptr
-                ? rNative.studentCode.toDartString()
-                : null,
-            examDate: rNative.examDate > 0
-                ? DateTime.fromMillisecondsSinceEpoch(rNative.examDate)
-                : null,
-            examTime: rNative.examTime != nullptr
-                ? rNative.examTime.toDartString()
-                : null,
-            roomName: rNative.roomName != nullptr
-                ? rNative.roomName.toDartString()
-                : null,
-            roomBuilding: rNative.roomBuilding != nullptr
-                ? rNative.roomBuilding.toDartString()
-                : null,
-            examMethod: rNative.examMethod != nullptr
-                ? rNative.examMethod.toDartString()
+            classCode: cNative.classCode != nullptr
+                ? cNative.classCode.toDartString()
+                : '',
+            className: cNative.className != nullptr
+                ? cNative.className.toDartString()
+                : '',
+            dayOfWeek: cNative.dayOfWeek,
+            startCourseHour: cNative.startCourseHour,
+            endCourseHour: cNative.endCourseHour,
+            room: cNative.room != nullptr ? cNative.room.toDartString() : '',
+            building: cNative.building != nullptr
+                ? cNative.building.toDartString()
+                : '',
+            campus: cNative.campus != nullptr
+                ? cNative.campus.toDartString()
+                : '',
+            credits: cNative.credits,
+            startDate: cNative.startDate,
+            endDate: cNative.endDate,
+            fromWeek: cNative.fromWeek,
+            toWeek: cNative.toWeek,
+            lecturerName: cNative.lecturerName != nullptr
+                ? cNative.lecturerName.toDartString()
                 : null,
-            notes: rNative.notes != nullptr
-                ? rNative.notes.toDartString()
+            lecturerEmail: cNative.lecturerEmail != nullptr
+                ? cNative.lecturerEmail.toDartString()
                 : null,
-            numberExpectedStudent: rNative.numberExpectedStudent,
+            status: cNative.status != nullptr
+                ? cNative.status.toDartString()
+                : 'N/A',
+            grade: cNative.hasGrade ? cNative.grade : null,
           ),
         );
       }
 
-      freeFunc(resultPtr);
       return list;
+    } finally {
+      // errorMessage and, for parse_courses_encoded, the strings live in
+      // the result arena, so this goes after the copies above.
+      freeFunc(resultPtr);
+    }
+  }
+
+  static List<ExamRoomModel> parseExamRooms(String jsonStr) =>
+      parseExamRoomsBytes(utf8.encode(jsonStr));
+
+  static List<ExamRoomModel> parseExamRoomsBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return [];
+    try {
+      final func = _library.lookupFunction<ParseExamRoomsFunc, ParseExamRooms>(
+        'parse_exam_rooms_bytes',
+      );
+
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
+      return _readExamRoomResult(resultPtr);
     } catch (e) {
       print("Native Logic Error (ExamRooms): $e");
       return [];
     }
   }
 
-  static List<ExamScheduleModel> parseExamSchedules(String jsonStr) {
-    if (jsonStr.isEmpty) return [];
+  /// Parses an exam room response body while it downloads; see
+  /// [_feedStream]. Pass [length] only when it is the decoded body length.
+  static Future<List<ExamRoomModel>> parseExamRoomsStream(
+    Stream<List<int>> body, {
+    int? length,
+  }) async {
+    try {
+      final stream = await _feedStream('parse_exam_rooms', body, length);
+      final finish = _library
+          .lookupFunction<FinishExamRoomsFunc, FinishExamRooms>(
+            'parse_exam_rooms_finish',
+          );
+      return _readExamRoomResult(finish(stream));
+    } catch (e) {
+      print("Native Logic Error (ExamRooms): $e");
+      return [];
+    }
+  }
+
+  // Converts and frees an ExamRoomResult; empty on a parse error.
+  static List<ExamRoomModel> _readExamRoomResult(
+    Pointer<ExamRoomResult> resultPtr,
+  ) {
+    final freeFunc = _library
+        .lookupFunction<FreeExamRoomResultFunc, FreeExamRoomResult>(
+          'free_exam_room_result',
+        );
+
+    if (resultPtr == nullptr) {
+      print("Native parseExamRooms returned null");
+      return [];
+    }
+
+    final result = resultPtr.ref;
+    if (result.errorMessage != nullptr) {
+      print(
+        "Native Parser Error (ExamRooms): ${result.errorMessage.toDartString()}",
+      );
+      freeFunc(resultPtr);
+      return [];
+    }
+
+    final List<ExamRoomModel> list = [];
+    final count = result.count;
+    final roomsPtr = result.rooms;
+
+    for (int i = 0; i < count; i++) {
+      list.add(_examRoomModel(roomsPtr[i]));
+    }
+
+    freeFunc(resultPtr);
+    return list;
+  }
+
+  static ExamRoomModel _examRoomModel(ExamRoomNative rNative) => ExamRoomModel(
+    id: rNative.id,
+    subjectName: rNative.subjectName != nullptr
+        ? rNative.subjectName.toDartString()
+        : '',
+    examPeriodCode: rNative.examPeriodCode != nullptr
+        ? rNative.examPeriodCode.toDartString()
+        : '',
+    examCode: rNative.examCode != nullptr
+        ? rNative.examCode.toDartString()
+        : null,
+    studentCode: rNative.studentCode != nullptr
+        ? rNative.studentCode.toDartString()
+        : null,
+    examDate: rNative.examDate > 0
+        ? DateTime.fromMillisecondsSinceEpoch(rNative.examDate)
+        : null,
+    examTime: rNative.examTime != nullptr
+        ? rNative.examTime.toDartString()
+        : null,
+    roomName: rNative.roomName != nullptr
+        ? rNative.roomName.toDartString()
+        : null,
+    roomBuilding: rNative.roomBuilding != nullptr
+        ? rNative.roomBuilding.toDartString()
+        : null,
+    examMethod: rNative.examMethod != nullptr
+        ? rNative.examMethod.toDartString()
+        : null,
+    notes: rNative.notes != nullptr
+        ? rNative.notes.toDartString()
+        : null,
+    numberExpectedStudent: rNative.numberExpectedStudent,
+  );
+
+  // parse_exam_rooms_batch takes at most this many bodies per call.
+  static const int _kExamRoomBatchMax = 64;
+
+  /// Parses several exam room response bodies in one native call, in
+  /// parallel, and returns their rooms per body, in the order given. Native
+  /// code de-duplicates rooms across bodies; a room several bodies list
+  /// comes back (as one model) in the list of each. A body that does not
+  /// parse gets an empty list, as does every body if none parses.
+  static List<List<ExamRoomModel>> parseExamRoomsBatch(
+    List<Uint8List> bodies,
+  ) {
+    if (bodies.length > _kExamRoomBatchMax) {
+      return [
+        for (int i = 0; i < bodies.length; i += _kExamRoomBatchMax)
+          ...parseExamRoomsBatch(
+            bodies.skip(i).take(_kExamRoomBatchMax).toList(),
+          ),
+      ];
+    }
+    final lists = [for (var _ in bodies) <ExamRoomModel>[]];
+    if (bodies.isEmpty) return lists;
+
+    final bufs = calloc<Pointer<Uint8>>(bodies.length);
+    final lens = calloc<Size>(bodies.length);
+    try {
+      for (int i = 0; i < bodies.length; i++) {
+        bufs[i] = _toNativeBuffer(bodies[i]);
+        lens[i] = bodies[i].length;
+      }
+      final func = _library
+          .lookupFunction<ParseExamRoomsBatchFunc, ParseExamRoomsBatch>(
+            'parse_exam_rooms_batch',
+          );
+      final freeFunc = _library
+          .lookupFunction<FreeExamRoomResultFunc, FreeExamRoomResult>(
+            'free_exam_room_result',
+          );
+      final resultPtr = func(bufs, lens, bodies.length);
+      if (resultPtr == nullptr) return lists;
+      try {
+        final result = resultPtr.ref;
+        if (result.errorMessage != nullptr) {
+          print(
+            "Native Parser Error (ExamRooms batch): "
+            "${result.errorMessage.toDartString()}",
+          );
+          return lists;
+        }
+        for (int i = 0; i < result.count; i++) {
+          final rNative = result.rooms[i];
+          final room = _examRoomModel(rNative);
+          for (int j = rNative.source; j < bodies.length; j++) {
+            if (((rNative.sources >> j) & 1) != 0) lists[j].add(room);
+          }
+        }
+        return lists;
+      } finally {
+        freeFunc(resultPtr);
+      }
+    } catch (e) {
+      print("Native Logic Error (ExamRooms batch): $e");
+      return lists;
+    } finally {
+      for (int i = 0; i < bodies.length; i++) {
+        if (bufs[i] != nullptr) _freeBuffer(bufs[i]);
+      }
+      calloc.free(bufs);
+      calloc.free(lens);
+    }
+  }
+
+  static List<ExamScheduleModel> parseExamSchedules(String jsonStr) =>
+      parseExamSchedulesBytes(utf8.encode(jsonStr));
+
+  static List<ExamScheduleModel> parseExamSchedulesBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return [];
 
     try {
       final func = _library
           .lookupFunction<ParseExamDetailsFunc, ParseExamDetails>(
-            'parse_exam_schedules',
+            'parse_exam_schedules_bytes',
           );
       final freeFunc = _library.lookupFunction<FreeResultFunc, FreeResult>(
         'free_exam_schedule_result',
       );
 
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
 
       if (resultPtr == nullptr) {
         print("Native parser returned null");
@@ -1014,177 +2288,100 @@ class NativeParser {
     }
   }
 
-  static List<CourseHour> parseCourseHours(String jsonStr) {
-    if (jsonStr.isEmpty) return [];
-    _cachedHoursJson = jsonStr; // Cache input
+  static List<CourseHour> parseCourseHours(String jsonStr) =>
+      parseCourseHoursBytes(utf8.encode(jsonStr));
+
+  static List<CourseHour> parseCourseHoursBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return [];
+    _cachedHoursJson = bytes; // Cache input
     try {
       final func = _library
           .lookupFunction<ParseCourseHoursFunc, ParseCourseHours>(
-            'parse_course_hours',
+            'parse_course_hours_bytes',
           );
-      final freeFunc = _library
-          .lookupFunction<FreeCourseHourResultFunc, FreeCourseHourResult>(
-            'free_course_hour_result',
-          );
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
-      if (resultPtr == nullptr) return [];
-      final result = resultPtr.ref;
-      if (result.errorMessage != nullptr) {
-        freeFunc(resultPtr);
-        return [];
-      }
-      final List<CourseHour> list = [];
-      for (int i = 0; i < result.count; i++) {
-        final h = result.hours[i];
-        list.add(
-          CourseHour(
-            id: h.id,
-            name: h.name != nullptr ? h.name.toDartString() : '',
-            startString: h.startString != nullptr
-                ? h.startString.toDartString()
-                : '',
-            endString: h.endString != nullptr ? h.endString.toDartString() : '',
-            indexNumber: h.indexNumber,
-          ),
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
+      return _readCourseHourResult(resultPtr);
+    } catch (e) {
+      return [];
+    }
+  }
+
+  // Converts and frees a CourseHourResult; a parse error reads as none.
+  static List<CourseHour> _readCourseHourResult(
+    Pointer<CourseHourResult> resultPtr,
+  ) {
+    if (resultPtr == nullptr) return [];
+    final freeFunc = _library
+        .lookupFunction<FreeCourseHourResultFunc, FreeCourseHourResult>(
+          'free_course_hour_result',
         );
-      }
+    final result = resultPtr.ref;
+    if (result.errorMessage != nullptr) {
       freeFunc(resultPtr);
-      return list;
-    } catch (e) {
       return [];
     }
+    final List<CourseHour> list = [];
+    for (int i = 0; i < result.count; i++) {
+      final h = result.hours[i];
+      list.add(
+        CourseHour(
+          id: h.id,
+          name: h.name != nullptr ? h.name.toDartString() : '',
+          startString: h.startString != nullptr
+              ? h.startString.toDartString()
+              : '',
+          endString: h.endString != nullptr ? h.endString.toDartString() : '',
+          indexNumber: h.indexNumber,
+        ),
+      );
+    }
+    freeFunc(resultPtr);
+    return list;
   }
 
-  static List<SchoolYearModel> parseSchoolYears(String jsonStr) {
-    if (jsonStr.isEmpty) return [];
+  static List<SchoolYearModel> parseSchoolYears(String jsonStr) =>
+      parseSchoolYearsBytes(utf8.encode(jsonStr));
+
+  static List<SchoolYearModel> parseSchoolYearsBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return [];
     try {
       final func = _library
           .lookupFunction<ParseSchoolYearsFunc, ParseSchoolYears>(
-            'parse_school_years',
-          );
-      final freeFunc = _library
-          .lookupFunction<FreeSchoolYearResultFunc, FreeSchoolYearResult>(
-            'free_school_year_result',
-          );
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
-      if (resultPtr == nullptr) return [];
-      final result = resultPtr.ref;
-      if (result.errorMessage != nullptr) {
-        freeFunc(resultPtr);
-        return [];
-      }
-      final List<SchoolYearModel> list = [];
-      for (int i = 0; i < result.count; i++) {
-        final sy = result.years[i];
-        List<SemesterModel> semesters = [];
-        final sPtr = sy.semesters;
-        for (int j = 0; j < sy.semestersCount; j++) {
-          final s = sPtr[j];
-          // Parse Register Periods
-          List<SemesterRegisterPeriodModel> periods = [];
-          final rpCount = s.registerPeriodsCount;
-          final rpPtr = s.registerPeriods;
-          if (rpPtr != nullptr && rpCount > 0) {
-            for (int k = 0; k < rpCount; k++) {
-              final rp = rpPtr[k];
-              periods.add(
-                SemesterRegisterPeriodModel(
-                  id: rp.id,
-                  name: rp.name != nullptr ? rp.name.toDartString() : '',
-                  startRegisterTime: rp.startRegisterTime > 0
-                      ? rp.startRegisterTime
-                      : _parseDateString(
-                          rp.startRegisterTimeString.address == 0
-                              ? null
-                              : rp.startRegisterTimeString.toDartString(),
-                        ),
-                  endRegisterTime: rp.endRegisterTime > 0
-                      ? rp.endRegisterTime
-                      : _parseDateString(
-                          rp.endRegisterTimeString.address == 0
-                              ? null
-                              : rp.endRegisterTimeString.toDartString(),
-                        ),
-                  endUnRegisterTime: rp.endUnRegisterTime > 0
-                      ? rp.endUnRegisterTime
-                      : _parseDateString(
-                          rp.endUnRegisterTimeString.address == 0
-                              ? null
-                              : rp.endUnRegisterTimeString.toDartString(),
-                        ),
-                ),
-              );
-            }
-          }
-
-          semesters.add(
-            SemesterModel(
-              id: s.id,
-              semesterCode: s.semesterCode != nullptr
-                  ? s.semesterCode.toDartString()
-                  : '',
-              semesterName: s.semesterName != nullptr
-                  ? s.semesterName.toDartString()
-                  : '',
-              startDate: s.startDate,
-              endDate: s.endDate,
-              isCurrent: s.isCurrent,
-              ordinalNumbers: s.ordinalNumbers,
-              registerPeriods: periods,
-            ),
+            'parse_school_years_bytes',
           );
-        }
-        list.add(
-          SchoolYearModel(
-            id: sy.id,
-            name: sy.name != nullptr ? sy.name.toDartString() : '',
-            code: sy.code != nullptr ? sy.code.toDartString() : '',
-            year: sy.year,
-            current: sy.current,
-            startDate: sy.startDate,
-            endDate: sy.endDate,
-            displayName: sy.displayName != nullptr
-                ? sy.displayName.toDartString()
-                : '',
-            semesters: semesters,
-          ),
-        );
-      }
-      freeFunc(resultPtr);
-      return list;
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
+      return _readSchoolYearResult(resultPtr);
     } catch (e) {
       return [];
     }
   }
 
-  static SemesterModel? parseSemester(String jsonStr) {
-    if (jsonStr.isEmpty) return null;
-    try {
-      final func = _library.lookupFunction<ParseSemesterFunc, ParseSemester>(
-        'parse_semester',
-      );
-      final freeFunc = _library
-          .lookupFunction<FreeSemesterResultFunc, FreeSemesterResult>(
-            'free_semester_result',
-          );
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
-      if (resultPtr == nullptr) return null;
-      final result = resultPtr.ref;
-      if (result.errorMessage != nullptr) {
-        freeFunc(resultPtr);
-        return null;
-      }
-      SemesterModel? sm;
-      if (result.semester != nullptr) {
-        final s = result.semester.ref;
-
-        // Parse periods for single semester too if needed
+  // Converts and frees a SchoolYearResult; a parse error reads as none.
+  static List<SchoolYearModel> _readSchoolYearResult(
+    Pointer<SchoolYearResult> resultPtr,
+  ) {
+    if (resultPtr == nullptr) return [];
+    final freeFunc = _library
+        .lookupFunction<FreeSchoolYearResultFunc, FreeSchoolYearResult>(
+          'free_school_year_result',
+        );
+    final result = resultPtr.ref;
+    if (result.errorMessage != nullptr) {
+      freeFunc(resultPtr);
+      return [];
+    }
+    final List<SchoolYearModel> list = [];
+    for (int i = 0; i < result.count; i++) {
+      final sy = result.years[i];
+      List<SemesterModel> semesters = [];
+      final sPtr = sy.semesters;
+      for (int j = 0; j < sy.semestersCount; j++) {
+        final s = sPtr[j];
+        // Parse Register Periods
         List<SemesterRegisterPeriodModel> periods = [];
         final rpCount = s.registerPeriodsCount;
         final rpPtr = s.registerPeriods;
@@ -1221,41 +2418,151 @@ class NativeParser {
           }
         }
 
-        sm = SemesterModel(
-          id: s.id,
-          semesterCode: s.semesterCode != nullptr
-              ? s.semesterCode.toDartString()
-              : '',
-          semesterName: s.semesterName != nullptr
-              ? s.semesterName.toDartString()
-              : '',
-          startDate: s.startDate,
-          endDate: s.endDate,
-          isCurrent: s.isCurrent,
-          ordinalNumbers: s.ordinalNumbers,
-          registerPeriods: periods,
+        semesters.add(
+          SemesterModel(
+            id: s.id,
+            semesterCode: s.semesterCode != nullptr
+                ? s.semesterCode.toDartString()
+                : '',
+            semesterName: s.semesterName != nullptr
+                ? s.semesterName.toDartString()
+                : '',
+            startDate: s.startDate,
+            endDate: s.endDate,
+            isCurrent: s.isCurrent,
+            ordinalNumbers: s.ordinalNumbers,
+            registerPeriods: periods,
+          ),
         );
       }
-      freeFunc(resultPtr);
-      return sm;
+      list.add(
+        SchoolYearModel(
+          id: sy.id,
+          name: sy.name != nullptr ? sy.name.toDartString() : '',
+          code: sy.code != nullptr ? sy.code.toDartString() : '',
+          year: sy.year,
+          current: sy.current,
+          startDate: sy.startDate,
+          endDate: sy.endDate,
+          displayName: sy.displayName != nullptr
+              ? sy.displayName.toDartString()
+              : '',
+          semesters: semesters,
+        ),
+      );
+    }
+    freeFunc(resultPtr);
+    return list;
+  }
+
+  static SemesterModel? parseSemester(String jsonStr) =>
+      parseSemesterBytes(utf8.encode(jsonStr));
+
+  static SemesterModel? parseSemesterBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return null;
+    try {
+      final func = _library.lookupFunction<ParseSemesterFunc, ParseSemester>(
+        'parse_semester_bytes',
+      );
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
+      return _readSemesterResult(resultPtr);
     } catch (e) {
       return null;
     }
   }
 
-  static UserModel? parseUser(String jsonStr) {
-    if (jsonStr.isEmpty) return null;
+  // Converts and frees a SemesterResult; a parse error reads as null.
+  static SemesterModel? _readSemesterResult(
+    Pointer<SemesterResult> resultPtr,
+  ) {
+    if (resultPtr == nullptr) return null;
+    final freeFunc = _library
+        .lookupFunction<FreeSemesterResultFunc, FreeSemesterResult>(
+          'free_semester_result',
+        );
+    final result = resultPtr.ref;
+    if (result.errorMessage != nullptr) {
+      freeFunc(resultPtr);
+      return null;
+    }
+    SemesterModel? sm;
+    if (result.semester != nullptr) {
+      final s = result.semester.ref;
+
+      // Parse periods for single semester too if needed
+      List<SemesterRegisterPeriodModel> periods = [];
+      final rpCount = s.registerPeriodsCount;
+      final rpPtr = s.registerPeriods;
+      if (rpPtr != nullptr && rpCount > 0) {
+        for (int k = 0; k < rpCount; k++) {
+          final rp = rpPtr[k];
+          periods.add(
+            SemesterRegisterPeriodModel(
+              id: rp.id,
+              name: rp.name != nullptr ? rp.name.toDartString() : '',
+              startRegisterTime: rp.startRegisterTime > 0
+                  ? rp.startRegisterTime
+                  : _parseDateString(
+                      rp.startRegisterTimeString.address == 0
+                          ? null
+                          : rp.startRegisterTimeString.toDartString(),
+                    ),
+              endRegisterTime: rp.endRegisterTime > 0
+                  ? rp.endRegisterTime
+                  : _parseDateString(
+                      rp.endRegisterTimeString.address == 0
+                          ? null
+                          : rp.endRegisterTimeString.toDartString(),
+                    ),
+              endUnRegisterTime: rp.endUnRegisterTime > 0
+                  ? rp.endUnRegisterTime
+                  : _parseDateString(
+                      rp.endUnRegisterTimeString.address == 0
+                          ? null
+                          : rp.endUnRegisterTimeString.toDartString(),
+                    ),
+            ),
+          );
+        }
+      }
+
+      sm = SemesterModel(
+        id: s.id,
+        semesterCode: s.semesterCode != nullptr
+            ? s.semesterCode.toDartString()
+            : '',
+        semesterName: s.semesterName != nullptr
+            ? s.semesterName.toDartString()
+            : '',
+        startDate: s.startDate,
+        endDate: s.endDate,
+        isCurrent: s.isCurrent,
+        ordinalNumbers: s.ordinalNumbers,
+        registerPeriods: periods,
+      );
+    }
+    freeFunc(resultPtr);
+    return sm;
+  }
+
+  static UserModel? parseUser(String jsonStr) =>
+      parseUserBytes(utf8.encode(jsonStr));
+
+  static UserModel? parseUserBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return null;
     try {
       final func = _library.lookupFunction<ParseUserFunc, ParseUser>(
-        'parse_user',
+        'parse_user_bytes',
       );
       final freeFunc = _library
           .lookupFunction<FreeUserResultFunc, FreeUserResult>(
             'free_user_result',
           );
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
       if (resultPtr == nullptr) return null;
       final result = resultPtr.ref;
       if (result.errorMessage != nullptr) {
@@ -1280,19 +2587,22 @@ class NativeParser {
     }
   }
 
-  static Map<String, dynamic>? parseToken(String jsonStr) {
-    if (jsonStr.isEmpty) return null;
+  static Map<String, dynamic>? parseToken(String jsonStr) =>
+      parseTokenBytes(utf8.encode(jsonStr));
+
+  static Map<String, dynamic>? parseTokenBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return null;
     try {
       final func = _library.lookupFunction<ParseTokenFunc, ParseToken>(
-        'parse_token',
+        'parse_token_bytes',
       );
       final freeFunc = _library
           .lookupFunction<FreeTokenResultFunc, FreeTokenResult>(
             'free_token_result',
           );
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
       if (resultPtr == nullptr) return null;
       final result = resultPtr.ref;
       if (result.errorMessage != nullptr) {
@@ -1367,21 +2677,24 @@ class NativeParser {
     }
   }
 
-  static List<StudentMarkModel> parseStudentMarks(String jsonStr) {
-    if (jsonStr.isEmpty) return [];
+  static List<StudentMarkModel> parseStudentMarks(String jsonStr) =>
+      parseStudentMarksBytes(utf8.encode(jsonStr));
+
+  static List<StudentMarkModel> parseStudentMarksBytes(Uint8List bytes) {
+    if (bytes.isEmpty) return [];
     try {
       final func = _library
           .lookupFunction<ParseStudentMarksFunc, ParseStudentMarks>(
-            'parse_student_marks',
+            'parse_student_marks_bytes',
           );
       final freeFunc = _library
           .lookupFunction<FreeStudentMarkResultFunc, FreeStudentMarkResult>(
             'free_student_mark_result',
           );
 
-      final jsonPtr = jsonStr.toNativeUtf8();
-      final resultPtr = func(jsonPtr);
-      malloc.free(jsonPtr);
+      final buf = _toNativeBuffer(bytes);
+      final resultPtr = func(buf, bytes.length);
+      _freeBuffer(buf);
 
       if (resultPtr == nullptr) return [];
       final result = resultPtr.ref;
@@ -1435,3 +2748,363 @@ class NativeParser {
     }
   }
 }
+
+/// A registration body held natively and converted as it is shown
+/// (nekko_registration_open): the first page costs the same however many
+/// subjects follow it. Subjects in a [page] come without their class
+/// sections; [subject] converts one subject in full.
+///
+/// Holds native memory until [close]; using it afterwards throws. Not for
+/// use from two isolates at once.
+class RegistrationPages {
+  Pointer<Void> _reg;
+
+  RegistrationPages._(this._reg);
+
+  static DynamicLibrary get _library => NativeParser._library;
+
+  static final _openBuffer = _library
+      .lookupFunction<
+        NekkoRegistrationOpenBufferFunc,
+        NekkoRegistrationOpenBuffer
+      >('nekko_registration_open_buffer');
+  static final _error = _library
+      .lookupFunction<NekkoRegistrationErrorFunc, NekkoRegistrationError>(
+        'nekko_registration_error',
+      );
+  static final _count = _library
+      .lookupFunction<NekkoRegistrationCountFunc, NekkoRegistrationCount>(
+        'nekko_registration_count',
+      );
+  static final _page = _library
+      .lookupFunction<NekkoRegistrationPageFunc, NekkoRegistrationPage>(
+        'nekko_registration_page',
+      );
+  static final _subject = _library
+      .lookupFunction<NekkoRegistrationSubjectFunc, NekkoRegistrationSubject>(
+        'nekko_registration_subject',
+      );
+  static final _close = _library
+      .lookupFunction<NekkoRegistrationCloseFunc, NekkoRegistrationClose>(
+        'nekko_registration_close',
+      );
+
+  /// Throws when [bytes] is not a subject list, with the server's message
+  /// where it sent one. An error further in surfaces from [page] or
+  /// [subject] once they reach it.
+  factory RegistrationPages.open(Uint8List bytes) {
+    // The handle takes the buffer over and reads it in place.
+    final reg = _openBuffer(NativeParser._toNativeBuffer(bytes), bytes.length);
+    if (reg == nullptr) throw Exception("nekko_registration_open failed");
+    final error = _error(reg);
+    if (error != nullptr) {
+      final message = error.toDartString();
+      _close(reg);
+      throw Exception("Native Parse Error: $message");
+    }
+    return RegistrationPages._(reg);
+  }
+
+  bool get isClosed => _reg == nullptr;
+
+  void close() {
+    if (_reg == nullptr) return;
+    _close(_reg);
+    _reg = nullptr;
+  }
+
+  Pointer<Void> get _handle {
+    if (_reg == nullptr) throw StateError("RegistrationPages is closed");
+    return _reg;
+  }
+
+  /// Number of subjects. Reads through the rest of the list, which is
+  /// cheap next to converting it but not free on a large body.
+  int get length => _count(_handle);
+
+  /// Up to [limit] subjects from [offset], each with no class sections.
+  List<SubjectRegistrationModel> page(int offset, int limit) =>
+      NativeParser._readRegistrationResult(_page(_handle, offset, limit));
+
+  /// Subject [index] with its class sections and timetables, or null past
+  /// the end.
+  SubjectRegistrationModel? subject(int index) {
+    final subjects = NativeParser._readRegistrationResult(
+      _subject(_handle, index),
+    );
+    return subjects.isEmpty ? null : subjects.first;
+  }
+}
+
+/// A response parsed once and kept native (nekko_doc_open), so one body can
+/// answer many questions without being parsed again or converted whole.
+/// Paths are RFC 6901 JSON Pointers: "" is the root, "/a/0/b" member "a",
+/// element 0, member "b". Keys are matched exactly, casing included.
+///
+/// The document holds native memory until [close]; using it afterwards
+/// throws. Getters return null where the path names nothing or a value of
+/// another type; numbers read from numeric strings too.
+class NativeDocument {
+  Pointer<Void> _doc;
+
+  NativeDocument._(this._doc);
+
+  static DynamicLibrary get _library => NativeParser._library;
+
+  static final _openBuffer = _library
+      .lookupFunction<NekkoDocOpenBufferFunc, NekkoDocOpenBuffer>(
+        'nekko_doc_open_buffer',
+      );
+  static final _error = _library
+      .lookupFunction<NekkoDocErrorFunc, NekkoDocError>('nekko_doc_error');
+  static final _close = _library
+      .lookupFunction<NekkoDocCloseFunc, NekkoDocClose>('nekko_doc_close');
+  static final _type = _library
+      .lookupFunction<NekkoDocTypeFunc, NekkoDocType>('nekko_doc_type');
+  static final _size = _library
+      .lookupFunction<NekkoDocSizeFunc, NekkoDocSize>('nekko_doc_size');
+  static final _int64 = _library
+      .lookupFunction<NekkoDocInt64Func, NekkoDocInt64>('nekko_doc_int64');
+  static final _double = _library
+      .lookupFunction<NekkoDocDoubleFunc, NekkoDocDouble>('nekko_doc_double');
+  static final _string = _library
+      .lookupFunction<NekkoDocStringFunc, NekkoDocString>('nekko_doc_string');
+  static final _write = _library
+      .lookupFunction<NekkoDocWriteFunc, NekkoDocWrite>('nekko_doc_write');
+  static final _extractInt64 = _library
+      .lookupFunction<NekkoDocExtractInt64Func, NekkoDocExtractInt64>(
+        'nekko_doc_extract_int64',
+      );
+  static final _extractDouble = _library
+      .lookupFunction<NekkoDocExtractDoubleFunc, NekkoDocExtractDouble>(
+        'nekko_doc_extract_double',
+      );
+  static final _extractString = _library
+      .lookupFunction<NekkoDocExtractStringFunc, NekkoDocExtractString>(
+        'nekko_doc_extract_string',
+      );
+
+  /// Parses [bytes]; throws if they are not JSON. The native copy is the
+  /// one the document reads from, so [bytes] may be dropped right after.
+  factory NativeDocument.open(Uint8List bytes) {
+    // The doc takes the buffer over, also when the open fails.
+    final doc = _openBuffer(NativeParser._toNativeBuffer(bytes), bytes.length);
+    if (doc == nullptr) throw Exception("nekko_doc_open failed");
+    final error = _error(doc);
+    if (error != nullptr) {
+      final message = error.toDartString();
+      _close(doc);
+      throw FormatException(message);
+    }
+    return NativeDocument._(doc);
+  }
+
+  bool get isClosed => _doc == nullptr;
+
+  void close() {
+    if (_doc == nullptr) return;
+    _close(_doc);
+    _doc = nullptr;
+  }
+
+  Pointer<Void> get _handle {
+    if (_doc == nullptr) throw StateError("NativeDocument is closed");
+    return _doc;
+  }
+
+  static T _withPath<T>(String path, T Function(Pointer<Utf8> p) read) {
+    final p = path.toNativeUtf8();
+    try {
+      return read(p);
+    } finally {
+      malloc.free(p);
+    }
+  }
+
+  /// kNekkoValue* of the value at [path]; kNekkoValueNone if there is none.
+  int type(String path) => _withPath(path, (p) => _type(_handle, p));
+
+  /// Elements of the array or members of the object at [path], else 0.
+  int length(String path) => _withPath(path, (p) => _size(_handle, p));
+
+  int? intAt(String path) => _withPath(path, (p) {
+    final out = malloc<Int64>();
+    try {
+      return _int64(_handle, p, out) ? out.value : null;
+    } finally {
+      malloc.free(out);
+    }
+  });
+
+  double? doubleAt(String path) => _withPath(path, (p) {
+    final out = malloc<Double>();
+    try {
+      return _double(_handle, p, out) ? out.value : null;
+    } finally {
+      malloc.free(out);
+    }
+  });
+
+  String? stringAt(String path) => _withPath(path, (p) {
+    final len = malloc<Size>();
+    try {
+      final str = _string(_handle, p, len);
+      return str == nullptr ? null : str.toDartString(length: len.value);
+    } finally {
+      malloc.free(len);
+    }
+  });
+
+  /// The JSON text of the value at [path], for handing a subtree to code
+  /// that wants it decoded.
+  String? jsonAt(String path) => _withPath(path, (p) {
+    final len = malloc<Size>();
+    try {
+      final text = _write(_handle, p, len);
+      if (text == nullptr) return null;
+      try {
+        return utf8.decode(text.asTypedList(len.value));
+      } finally {
+        NativeParser._freeBuffer(text);
+      }
+    } finally {
+      malloc.free(len);
+    }
+  });
+
+  /// The value at [field] (a pointer relative to each element, "" for the
+  /// element itself) of every element of the array at [array], 0 where an
+  /// element has none. Empty when [array] is not an array.
+  Int64List intColumn(String array, String field) =>
+      _column(array, field, (a, f, n) {
+        final out = malloc<Int64>(n);
+        try {
+          _extractInt64(_handle, a, f, out, nullptr, n);
+          return Int64List.fromList(out.asTypedList(n));
+        } finally {
+          malloc.free(out);
+        }
+      }, Int64List(0));
+
+  Float64List doubleColumn(String array, String field) =>
+      _column(array, field, (a, f, n) {
+        final out = malloc<Double>(n);
+        try {
+          _extractDouble(_handle, a, f, out, nullptr, n);
+          return Float64List.fromList(out.asTypedList(n));
+        } finally {
+          malloc.free(out);
+        }
+      }, Float64List(0));
+
+  /// As [intColumn], with null where an element has no string there.
+  List<String?> stringColumn(String array, String field) =>
+      _column(array, field, (a, f, n) {
+        final out = malloc<Pointer<Utf8>>(n);
+        final lens = malloc<Uint32>(n);
+        try {
+          _extractString(_handle, a, f, out, lens, n);
+          return List<String?>.generate(
+            n,
+            (i) => out[i] == nullptr
+                ? null
+                : out[i].toDartString(length: lens[i]),
+          );
+        } finally {
+          malloc.free(out);
+          malloc.free(lens);
+        }
+      }, const <String?>[]);
+
+  T _column<T>(
+    String array,
+    String field,
+    T Function(Pointer<Utf8> a, Pointer<Utf8> f, int n) extract,
+    T empty,
+  ) => _withPath(array, (a) {
+    if (_type(_handle, a) != kNekkoValueArray) return empty;
+    final n = _size(_handle, a);
+    if (n == 0) return empty;
+    return _withPath(field, (f) => extract(a, f, n));
+  });
+}
+
+/// Thrown by the *Async parses when their [NativeCancelToken] stopped the
+/// parse before it finished.
+class NativeParseCancelled implements Exception {
+  const NativeParseCancelled();
+
+  @override
+  String toString() => "NativeParseCancelled";
+}
+
+/// Stops background parses that are no longer wanted (nekko_cancel_create),
+/// e.g. when the user switches semesters while one is still loading. Pass it
+/// to the *Async parses; [cancel], or [deadline] passing, makes them stop
+/// at the next array element, free what they built and throw
+/// [NativeParseCancelled]. A parse that finished first returns as usual.
+///
+/// Holds native memory until [close], which may come while its parses are
+/// still running: the memory goes when the last of them is done. Once
+/// closed it cannot be passed to a parse again.
+class NativeCancelToken {
+  Pointer<Void> _token;
+  int _jobs = 0;
+  bool _closed = false;
+
+  NativeCancelToken._(this._token);
+
+  static DynamicLibrary get _library => NativeParser._library;
+
+  static final _create = _library
+      .lookupFunction<NekkoCancelCreateFunc, NekkoCancelCreate>(
+        'nekko_cancel_create',
+      );
+  static final _cancel = _library
+      .lookupFunction<NekkoCancelOpFunc, NekkoCancelOp>('nekko_cancel');
+  static final _cancelled = _library
+      .lookupFunction<NekkoCancelledFunc, NekkoCancelled>('nekko_cancelled');
+  static final _destroy = _library
+      .lookupFunction<NekkoCancelOpFunc, NekkoCancelOp>(
+        'nekko_cancel_destroy',
+      );
+
+  /// A token that also fires by itself once [deadline] has passed.
+  factory NativeCancelToken({Duration? deadline}) {
+    final token = _create(deadline?.inMilliseconds ?? 0);
+    if (token == nullptr) throw Exception("nekko_cancel_create failed");
+    return NativeCancelToken._(token);
+  }
+
+  bool get isClosed => _closed;
+
+  /// Whether [cancel] was called or the deadline has passed.
+  bool get isCancelled => _token != nullptr && _cancelled(_token);
+
+  /// Stops the parses holding this token; safe to call more than once.
+  void cancel() {
+    if (_token != nullptr) _cancel(_token);
+  }
+
+  void close() {
+    _closed = true;
+    _release();
+  }
+
+  Pointer<Void> _startJob() {
+    if (_closed) throw StateError("NativeCancelToken is closed");
+    _jobs++;
+    return _token;
+  }
+
+  void _jobFinished() {
+    _jobs--;
+    _release();
+  }
+
+  void _release() {
+    if (!_closed || _jobs > 0 || _token == nullptr) return;
+    _destroy(_token);
+    _token = nullptr;
+  }
+}
@@ -1,4 +1,5 @@
 import 'dart:io';
+import 'dart:typed_data';
 import 'package:dio/dio.dart';
 import 'package:dio/io.dart';
 import 'package:tlucalendar/core/network/dio_brotli_transformer.dart';
@@ -9,8 +10,19 @@ import 'package:tlucalendar/core/error/failures.dart';
 class NetworkClient {
   late final Dio _dio;
 
+  /// Leaves response bodies compressed, for [getEncoded].
+  late final Dio _encodedDio;
+
   NetworkClient({required String baseUrl}) {
-    _dio = Dio(
+    _dio = _createDio(baseUrl, autoUncompress: true);
+    // Register Custom Transformer for Brotli
+    _dio.transformer = DioBrotliTransformer();
+
+    _encodedDio = _createDio(baseUrl, autoUncompress: false);
+  }
+
+  static Dio _createDio(String baseUrl, {required bool autoUncompress}) {
+    final dio = Dio(
       BaseOptions(
         baseUrl: baseUrl,
         connectTimeout: const Duration(seconds: 240),
@@ -24,13 +36,10 @@ class NetworkClient {
       ),
     );
 
-    // Register Custom Transformer for Brotli
-    _dio.transformer = DioBrotliTransformer();
-
     // Aggressive Retry Strategy for High Load
-    _dio.interceptors.add(
+    dio.interceptors.add(
       RetryInterceptor(
-        dio: _dio,
+        dio: dio,
         logPrint: (message) => debugPrint('[Retry] $message'),
         retries: 5,
         retryDelays: const [
@@ -50,13 +59,14 @@ class NetworkClient {
     );
 
     // SSL Verify Bypass (Keep enabled for Emulator/Low Android Versions)
-    (_dio.httpClientAdapter as IOHttpClientAdapter).createHttpClient = () {
+    (dio.httpClientAdapter as IOHttpClientAdapter).createHttpClient = () {
       final client = HttpClient();
       // client.badCertificateCallback =
       //     (X509Certificate cert, String host, int port) => true;
-      client.autoUncompress = true; // Handle gzip/deflate automatically
+      client.autoUncompress = autoUncompress; // gzip/deflate, unless decoded natively
       return client;
     };
+    return dio;
   }
 
   Future<Response> get(
@@ -78,6 +88,42 @@ class NetworkClient {
     }
   }
 
+  /// GET returning the body exactly as sent, still compressed, for the
+  /// native parse_x_encoded parsers; [EncodedBody.encoding] is its
+  /// Content-Encoding. Skips decoding into a Dart string altogether.
+  Future<Response<EncodedBody>> getEncoded(
+    String path, {
+    Map<String, dynamic>? queryParameters,
+    Options? options,
+  }) async {
+    try {
+      final response = await _encodedDio.get<List<int>>(
+        path,
+        queryParameters: queryParameters,
+        options: (options ?? Options()).copyWith(
+          responseType: ResponseType.bytes,
+        ),
+      );
+      final data = response.data;
+      return Response<EncodedBody>(
+        data: (
+          bytes: data is Uint8List ? data : Uint8List.fromList(data ?? const []),
+          encoding: response.headers.value('content-encoding'),
+        ),
+        headers: response.headers,
+        requestOptions: response.requestOptions,
+        statusCode: response.statusCode,
+        statusMessage: response.statusMessage,
+        redirects: response.redirects,
+        extra: response.extra,
+      );
+    } on DioException catch (e) {
+      throw _handleDioError(e);
+    } catch (e) {
+      throw const NetworkFailure('Unexpected error occurred');
+    }
+  }
+
   Future<Response> post(
     String path, {
     dynamic data,
@@ -146,3 +192,25 @@ class NetworkClient {
     return NetworkFailure(error.message ?? 'Unknown network error');
   }
 }
+
+/// A response body as received and its Content-Encoding (null for none).
+typedef EncodedBody = ({Uint8List bytes, String? encoding});
+
+/// Body of a [ResponseType.stream] response: Dio hands over a
+/// [ResponseBody], [DioBrotliTransformer] a stream of the decoded bytes.
+Stream<List<int>> responseBodyStream(Response response) {
+  final data = response.data;
+  if (data is ResponseBody) return data.stream;
+  return data as Stream<List<int>>;
+}
+
+/// Content-Length, when it is the length of what [responseBodyStream]
+/// yields. A compressed body reaches the stream decoded, so its header
+/// describes something else.
+int? decodedContentLength(Response response) {
+  if (response.headers.value('content-encoding') != null) return null;
+  final length = int.tryParse(
+    response.headers.value(Headers.contentLengthHeader) ?? '',
+  );
+  return length != null && length > 0 ? length : null;
+}
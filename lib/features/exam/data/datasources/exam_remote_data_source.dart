@@ -1,3 +1,5 @@
+import 'dart:typed_data';
+
 import 'package:dio/dio.dart';
 import 'package:tlucalendar/core/error/failures.dart';
 import 'package:tlucalendar/core/network/network_client.dart';
@@ -19,6 +21,16 @@ abstract class ExamRemoteDataSource {
     required String accessToken,
     String? rawToken,
   });
+
+  /// Exam rooms for each (scheduleId, round) pair in [periods], in that
+  /// order, parsed together in one native call; null for a pair whose
+  /// request failed.
+  Future<List<List<ExamRoomModel>?>> getExamRoomsBatch({
+    required int semesterId,
+    required List<(int, int)> periods,
+    required String accessToken,
+    String? rawToken,
+  });
 }
 
 class ExamRemoteDataSourceImpl implements ExamRemoteDataSource {
@@ -92,4 +104,55 @@ class ExamRemoteDataSourceImpl implements ExamRemoteDataSource {
       throw ServerFailure(e.toString());
     }
   }
+
+  @override
+  Future<List<List<ExamRoomModel>?>> getExamRoomsBatch({
+    required int semesterId,
+    required List<(int, int)> periods,
+    required String accessToken,
+    String? rawToken,
+  }) async {
+    // Bodies are fetched together and collected first so a semester's
+    // worth of periods and rounds is parsed (in parallel, natively) and
+    // freed once.
+    final responses = await Future.wait([
+      for (final (scheduleId, round) in periods)
+        _getExamRoomsBody(semesterId, scheduleId, round, accessToken),
+    ]);
+    final bodies = <Uint8List>[];
+    final slots = <int?>[];
+    for (final body in responses) {
+      slots.add(body == null ? null : bodies.length);
+      if (body != null) bodies.add(body);
+    }
+
+    final rooms = NativeParser.parseExamRoomsBatch(bodies);
+    return [for (final slot in slots) slot == null ? null : rooms[slot]];
+  }
+
+  // One exam room response as sent; null if the request failed.
+  Future<Uint8List?> _getExamRoomsBody(
+    int semesterId,
+    int scheduleId,
+    int round,
+    String accessToken,
+  ) async {
+    try {
+      final response = await client.get(
+        '/education/api/semestersubjectexamroom/getListRoomByStudentByLoginUser/$semesterId/$scheduleId/$round',
+        options: Options(
+          responseType: ResponseType.bytes,
+          headers: {
+            'Authorization': 'Bearer $accessToken',
+            'Accept': 'application/json',
+          },
+        ),
+      );
+      if (response.statusCode != 200) return null;
+      final data = response.data as List<int>;
+      return data is Uint8List ? data : Uint8List.fromList(data);
+    } catch (_) {
+      return null;
+    }
+  }
 }
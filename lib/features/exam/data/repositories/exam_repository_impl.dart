@@ -2,6 +2,7 @@ import 'package:dartz/dartz.dart';
 import 'package:tlucalendar/core/error/failures.dart';
 import 'package:tlucalendar/features/exam/data/datasources/exam_remote_data_source.dart';
 import 'package:tlucalendar/features/exam/data/datasources/exam_local_data_source.dart';
+import 'package:tlucalendar/features/exam/data/models/exam_room_model.dart';
 import 'package:tlucalendar/features/exam/domain/entities/exam_room.dart';
 import 'package:tlucalendar/features/exam/domain/entities/exam_schedule.dart';
 import 'package:tlucalendar/features/exam/domain/repositories/exam_repository.dart';
@@ -95,4 +96,63 @@ class ExamRepositoryImpl implements ExamRepository {
       return Left(ServerFailure(e.toString()));
     }
   }
+
+  @override
+  Future<Either<Failure, List<List<ExamRoom>?>>> getExamRoomsBatch({
+    required int semesterId,
+    required List<(int, int)> periods,
+    required String accessToken,
+    String? rawToken,
+  }) async {
+    List<List<ExamRoomModel>?> fetched;
+    try {
+      fetched = await remoteDataSource.getExamRoomsBatch(
+        semesterId: semesterId,
+        periods: periods,
+        accessToken: accessToken,
+        rawToken: rawToken,
+      );
+    } catch (_) {
+      fetched = List.filled(periods.length, null);
+    }
+
+    // Cache what came back; fall back to the cache for the rest.
+    final rooms = <List<ExamRoom>?>[];
+    bool anyFetched = false;
+    bool anyCached = false;
+    for (int i = 0; i < periods.length; i++) {
+      final (scheduleId, round) = periods[i];
+      final periodRooms = fetched[i];
+      if (periodRooms != null) {
+        anyFetched = true;
+        try {
+          await localDataSource.cacheExamRooms(
+            semesterId: semesterId,
+            scheduleId: scheduleId,
+            round: round,
+            rooms: periodRooms,
+          );
+        } catch (e) {
+          // Log error
+        }
+        rooms.add(periodRooms);
+        continue;
+      }
+      List<ExamRoom>? cached;
+      try {
+        final localResult = await localDataSource.getCachedExamRooms(
+          semesterId: semesterId,
+          scheduleId: scheduleId,
+          round: round,
+        );
+        if (localResult.isNotEmpty) cached = localResult;
+      } catch (_) {}
+      anyCached = anyCached || cached != null;
+      rooms.add(cached);
+    }
+
+    if (anyFetched || periods.isEmpty) return Right(rooms);
+    if (anyCached) return Left(CachedDataFailure(rooms));
+    return const Left(ServerFailure('Get ExamRooms failed'));
+  }
 }
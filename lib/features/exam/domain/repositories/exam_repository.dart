@@ -19,4 +19,14 @@ abstract class ExamRepository {
     required String accessToken,
     String? rawToken,
   });
+
+  /// Exam rooms for each (scheduleId, round) pair in [periods], in that
+  /// order, parsed together in one native call; null for a pair that could
+  /// neither be fetched nor read from the cache.
+  Future<Either<Failure, List<List<ExamRoom>?>>> getExamRoomsBatch({
+    required int semesterId,
+    required List<(int, int)> periods,
+    required String accessToken,
+    String? rawToken,
+  });
 }
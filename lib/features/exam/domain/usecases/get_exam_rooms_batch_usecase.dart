@@ -0,0 +1,47 @@
+import 'package:dartz/dartz.dart';
+import 'package:equatable/equatable.dart';
+import 'package:tlucalendar/core/error/failures.dart';
+import 'package:tlucalendar/core/usecases/usecase.dart';
+import 'package:tlucalendar/features/exam/domain/entities/exam_room.dart';
+import 'package:tlucalendar/features/exam/domain/repositories/exam_repository.dart';
+
+class GetExamRoomsBatchUseCase
+    implements UseCase<List<List<ExamRoom>?>, GetExamRoomsBatchParams> {
+  final ExamRepository repository;
+
+  GetExamRoomsBatchUseCase(this.repository);
+
+  @override
+  Future<Either<Failure, List<List<ExamRoom>?>>> call(
+    GetExamRoomsBatchParams params,
+  ) async {
+    return await repository.getExamRoomsBatch(
+      semesterId: params.semesterId,
+      periods: params.periods,
+      accessToken: params.accessToken,
+      rawToken: params.rawToken,
+    );
+  }
+}
+
+class GetExamRoomsBatchParams extends Equatable {
+  final int semesterId;
+  final List<(int, int)> periods; // (scheduleId, round)
+  final String accessToken;
+  final String? rawToken;
+
+  const GetExamRoomsBatchParams({
+    required this.semesterId,
+    required this.periods,
+    required this.accessToken,
+    this.rawToken,
+  });
+
+  @override
+  List<Object> get props => [
+    semesterId,
+    periods,
+    accessToken,
+    if (rawToken != null) rawToken!,
+  ];
+}
@@ -39,10 +39,12 @@ class RegistrationRemoteDataSourceImpl implements RegistrationRemoteDataSource {
     String accessToken,
   ) async {
     try {
+      // Streamed: the native parser works through the body while the rest
+      // of it is still downloading.
       final response = await client.get(
         '/education/api/cs_reg_mongo/findByPeriod/$personId/$periodId',
         options: Options(
-          responseType: ResponseType.plain,
+          responseType: ResponseType.stream,
           headers: {
             'Authorization': 'Bearer $accessToken',
             'Accept': 'application/json',
@@ -50,12 +52,10 @@ class RegistrationRemoteDataSourceImpl implements RegistrationRemoteDataSource {
         ),
       );
 
-      final String jsonStr = response.data is String
-          ? response.data
-          : response.toString();
-      // debugPrint("REGISTRATION JSON: $jsonStr"); // Use simple print or log
-      print("REGISTRATION JSON: $jsonStr");
-      return NativeParser.parseRegistrationData(jsonStr);
+      return NativeParser.parseRegistrationDataStream(
+        responseBodyStream(response),
+        length: decodedContentLength(response),
+      );
     } on DioException catch (e) {
       throw ServerFailure(e.message ?? 'Unknown Dio Error');
     } catch (e) {
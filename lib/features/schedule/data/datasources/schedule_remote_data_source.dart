@@ -1,5 +1,4 @@
 import 'package:dio/dio.dart';
-import 'package:flutter/foundation.dart'; // for compute
 import 'package:tlucalendar/core/error/failures.dart';
 import 'package:tlucalendar/core/network/network_client.dart';
 
@@ -28,10 +27,11 @@ class ScheduleRemoteDataSourceImpl implements ScheduleRemoteDataSource {
     String accessToken,
   ) async {
     try {
-      final response = await client.get(
+      // Fetched still compressed: the native parser decodes and parses it
+      // in one pass.
+      final response = await client.getEncoded(
         '/education/api/StudentCourseSubject/studentLoginUser/$semesterId',
         options: Options(
-          responseType: ResponseType.plain,
           headers: {
             'Authorization': 'Bearer $accessToken',
             'Accept': 'application/json',
@@ -40,8 +40,8 @@ class ScheduleRemoteDataSourceImpl implements ScheduleRemoteDataSource {
       );
 
       if (response.statusCode == 200) {
-        // Run Native Parsing in a separate Isolate to avoid Main Thread GC Jank
-        return compute(NativeParser.parseCourses, response.data as String);
+        // Parsed on the native worker threads, off the UI isolate.
+        return NativeParser.parseCoursesAsync(response.data!);
       } else {
         throw ServerFailure('Get Courses failed: ${response.statusCode}');
       }
@@ -65,8 +65,7 @@ class ScheduleRemoteDataSourceImpl implements ScheduleRemoteDataSource {
       );
 
       if (response.statusCode == 200) {
-        // Run Native Parsing in a separate Isolate
-        return compute(NativeParser.parseCourseHours, response.data as String);
+        return NativeParser.parseCourseHoursAsync(response.data as String);
       } else {
         throw ServerFailure('Get CourseHours failed: ${response.statusCode}');
       }
@@ -91,8 +90,7 @@ class ScheduleRemoteDataSourceImpl implements ScheduleRemoteDataSource {
 
       if (response.statusCode == 200) {
         //debugPrint('RAW SCHOOL YEARS: ${response.data}'); // DEBUG LOG
-        // Run Native Parsing in a separate Isolate
-        return compute(NativeParser.parseSchoolYears, response.data as String);
+        return NativeParser.parseSchoolYearsAsync(response.data as String);
       } else {
         throw ServerFailure('Get SchoolYears failed: ${response.statusCode}');
       }
@@ -116,13 +114,7 @@ class ScheduleRemoteDataSourceImpl implements ScheduleRemoteDataSource {
       );
 
       if (response.statusCode == 200) {
-        // Run Native Parsing in a separate Isolate
-        // Note: parseSemester returns nullable, so we handle it inside wrapper if needed,
-        // but compute works with function returning nullable too.
-        // However, parseSemester returns SemesterResult? or Model?
-        // It currently returns SemesterModel?.
-        final result = await compute(
-          NativeParser.parseSemester,
+        final result = await NativeParser.parseSemesterAsync(
           response.data as String,
         );
         return result ??
@@ -24,6 +24,7 @@ import 'package:tlucalendar/features/schedule/domain/usecases/get_current_semest
 import 'package:tlucalendar/features/schedule/domain/usecases/get_course_hours_usecase.dart';
 import 'package:tlucalendar/features/exam/domain/usecases/get_exam_schedules_usecase.dart';
 import 'package:tlucalendar/features/exam/domain/usecases/get_exam_rooms_usecase.dart';
+import 'package:tlucalendar/features/exam/domain/usecases/get_exam_rooms_batch_usecase.dart';
 import 'package:tlucalendar/features/exam/domain/repositories/exam_repository.dart';
 import 'package:tlucalendar/features/exam/data/repositories/exam_repository_impl.dart';
 import 'package:tlucalendar/features/exam/data/datasources/exam_remote_data_source.dart';
@@ -85,6 +86,7 @@ Future<void> init() async {
   // UseCases
   sl.registerLazySingleton(() => GetExamSchedulesUseCase(sl()));
   sl.registerLazySingleton(() => GetExamRoomsUseCase(sl()));
+  sl.registerLazySingleton(() => GetExamRoomsBatchUseCase(sl()));
 
   // Schedule Feature
   sl.registerLazySingleton(() => GetSchoolYearsUseCase(sl()));
@@ -161,7 +163,7 @@ Future<void> init() async {
   sl.registerLazySingleton(
     () => ExamProvider(
       getExamSchedulesUseCase: sl(),
-      getExamRoomsUseCase: sl(),
+      getExamRoomsBatchUseCase: sl(),
       getSchoolYearsUseCase: sl(),
       getCourseHoursUseCase: sl(),
     ),
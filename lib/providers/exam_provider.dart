@@ -1,7 +1,7 @@
 import 'package:tlucalendar/features/exam/data/models/exam_dtos.dart' as Legacy;
 import 'package:tlucalendar/services/log_service.dart';
 import 'package:tlucalendar/services/notification_service.dart';
-import 'package:tlucalendar/features/exam/domain/usecases/get_exam_rooms_usecase.dart';
+import 'package:tlucalendar/features/exam/domain/usecases/get_exam_rooms_batch_usecase.dart';
 import 'package:tlucalendar/features/exam/domain/usecases/get_exam_schedules_usecase.dart';
 import 'package:tlucalendar/features/schedule/domain/usecases/get_school_years_usecase.dart';
 import 'package:tlucalendar/features/schedule/domain/usecases/get_course_hours_usecase.dart';
@@ -19,7 +19,7 @@ class ExamProvider with ChangeNotifier {
   final _log = LogService();
 
   final GetExamSchedulesUseCase getExamSchedulesUseCase;
-  final GetExamRoomsUseCase getExamRoomsUseCase;
+  final GetExamRoomsBatchUseCase getExamRoomsBatchUseCase;
   final GetSchoolYearsUseCase getSchoolYearsUseCase;
   final GetCourseHoursUseCase getCourseHoursUseCase;
 
@@ -27,7 +27,7 @@ class ExamProvider with ChangeNotifier {
 
   ExamProvider({
     required this.getExamSchedulesUseCase,
-    required this.getExamRoomsUseCase,
+    required this.getExamRoomsBatchUseCase,
     required this.getSchoolYearsUseCase,
     required this.getCourseHoursUseCase,
   });
@@ -50,6 +50,10 @@ class ExamProvider with ChangeNotifier {
   int? _selectedSemesterId;
   int _selectedExamRound = 1;
 
+  // Rooms already loaded for _roomsSemesterId, per (scheduleId, round).
+  final Map<(int, int), List<ExamRoom>> _roomsByPeriod = {};
+  int? _roomsSemesterId;
+
   List<Legacy.RegisterPeriod> get registerPeriods => _registerPeriods;
   List<Legacy.SemesterDto> get availableSemesters => _availableSemesters;
   List<Legacy.StudentExamRoom> get examRooms => _examRooms;
@@ -212,6 +216,7 @@ class ExamProvider with ChangeNotifier {
     _isLoading = true;
     _errorMessage = null;
     _registerPeriods = [];
+    _roomsByPeriod.clear();
     notifyListeners();
 
     String currentToken = accessToken;
@@ -359,18 +364,43 @@ class ExamProvider with ChangeNotifier {
     int round,
     String? rawToken,
   ) async {
+    if (_roomsSemesterId != semesterId) {
+      _roomsSemesterId = semesterId;
+      _roomsByPeriod.clear();
+    }
+
+    // Served from the semester's batch when it had rooms for this pair;
+    // an empty or failed pair is fetched again.
+    final loaded = _roomsByPeriod[(scheduleId, round)];
+    if (loaded != null && loaded.isNotEmpty) {
+      _roomErrorMessage = null;
+      _populateExamRooms(loaded);
+      _scheduleNotifications();
+      notifyListeners();
+      return;
+    }
+
     _isLoadingRooms = true;
     _roomErrorMessage = null;
     notifyListeners();
 
+    // The first load of a semester takes both rounds of every period with
+    // it, parsed in one native call, so switching between them is instant.
+    final periods = <(int, int)>[
+      (scheduleId, round),
+      if (_roomsByPeriod.isEmpty)
+        for (var period in _registerPeriods)
+          for (var r in const [1, 2])
+            if (period.id != scheduleId || r != round) (period.id, r),
+    ];
+
     String currentToken = accessToken;
 
     try {
-      var result = await getExamRoomsUseCase(
-        GetExamRoomsParams(
+      var result = await getExamRoomsBatchUseCase(
+        GetExamRoomsBatchParams(
           semesterId: semesterId,
-          scheduleId: scheduleId,
-          round: round,
+          periods: periods,
           accessToken: currentToken,
           rawToken: rawToken,
         ),
@@ -379,18 +409,19 @@ class ExamProvider with ChangeNotifier {
       bool shouldRetry = false;
       result.fold((l) {
         if (l is! CachedDataFailure) shouldRetry = true;
-      }, (r) {});
+      }, (r) {
+        shouldRetry = r.first == null;
+      });
 
       if (shouldRetry && _authProvider != null) {
         if (await _authProvider!.reLogin()) {
           currentToken = _authProvider!.accessToken!;
           final newRaw = _authProvider!.rawTokenStr ?? rawToken;
 
-          result = await getExamRoomsUseCase(
-            GetExamRoomsParams(
+          result = await getExamRoomsBatchUseCase(
+            GetExamRoomsBatchParams(
               semesterId: semesterId,
-              scheduleId: scheduleId,
-              round: round,
+              periods: periods,
               accessToken: currentToken,
               rawToken: newRaw,
             ),
@@ -400,8 +431,9 @@ class ExamProvider with ChangeNotifier {
 
       result.fold(
         (l) {
-          if (l is CachedDataFailure<List<ExamRoom>>) {
-            _populateExamRooms(l.data);
+          if (l is CachedDataFailure<List<List<ExamRoom>?>>) {
+            // Offline copies are not kept, so the next pick tries again.
+            _populateExamRooms(l.data.first ?? []);
             _roomErrorMessage = l.message;
           } else {
             _roomErrorMessage = l.message;
@@ -409,7 +441,13 @@ class ExamProvider with ChangeNotifier {
           }
         },
         (r) {
-          _populateExamRooms(r);
+          _storeExamRooms(periods, r);
+          if (r.first != null) {
+            _populateExamRooms(r.first!);
+          } else {
+            _roomErrorMessage = 'Get ExamRooms failed';
+            _examRooms = [];
+          }
         },
       );
     } catch (e) {
@@ -427,6 +465,16 @@ class ExamProvider with ChangeNotifier {
     }
   }
 
+  void _storeExamRooms(
+    List<(int, int)> periods,
+    List<List<ExamRoom>?> rooms,
+  ) {
+    for (int i = 0; i < periods.length; i++) {
+      final periodRooms = rooms[i];
+      if (periodRooms != null) _roomsByPeriod[periods[i]] = periodRooms;
+    }
+  }
+
   void _populateExamRooms(List<ExamRoom> rooms) {
     _examRoomEntities = rooms;
     _examRooms = rooms.map((e) {
@@ -142,38 +142,30 @@ class AutoRefreshService {
           );
           await examLocal.cacheExamSchedules(currentSem.id, examSchedules);
 
-          for (var schedule in examSchedules) {
-            // Round 1
-            try {
-              final rooms1 = await examRemote.getExamRooms(
-                semesterId: currentSem.id,
-                scheduleId: schedule.id,
-                round: 1,
-                accessToken: accessToken,
-                rawToken: rawToken,
-              );
-              await examLocal.cacheExamRooms(
-                semesterId: currentSem.id,
-                scheduleId: schedule.id,
-                round: 1,
-                rooms: rooms1,
-              );
-            } catch (_) {}
-
-            // Round 2
+          // Both rounds of every period, fetched together and parsed in one
+          // native call.
+          final periods = [
+            for (var schedule in examSchedules) ...[
+              (schedule.id, 1),
+              (schedule.id, 2),
+            ],
+          ];
+          final rooms = await examRemote.getExamRoomsBatch(
+            semesterId: currentSem.id,
+            periods: periods,
+            accessToken: accessToken,
+            rawToken: rawToken,
+          );
+          for (int i = 0; i < periods.length; i++) {
+            final periodRooms = rooms[i];
+            if (periodRooms == null) continue;
+            final (scheduleId, round) = periods[i];
             try {
-              final rooms2 = await examRemote.getExamRooms(
-                semesterId: currentSem.id,
-                scheduleId: schedule.id,
-                round: 2,
-                accessToken: accessToken,
-                rawToken: rawToken,
-              );
               await examLocal.cacheExamRooms(
                 semesterId: currentSem.id,
-                scheduleId: schedule.id,
-                round: 2,
-                rooms: rooms2,
+                scheduleId: scheduleId,
+                round: round,
+                rooms: periodRooms,
               );
             } catch (_) {}
           }